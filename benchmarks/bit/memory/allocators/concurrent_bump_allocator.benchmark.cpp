@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * \file
+ * \brief Scaling benchmarks for the concurrent_bump_allocator, compared
+ *        against an arena_allocator guarded by a std::mutex
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/arena_allocator.hpp>
+#include <bit/memory/allocators/concurrent_bump_allocator.hpp>
+#include <bit/memory/allocators/policy_allocator.hpp>
+#include <bit/memory/block_allocators/new_block_allocator.hpp>
+#include <bit/memory/policies/bounds_checkers/null_bounds_checker.hpp>
+#include <bit/memory/policies/taggers/null_tagger.hpp>
+#include <bit/memory/policies/trackers/null_tracker.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <mutex> // std::mutex
+
+namespace {
+
+  constexpr auto block_size      = 1024u * 1024u;
+  constexpr auto allocation_size = 48u;
+
+  /// Each thread performs a fixed number of allocations per run, so that
+  /// the arenas stay bounded at 64 threads
+  constexpr auto iterations = 1u << 16;
+
+  using block_allocator_type = bit::memory::new_block_allocator<block_size>;
+
+  using concurrent_allocator_type
+    = bit::memory::concurrent_bump_allocator<block_allocator_type>;
+
+  using locked_allocator_type = bit::memory::policy_allocator<
+    bit::memory::arena_allocator<block_allocator_type>,
+    bit::memory::null_tagger,
+    bit::memory::null_tracker,
+    bit::memory::null_bounds_checker,
+    std::mutex
+  >;
+
+  concurrent_allocator_type& concurrent_allocator()
+  {
+    static concurrent_allocator_type allocator{};
+    return allocator;
+  }
+
+  locked_allocator_type& locked_allocator()
+  {
+    static locked_allocator_type allocator{};
+    return allocator;
+  }
+
+  template<typename Allocator, typename Reset>
+  void parallel_fill( benchmark::State& state, Allocator& allocator, Reset reset )
+  {
+    // Every thread waits at the start of the loop, so the first thread can
+    // safely release the previous run's blocks
+    if( state.thread_index() == 0 ) reset();
+
+    for( auto _ : state ) {
+      auto p = allocator.try_allocate(allocation_size,8);
+      benchmark::DoNotOptimize(p);
+    }
+    state.SetItemsProcessed( state.iterations() );
+  }
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+static void concurrent_bump_allocator_scaling( benchmark::State& state )
+{
+  parallel_fill( state, concurrent_allocator(), []{
+    concurrent_allocator().deallocate_all();
+  });
+}
+BENCHMARK(concurrent_bump_allocator_scaling)
+  ->ThreadRange(1,64)->Iterations(iterations)->UseRealTime();
+
+//-----------------------------------------------------------------------------
+
+static void locked_arena_allocator_scaling( benchmark::State& state )
+{
+  parallel_fill( state, locked_allocator(), []{
+    locked_allocator().deallocate_all();
+  });
+}
+BENCHMARK(locked_arena_allocator_scaling)
+  ->ThreadRange(1,64)->Iterations(iterations)->UseRealTime();
@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * \file
+ * \brief Contention benchmarks for the concurrent_pool_allocator, compared
+ *        against a pool_allocator guarded by a std::mutex
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/concurrent_pool_allocator.hpp>
+#include <bit/memory/allocators/pool_allocator.hpp>
+#include <bit/memory/allocators/policy_allocator.hpp>
+#include <bit/memory/policies/bounds_checkers/null_bounds_checker.hpp>
+#include <bit/memory/policies/taggers/null_tagger.hpp>
+#include <bit/memory/policies/trackers/null_tracker.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array> // std::array
+#include <mutex> // std::mutex
+
+namespace {
+
+  constexpr auto chunk_size = 64u;
+  constexpr auto chunks     = 64u * 1024u;
+
+  /// The number of allocations each thread holds at a time
+  constexpr auto batch_size = 16u;
+
+  using locked_pool_allocator = bit::memory::policy_allocator<
+    bit::memory::pool_allocator,
+    bit::memory::null_tagger,
+    bit::memory::null_tracker,
+    bit::memory::null_bounds_checker,
+    std::mutex
+  >;
+
+  alignas(chunk_size) char concurrent_storage[chunk_size * chunks];
+  alignas(chunk_size) char locked_storage[chunk_size * chunks];
+
+  bit::memory::concurrent_pool_allocator& concurrent_allocator()
+  {
+    static bit::memory::concurrent_pool_allocator allocator{
+      chunk_size,
+      bit::memory::memory_block{concurrent_storage,sizeof(concurrent_storage)}
+    };
+    return allocator;
+  }
+
+  locked_pool_allocator& locked_allocator()
+  {
+    static locked_pool_allocator allocator{
+      chunk_size,
+      bit::memory::memory_block{locked_storage,sizeof(locked_storage)}
+    };
+    return allocator;
+  }
+
+  template<typename Allocator>
+  void allocate_and_deallocate( benchmark::State& state, Allocator& allocator )
+  {
+    auto pointers = std::array<void*,batch_size>{};
+
+    for( auto _ : state ) {
+      for( auto& p : pointers ) {
+        p = allocator.try_allocate(chunk_size/2,8);
+        benchmark::DoNotOptimize(p);
+      }
+      for( auto p : pointers ) {
+        allocator.deallocate(p,chunk_size/2);
+      }
+    }
+    state.SetItemsProcessed( state.iterations() * batch_size );
+  }
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+static void concurrent_pool_allocator_contention( benchmark::State& state )
+{
+  allocate_and_deallocate( state, concurrent_allocator() );
+}
+BENCHMARK(concurrent_pool_allocator_contention)->ThreadRange(1,64)->UseRealTime();
+
+//-----------------------------------------------------------------------------
+
+static void locked_pool_allocator_contention( benchmark::State& state )
+{
+  allocate_and_deallocate( state, locked_allocator() );
+}
+BENCHMARK(locked_pool_allocator_contention)->ThreadRange(1,64)->UseRealTime();
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ * \file
+ * \brief Contention benchmarks for each lock policy, measured through a
+ *        policy_allocator guarding a pool_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/pool_allocator.hpp>
+#include <bit/memory/allocators/policy_allocator.hpp>
+#include <bit/memory/policies/bounds_checkers/null_bounds_checker.hpp>
+#include <bit/memory/policies/lockables/hybrid_spin_then_park_lock.hpp>
+#include <bit/memory/policies/lockables/mcs_lock.hpp>
+#include <bit/memory/policies/lockables/spin_lock.hpp>
+#include <bit/memory/policies/lockables/ticket_lock.hpp>
+#include <bit/memory/policies/taggers/null_tagger.hpp>
+#include <bit/memory/policies/trackers/null_tracker.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array> // std::array
+#include <mutex> // std::mutex
+
+namespace {
+
+  constexpr auto chunk_size = 64u;
+
+  /// The number of allocations each thread holds at a time
+  constexpr auto batch_size = 16u;
+
+  /// Enough chunks for every thread in the range to hold a full batch
+  constexpr auto chunks = 64u * batch_size;
+
+  template<typename Lock>
+  using locked_pool_allocator = bit::memory::policy_allocator<
+    bit::memory::pool_allocator,
+    bit::memory::null_tagger,
+    bit::memory::null_tracker,
+    bit::memory::null_bounds_checker,
+    Lock
+  >;
+
+  template<typename Lock>
+  locked_pool_allocator<Lock>& locked_allocator()
+  {
+    alignas(chunk_size) static char storage[chunk_size * chunks];
+
+    static locked_pool_allocator<Lock> allocator{
+      chunk_size,
+      bit::memory::memory_block{storage,sizeof(storage)}
+    };
+    return allocator;
+  }
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+template<typename Lock>
+static void locked_pool_allocator_contention( benchmark::State& state )
+{
+  auto& allocator = locked_allocator<Lock>();
+  auto pointers = std::array<void*,batch_size>{};
+
+  for( auto _ : state ) {
+    for( auto& p : pointers ) {
+      p = allocator.try_allocate(chunk_size/2,8);
+      benchmark::DoNotOptimize(p);
+    }
+    for( auto p : pointers ) {
+      allocator.deallocate(p,chunk_size/2);
+    }
+  }
+  state.SetItemsProcessed( state.iterations() * batch_size * 2 );
+}
+
+BENCHMARK_TEMPLATE(locked_pool_allocator_contention, std::mutex)
+  ->ThreadRange(1,64)->UseRealTime();
+BENCHMARK_TEMPLATE(locked_pool_allocator_contention, bit::memory::spin_lock)
+  ->ThreadRange(1,64)->UseRealTime();
+BENCHMARK_TEMPLATE(locked_pool_allocator_contention, bit::memory::ticket_lock)
+  ->ThreadRange(1,64)->UseRealTime();
+BENCHMARK_TEMPLATE(locked_pool_allocator_contention, bit::memory::mcs_lock)
+  ->ThreadRange(1,64)->UseRealTime();
+BENCHMARK_TEMPLATE(locked_pool_allocator_contention, bit::memory::hybrid_spin_then_park_lock)
+  ->ThreadRange(1,64)->UseRealTime();
@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * \file
+ * \brief Benchmarks comparing the startup cost of prefaulting committed
+ *        virtual memory against the cost of faulting it in on first access
+ *****************************************************************************/
+
+
+#include <bit/memory/regions/virtual_memory.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef> // std::size_t
+
+namespace {
+
+  /// The size of the arena committed by each iteration
+  constexpr auto arena_size = std::size_t{256} * 1024u * 1024u;
+
+  /// \brief Writes to the first byte of every page in [p, p + size), as the
+  ///        first request against a freshly committed arena would
+  void touch_pages( void* p, std::size_t size )
+  {
+    const auto page_size = bit::memory::virtual_memory_page_size();
+    auto* const begin    = static_cast<volatile char*>(p);
+
+    for( auto offset = std::size_t{0}; offset < size; offset += page_size ) {
+      begin[offset] = 1;
+    }
+  }
+
+  /// \brief Measures either the commit ('startup') or the first pass over
+  ///        the arena ('first request'), with \p threads prefault threads;
+  ///        0 threads commits lazily
+  void commit_then_touch( benchmark::State& state, bool measure_commit )
+  {
+    const auto threads = static_cast<std::size_t>(state.range(0));
+    const auto pages   = arena_size / bit::memory::virtual_memory_page_size();
+
+    for( auto _ : state ) {
+      state.PauseTiming();
+      auto* const p = bit::memory::virtual_memory_reserve( pages );
+      if( measure_commit ) state.ResumeTiming();
+
+      bit::memory::virtual_memory_commit( p, pages );
+      if( threads != 0 ) {
+        bit::memory::virtual_memory_prefault( p, arena_size, threads );
+      }
+
+      if( measure_commit ) {
+        state.PauseTiming();
+      } else {
+        state.ResumeTiming();
+      }
+
+      touch_pages( p, arena_size );
+
+      if( !measure_commit ) state.PauseTiming();
+      bit::memory::virtual_memory_release( p, pages );
+      state.ResumeTiming();
+    }
+    state.SetBytesProcessed( state.iterations() * arena_size );
+  }
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+static void virtual_memory_startup( benchmark::State& state )
+{
+  commit_then_touch( state, true );
+}
+BENCHMARK(virtual_memory_startup)
+  ->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+  ->UseRealTime()->Unit(benchmark::kMillisecond);
+
+//-----------------------------------------------------------------------------
+
+static void virtual_memory_first_request( benchmark::State& state )
+{
+  commit_then_touch( state, false );
+}
+BENCHMARK(virtual_memory_first_request)
+  ->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+  ->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,268 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for an allocator that bumps
+ *        through a growing chain of blocks from a BlockAllocator
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_ARENA_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_ARENA_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../concepts/BlockAllocator.hpp" // is_block_allocator
+
+#include "../traits/block_allocator_traits.hpp" // block_allocator_traits
+
+#include "../utilities/ebo_storage.hpp"        // ebo_storage
+#include "../utilities/macros.hpp"             // BIT_MEMORY_UNLIKELY
+#include "../utilities/memory_block.hpp"       // memory_block
+#include "../utilities/memory_block_cache.hpp" // memory_block_cache
+#include "../utilities/owner.hpp"              // owner
+#include "../utilities/pointer_utilities.hpp"  // offset_align_forward
+
+#include <cassert>     // assert
+#include <cstddef>     // std::size_t
+#include <tuple>       // std::forward_as_tuple
+#include <type_traits> // std::enable_if_t, std::is_constructible
+#include <utility>     // std::forward, std::move
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief An allocator that bumps allocations up through a chain of
+    ///        blocks requested from an underlying BlockAllocator
+    ///
+    /// Allocations are made in an increasing memory-address pattern inside
+    /// of the current block, in the same way as the bump_up_allocator. When
+    /// the current block is exhausted, a new block is requested from the
+    /// BlockAllocator, and allocations continue from there -- giving
+    /// unbounded bump allocation at an amortized O(1) cost.
+    ///
+    /// Each block reserves the first \c sizeof(memory_block) bytes in order
+    /// to intrusively link the blocks together, so no additional bookkeeping
+    /// memory is required.
+    ///
+    /// This allocator can only deallocate memory with truncated deallocations
+    /// through \c deallocate_all, which returns every block to the
+    /// BlockAllocator in O(blocks), or by rewinding to a marker recorded with
+    /// \c checkpoint, which returns only the blocks acquired since.
+    ///
+    /// \satisfies{ExtendedAllocator}
+    ///
+    /// \tparam BlockAllocator the block allocator to request blocks from
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename BlockAllocator>
+    class arena_allocator
+      : private ebo_storage<BlockAllocator>
+    {
+      static_assert( is_block_allocator<BlockAllocator>::value,
+                     "BlockAllocator must be a BlockAllocator" );
+
+      using base_type = ebo_storage<BlockAllocator>;
+
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using block_allocator_type = BlockAllocator;
+
+      /// A marker of the allocation state, returned from \c checkpoint
+      struct checkpoint_type
+      {
+        void* block;   ///< The data of the current block
+        void* current; ///< The bump pointer in the current block
+      };
+
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an arena_allocator by forwarding all arguments to
+      ///        the underlying BlockAllocator
+      ///
+      /// No blocks are requested until the first allocation
+      ///
+      /// \param args the arguments to forward to the BlockAllocator
+      template<typename...Args, typename = std::enable_if_t<std::is_constructible<BlockAllocator,Args...>::value>>
+      explicit arena_allocator( Args&&...args );
+
+      /// \brief Move-constructs an arena_allocator from another allocator
+      ///
+      /// \param other the other arena_allocator to move
+      arena_allocator( arena_allocator&& other ) noexcept;
+
+      // Deleted copy constructor
+      arena_allocator( const arena_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Destructs this arena_allocator, returning every block to the
+      ///        underlying BlockAllocator
+      ~arena_allocator();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted copy assignment
+      arena_allocator& operator=( const arena_allocator& ) = delete;
+
+      // Deleted move assignment
+      arena_allocator& operator=( arena_allocator&& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate memory of size \p size, aligned to the
+      ///        boundary \p align, offset by \p offset
+      ///
+      /// If the current block cannot satisfy the request, a new block is
+      /// requested from the underlying BlockAllocator
+      ///
+      /// \param size the size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \param offset the amount to offset the alignment by
+      /// \return the allocated pointer on success, \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size,
+                                 std::size_t align,
+                                 std::size_t offset = 0 ) noexcept;
+
+      /// \brief Does nothing for arena_allocator. Use deallocate_all
+      ///
+      /// \param p the pointer
+      /// \param size the size of the allocation
+      void deallocate( owner<void*> p, std::size_t size );
+
+      /// \brief Deallocates everything from this allocator, returning every
+      ///        block to the underlying BlockAllocator
+      void deallocate_all();
+
+      //-----------------------------------------------------------------------
+      // Checkpoints
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Records the current allocation state of this allocator
+      ///
+      /// \return a marker that can later be passed to \c rewind
+      checkpoint_type checkpoint() const noexcept;
+
+      /// \brief Deallocates everything that was allocated since \p marker
+      ///        was recorded
+      ///
+      /// Every block that was acquired since \p marker was recorded is
+      /// returned to the underlying BlockAllocator
+      ///
+      /// \pre \p marker was returned from \c checkpoint on this allocator,
+      ///      and no earlier marker has been rewound to since
+      ///
+      /// \param marker the marker to rewind to
+      void rewind( checkpoint_type marker );
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Checks whether \p arena_allocator contains the pointer \p p
+      ///
+      /// \note This is O(blocks)
+      ///
+      /// \param p the pointer to check
+      /// \return \c true if \p p is contained in this allocator
+      bool owns( const void* p ) const noexcept;
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'arena_allocator'. Use a
+      /// named_arena_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Gets the number of blocks currently in use by this allocator
+      ///
+      /// \return the number of blocks
+      std::size_t blocks() const noexcept;
+
+      /// \brief Gets a reference to the underlying block allocator
+      ///
+      /// \return reference to the block allocator
+      block_allocator_type& block_allocator() noexcept;
+
+      /// \copydoc block_allocator()
+      const block_allocator_type& block_allocator() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      memory_block_cache m_blocks;  ///< All blocks; the head is the current
+      void*              m_current; ///< The bump pointer in the current block
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Bumps the current pointer in the current block
+      ///
+      /// \return the allocated pointer, or \c nullptr if it does not fit
+      void* allocate_from_current_block( std::size_t size,
+                                         std::size_t align,
+                                         std::size_t offset ) noexcept;
+
+      /// \brief Requests a new block from the block allocator, making it the
+      ///        current block
+      ///
+      /// \return \c true if a new block was acquired
+      bool acquire_block();
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    template<typename BlockAllocator>
+    using named_arena_allocator
+      = detail::named_allocator<arena_allocator<BlockAllocator>>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/arena_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_ARENA_ALLOCATOR_HPP */
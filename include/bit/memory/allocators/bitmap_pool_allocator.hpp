@@ -0,0 +1,239 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a fixed-size pool allocator
+ *        that tracks occupancy in a bitmap
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_BITMAP_POOL_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_BITMAP_POOL_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../utilities/allocator_info.hpp"    // allocator_info
+#include "../utilities/bit_scan.hpp"          // count_trailing_zeros
+#include "../utilities/macros.hpp"            // BIT_MEMORY_UNLIKELY
+#include "../utilities/memory_block.hpp"      // memory_block
+#include "../utilities/owner.hpp"             // owner
+#include "../utilities/pointer_utilities.hpp" // align_forward
+
+#include <cassert>     // assert
+#include <cstddef>     // std::size_t, std::max_align_t
+#include <cstdint>     // std::uint64_t
+#include <type_traits> // std::integral_constant
+#include <utility>     // std::forward
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h> // _mm_loadu_si128, _mm_cmpeq_epi32, _mm_movemask_epi8
+# define BIT_MEMORY_BITMAP_POOL_USE_SSE2 1
+#endif
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief This allocator creates a pool of fixed-sized chunks, whose
+    ///        occupancy is tracked in a bitmap rather than a freelist
+    ///
+    /// Since no links are stored in the chunks themselves, chunks may be as
+    /// small as a single byte, and every live chunk can be enumerated in
+    /// address order with \c for_each_allocated.
+    ///
+    /// The bitmap is stored at the front of the block, with one bit per
+    /// chunk. Free chunks are found by scanning the bitmap a word at a time
+    /// (two words at a time with SSE2) from the lowest word that may have a
+    /// free chunk, so allocations are always satisfied from the lowest free
+    /// address.
+    ///
+    /// \satisfies{Allocator}
+    ///////////////////////////////////////////////////////////////////////////
+    class bitmap_pool_allocator
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      /// Chunks are aligned to the largest power of two that divides the
+      /// chunk size, up to this alignment
+      using max_alignment = std::integral_constant<std::size_t,alignof(std::max_align_t)>;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a bitmap pool allocator with chunk sizes of
+      ///        \p chunk_size, in the arena indicated by \p block
+      ///
+      /// \param chunk_size the size of each entry in the pool allocator
+      /// \param block the block to allocate from
+      bitmap_pool_allocator( std::size_t chunk_size, memory_block block ) noexcept;
+
+      /// \brief Move-constructs the bitmap_pool_allocator from another
+      ///        allocator
+      ///
+      /// \param other the other allocator to move
+      bitmap_pool_allocator( bitmap_pool_allocator&& other ) noexcept = default;
+
+      // Deleted copy construction
+      bitmap_pool_allocator( const bitmap_pool_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      bitmap_pool_allocator& operator=( bitmap_pool_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      bitmap_pool_allocator& operator=( const bitmap_pool_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align
+      ///
+      /// Requests larger than \c max_size(), or more aligned than the
+      /// chunks, fail
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size, std::size_t align ) noexcept;
+
+      /// \brief Deallocates memory previously allocated from a call to
+      ///        \c try_allocate
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate( owner<void*> p, std::size_t size );
+
+      /// \brief Deallocates all memory in this bitmap_pool_allocator
+      void deallocate_all();
+
+      //-----------------------------------------------------------------------
+      // Iteration
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Invokes \p fn with a pointer to every allocated chunk, in
+      ///        address order
+      ///
+      /// \p fn must not allocate from, or deallocate to, this allocator
+      ///
+      /// \param fn a function invocable as \c fn(void*)
+      template<typename Fn>
+      void for_each_allocated( Fn&& fn );
+
+      /// \copydoc for_each_allocated
+      template<typename Fn>
+      void for_each_allocated( Fn&& fn ) const;
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Determines whether the pointer \p p is owned by this allocator
+      ///
+      /// \return \c true if the pointer \p p is originally from this allocator
+      bool owns( const void* p ) const noexcept;
+
+      /// \brief Determines the max size that this allocator can allocate
+      ///
+      /// \return the max size
+      std::size_t max_size() const noexcept;
+
+      /// \brief Gets the number of chunks in this pool
+      ///
+      /// \return the number of chunks
+      std::size_t capacity() const noexcept;
+
+      /// \brief Gets the number of chunks that are currently allocated
+      ///
+      /// \return the number of allocated chunks
+      std::size_t size() const noexcept;
+
+      //----------------------------------------------------------------------
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'bitmap_pool_allocator'. Use a
+      /// named_bitmap_pool_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      std::uint64_t* m_bitmap;      ///< One bit per chunk; set if allocated
+      void*          m_chunks;      ///< The first chunk
+      std::size_t    m_chunk_size;  ///< The size of each chunk
+      std::size_t    m_chunk_align; ///< The alignment of every chunk
+      std::size_t    m_chunk_count; ///< The number of chunks
+      std::size_t    m_words;       ///< The number of words in the bitmap
+      std::size_t    m_hint;        ///< No word before this has a free chunk
+      std::size_t    m_size;        ///< The number of allocated chunks
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Clears the bitmap, marking the padding bits in the last word
+      ///        as permanently allocated
+      void reset_bitmap() noexcept;
+
+      /// \brief Finds the index of the first bitmap word with a free chunk,
+      ///        starting from \c m_hint
+      ///
+      /// \return the index of the word, or \c m_words if the pool is full
+      std::size_t find_free_word() const noexcept;
+
+      /// \brief Gets a pointer to the chunk at \p index
+      void* chunk_at( std::size_t index ) const noexcept;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    using named_bitmap_pool_allocator
+      = detail::named_allocator<bitmap_pool_allocator>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/bitmap_pool_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_BITMAP_POOL_ALLOCATOR_HPP */
@@ -0,0 +1,275 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a binary buddy allocator
+ *        backed by reserved virtual memory
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_BUDDY_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_BUDDY_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../regions/virtual_memory.hpp" // virtual_memory_reserve, etc
+
+#include "../utilities/allocator_info.hpp"    // allocator_info
+#include "../utilities/bit_scan.hpp"          // count_trailing_zeros, etc
+#include "../utilities/macros.hpp"            // BIT_MEMORY_UNLIKELY
+#include "../utilities/owner.hpp"             // owner
+#include "../utilities/pointer_utilities.hpp" // is_power_of_two
+
+#include <cassert>     // assert
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t
+#include <type_traits> // std::integral_constant
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A binary buddy allocator over a power-of-two range of reserved
+    ///        virtual memory
+    ///
+    /// The range is reserved up front with \c virtual_memory_reserve, and is
+    /// recursively split into halves ('buddies') to satisfy allocations. The
+    /// smallest buddy is a single virtual page, so this allocator is best
+    /// suited to large buffers.
+    ///
+    /// Pages are only committed once they are handed out in an allocation.
+    /// When a deallocated buddy merges into a free buddy of at least
+    /// \c decommit_threshold() bytes, its pages are decommitted again.
+    ///
+    /// Free buddies are tracked in a bitmap per order, so that splitting and
+    /// merging are O(log n). Since the buddy of an allocation is known, an
+    /// allocation can also be expanded in place by absorbing free buddies
+    /// to its right, without copying.
+    ///
+    /// The bookkeeping is stored in its own committed virtual memory, apart
+    /// from the managed range.
+    ///
+    /// \satisfies{Allocator}
+    ///////////////////////////////////////////////////////////////////////////
+    class buddy_allocator
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      /// Every buddy is aligned to at least one virtual page
+      using max_alignment = std::integral_constant<std::size_t,4096>;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a buddy_allocator that reserves \p size bytes of
+      ///        virtual memory, rounded up to a power-of-two number of pages
+      ///
+      /// \param size the number of bytes to reserve
+      /// \param decommit_threshold the size of the smallest free buddy that
+      ///        is decommitted on deallocation
+      explicit buddy_allocator( std::size_t size,
+                                std::size_t decommit_threshold = 1024 * 1024 );
+
+      /// \brief Move-constructs the buddy_allocator from another allocator
+      ///
+      /// \param other the other allocator to move
+      buddy_allocator( buddy_allocator&& other ) noexcept;
+
+      // Deleted copy construction
+      buddy_allocator( const buddy_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Releases all virtual memory reserved by this allocator
+      ~buddy_allocator();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      buddy_allocator& operator=( buddy_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      buddy_allocator& operator=( const buddy_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align
+      ///
+      /// The size is rounded up to the nearest power-of-two number of pages
+      ///
+      /// \pre \p align does not exceed the virtual page size
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size, std::size_t align ) noexcept;
+
+      /// \brief Expands the allocation at \p p in place so that it holds at
+      ///        least \p new_size bytes
+      ///
+      /// This succeeds only if every buddy that would be absorbed is free.
+      /// On failure, nothing is changed.
+      ///
+      /// \param p the pointer to the allocation to expand
+      /// \param new_size the new size of the allocation
+      /// \return \c true if the allocation now holds \p new_size bytes
+      bool expand( void* p, std::size_t new_size ) noexcept;
+
+      /// \brief Deallocates memory previously allocated from a call to
+      ///        \c try_allocate
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to
+      ///        try_allocate, or to the last successful call to expand
+      void deallocate( owner<void*> p, std::size_t size );
+
+      /// \brief Deallocates all memory in this buddy_allocator, and
+      ///        decommits every page
+      void deallocate_all();
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Determines whether the pointer \p p is owned by this allocator
+      ///
+      /// \return \c true if the pointer \p p is originally from this allocator
+      bool owns( const void* p ) const noexcept;
+
+      /// \brief Determines the max size that this allocator can allocate
+      ///
+      /// \return the size of the whole reserved range
+      std::size_t max_size() const noexcept;
+
+      /// \brief Gets the number of bytes that are currently committed
+      ///
+      /// \return the number of committed bytes
+      std::size_t committed_size() const noexcept;
+
+      /// \brief Gets the size of the smallest free buddy that is decommitted
+      ///        on deallocation
+      ///
+      /// \return the decommit threshold, in bytes
+      std::size_t decommit_threshold() const noexcept;
+
+      //----------------------------------------------------------------------
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'buddy_allocator'. Use a
+      /// named_buddy_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      /// The maximum number of orders; order 0 is a single page
+      static constexpr auto s_max_orders = std::size_t{40};
+
+      void*          m_memory;          ///< The reserved range
+      std::size_t    m_max_order;       ///< The order of the whole range
+      std::size_t    m_decommit_order;  ///< The smallest decommitted order
+
+      void*          m_metadata;        ///< Memory for the bookkeeping
+      std::size_t    m_metadata_pages;  ///< Pages of bookkeeping
+      std::uint64_t* m_committed;       ///< One bit per committed page
+      unsigned char* m_orders;          ///< (order+1) of each allocation
+      std::size_t    m_committed_pages; ///< The number of committed pages
+
+      std::uint64_t  m_free_orders;     ///< One bit per order with free buddies
+      std::uint64_t* m_free[s_max_orders];
+      std::size_t    m_free_counts[s_max_orders];
+      std::size_t    m_free_hints[s_max_orders];
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Gets the order of the smallest buddy that holds \p size bytes
+      std::size_t order_of( std::size_t size ) const noexcept;
+
+      /// \brief Gets the address of the first page of \p page
+      void* page_address( std::size_t page ) const noexcept;
+
+      bool test_free( std::size_t order, std::size_t index ) const noexcept;
+      void set_free( std::size_t order, std::size_t index ) noexcept;
+      void clear_free( std::size_t order, std::size_t index ) noexcept;
+
+      /// \brief Finds, and removes, a free buddy of \p order
+      std::size_t request_free( std::size_t order ) noexcept;
+
+      /// \brief Frees the buddy of \p order at \p index, merging it with any
+      ///        free buddies
+      void release_buddy( std::size_t order, std::size_t index ) noexcept;
+
+      /// \brief Finds the first page in [first, last) that is committed if
+      ///        \p committed is \c true, or uncommitted otherwise
+      ///
+      /// \return the page, or \p last if there is none
+      std::size_t find_page( std::size_t first,
+                             std::size_t last,
+                             bool committed ) const noexcept;
+
+      /// \brief Marks every page in [first, last) as committed if
+      ///        \p committed is \c true, or uncommitted otherwise
+      void mark_pages( std::size_t first,
+                       std::size_t last,
+                       bool committed ) noexcept;
+
+      /// \brief Commits any uncommitted pages in [first, first + n)
+      bool commit_pages( std::size_t first, std::size_t n ) noexcept;
+
+      /// \brief Decommits any committed pages in [first, first + n)
+      void decommit_pages( std::size_t first, std::size_t n ) noexcept;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    using named_buddy_allocator = detail::named_allocator<buddy_allocator>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/buddy_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_BUDDY_ALLOCATOR_HPP */
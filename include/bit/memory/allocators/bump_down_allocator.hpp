@@ -76,6 +76,12 @@ namespace bit {
 
       using max_alignment = std::integral_constant<std::size_t,(1 << (sizeof(std::size_t)-1))>;
 
+      /// A marker of the allocation state, returned from \c checkpoint
+      struct checkpoint_type
+      {
+        void* current;
+      };
+
       //-----------------------------------------------------------------------
       // Constructors
       //-----------------------------------------------------------------------
@@ -128,6 +134,25 @@ namespace bit {
       /// \brief Deallocates everything from this allocator
       void deallocate_all() noexcept;
 
+      //-----------------------------------------------------------------------
+      // Checkpoints
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Records the current allocation state of this allocator
+      ///
+      /// \return a marker that can later be passed to \c rewind
+      checkpoint_type checkpoint() const noexcept;
+
+      /// \brief Deallocates everything that was allocated since \p marker
+      ///        was recorded, in O(1)
+      ///
+      /// \pre \p marker was returned from \c checkpoint on this allocator,
+      ///      and no earlier marker has been rewound to since
+      ///
+      /// \param marker the marker to rewind to
+      void rewind( checkpoint_type marker ) noexcept;
+
       //-----------------------------------------------------------------------
       // Observers
       //-----------------------------------------------------------------------
@@ -68,6 +68,12 @@ namespace bit {
 
       using max_alignment = std::integral_constant<std::size_t,(1 << (sizeof(std::size_t)-1))>;
 
+      /// A marker of the allocation state, returned from \c checkpoint
+      struct checkpoint_type
+      {
+        void* current;
+      };
+
       //-----------------------------------------------------------------------
       // Constructors
       //-----------------------------------------------------------------------
@@ -111,6 +117,18 @@ namespace bit {
                                  std::size_t align,
                                  std::size_t offset = 0 ) noexcept;
 
+      /// \brief Expands the most recent allocation at \p p in place so that
+      ///        it holds \p new_size bytes
+      ///
+      /// Only the most recent allocation can be expanded, since it is the
+      /// only one with nothing allocated after it. On failure, nothing is
+      /// changed.
+      ///
+      /// \param p the pointer to the most recent allocation
+      /// \param new_size the new size of the allocation
+      /// \return \c true if the allocation now holds \p new_size bytes
+      bool expand( void* p, std::size_t new_size ) noexcept;
+
       /// \brief Does nothing for bump_up_allocator. Use deallocate_all
       ///
       /// \param p the pointer
@@ -120,6 +138,25 @@ namespace bit {
       /// \brief Deallocates everything from this allocator
       void deallocate_all() noexcept;
 
+      //-----------------------------------------------------------------------
+      // Checkpoints
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Records the current allocation state of this allocator
+      ///
+      /// \return a marker that can later be passed to \c rewind
+      checkpoint_type checkpoint() const noexcept;
+
+      /// \brief Deallocates everything that was allocated since \p marker
+      ///        was recorded, in O(1)
+      ///
+      /// \pre \p marker was returned from \c checkpoint on this allocator,
+      ///      and no earlier marker has been rewound to since
+      ///
+      /// \param marker the marker to rewind to
+      void rewind( checkpoint_type marker ) noexcept;
+
       //-----------------------------------------------------------------------
       // Observers
       //-----------------------------------------------------------------------
@@ -146,6 +183,7 @@ namespace bit {
 
       memory_block m_block;
       void*        m_current;
+      void*        m_last;    ///< The most recent allocation
     };
 
     //-------------------------------------------------------------------------
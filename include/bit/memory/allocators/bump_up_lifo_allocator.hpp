@@ -123,6 +123,17 @@ namespace bit {
                                  std::size_t align,
                                  std::size_t offset = 0 ) noexcept;
 
+      /// \brief Expands the most recent allocation at \p p in place so that
+      ///        it holds \p new_size bytes
+      ///
+      /// Only the most recent allocation that has not been deallocated can be
+      /// expanded. On failure, nothing is changed.
+      ///
+      /// \param p the pointer to the most recent allocation
+      /// \param new_size the new size of the allocation
+      /// \return \c true if the allocation now holds \p new_size bytes
+      bool expand( void* p, std::size_t new_size ) noexcept;
+
       /// \brief Does nothing for bump_up_lifo_allocator. Use deallocate_all
       ///
       /// \param p the pointer
@@ -158,6 +169,7 @@ namespace bit {
 
       memory_block m_block;
       void*        m_current;
+      void*        m_last;    ///< The most recent allocation
     };
 
     //-------------------------------------------------------------------------
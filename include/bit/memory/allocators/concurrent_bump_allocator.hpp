@@ -0,0 +1,258 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a bump allocator that may
+ *        be shared between threads
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_CONCURRENT_BUMP_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_CONCURRENT_BUMP_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../concepts/BasicLockable.hpp"  // is_basic_lockable
+#include "../concepts/BlockAllocator.hpp" // is_block_allocator
+
+#include "../traits/block_allocator_traits.hpp" // block_allocator_traits
+
+#include "../utilities/allocator_info.hpp"    // allocator_info
+#include "../utilities/ebo_storage.hpp"       // ebo_storage
+#include "../utilities/macros.hpp"            // BIT_MEMORY_UNLIKELY
+#include "../utilities/memory_block.hpp"      // memory_block
+#include "../utilities/owner.hpp"             // owner
+#include "../utilities/pointer_utilities.hpp" // align_forward
+
+#include <atomic>      // std::atomic
+#include <cassert>     // assert
+#include <cstddef>     // std::size_t, std::max_align_t
+#include <mutex>       // std::mutex, std::lock_guard
+#include <new>         // placement new
+#include <tuple>       // std::forward_as_tuple
+#include <type_traits> // std::enable_if_t, std::is_constructible
+#include <utility>     // std::forward
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A bump allocator over a chain of blocks that any number of
+    ///        threads may allocate from at once
+    ///
+    /// Each allocation claims its space from the current block with a single
+    /// \c fetch_add on the block's offset, so allocating never blocks or
+    /// retries. Sizes are rounded up to the fundamental alignment so that
+    /// every claim stays aligned to it; over-aligned requests claim enough
+    /// extra space to be aligned within the claim.
+    ///
+    /// When a claim overruns the current block, the claiming thread requests
+    /// a new block from the BlockAllocator and publishes it as the current
+    /// block. Only this slow path takes the lock, which guards nothing but
+    /// the BlockAllocator; threads that overrun the same block concurrently
+    /// adopt the first new block rather than each requesting their own.
+    ///
+    /// Like the arena_allocator, memory is only deallocated in bulk with
+    /// \c deallocate_all, which must not run concurrently with allocations.
+    ///
+    /// \satisfies{Allocator}
+    ///
+    /// \tparam BlockAllocator the block allocator to request blocks from
+    /// \tparam BasicLockable the lock guarding the BlockAllocator
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename BlockAllocator, typename BasicLockable = std::mutex>
+    class concurrent_bump_allocator
+      : private ebo_storage<BlockAllocator,BasicLockable>
+    {
+      static_assert( is_block_allocator<BlockAllocator>::value,
+                     "BlockAllocator must be a BlockAllocator" );
+      static_assert( is_basic_lockable<BasicLockable>::value,
+                     "BasicLockable must be BasicLockable" );
+
+      using base_type = ebo_storage<BlockAllocator,BasicLockable>;
+
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using block_allocator_type = BlockAllocator;
+      using lock_type            = BasicLockable;
+
+      /// Every claim is a multiple of this size, and aligned to it
+      using granule_size = std::integral_constant<std::size_t,alignof(std::max_align_t)>;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a concurrent_bump_allocator by forwarding all
+      ///        arguments to the underlying BlockAllocator
+      ///
+      /// No blocks are requested until the first allocation
+      ///
+      /// \param args the arguments to forward to the BlockAllocator
+      template<typename...Args, typename = std::enable_if_t<std::is_constructible<BlockAllocator,Args...>::value>>
+      explicit concurrent_bump_allocator( Args&&...args );
+
+      // Deleted move constructor
+      concurrent_bump_allocator( concurrent_bump_allocator&& other ) = delete;
+
+      // Deleted copy constructor
+      concurrent_bump_allocator( const concurrent_bump_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Destructs this concurrent_bump_allocator, returning every
+      ///        block to the underlying BlockAllocator
+      ~concurrent_bump_allocator();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      concurrent_bump_allocator& operator=( concurrent_bump_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      concurrent_bump_allocator& operator=( const concurrent_bump_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align
+      ///
+      /// This may be called from any number of threads concurrently
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size, std::size_t align ) noexcept;
+
+      /// \brief Does nothing for concurrent_bump_allocator. Use
+      ///        deallocate_all
+      ///
+      /// \param p the pointer
+      /// \param size the size of the allocation
+      void deallocate( owner<void*> p, std::size_t size );
+
+      /// \brief Deallocates everything from this allocator, returning every
+      ///        block to the underlying BlockAllocator
+      ///
+      /// \note No other thread may be using this allocator at the same time
+      void deallocate_all();
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Checks whether this allocator contains the pointer \p p
+      ///
+      /// \note This is O(blocks)
+      ///
+      /// \param p the pointer to check
+      /// \return \c true if \p p is contained in this allocator
+      bool owns( const void* p ) const noexcept;
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'concurrent_bump_allocator'. Use a
+      /// named_concurrent_bump_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Gets the number of blocks currently in use by this allocator
+      ///
+      /// \return the number of blocks
+      std::size_t blocks() const noexcept;
+
+      /// \brief Gets a reference to the underlying block allocator
+      ///
+      /// \note Accessing the block allocator is not synchronized
+      ///
+      /// \return reference to the block allocator
+      block_allocator_type& block_allocator() noexcept;
+
+      /// \copydoc block_allocator()
+      const block_allocator_type& block_allocator() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief The header stored at the start of each block
+      struct block_header
+      {
+        memory_block             block;    ///< The block this heads
+        block_header*            previous; ///< The block used before this
+        unsigned char*           data;     ///< The first claimable byte
+        std::size_t              capacity; ///< The number of claimable bytes
+        std::atomic<std::size_t> offset;   ///< The bytes claimed so far
+      };
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      std::atomic<block_header*> m_current; ///< The block being claimed from
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Replaces \p full as the current block, unless another thread
+      ///        already has
+      ///
+      /// \param full the block that a claim overran
+      /// \param claim the size of the claim that must fit the new block
+      /// \return the current block, or \c nullptr if no block could be made
+      block_header* acquire_block( block_header* full,
+                                   std::size_t claim ) noexcept;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    template<typename BlockAllocator, typename BasicLockable = std::mutex>
+    using named_concurrent_bump_allocator
+      = detail::named_allocator<concurrent_bump_allocator<BlockAllocator,BasicLockable>>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/concurrent_bump_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_CONCURRENT_BUMP_ALLOCATOR_HPP */
@@ -0,0 +1,191 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a thread-safe allocator
+ *        that creates fixed-sized allocations from a reused pool
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_CONCURRENT_POOL_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_CONCURRENT_POOL_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../utilities/atomic_freelist.hpp"   // atomic_freelist
+#include "../utilities/macros.hpp"            // BIT_MEMORY_UNLIKELY
+#include "../utilities/memory_block.hpp"      // memory_block
+#include "../utilities/owner.hpp"             // owner
+#include "../utilities/pointer_utilities.hpp" // is_power_of_two
+
+#include <atomic>  // std::atomic
+#include <cassert>
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief This allocator creates a pool of fixed-sized chunk entries for
+    ///        allocations that may be accessed concurrently from multiple
+    ///        threads without any external locking
+    ///
+    /// Chunks are recycled through an atomic_freelist, so both
+    /// \c try_allocate and \c deallocate are lock-free on platforms that
+    /// support a double-width compare-and-swap. Like the pool_allocator,
+    /// chunks that have never been used are claimed from an atomic bump
+    /// cursor rather than being linked into the freelist up front.
+    ///
+    /// \note \c deallocate_all is not thread-safe, and must not be called
+    ///       while any other thread is accessing this allocator
+    ///
+    /// \satisfies{ExtendedAllocator}
+    ///////////////////////////////////////////////////////////////////////////
+    class concurrent_pool_allocator
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      /// The max alignment is limited to 128 bytes due to an internal
+      /// requirement that it stores the offset information
+      using max_alignment = std::integral_constant<std::size_t,128>;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a concurrent pool allocator with chunk sizes of
+      ///        \p chunk_size, in the arena indicated by \p block
+      ///
+      /// \param chunk_size the size of each entry in the pool allocator
+      /// \param block the block to allocate from
+      concurrent_pool_allocator( std::size_t chunk_size, memory_block block );
+
+      // Deleted move construction
+      concurrent_pool_allocator( concurrent_pool_allocator&& other ) = delete;
+
+      // Deleted copy construction
+      concurrent_pool_allocator( const concurrent_pool_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      concurrent_pool_allocator& operator=( concurrent_pool_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      concurrent_pool_allocator& operator=( const concurrent_pool_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align,
+      ///        offset by \p offset
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \param offset the amount to offset the alignment
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size,
+                                 std::size_t align,
+                                 std::size_t offset = 0 ) noexcept;
+
+      /// \brief Deallocates memory previously allocated from a call to
+      ///        \c try_allocate
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate( owner<void*> p, std::size_t size );
+
+      /// \brief Deallocates all memory in this concurrent_pool_allocator
+      ///
+      /// \note This function is not thread-safe
+      void deallocate_all();
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Determines whether the pointer \p p is owned by this allocator
+      ///
+      /// \return \c true if the pointer \p p is originally from this allocator
+      bool owns( const void* p ) const noexcept;
+
+      /// \brief Determines the max size that this allocator can allocate
+      ///
+      /// \return the max size
+      std::size_t max_size() const noexcept;
+
+      //----------------------------------------------------------------------
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'concurrent_pool_allocator'. Use a
+      /// named_concurrent_pool_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      atomic_freelist          m_freelist;
+      memory_block             m_block;
+      std::atomic<std::size_t> m_offset;
+      std::size_t              m_chunk_size;
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Requests a chunk that has been recycled, or one that has not
+      ///        yet been used from the untouched portion of the block
+      ///
+      /// \return pointer to the chunk, or \c nullptr if the pool is exhausted
+      void* request_chunk() noexcept;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    using named_concurrent_pool_allocator
+      = detail::named_allocator<concurrent_pool_allocator>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/concurrent_pool_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_CONCURRENT_POOL_ALLOCATOR_HPP */
@@ -0,0 +1,229 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_ARENA_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_ARENA_ALLOCATOR_INL
+
+//============================================================================
+// arena_allocator
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructors / Destructor
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+template<typename...Args, typename>
+inline bit::memory::arena_allocator<BlockAllocator>
+  ::arena_allocator( Args&&...args )
+  : base_type( std::forward_as_tuple(std::forward<Args>(args)...) ),
+    m_blocks(),
+    m_current(nullptr)
+{
+
+}
+
+template<typename BlockAllocator>
+inline bit::memory::arena_allocator<BlockAllocator>
+  ::arena_allocator( arena_allocator&& other )
+  noexcept
+  : base_type( static_cast<base_type&&>(other) ),
+    m_blocks(),
+    m_current(other.m_current)
+{
+  m_blocks.swap( other.m_blocks );
+  other.m_current = nullptr;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline bit::memory::arena_allocator<BlockAllocator>::~arena_allocator()
+{
+  deallocate_all();
+}
+
+//----------------------------------------------------------------------------
+// Allocation / Deallocation
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline bit::memory::owner<void*>
+  bit::memory::arena_allocator<BlockAllocator>
+  ::try_allocate( std::size_t size, std::size_t align, std::size_t offset )
+  noexcept
+{
+  assert( size && "cannot allocate 0 bytes");
+  assert( align && "cannot allocate with 0 alignment");
+  assert( is_power_of_two(align) && "alignment must be a power of two" );
+
+  auto p = allocate_from_current_block( size, align, offset );
+
+  if( BIT_MEMORY_LIKELY(p != nullptr) ) return p;
+
+  // Don't bother requesting a block that could never fit the request
+  const auto next_size = block_allocator_traits<BlockAllocator>
+                         ::next_block_size( block_allocator() );
+  if( BIT_MEMORY_UNLIKELY(sizeof(memory_block) + offset + size > next_size) ) {
+    return nullptr;
+  }
+
+  if( BIT_MEMORY_UNLIKELY(!acquire_block()) ) return nullptr;
+
+  return allocate_from_current_block( size, align, offset );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline void bit::memory::arena_allocator<BlockAllocator>
+  ::deallocate( owner<void*> p, std::size_t size )
+{
+  BIT_MEMORY_UNUSED(p);
+  BIT_MEMORY_UNUSED(size);
+
+  assert( owns( p ) && "Pointer must be contained by the arena" );
+
+  // arena_allocator only uses truncated deallocations with deallocate_all
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline void bit::memory::arena_allocator<BlockAllocator>::deallocate_all()
+{
+  auto& allocator = block_allocator();
+
+  while( !m_blocks.empty() ) {
+    block_allocator_traits<BlockAllocator>::deallocate_block(
+      allocator,
+      m_blocks.request_block()
+    );
+  }
+  m_current = nullptr;
+}
+
+//----------------------------------------------------------------------------
+// Checkpoints
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline typename bit::memory::arena_allocator<BlockAllocator>::checkpoint_type
+  bit::memory::arena_allocator<BlockAllocator>::checkpoint()
+  const noexcept
+{
+  if( m_blocks.empty() ) return {nullptr,nullptr};
+
+  return {m_blocks.peek().data(),m_current};
+}
+
+template<typename BlockAllocator>
+inline void bit::memory::arena_allocator<BlockAllocator>
+  ::rewind( checkpoint_type marker )
+{
+  auto& allocator = block_allocator();
+
+  // Return every block acquired after the marker was recorded
+  while( !m_blocks.empty() && m_blocks.peek().data() != marker.block ) {
+    block_allocator_traits<BlockAllocator>::deallocate_block(
+      allocator,
+      m_blocks.request_block()
+    );
+  }
+
+  assert( (marker.block == nullptr || !m_blocks.empty()) &&
+          "marker must refer to a block owned by this arena" );
+
+  m_current = marker.current;
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline bool bit::memory::arena_allocator<BlockAllocator>
+  ::owns( const void* p )
+  const noexcept
+{
+  return m_blocks.contains( p );
+}
+
+template<typename BlockAllocator>
+inline bit::memory::allocator_info
+  bit::memory::arena_allocator<BlockAllocator>::info()
+  const noexcept
+{
+  return {"arena_allocator",this};
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline std::size_t bit::memory::arena_allocator<BlockAllocator>::blocks()
+  const noexcept
+{
+  return m_blocks.size();
+}
+
+template<typename BlockAllocator>
+inline typename bit::memory::arena_allocator<BlockAllocator>::block_allocator_type&
+  bit::memory::arena_allocator<BlockAllocator>::block_allocator()
+  noexcept
+{
+  return get<0>(*this);
+}
+
+template<typename BlockAllocator>
+inline const typename bit::memory::arena_allocator<BlockAllocator>::block_allocator_type&
+  bit::memory::arena_allocator<BlockAllocator>::block_allocator()
+  const noexcept
+{
+  return get<0>(*this);
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline void* bit::memory::arena_allocator<BlockAllocator>
+  ::allocate_from_current_block( std::size_t size,
+                                 std::size_t align,
+                                 std::size_t offset )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  if( BIT_MEMORY_UNLIKELY(m_current == nullptr) ) return nullptr;
+
+  auto* p     = offset_align_forward(m_current,align,offset);
+  auto* p_end = static_cast<byte_t*>(p) + size;
+
+  // If allocated outside the range, return nullptr
+  if( BIT_MEMORY_UNLIKELY( p_end > m_blocks.peek().end_address() ) )
+    return nullptr;
+
+  // bump the pointer
+  m_current = p_end;
+
+  return p;
+}
+
+template<typename BlockAllocator>
+inline bool bit::memory::arena_allocator<BlockAllocator>::acquire_block()
+{
+  using byte_t = unsigned char;
+
+  auto block = block_allocator_traits<BlockAllocator>
+               ::allocate_block( block_allocator() );
+
+  if( BIT_MEMORY_UNLIKELY(block == nullblock) ) return false;
+
+  assert( block.size() > sizeof(memory_block) );
+
+  // The start of the block is reserved for the link to the previous block
+  m_blocks.store_block( block );
+  m_current = static_cast<byte_t*>(block.data()) + sizeof(memory_block);
+
+  return true;
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_ARENA_ALLOCATOR_INL */
@@ -0,0 +1,251 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_BITMAP_POOL_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_BITMAP_POOL_ALLOCATOR_INL
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+inline bit::memory::bitmap_pool_allocator
+  ::bitmap_pool_allocator( std::size_t chunk_size, memory_block block )
+  noexcept
+  : m_bitmap(nullptr),
+    m_chunks(nullptr),
+    m_chunk_size(chunk_size),
+    m_chunk_align(0),
+    m_chunk_count(0),
+    m_words(0),
+    m_hint(0),
+    m_size(0)
+{
+  using byte_t = unsigned char;
+
+  assert( chunk_size != 0 );
+
+  // Chunks are aligned to the largest power of two dividing the chunk size
+  auto chunk_align = chunk_size & (~chunk_size + 1);
+  if( chunk_align > max_alignment::value ) chunk_align = max_alignment::value;
+
+  auto* const begin = static_cast<byte_t*>(
+    align_forward( block.data(), alignof(std::uint64_t) )
+  );
+  auto* const end   = static_cast<byte_t*>(block.end_address());
+
+  if( BIT_MEMORY_UNLIKELY(begin >= end) ) return;
+
+  // Each chunk costs chunk_size bytes plus one bit. The estimate ignores the
+  // rounding of the bitmap and chunk alignment, so it is corrected below.
+  const auto available = static_cast<std::size_t>(end - begin);
+  auto count = (available * 8) / (chunk_size * 8 + 1);
+
+  auto* chunks = static_cast<byte_t*>(nullptr);
+  while( count > 0 ) {
+    const auto words = (count + 63) / 64;
+
+    chunks = static_cast<byte_t*>(
+      align_forward( begin + words * sizeof(std::uint64_t), chunk_align )
+    );
+
+    if( chunks <= end &&
+        static_cast<std::size_t>(end - chunks) / chunk_size >= count ) break;
+
+    --count;
+  }
+
+  if( BIT_MEMORY_UNLIKELY(count == 0) ) return;
+
+  m_bitmap      = static_cast<std::uint64_t*>(static_cast<void*>(begin));
+  m_chunks      = chunks;
+  m_chunk_align = (align_of(chunks) < chunk_align) ? align_of(chunks) : chunk_align;
+  m_chunk_count = count;
+  m_words       = (count + 63) / 64;
+
+  reset_bitmap();
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+inline bit::memory::owner<void*>
+  bit::memory::bitmap_pool_allocator::try_allocate( std::size_t size,
+                                                    std::size_t align )
+  noexcept
+{
+  if( BIT_MEMORY_UNLIKELY(size > m_chunk_size || align > m_chunk_align) ) {
+    return nullptr;
+  }
+
+  const auto word = find_free_word();
+
+  if( BIT_MEMORY_UNLIKELY(word == m_words) ) {
+    m_hint = word;
+    return nullptr;
+  }
+
+  const auto bit = count_trailing_zeros( ~m_bitmap[word] );
+
+  m_bitmap[word] |= (std::uint64_t{1} << bit);
+  m_hint = word;
+  ++m_size;
+
+  return chunk_at( word * 64 + bit );
+}
+
+inline void bit::memory::bitmap_pool_allocator::deallocate( owner<void*> p,
+                                                            std::size_t size )
+{
+  BIT_MEMORY_UNUSED(size);
+
+  assert( owns(p) && "pointer must be owned by this allocator" );
+
+  const auto offset = static_cast<std::size_t>(
+    static_cast<unsigned char*>(p) - static_cast<unsigned char*>(m_chunks)
+  );
+
+  assert( (offset % m_chunk_size) == 0 && "pointer must be to a chunk" );
+
+  const auto index = offset / m_chunk_size;
+  const auto word  = index / 64;
+  const auto mask  = std::uint64_t{1} << (index % 64);
+
+  assert( (m_bitmap[word] & mask) && "double free detected" );
+
+  m_bitmap[word] &= ~mask;
+  if( word < m_hint ) m_hint = word;
+  --m_size;
+}
+
+inline void bit::memory::bitmap_pool_allocator::deallocate_all()
+{
+  if( BIT_MEMORY_UNLIKELY(m_bitmap == nullptr) ) return;
+
+  reset_bitmap();
+}
+
+//-----------------------------------------------------------------------------
+// Iteration
+//-----------------------------------------------------------------------------
+
+template<typename Fn>
+inline void bit::memory::bitmap_pool_allocator::for_each_allocated( Fn&& fn )
+{
+  static_cast<const bitmap_pool_allocator&>(*this).for_each_allocated(
+    std::forward<Fn>(fn)
+  );
+}
+
+template<typename Fn>
+inline void bit::memory::bitmap_pool_allocator::for_each_allocated( Fn&& fn )
+  const
+{
+  for( auto word = std::size_t{0}; word < m_words; ++word ) {
+    auto bits = m_bitmap[word];
+
+    // Ignore the padding bits at the end of the bitmap
+    if( word == (m_words - 1) && (m_chunk_count % 64) != 0 ) {
+      bits &= (std::uint64_t{1} << (m_chunk_count % 64)) - 1;
+    }
+
+    while( bits != 0 ) {
+      const auto bit = count_trailing_zeros( bits );
+
+      fn( chunk_at( word * 64 + bit ) );
+
+      bits &= (bits - 1);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+inline bool bit::memory::bitmap_pool_allocator::owns( const void* p )
+  const noexcept
+{
+  auto* const begin = static_cast<const unsigned char*>(m_chunks);
+
+  return m_chunks != nullptr &&
+         static_cast<const unsigned char*>(p) >= begin &&
+         static_cast<const unsigned char*>(p) < (begin + m_chunk_count * m_chunk_size);
+}
+
+inline std::size_t bit::memory::bitmap_pool_allocator::max_size()
+  const noexcept
+{
+  return m_chunk_size;
+}
+
+inline std::size_t bit::memory::bitmap_pool_allocator::capacity()
+  const noexcept
+{
+  return m_chunk_count;
+}
+
+inline std::size_t bit::memory::bitmap_pool_allocator::size()
+  const noexcept
+{
+  return m_size;
+}
+
+//-----------------------------------------------------------------------------
+
+inline bit::memory::allocator_info bit::memory::bitmap_pool_allocator::info()
+  const noexcept
+{
+  return {"bitmap_pool_allocator",this};
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::bitmap_pool_allocator::reset_bitmap()
+  noexcept
+{
+  for( auto word = std::size_t{0}; word < m_words; ++word ) {
+    m_bitmap[word] = 0;
+  }
+
+  if( (m_chunk_count % 64) != 0 ) {
+    m_bitmap[m_words - 1] = ~((std::uint64_t{1} << (m_chunk_count % 64)) - 1);
+  }
+
+  m_hint = 0;
+  m_size = 0;
+}
+
+inline std::size_t bit::memory::bitmap_pool_allocator::find_free_word()
+  const noexcept
+{
+  auto word = m_hint;
+
+#if defined(BIT_MEMORY_BITMAP_POOL_USE_SSE2)
+  // Skip full words two at a time
+  const auto full = _mm_set1_epi32(-1);
+
+  while( (word + 2) <= m_words ) {
+    const auto bits = _mm_loadu_si128(
+      static_cast<const __m128i*>(static_cast<const void*>(m_bitmap + word))
+    );
+
+    if( _mm_movemask_epi8( _mm_cmpeq_epi32(bits, full) ) != 0xffff ) break;
+
+    word += 2;
+  }
+#endif
+
+  while( word < m_words && m_bitmap[word] == ~std::uint64_t{0} ) {
+    ++word;
+  }
+
+  return word;
+}
+
+inline void* bit::memory::bitmap_pool_allocator::chunk_at( std::size_t index )
+  const noexcept
+{
+  return static_cast<unsigned char*>(m_chunks) + index * m_chunk_size;
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_BITMAP_POOL_ALLOCATOR_INL */
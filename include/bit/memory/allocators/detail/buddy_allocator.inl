@@ -0,0 +1,479 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_BUDDY_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_BUDDY_ALLOCATOR_INL
+
+//-----------------------------------------------------------------------------
+// Constructors / Destructor / Assignment
+//-----------------------------------------------------------------------------
+
+inline bit::memory::buddy_allocator::buddy_allocator( std::size_t size,
+                                                      std::size_t decommit_threshold )
+  : m_memory(nullptr),
+    m_max_order(0),
+    m_decommit_order(0),
+    m_metadata(nullptr),
+    m_metadata_pages(0),
+    m_committed(nullptr),
+    m_orders(nullptr),
+    m_committed_pages(0),
+    m_free_orders(0),
+    m_free(),
+    m_free_counts(),
+    m_free_hints()
+{
+  assert( size != 0 );
+
+  const auto page_size = virtual_memory_page_size();
+
+  m_max_order      = ceil_log2( (size + page_size - 1) / page_size );
+  m_decommit_order = order_of( decommit_threshold );
+
+  assert( m_max_order < s_max_orders && "size exceeds the maximum range" );
+
+  const auto pages = std::size_t{1} << m_max_order;
+
+  // Lay out the bookkeeping: a free bitmap per order, a committed bitmap,
+  // and the order of each allocation
+  auto words = std::size_t{0};
+  for( auto order = std::size_t{0}; order <= m_max_order; ++order ) {
+    words += ((pages >> order) + 63) / 64;
+  }
+  words += (pages + 63) / 64;
+
+  const auto metadata_size = words * sizeof(std::uint64_t) + pages;
+
+  m_metadata_pages = (metadata_size + page_size - 1) / page_size;
+  m_metadata       = virtual_memory_reserve( m_metadata_pages );
+
+  if( BIT_MEMORY_UNLIKELY(m_metadata == nullptr) ) return;
+
+  if( BIT_MEMORY_UNLIKELY(!virtual_memory_commit( m_metadata, m_metadata_pages )) ) {
+    virtual_memory_release( m_metadata, m_metadata_pages );
+    m_metadata = nullptr;
+    return;
+  }
+
+  m_memory = virtual_memory_reserve( pages );
+
+  if( BIT_MEMORY_UNLIKELY(m_memory == nullptr) ) {
+    virtual_memory_release( m_metadata, m_metadata_pages );
+    m_metadata = nullptr;
+    return;
+  }
+
+  auto* words_ptr = static_cast<std::uint64_t*>(m_metadata);
+  for( auto order = std::size_t{0}; order <= m_max_order; ++order ) {
+    m_free[order] = words_ptr;
+    words_ptr    += ((pages >> order) + 63) / 64;
+  }
+  m_committed = words_ptr;
+  words_ptr  += (pages + 63) / 64;
+  m_orders    = static_cast<unsigned char*>(static_cast<void*>(words_ptr));
+
+  // Freshly committed memory is zeroed, so only the whole range needs to be
+  // marked free
+  set_free( m_max_order, 0 );
+}
+
+inline bit::memory::buddy_allocator::buddy_allocator( buddy_allocator&& other )
+  noexcept
+  : m_memory(other.m_memory),
+    m_max_order(other.m_max_order),
+    m_decommit_order(other.m_decommit_order),
+    m_metadata(other.m_metadata),
+    m_metadata_pages(other.m_metadata_pages),
+    m_committed(other.m_committed),
+    m_orders(other.m_orders),
+    m_committed_pages(other.m_committed_pages),
+    m_free_orders(other.m_free_orders),
+    m_free(),
+    m_free_counts(),
+    m_free_hints()
+{
+  for( auto order = std::size_t{0}; order < s_max_orders; ++order ) {
+    m_free[order]        = other.m_free[order];
+    m_free_counts[order] = other.m_free_counts[order];
+    m_free_hints[order]  = other.m_free_hints[order];
+  }
+
+  other.m_memory          = nullptr;
+  other.m_metadata        = nullptr;
+  other.m_committed_pages = 0;
+  other.m_free_orders     = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+inline bit::memory::buddy_allocator::~buddy_allocator()
+{
+  if( m_memory != nullptr ) {
+    virtual_memory_release( m_memory, std::size_t{1} << m_max_order );
+  }
+  if( m_metadata != nullptr ) {
+    virtual_memory_release( m_metadata, m_metadata_pages );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+inline bit::memory::owner<void*>
+  bit::memory::buddy_allocator::try_allocate( std::size_t size,
+                                              std::size_t align )
+  noexcept
+{
+  assert( size && "cannot allocate 0 bytes");
+  assert( align <= virtual_memory_page_size() &&
+          "alignment must not exceed the page size" );
+  BIT_MEMORY_UNUSED(align);
+
+  if( BIT_MEMORY_UNLIKELY(size > max_size()) ) return nullptr;
+
+  const auto order = order_of( size );
+
+  // Find the smallest order with a free buddy that can fit the request
+  const auto orders = m_free_orders & (~std::uint64_t{0} << order);
+
+  if( BIT_MEMORY_UNLIKELY(orders == 0) ) return nullptr;
+
+  auto current = count_trailing_zeros( orders );
+  auto index   = request_free( current );
+
+  // Split the buddy down to the requested order, freeing each right half
+  while( current > order ) {
+    --current;
+    index <<= 1;
+    set_free( current, index + 1 );
+  }
+
+  const auto page = index << order;
+
+  if( BIT_MEMORY_UNLIKELY(!commit_pages( page, std::size_t{1} << order )) ) {
+    release_buddy( order, index );
+    return nullptr;
+  }
+
+  m_orders[page] = static_cast<unsigned char>(order + 1);
+
+  return page_address( page );
+}
+
+//-----------------------------------------------------------------------------
+
+inline bool bit::memory::buddy_allocator::expand( void* p,
+                                                  std::size_t new_size )
+  noexcept
+{
+  assert( owns(p) && "pointer must be owned by this allocator" );
+
+  const auto page = static_cast<std::size_t>(
+    static_cast<unsigned char*>(p) - static_cast<unsigned char*>(m_memory)
+  ) / virtual_memory_page_size();
+
+  assert( m_orders[page] != 0 && "pointer must be the start of an allocation" );
+
+  const auto order = static_cast<std::size_t>(m_orders[page] - 1);
+
+  if( BIT_MEMORY_UNLIKELY(new_size > max_size()) ) return false;
+
+  const auto new_order = order_of( new_size );
+
+  if( new_order <= order ) return true;
+
+  // Every buddy on the path up to the new order must be a free right-buddy
+  for( auto current = order; current < new_order; ++current ) {
+    const auto index = page >> current;
+
+    if( (index & 1u) || !test_free( current, index ^ 1u ) ) return false;
+  }
+
+  if( BIT_MEMORY_UNLIKELY(!commit_pages( page, std::size_t{1} << new_order )) ) {
+    return false;
+  }
+
+  for( auto current = order; current < new_order; ++current ) {
+    clear_free( current, (page >> current) ^ 1u );
+  }
+
+  m_orders[page] = static_cast<unsigned char>(new_order + 1);
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::buddy_allocator::deallocate( owner<void*> p,
+                                                      std::size_t size )
+{
+  BIT_MEMORY_UNUSED(size);
+
+  assert( owns(p) && "pointer must be owned by this allocator" );
+
+  const auto page = static_cast<std::size_t>(
+    static_cast<unsigned char*>(p) - static_cast<unsigned char*>(m_memory)
+  ) / virtual_memory_page_size();
+
+  assert( m_orders[page] != 0 && "pointer must be the start of an allocation" );
+
+  const auto order = static_cast<std::size_t>(m_orders[page] - 1);
+
+  assert( order >= order_of(size) );
+
+  m_orders[page] = 0;
+
+  release_buddy( order, page >> order );
+}
+
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::buddy_allocator::deallocate_all()
+{
+  if( BIT_MEMORY_UNLIKELY(m_memory == nullptr) ) return;
+
+  const auto pages = std::size_t{1} << m_max_order;
+
+  decommit_pages( 0, pages );
+
+  for( auto order = std::size_t{0}; order <= m_max_order; ++order ) {
+    const auto words = ((pages >> order) + 63) / 64;
+    for( auto i = std::size_t{0}; i < words; ++i ) {
+      m_free[order][i] = 0;
+    }
+    m_free_counts[order] = 0;
+    m_free_hints[order]  = 0;
+  }
+  for( auto i = std::size_t{0}; i < pages; ++i ) {
+    m_orders[i] = 0;
+  }
+  m_free_orders = 0;
+
+  set_free( m_max_order, 0 );
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+inline bool bit::memory::buddy_allocator::owns( const void* p )
+  const noexcept
+{
+  auto* const begin = static_cast<const unsigned char*>(m_memory);
+
+  return m_memory != nullptr &&
+         static_cast<const unsigned char*>(p) >= begin &&
+         static_cast<const unsigned char*>(p) < (begin + max_size());
+}
+
+inline std::size_t bit::memory::buddy_allocator::max_size()
+  const noexcept
+{
+  if( BIT_MEMORY_UNLIKELY(m_memory == nullptr) ) return 0;
+
+  return virtual_memory_page_size() << m_max_order;
+}
+
+inline std::size_t bit::memory::buddy_allocator::committed_size()
+  const noexcept
+{
+  return m_committed_pages * virtual_memory_page_size();
+}
+
+inline std::size_t bit::memory::buddy_allocator::decommit_threshold()
+  const noexcept
+{
+  return virtual_memory_page_size() << m_decommit_order;
+}
+
+//-----------------------------------------------------------------------------
+
+inline bit::memory::allocator_info bit::memory::buddy_allocator::info()
+  const noexcept
+{
+  return {"buddy_allocator",this};
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::buddy_allocator::order_of( std::size_t size )
+  const noexcept
+{
+  const auto page_size = virtual_memory_page_size();
+
+  return ceil_log2( (size + page_size - 1) / page_size );
+}
+
+inline void* bit::memory::buddy_allocator::page_address( std::size_t page )
+  const noexcept
+{
+  return static_cast<unsigned char*>(m_memory) +
+         page * virtual_memory_page_size();
+}
+
+//-----------------------------------------------------------------------------
+
+inline bool bit::memory::buddy_allocator::test_free( std::size_t order,
+                                                     std::size_t index )
+  const noexcept
+{
+  return (m_free[order][index / 64] >> (index % 64)) & 1u;
+}
+
+inline void bit::memory::buddy_allocator::set_free( std::size_t order,
+                                                    std::size_t index )
+  noexcept
+{
+  const auto word = index / 64;
+
+  m_free[order][word] |= (std::uint64_t{1} << (index % 64));
+
+  if( word < m_free_hints[order] ) m_free_hints[order] = word;
+  ++m_free_counts[order];
+  m_free_orders |= (std::uint64_t{1} << order);
+}
+
+inline void bit::memory::buddy_allocator::clear_free( std::size_t order,
+                                                      std::size_t index )
+  noexcept
+{
+  m_free[order][index / 64] &= ~(std::uint64_t{1} << (index % 64));
+
+  if( --m_free_counts[order] == 0 ) {
+    m_free_orders &= ~(std::uint64_t{1} << order);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::buddy_allocator::request_free( std::size_t order )
+  noexcept
+{
+  assert( m_free_counts[order] != 0 );
+
+  // Every word before the hint is known to be empty
+  auto word = m_free_hints[order];
+  while( m_free[order][word] == 0 ) {
+    ++word;
+  }
+  m_free_hints[order] = word;
+
+  const auto index = word * 64 + count_trailing_zeros( m_free[order][word] );
+
+  clear_free( order, index );
+
+  return index;
+}
+
+inline void bit::memory::buddy_allocator::release_buddy( std::size_t order,
+                                                         std::size_t index )
+  noexcept
+{
+  // Merge with the buddy at each order for as long as it is free
+  while( order < m_max_order && test_free( order, index ^ 1u ) ) {
+    clear_free( order, index ^ 1u );
+    index >>= 1;
+    ++order;
+  }
+
+  set_free( order, index );
+
+  if( order >= m_decommit_order ) {
+    decommit_pages( index << order, std::size_t{1} << order );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::buddy_allocator::find_page( std::size_t first,
+                                                            std::size_t last,
+                                                            bool committed )
+  const noexcept
+{
+  // Scan a word of pages at a time, flipping the bits when looking for
+  // uncommitted pages
+  const auto flip = committed ? std::uint64_t{0} : ~std::uint64_t{0};
+
+  auto word = first / 64;
+  auto bits = (m_committed[word] ^ flip) & (~std::uint64_t{0} << (first % 64));
+
+  while( bits == 0 ) {
+    if( ++word * 64 >= last ) return last;
+
+    bits = m_committed[word] ^ flip;
+  }
+
+  const auto page = word * 64 + count_trailing_zeros( bits );
+
+  return (page < last) ? page : last;
+}
+
+inline void bit::memory::buddy_allocator::mark_pages( std::size_t first,
+                                                      std::size_t last,
+                                                      bool committed )
+  noexcept
+{
+  // Mark a word of pages at a time
+  while( first < last ) {
+    const auto shift = first % 64;
+    const auto count = (last - first < 64 - shift) ? (last - first) : (64 - shift);
+    const auto mask  = (count == 64)
+                       ? ~std::uint64_t{0}
+                       : (((std::uint64_t{1} << count) - 1) << shift);
+
+    if( committed ) {
+      m_committed[first / 64] |= mask;
+    } else {
+      m_committed[first / 64] &= ~mask;
+    }
+    first += count;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+inline bool bit::memory::buddy_allocator::commit_pages( std::size_t first,
+                                                        std::size_t n )
+  noexcept
+{
+  const auto last = first + n;
+
+  // Commit each run of uncommitted pages with a single call
+  auto page = find_page( first, last, false );
+  while( page < last ) {
+    const auto end = find_page( page, last, true );
+
+    if( BIT_MEMORY_UNLIKELY(!virtual_memory_commit( page_address(page), end - page )) ) {
+      return false;
+    }
+
+    mark_pages( page, end, true );
+    m_committed_pages += end - page;
+
+    page = (end < last) ? find_page( end, last, false ) : last;
+  }
+
+  return true;
+}
+
+inline void bit::memory::buddy_allocator::decommit_pages( std::size_t first,
+                                                          std::size_t n )
+  noexcept
+{
+  const auto last = first + n;
+
+  // Decommit each run of committed pages with a single call
+  auto page = find_page( first, last, true );
+  while( page < last ) {
+    const auto end = find_page( page, last, false );
+
+    virtual_memory_decommit( page_address(page), end - page );
+
+    mark_pages( page, end, false );
+    m_committed_pages -= end - page;
+
+    page = (end < last) ? find_page( end, last, true ) : last;
+  }
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_BUDDY_ALLOCATOR_INL */
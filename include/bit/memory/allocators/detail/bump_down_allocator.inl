@@ -64,6 +64,26 @@ inline void bit::memory::bump_down_allocator::deallocate_all()
   m_current = m_block.end_address();
 }
 
+//----------------------------------------------------------------------------
+// Checkpoints
+//----------------------------------------------------------------------------
+
+inline bit::memory::bump_down_allocator::checkpoint_type
+  bit::memory::bump_down_allocator::checkpoint()
+  const noexcept
+{
+  return {m_current};
+}
+
+inline void bit::memory::bump_down_allocator::rewind( checkpoint_type marker )
+  noexcept
+{
+  assert( m_block.contains( marker.current ) ||
+          marker.current == m_block.end_address() );
+
+  m_current = marker.current;
+}
+
 //----------------------------------------------------------------------------
 // Observers
 //----------------------------------------------------------------------------
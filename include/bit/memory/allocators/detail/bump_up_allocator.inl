@@ -12,7 +12,8 @@
 inline bit::memory::bump_up_allocator::bump_up_allocator( memory_block block )
   noexcept
   : m_block(block),
-    m_current(m_block.data())
+    m_current(m_block.data()),
+    m_last(nullptr)
 {
   assert( m_block && "Block must not be null" );
 }
@@ -43,12 +44,33 @@ inline bit::memory::owner<void*>
 
   // bump the pointer
   m_current = p_end;
+  m_last    = p;
 
   return p;
 }
 
 //----------------------------------------------------------------------------
 
+inline bool bit::memory::bump_up_allocator::expand( void* p,
+                                                    std::size_t new_size )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  if( p != m_last ) return false;
+
+  auto* p_end = static_cast<byte_t*>(p) + new_size;
+
+  if( BIT_MEMORY_UNLIKELY( p_end > m_block.end_address() ) )
+    return false;
+
+  m_current = p_end;
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+
 inline void bit::memory::bump_up_allocator::deallocate( owner<void*> p,
                                                         std::size_t size )
 {
@@ -66,6 +88,28 @@ inline void bit::memory::bump_up_allocator::deallocate_all()
   noexcept
 {
   m_current = m_block.data();
+  m_last    = nullptr;
+}
+
+//----------------------------------------------------------------------------
+// Checkpoints
+//----------------------------------------------------------------------------
+
+inline bit::memory::bump_up_allocator::checkpoint_type
+  bit::memory::bump_up_allocator::checkpoint()
+  const noexcept
+{
+  return {m_current};
+}
+
+inline void bit::memory::bump_up_allocator::rewind( checkpoint_type marker )
+  noexcept
+{
+  assert( m_block.contains( marker.current ) ||
+          marker.current == m_block.end_address() );
+
+  m_current = marker.current;
+  m_last    = nullptr;
 }
 
 //----------------------------------------------------------------------------
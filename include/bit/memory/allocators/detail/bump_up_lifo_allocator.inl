@@ -12,7 +12,8 @@
 inline bit::memory::bump_up_lifo_allocator::bump_up_lifo_allocator( memory_block block )
   noexcept
   : m_block(block),
-    m_current(m_block.data())
+    m_current(m_block.data()),
+    m_last(nullptr)
 {
   assert( m_block && "Block must not be null" );
 }
@@ -46,8 +47,29 @@ inline void* bit::memory::bump_up_lifo_allocator::try_allocate( std::size_t size
 
   // bump the pointer
   m_current = p_end;
+  m_last    = byte_ptr + 1;
 
-  return byte_ptr + 1;
+  return m_last;
+}
+
+//----------------------------------------------------------------------------
+
+inline bool bit::memory::bump_up_lifo_allocator::expand( void* p,
+                                                         std::size_t new_size )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  if( p != m_last ) return false;
+
+  auto* p_end = static_cast<byte_t*>(p) + new_size;
+
+  if( BIT_MEMORY_UNLIKELY( p_end > m_block.end_address() ) )
+    return false;
+
+  m_current = p_end;
+
+  return true;
 }
 
 //----------------------------------------------------------------------------
@@ -70,6 +92,9 @@ inline void bit::memory::bump_up_lifo_allocator::deallocate( void* p,
   byte_ptr -= adjust;
 
   m_current = byte_ptr;
+
+  // The start of the allocation before this one is not known
+  m_last = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -78,6 +103,7 @@ inline void bit::memory::bump_up_lifo_allocator::deallocate_all()
   noexcept
 {
   m_current = m_block.data();
+  m_last    = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,222 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_CONCURRENT_BUMP_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_CONCURRENT_BUMP_ALLOCATOR_INL
+
+//----------------------------------------------------------------------------
+// Constructors / Destructor
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator, typename BasicLockable>
+template<typename...Args, typename>
+inline bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>
+  ::concurrent_bump_allocator( Args&&...args )
+  : base_type( std::forward_as_tuple(std::forward<Args>(args)...),
+               std::forward_as_tuple() ),
+    m_current(nullptr)
+{
+
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator, typename BasicLockable>
+inline bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>
+  ::~concurrent_bump_allocator()
+{
+  deallocate_all();
+}
+
+//----------------------------------------------------------------------------
+// Allocation / Deallocation
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator, typename BasicLockable>
+inline bit::memory::owner<void*>
+  bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>
+  ::try_allocate( std::size_t size, std::size_t align )
+  noexcept
+{
+  assert( size && "cannot allocate 0 bytes");
+  assert( align && "cannot allocate with 0 alignment");
+  assert( is_power_of_two(align) && "alignment must be a power of two" );
+
+  constexpr auto granule = granule_size::value;
+
+  // Every claim is a whole number of granules, so every claim starts
+  // granule-aligned; larger alignments are found within a larger claim
+  const auto rounded = (size + granule - 1) & ~(granule - 1);
+  const auto claim   = (align <= granule) ? rounded : (rounded + align - granule);
+
+  auto* block = m_current.load( std::memory_order_acquire );
+
+  while( true ) {
+    if( BIT_MEMORY_LIKELY(block != nullptr) ) {
+      const auto offset = block->offset.fetch_add( claim, std::memory_order_relaxed );
+
+      // Claims that overrun the block are simply abandoned
+      if( BIT_MEMORY_LIKELY(offset <= block->capacity &&
+                            claim <= (block->capacity - offset)) ) {
+        auto* const p = block->data + offset;
+
+        return (align <= granule) ? p : align_forward( p, align );
+      }
+    }
+
+    block = acquire_block( block, claim );
+
+    if( BIT_MEMORY_UNLIKELY(block == nullptr) ) return nullptr;
+  }
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator, typename BasicLockable>
+inline void bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>
+  ::deallocate( owner<void*> p, std::size_t size )
+{
+  BIT_MEMORY_UNUSED(p);
+  BIT_MEMORY_UNUSED(size);
+
+  assert( owns( p ) && "Pointer must be contained by the allocator" );
+
+  // concurrent_bump_allocator only uses truncated deallocations with
+  // deallocate_all
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator, typename BasicLockable>
+inline void bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>
+  ::deallocate_all()
+{
+  using ::bit::memory::get;
+
+  auto& allocator = get<0>(*this);
+  auto* block     = m_current.load( std::memory_order_acquire );
+
+  while( block != nullptr ) {
+    const auto memory = block->block;
+    block = block->previous;
+
+    block_allocator_traits<BlockAllocator>::deallocate_block( allocator, memory );
+  }
+
+  m_current.store( nullptr, std::memory_order_release );
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator, typename BasicLockable>
+inline bool bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>
+  ::owns( const void* p )
+  const noexcept
+{
+  auto* block = m_current.load( std::memory_order_acquire );
+
+  for( ; block != nullptr; block = block->previous ) {
+    if( block->block.contains(p) ) return true;
+  }
+  return false;
+}
+
+template<typename BlockAllocator, typename BasicLockable>
+inline bit::memory::allocator_info
+  bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>::info()
+  const noexcept
+{
+  return {"concurrent_bump_allocator",this};
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>::blocks()
+  const noexcept
+{
+  auto result = std::size_t{0};
+  auto* block = m_current.load( std::memory_order_acquire );
+
+  for( ; block != nullptr; block = block->previous ) {
+    ++result;
+  }
+  return result;
+}
+
+template<typename BlockAllocator, typename BasicLockable>
+inline typename bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>::block_allocator_type&
+  bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>::block_allocator()
+  noexcept
+{
+  using ::bit::memory::get;
+
+  return get<0>(*this);
+}
+
+template<typename BlockAllocator, typename BasicLockable>
+inline const typename bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>::block_allocator_type&
+  bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>::block_allocator()
+  const noexcept
+{
+  using ::bit::memory::get;
+
+  return get<0>(*this);
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator, typename BasicLockable>
+inline typename bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>::block_header*
+  bit::memory::concurrent_bump_allocator<BlockAllocator,BasicLockable>
+  ::acquire_block( block_header* full, std::size_t claim )
+  noexcept
+{
+  using ::bit::memory::get;
+  using byte_t = unsigned char;
+  using traits = block_allocator_traits<BlockAllocator>;
+
+  std::lock_guard<lock_type> lock(get<1>(*this));
+
+  // Another thread may have replaced the block while this one waited
+  auto* const current = m_current.load( std::memory_order_acquire );
+  if( current != full ) return current;
+
+  auto& allocator = get<0>(*this);
+
+  // Don't bother requesting a block that could never fit the claim
+  const auto overhead = sizeof(block_header) + granule_size::value;
+  if( BIT_MEMORY_UNLIKELY(overhead + claim > traits::next_block_size( allocator )) ) {
+    return nullptr;
+  }
+
+  const auto memory = traits::allocate_block( allocator );
+  if( BIT_MEMORY_UNLIKELY(memory == nullblock) ) return nullptr;
+
+  assert( align_of(memory.data()) >= alignof(block_header) &&
+          "blocks must be aligned to hold the block header" );
+
+  auto* const data = static_cast<byte_t*>(
+    align_forward( static_cast<byte_t*>(memory.data()) + sizeof(block_header),
+                   granule_size::value )
+  );
+  auto* const end  = static_cast<byte_t*>(memory.end_address());
+
+  if( BIT_MEMORY_UNLIKELY(data >= end ||
+                          static_cast<std::size_t>(end - data) < claim) ) {
+    traits::deallocate_block( allocator, memory );
+    return nullptr;
+  }
+
+  auto* const block = ::new(memory.data()) block_header{
+    memory, current, data, static_cast<std::size_t>(end - data), {0}
+  };
+
+  m_current.store( block, std::memory_order_release );
+
+  return block;
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_CONCURRENT_BUMP_ALLOCATOR_INL */
@@ -0,0 +1,125 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_CONCURRENT_POOL_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_CONCURRENT_POOL_ALLOCATOR_INL
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+inline bit::memory::concurrent_pool_allocator
+  ::concurrent_pool_allocator( std::size_t chunk_size, memory_block block )
+  : m_block(block),
+    m_offset(0u),
+    m_chunk_size(chunk_size)
+{
+  // It is a requirement that chunk_size is a power-of-2 that is greater
+  // than alignof(void*) and sizeof(void*) -- otherwise the pool would
+  // suffer misalignment issues on the internal freelist
+  assert( is_power_of_two(chunk_size) );
+  assert( chunk_size >= sizeof(void*) );
+  assert( chunk_size >= alignof(void*) );
+  assert( chunk_size <= m_block.size() );
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+inline bit::memory::owner<void*>
+  bit::memory::concurrent_pool_allocator::try_allocate( std::size_t size,
+                                                        std::size_t align,
+                                                        std::size_t offset )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  auto p = request_chunk();
+
+  if( BIT_MEMORY_UNLIKELY(p==nullptr) ) return nullptr;
+
+  auto adjust = std::size_t{};
+  auto* result = offset_align_forward(p, align, offset+1, &adjust);
+
+  const auto new_size = (size + 1 + adjust);
+
+  if( BIT_MEMORY_UNLIKELY(new_size > max_size()) ) {
+    m_freelist.store( p );
+    return nullptr;
+  }
+
+  // Store the adjustment made to align correctly
+  *static_cast<byte_t*>(result) = static_cast<byte_t>(adjust);
+
+  return static_cast<byte_t*>(result) + 1;
+}
+
+inline void bit::memory::concurrent_pool_allocator::deallocate( owner<void*> p,
+                                                                std::size_t size )
+{
+  BIT_MEMORY_UNUSED(size);
+
+  using byte_t = unsigned char;
+
+  p           = static_cast<byte_t*>(p) - 1;
+  auto adjust = static_cast<std::ptrdiff_t>(*static_cast<byte_t*>(p));
+  p           = static_cast<byte_t*>(p) - adjust;
+
+  m_freelist.store( p );
+}
+
+inline void bit::memory::concurrent_pool_allocator::deallocate_all()
+{
+  m_freelist.clear();
+  m_offset.store( 0u, std::memory_order_relaxed );
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+inline bool bit::memory::concurrent_pool_allocator::owns( const void* p )
+  const noexcept
+{
+  return m_block.contains(p);
+}
+
+inline std::size_t bit::memory::concurrent_pool_allocator::max_size()
+  const noexcept
+{
+  return m_chunk_size;
+}
+
+//-----------------------------------------------------------------------------
+
+inline bit::memory::allocator_info
+  bit::memory::concurrent_pool_allocator::info()
+  const noexcept
+{
+  return {"concurrent_pool_allocator",this};
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+inline void* bit::memory::concurrent_pool_allocator::request_chunk()
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  auto p = m_freelist.request();
+
+  if( p != nullptr ) return p;
+
+  // Claim the next chunk that has never been used. Nothing has been written
+  // to the chunk yet, so no ordering is required on the cursor itself
+  auto offset = m_offset.load(std::memory_order_relaxed);
+  while( offset + m_chunk_size <= m_block.size() ) {
+    if( m_offset.compare_exchange_weak( offset, offset + m_chunk_size,
+                                        std::memory_order_relaxed ) ) {
+      return static_cast<byte_t*>(m_block.data()) + offset;
+    }
+  }
+  return nullptr;
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_CONCURRENT_POOL_ALLOCATOR_INL */
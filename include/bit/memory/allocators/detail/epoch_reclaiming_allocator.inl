@@ -0,0 +1,540 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_EPOCH_RECLAIMING_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_EPOCH_RECLAIMING_ALLOCATOR_INL
+
+//============================================================================
+// epoch_reclaiming_allocator::critical_section
+//============================================================================
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::critical_section::critical_section( epoch_reclaiming_allocator& allocator )
+  : m_allocator(allocator)
+{
+  m_allocator.enter_critical();
+}
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::critical_section::~critical_section()
+{
+  m_allocator.exit_critical();
+}
+
+//============================================================================
+// epoch_reclaiming_allocator::thread_record_list
+//============================================================================
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::thread_record_list::~thread_record_list()
+{
+  while( head != nullptr ) {
+    auto* record = head;
+    head = record->next_local;
+
+    {
+      std::lock_guard<std::mutex> lock(registry_mutex());
+
+      // The owning allocator may have been destroyed before this thread
+      // exited, in which case it has already released this record's limbo
+      auto* allocator = record->owner.load(std::memory_order_relaxed);
+      if( allocator != nullptr ) {
+        allocator->orphan_record( *record );
+        allocator->unregister_record( *record );
+      }
+    }
+    destroy_record( record );
+  }
+  last = nullptr;
+}
+
+//============================================================================
+// epoch_reclaiming_allocator
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructors / Destructor
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+template<typename...Args, typename>
+inline bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::epoch_reclaiming_allocator( Args&&...args )
+  : base_type( std::forward_as_tuple(std::forward<Args>(args)...),
+               std::forward_as_tuple() ),
+    m_epoch(0u),
+    m_records(nullptr),
+    m_orphans(),
+    m_batch_size(64)
+{
+
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::~epoch_reclaiming_allocator()
+{
+  std::lock_guard<std::mutex> lock(registry_mutex());
+
+  // Records are left in their thread's list, and are deleted by that thread
+  // the next time it looks up a record, or when it exits. The record must
+  // not be touched once its owner is cleared
+  while( m_records != nullptr ) {
+    auto* record = m_records;
+    m_records = record->next;
+
+    for( auto& list : record->limbo ) {
+      release_list( list, record );
+    }
+    record->owner.store( nullptr, std::memory_order_release );
+  }
+  release_list( m_orphans, nullptr );
+}
+
+//----------------------------------------------------------------------------
+// Allocation / Deallocation
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::owner<void*>
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::try_allocate( std::size_t size, std::size_t align )
+  noexcept
+{
+  std::lock_guard<lock_type> lock(get<1>(*this));
+
+  return allocator_traits<Allocator>::try_allocate( get<0>(*this), size, align );
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::deallocate( owner<void*> p, std::size_t size )
+{
+  std::lock_guard<lock_type> lock(get<1>(*this));
+
+  allocator_traits<Allocator>::deallocate( get<0>(*this), p, size );
+}
+
+//----------------------------------------------------------------------------
+// Reclamation
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::enter_critical()
+{
+  auto& record = local_record();
+
+  if( record.nesting++ != 0 ) return;
+
+  const auto epoch = m_epoch.load(std::memory_order_relaxed);
+  record.state.store( (epoch << 1) | 1u, std::memory_order_relaxed );
+
+  // The announcement must be visible to any thread advancing the epoch
+  // before this thread reads any shared node
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::exit_critical()
+  noexcept
+{
+  auto* record = find_local_record();
+
+  assert( record != nullptr && record->nesting != 0 &&
+          "exit_critical must match a call to enter_critical" );
+
+  if( --record->nesting != 0 ) return;
+
+  record->state.store( 0u, std::memory_order_release );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::retire( owner<void*> p, std::size_t size )
+{
+  auto& record     = local_record();
+  const auto epoch = m_epoch.load(std::memory_order_seq_cst);
+  auto& list       = record.limbo[epoch % limbo_lists];
+
+  // A list filled in an older epoch is at least three epochs old, which is
+  // past the two that make it safe
+  if( list.head != nullptr && list.epoch != epoch ) {
+    release_list( list, &record );
+  }
+
+  if( list.head == nullptr || list.head->count == limbo_block::capacity ) {
+    auto* block = record.spare;
+
+    if( block != nullptr ) {
+      record.spare = block->next;
+      block->count = 0;
+    } else {
+      block = new limbo_block;
+    }
+    block->next = list.head;
+    list.head   = block;
+  }
+
+  list.epoch = epoch;
+  list.head->entries[list.head->count++] = retired_entry{ p, size };
+  ++list.count;
+
+  if( BIT_MEMORY_UNLIKELY(++record.retired >= m_batch_size) ) {
+    collect( record );
+  }
+}
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>::reclaim()
+{
+  return collect( local_record() );
+}
+
+//----------------------------------------------------------------------------
+// Tuning
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::set_batch_size( std::size_t size )
+  noexcept
+{
+  assert( size > 0 && "batch size must be non-zero" );
+
+  m_batch_size = size;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::batch_size()
+  const noexcept
+{
+  return m_batch_size;
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::local_record_count()
+  noexcept
+{
+  auto count = std::size_t{0};
+
+  for( auto* record = thread_records().head; record != nullptr; record = record->next_local ) {
+    ++count;
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>::epoch()
+  const noexcept
+{
+  return m_epoch.load(std::memory_order_relaxed);
+}
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>::pending()
+  noexcept
+{
+  auto* record = find_local_record();
+
+  if( record == nullptr ) return 0u;
+
+  auto count = std::size_t{0};
+  for( const auto& list : record->limbo ) {
+    count += list.count;
+  }
+  return count;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::allocator_info
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>::info()
+  const noexcept
+{
+  return {"epoch_reclaiming_allocator",this};
+}
+
+template<typename Allocator, typename BasicLockable>
+inline typename bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>::allocator_type&
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::backing_allocator()
+  noexcept
+{
+  return get<0>(*this);
+}
+
+template<typename Allocator, typename BasicLockable>
+inline const typename bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>::allocator_type&
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::backing_allocator()
+  const noexcept
+{
+  return get<0>(*this);
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline typename bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>::thread_record&
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::local_record()
+{
+  auto* record = find_local_record();
+  if( BIT_MEMORY_LIKELY(record != nullptr) ) return *record;
+
+  record = new thread_record{};
+  record->owner.store( this, std::memory_order_relaxed );
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+
+    record->next = m_records;
+    if( m_records != nullptr ) m_records->previous = record;
+    m_records = record;
+  }
+
+  auto& records = thread_records();
+
+  record->next_local = records.head;
+  records.head = record;
+  records.last = record;
+
+  return *record;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline typename bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>::thread_record*
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::find_local_record()
+  noexcept
+{
+  auto& records = thread_records();
+
+  // Fast-path: the same allocator is usually used repeatedly
+  if( BIT_MEMORY_LIKELY(records.last != nullptr &&
+                        records.last->owner.load(std::memory_order_relaxed) == this) ) {
+    return records.last;
+  }
+
+  auto* link = &records.head;
+
+  while( *link != nullptr ) {
+    auto* record = *link;
+    auto* owner  = record->owner.load(std::memory_order_acquire);
+
+    if( owner == this ) {
+      records.last = record;
+      return record;
+    }
+
+    // Reclaim the records of destroyed allocators, so that a thread that
+    // outlives many allocators does not accumulate their records
+    if( owner == nullptr ) {
+      *link = record->next_local;
+      if( records.last == record ) records.last = nullptr;
+
+      destroy_record( record );
+      continue;
+    }
+    link = &record->next_local;
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::try_advance( limbo_list& orphans )
+  noexcept
+{
+  std::unique_lock<std::mutex> lock(registry_mutex(), std::try_to_lock);
+
+  if( !lock.owns_lock() ) return;
+
+  auto epoch = m_epoch.load(std::memory_order_relaxed);
+
+  // Pairs with the fence in enter_critical
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  auto advance = true;
+  // Acquiring a record's state orders every read of a critical section the
+  // record has since exited before the memory those reads could have seen
+  // is reclaimed
+  for( auto* record = m_records; record != nullptr; record = record->next ) {
+    const auto state = record->state.load(std::memory_order_acquire);
+
+    if( (state & 1u) != 0 && (state >> 1) != epoch ) {
+      advance = false;
+      break;
+    }
+  }
+
+  // The epoch is only ever advanced under the registry mutex
+  if( advance ) {
+    m_epoch.store( ++epoch, std::memory_order_seq_cst );
+  }
+
+  if( m_orphans.head != nullptr && (m_orphans.epoch + 2) <= epoch ) {
+    orphans   = m_orphans;
+    m_orphans = limbo_list{};
+  }
+}
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::collect( thread_record& record )
+{
+  auto orphans = limbo_list{};
+  try_advance( orphans );
+
+  const auto epoch = m_epoch.load(std::memory_order_seq_cst);
+  auto count = release_list( orphans, &record );
+
+  for( auto& list : record.limbo ) {
+    if( list.head != nullptr && (list.epoch + 2) <= epoch ) {
+      count += release_list( list, &record );
+    }
+  }
+  record.retired = 0;
+
+  return count;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::release_list( limbo_list& list, thread_record* record )
+{
+  if( list.head == nullptr ) return 0u;
+
+  const auto count = list.count;
+  {
+    std::lock_guard<lock_type> lock(get<1>(*this));
+
+    for( auto* block = list.head; block != nullptr; block = block->next ) {
+      for( auto i = 0u; i < block->count; ++i ) {
+        allocator_traits<Allocator>::deallocate( get<0>(*this),
+                                                 block->entries[i].pointer,
+                                                 block->entries[i].size );
+      }
+    }
+  }
+
+  while( list.head != nullptr ) {
+    auto* block = list.head;
+    list.head = block->next;
+
+    if( record != nullptr ) {
+      block->next   = record->spare;
+      record->spare = block;
+    } else {
+      delete block;
+    }
+  }
+  list = limbo_list{};
+
+  return count;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::orphan_record( thread_record& record )
+  noexcept
+{
+  assert( record.nesting == 0 && "a thread exited inside a critical section" );
+
+  for( auto& list : record.limbo ) {
+    if( list.head == nullptr ) continue;
+
+    auto* last = list.head;
+    while( last->next != nullptr ) last = last->next;
+
+    // Only the first block may be partially filled, so the orphaned blocks
+    // can be chained in any order
+    last->next       = m_orphans.head;
+    m_orphans.head   = list.head;
+    m_orphans.count += list.count;
+    list             = limbo_list{};
+  }
+
+  // The orphans are stamped with the newest epoch any of them may be from
+  m_orphans.epoch = m_epoch.load(std::memory_order_relaxed);
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::unregister_record( thread_record& record )
+  noexcept
+{
+  if( record.previous != nullptr ) {
+    record.previous->next = record.next;
+  } else {
+    m_records = record.next;
+  }
+  if( record.next != nullptr ) {
+    record.next->previous = record.previous;
+  }
+  record.owner.store( nullptr, std::memory_order_relaxed );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline std::mutex&
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::registry_mutex()
+  noexcept
+{
+  static std::mutex mutex;
+
+  return mutex;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::destroy_record( thread_record* record )
+  noexcept
+{
+  while( record->spare != nullptr ) {
+    auto* block = record->spare;
+    record->spare = block->next;
+    delete block;
+  }
+  delete record;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline typename bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>::thread_record_list&
+  bit::memory::epoch_reclaiming_allocator<Allocator,BasicLockable>
+  ::thread_records()
+  noexcept
+{
+  static thread_local thread_record_list records;
+
+  return records;
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_EPOCH_RECLAIMING_ALLOCATOR_INL */
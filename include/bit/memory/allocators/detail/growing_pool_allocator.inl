@@ -0,0 +1,320 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_GROWING_POOL_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_GROWING_POOL_ALLOCATOR_INL
+
+//============================================================================
+// growing_pool_allocator
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructors / Destructor
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+template<typename...Args, typename>
+inline bit::memory::growing_pool_allocator<BlockAllocator>
+  ::growing_pool_allocator( std::size_t chunk_size, Args&&...args )
+  : base_type( std::forward_as_tuple(std::forward<Args>(args)...) ),
+    m_slabs(nullptr),
+    m_free_slabs(nullptr),
+    m_slab_count(0),
+    m_slab_align(0),
+    m_chunk_size(chunk_size)
+{
+  // It is a requirement that chunk_size is a power-of-2 that is greater
+  // than alignof(void*) and sizeof(void*) -- otherwise the pool would
+  // suffer misalignment issues on the internal freelist
+  assert( is_power_of_two(chunk_size) );
+  assert( chunk_size >= sizeof(void*) );
+  assert( chunk_size >= alignof(void*) );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline bit::memory::growing_pool_allocator<BlockAllocator>
+  ::~growing_pool_allocator()
+{
+  deallocate_all();
+}
+
+//----------------------------------------------------------------------------
+// Allocation / Deallocation
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline bit::memory::owner<void*>
+  bit::memory::growing_pool_allocator<BlockAllocator>
+  ::try_allocate( std::size_t size, std::size_t align, std::size_t offset )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  // Don't bother requesting a slab that could never fit the request
+  if( BIT_MEMORY_UNLIKELY((size + 1) > m_chunk_size) ) return nullptr;
+
+  auto* s = m_free_slabs;
+
+  if( BIT_MEMORY_UNLIKELY(s == nullptr) ) {
+    s = acquire_slab();
+
+    if( BIT_MEMORY_UNLIKELY(s == nullptr) ) return nullptr;
+  }
+
+  auto p = s->chunks.request();
+
+  if( p == nullptr ) {
+    p          = s->current;
+    s->current = static_cast<byte_t*>(p) + m_chunk_size;
+  }
+
+  auto adjust  = std::size_t{};
+  auto* result = offset_align_forward(p, align, offset+1, &adjust);
+
+  const auto new_size = (size + 1 + adjust);
+
+  if( BIT_MEMORY_UNLIKELY(new_size > max_size()) ) {
+    s->chunks.store( p );
+    return nullptr;
+  }
+
+  ++s->allocated;
+
+  // The slab is full once it has no recycled or unused chunks left
+  if( s->chunks.empty() && distance(s->current,s->end) < m_chunk_size ) {
+    remove_free_slab( s );
+  }
+
+  // Store the adjustment made to align correctly
+  *static_cast<byte_t*>(result) = static_cast<byte_t>(adjust);
+
+  return static_cast<byte_t*>(result) + 1;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline void bit::memory::growing_pool_allocator<BlockAllocator>
+  ::deallocate( owner<void*> p, std::size_t size )
+{
+  BIT_MEMORY_UNUSED(size);
+
+  using byte_t = unsigned char;
+
+  p           = static_cast<byte_t*>(p) - 1;
+  auto adjust = static_cast<std::ptrdiff_t>(*static_cast<byte_t*>(p));
+  p           = static_cast<byte_t*>(p) - adjust;
+
+  auto* s = find_slab( p );
+
+  assert( s != nullptr && "pointer must be owned by this allocator" );
+
+  const auto was_full = s->chunks.empty() &&
+                        distance(s->current,s->end) < m_chunk_size;
+
+  s->chunks.store( p );
+  --s->allocated;
+
+  if( was_full ) push_free_slab( s );
+
+  // Keep an empty slab only if it is the last slab with a free chunk, so
+  // that alternating allocations and deallocations don't thrash the
+  // block allocator
+  if( s->allocated == 0 && (s != m_free_slabs || s->next_free != nullptr) ) {
+    remove_free_slab( s );
+    release_slab( s );
+  }
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline void bit::memory::growing_pool_allocator<BlockAllocator>
+  ::deallocate_all()
+{
+  while( m_slabs != nullptr ) {
+    release_slab( m_slabs );
+  }
+  m_free_slabs = nullptr;
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline bool bit::memory::growing_pool_allocator<BlockAllocator>
+  ::owns( const void* p )
+  const noexcept
+{
+  for( auto* s = m_slabs; s != nullptr; s = s->next ) {
+    if( s->block.contains( p ) ) return true;
+  }
+  return false;
+}
+
+template<typename BlockAllocator>
+inline std::size_t bit::memory::growing_pool_allocator<BlockAllocator>
+  ::max_size()
+  const noexcept
+{
+  return m_chunk_size;
+}
+
+template<typename BlockAllocator>
+inline bit::memory::allocator_info
+  bit::memory::growing_pool_allocator<BlockAllocator>::info()
+  const noexcept
+{
+  return {"growing_pool_allocator",this};
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline std::size_t bit::memory::growing_pool_allocator<BlockAllocator>
+  ::slabs()
+  const noexcept
+{
+  return m_slab_count;
+}
+
+template<typename BlockAllocator>
+inline typename bit::memory::growing_pool_allocator<BlockAllocator>::block_allocator_type&
+  bit::memory::growing_pool_allocator<BlockAllocator>::block_allocator()
+  noexcept
+{
+  return get<0>(*this);
+}
+
+template<typename BlockAllocator>
+inline const typename bit::memory::growing_pool_allocator<BlockAllocator>::block_allocator_type&
+  bit::memory::growing_pool_allocator<BlockAllocator>::block_allocator()
+  const noexcept
+{
+  return get<0>(*this);
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline typename bit::memory::growing_pool_allocator<BlockAllocator>::slab*
+  bit::memory::growing_pool_allocator<BlockAllocator>::acquire_slab()
+{
+  using byte_t = unsigned char;
+
+  auto& allocator = block_allocator();
+  auto block = block_allocator_traits<BlockAllocator>
+               ::allocate_block( allocator );
+
+  if( BIT_MEMORY_UNLIKELY(block == nullblock) ) return nullptr;
+
+  // The chunks start after the slab bookkeeping
+  auto* const first = static_cast<byte_t*>(
+    align_forward( static_cast<byte_t*>(block.data()) + sizeof(slab),
+                   alignof(std::max_align_t) )
+  );
+  auto* const last  = static_cast<byte_t*>(block.end_address());
+
+  if( BIT_MEMORY_UNLIKELY(first >= last ||
+                          distance(first,last) < m_chunk_size) ) {
+    block_allocator_traits<BlockAllocator>::deallocate_block( allocator, block );
+    return nullptr;
+  }
+
+  const auto chunks = distance(first,last) / m_chunk_size;
+
+  auto* s = ::new(block.data()) slab();
+  s->block     = block;
+  s->current   = first;
+  s->end       = first + chunks * m_chunk_size;
+  s->allocated = 0;
+
+  // Chunks can only be mapped back to their slab with a mask if every slab
+  // is the same size, and aligned to it
+  if( m_slab_count == 0 ) {
+    const auto aligned = is_power_of_two(block.size()) &&
+                         align_of(block.data()) >= block.size();
+
+    m_slab_align = aligned ? block.size() : 0;
+  } else if( block.size() != m_slab_align ||
+             align_of(block.data()) < m_slab_align ) {
+    m_slab_align = 0;
+  }
+
+  s->previous = nullptr;
+  s->next     = m_slabs;
+  if( m_slabs != nullptr ) m_slabs->previous = s;
+  m_slabs = s;
+  ++m_slab_count;
+
+  push_free_slab( s );
+
+  return s;
+}
+
+template<typename BlockAllocator>
+inline void bit::memory::growing_pool_allocator<BlockAllocator>
+  ::release_slab( slab* s )
+{
+  if( s->previous != nullptr ) {
+    s->previous->next = s->next;
+  } else {
+    m_slabs = s->next;
+  }
+  if( s->next != nullptr ) s->next->previous = s->previous;
+  --m_slab_count;
+
+  const auto block = s->block;
+  s->~slab();
+
+  block_allocator_traits<BlockAllocator>::deallocate_block(
+    block_allocator(),
+    block
+  );
+}
+
+template<typename BlockAllocator>
+inline typename bit::memory::growing_pool_allocator<BlockAllocator>::slab*
+  bit::memory::growing_pool_allocator<BlockAllocator>
+  ::find_slab( const void* p )
+  const noexcept
+{
+  if( m_slab_align != 0 ) {
+    return static_cast<slab*>(
+      align_backward( const_cast<void*>(p), m_slab_align )
+    );
+  }
+
+  for( auto* s = m_slabs; s != nullptr; s = s->next ) {
+    if( s->block.contains( p ) ) return s;
+  }
+  return nullptr;
+}
+
+template<typename BlockAllocator>
+inline void bit::memory::growing_pool_allocator<BlockAllocator>
+  ::push_free_slab( slab* s )
+  noexcept
+{
+  s->previous_free = nullptr;
+  s->next_free     = m_free_slabs;
+  if( m_free_slabs != nullptr ) m_free_slabs->previous_free = s;
+  m_free_slabs = s;
+}
+
+template<typename BlockAllocator>
+inline void bit::memory::growing_pool_allocator<BlockAllocator>
+  ::remove_free_slab( slab* s )
+  noexcept
+{
+  if( s->previous_free != nullptr ) {
+    s->previous_free->next_free = s->next_free;
+  } else {
+    m_free_slabs = s->next_free;
+  }
+  if( s->next_free != nullptr ) s->next_free->previous_free = s->previous_free;
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_GROWING_POOL_ALLOCATOR_INL */
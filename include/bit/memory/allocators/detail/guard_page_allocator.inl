@@ -0,0 +1,292 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_GUARD_PAGE_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_GUARD_PAGE_ALLOCATOR_INL
+
+//-----------------------------------------------------------------------------
+// Constructors / Destructor / Assignment
+//-----------------------------------------------------------------------------
+
+inline bit::memory::guard_page_allocator
+  ::guard_page_allocator( std::size_t max_size,
+                          std::size_t slots,
+                          guard_page_alignment alignment )
+  : m_memory(nullptr),
+    m_slot_pages(0),
+    m_slots(slots),
+    m_alignment(alignment),
+    m_metadata(nullptr),
+    m_metadata_pages(0),
+    m_free(nullptr),
+    m_allocated(nullptr),
+    m_free_head(0),
+    m_free_count(0)
+{
+  assert( max_size != 0 );
+  assert( slots != 0 );
+
+  const auto page_size = virtual_memory_page_size();
+
+  m_slot_pages = (max_size + page_size - 1) / page_size;
+
+  // The bookkeeping holds a ring of free slots, and a flag per slot
+  const auto metadata_size = slots * (sizeof(std::size_t) + 1);
+
+  m_metadata_pages = (metadata_size + page_size - 1) / page_size;
+  m_metadata       = virtual_memory_reserve( m_metadata_pages );
+
+  if( BIT_MEMORY_UNLIKELY(m_metadata == nullptr) ) return;
+
+  if( BIT_MEMORY_UNLIKELY(!virtual_memory_commit( m_metadata, m_metadata_pages )) ) {
+    virtual_memory_release( m_metadata, m_metadata_pages );
+    m_metadata = nullptr;
+    return;
+  }
+
+  // Guard pages are simply never committed
+  m_memory = virtual_memory_reserve( reserved_pages() );
+
+  if( BIT_MEMORY_UNLIKELY(m_memory == nullptr) ) {
+    virtual_memory_release( m_metadata, m_metadata_pages );
+    m_metadata = nullptr;
+    return;
+  }
+
+  m_free      = static_cast<std::size_t*>(m_metadata);
+  m_allocated = static_cast<unsigned char*>(static_cast<void*>(m_free + slots));
+
+  reset_slots();
+}
+
+inline bit::memory::guard_page_allocator
+  ::guard_page_allocator( guard_page_allocator&& other )
+  noexcept
+  : m_memory(other.m_memory),
+    m_slot_pages(other.m_slot_pages),
+    m_slots(other.m_slots),
+    m_alignment(other.m_alignment),
+    m_metadata(other.m_metadata),
+    m_metadata_pages(other.m_metadata_pages),
+    m_free(other.m_free),
+    m_allocated(other.m_allocated),
+    m_free_head(other.m_free_head),
+    m_free_count(other.m_free_count)
+{
+  other.m_memory     = nullptr;
+  other.m_metadata   = nullptr;
+  other.m_free_count = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+inline bit::memory::guard_page_allocator::~guard_page_allocator()
+{
+  if( m_memory != nullptr ) {
+    virtual_memory_release( m_memory, reserved_pages() );
+  }
+  if( m_metadata != nullptr ) {
+    virtual_memory_release( m_metadata, m_metadata_pages );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+inline bit::memory::owner<void*>
+  bit::memory::guard_page_allocator::try_allocate( std::size_t size,
+                                                   std::size_t align )
+  noexcept
+{
+  assert( align <= virtual_memory_page_size() &&
+          "alignment must not exceed the page size" );
+
+  if( BIT_MEMORY_UNLIKELY(size > max_size() || m_free_count == 0) ) {
+    return nullptr;
+  }
+  if( size == 0 ) size = 1;
+
+  const auto index = m_free[m_free_head];
+  auto* const slot = slot_address( index );
+
+  auto* const p = (m_alignment == guard_page_alignment::overflow)
+    ? static_cast<unsigned char*>(
+        align_backward( slot + max_size() - size, align )
+      )
+    : slot;
+
+  unsigned char* first;
+  unsigned char* last;
+  pages_of( p, size, &first, &last );
+
+  const auto pages = static_cast<std::size_t>(last - first) / virtual_memory_page_size();
+
+  if( BIT_MEMORY_UNLIKELY(!virtual_memory_commit( first, pages )) ) {
+    return nullptr;
+  }
+
+  m_free_head = (m_free_head + 1) % m_slots;
+  --m_free_count;
+  m_allocated[index] = 1;
+
+  return p;
+}
+
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::guard_page_allocator::deallocate( owner<void*> p,
+                                                           std::size_t size )
+{
+  assert( owns(p) && "pointer must be owned by this allocator" );
+
+  const auto index = slot_of( p );
+
+  if( BIT_MEMORY_UNLIKELY(!m_allocated[index]) ) {
+    (*get_double_delete_handler())( info(), p, static_cast<std::ptrdiff_t>(size) );
+    return;
+  }
+  if( size == 0 ) size = 1;
+
+  unsigned char* first;
+  unsigned char* last;
+  pages_of( p, size, &first, &last );
+
+  // Decommitting makes any use after free fault
+  virtual_memory_decommit(
+    first,
+    static_cast<std::size_t>(last - first) / virtual_memory_page_size()
+  );
+
+  m_allocated[index] = 0;
+  m_free[(m_free_head + m_free_count) % m_slots] = index;
+  ++m_free_count;
+}
+
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::guard_page_allocator::deallocate_all()
+{
+  if( BIT_MEMORY_UNLIKELY(m_memory == nullptr) ) return;
+
+  virtual_memory_decommit( m_memory, reserved_pages() );
+
+  reset_slots();
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+inline bool bit::memory::guard_page_allocator::owns( const void* p )
+  const noexcept
+{
+  if( m_memory == nullptr ) return false;
+
+  auto* const begin = static_cast<const unsigned char*>(m_memory);
+  auto* const end   = begin + reserved_pages() * virtual_memory_page_size();
+
+  return static_cast<const unsigned char*>(p) >= begin &&
+         static_cast<const unsigned char*>(p) < end;
+}
+
+inline bool bit::memory::guard_page_allocator::is_allocated( const void* p )
+  const noexcept
+{
+  assert( owns(p) && "pointer must be owned by this allocator" );
+
+  return m_allocated[slot_of( p )] != 0;
+}
+
+inline std::size_t bit::memory::guard_page_allocator::max_size()
+  const noexcept
+{
+  return m_slot_pages * virtual_memory_page_size();
+}
+
+inline std::size_t bit::memory::guard_page_allocator::capacity()
+  const noexcept
+{
+  return m_slots;
+}
+
+inline std::size_t bit::memory::guard_page_allocator::size()
+  const noexcept
+{
+  return (m_memory == nullptr) ? 0 : (m_slots - m_free_count);
+}
+
+inline bit::memory::guard_page_alignment
+  bit::memory::guard_page_allocator::alignment()
+  const noexcept
+{
+  return m_alignment;
+}
+
+//-----------------------------------------------------------------------------
+
+inline bit::memory::allocator_info bit::memory::guard_page_allocator::info()
+  const noexcept
+{
+  return {"guard_page_allocator",this};
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::guard_page_allocator::reserved_pages()
+  const noexcept
+{
+  // Each slot is followed by a guard page, and the first slot is preceded
+  // by one
+  return m_slots * (m_slot_pages + 1) + 1;
+}
+
+inline unsigned char*
+  bit::memory::guard_page_allocator::slot_address( std::size_t index )
+  const noexcept
+{
+  const auto page_size = virtual_memory_page_size();
+
+  return static_cast<unsigned char*>(m_memory)
+         + page_size
+         + index * (m_slot_pages + 1) * page_size;
+}
+
+inline std::size_t
+  bit::memory::guard_page_allocator::slot_of( const void* p )
+  const noexcept
+{
+  const auto page_size = virtual_memory_page_size();
+  const auto offset    = static_cast<std::size_t>(
+    static_cast<const unsigned char*>(p) - static_cast<unsigned char*>(m_memory)
+  ) - page_size;
+
+  return offset / ((m_slot_pages + 1) * page_size);
+}
+
+inline void bit::memory::guard_page_allocator::pages_of( void* p,
+                                                         std::size_t size,
+                                                         unsigned char** first,
+                                                         unsigned char** last )
+  const noexcept
+{
+  const auto page_size = virtual_memory_page_size();
+
+  *first = static_cast<unsigned char*>(align_backward( p, page_size ));
+  *last  = static_cast<unsigned char*>(
+    align_forward( static_cast<unsigned char*>(p) + size, page_size )
+  );
+}
+
+inline void bit::memory::guard_page_allocator::reset_slots()
+  noexcept
+{
+  for( auto i = std::size_t{0}; i < m_slots; ++i ) {
+    m_free[i]      = i;
+    m_allocated[i] = 0;
+  }
+
+  m_free_head  = 0;
+  m_free_count = m_slots;
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_GUARD_PAGE_ALLOCATOR_INL */
@@ -0,0 +1,255 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_LATENCY_TRACKING_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_LATENCY_TRACKING_ALLOCATOR_INL
+
+//----------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename LatencyTracker>
+template<typename...Args, typename>
+inline bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::latency_tracking_allocator( Args&&...args )
+  : base_type( std::forward_as_tuple(std::forward<Args>(args)...),
+               std::forward_as_tuple() )
+{
+
+}
+
+//----------------------------------------------------------------------------
+// Allocations / Deallocations
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename LatencyTracker>
+inline bit::memory::owner<void*>
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::try_allocate( std::size_t size, std::size_t align )
+  noexcept
+{
+  using ::bit::memory::get;
+
+  const auto start = clock_type::now();
+  auto* const p = allocator_traits<Allocator>::try_allocate( get<0>(*this), size, align );
+  const auto end = clock_type::now();
+
+  get<1>(*this).on_allocate_latency( end - start );
+
+  return p;
+}
+
+template<typename Allocator, typename LatencyTracker>
+template<typename, typename>
+inline bit::memory::owner<void*>
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::try_allocate( std::size_t size, std::size_t align, std::size_t offset )
+  noexcept
+{
+  using ::bit::memory::get;
+
+  const auto start = clock_type::now();
+  auto* const p = get<0>(*this).try_allocate( size, align, offset );
+  const auto end = clock_type::now();
+
+  get<1>(*this).on_allocate_latency( end - start );
+
+  return p;
+}
+
+template<typename Allocator, typename LatencyTracker>
+template<typename, typename>
+inline bit::memory::owner<void*>
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::allocate( std::size_t size, std::size_t align )
+{
+  using ::bit::memory::get;
+
+  const auto start = clock_type::now();
+  auto* const p = get<0>(*this).allocate( size, align );
+  const auto end = clock_type::now();
+
+  get<1>(*this).on_allocate_latency( end - start );
+
+  return p;
+}
+
+template<typename Allocator, typename LatencyTracker>
+template<typename, typename>
+inline bit::memory::owner<void*>
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::allocate( std::size_t size, std::size_t align, std::size_t offset )
+{
+  using ::bit::memory::get;
+
+  const auto start = clock_type::now();
+  auto* const p = get<0>(*this).allocate( size, align, offset );
+  const auto end = clock_type::now();
+
+  get<1>(*this).on_allocate_latency( end - start );
+
+  return p;
+}
+
+template<typename Allocator, typename LatencyTracker>
+template<typename, typename>
+inline std::size_t
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::try_allocate_n( std::size_t size,
+                    std::size_t align,
+                    std::size_t n,
+                    void** out )
+  noexcept
+{
+  using ::bit::memory::get;
+
+  const auto start = clock_type::now();
+  const auto count = get<0>(*this).try_allocate_n( size, align, n, out );
+  const auto end = clock_type::now();
+
+  get<1>(*this).on_allocate_latency( end - start );
+
+  return count;
+}
+
+template<typename Allocator, typename LatencyTracker>
+template<typename, typename>
+inline bool bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::expand( void* p, std::size_t new_size )
+  noexcept
+{
+  using ::bit::memory::get;
+
+  return get<0>(*this).expand( p, new_size );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename LatencyTracker>
+inline void bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::deallocate( owner<void*> p, std::size_t size )
+{
+  using ::bit::memory::get;
+
+  const auto start = clock_type::now();
+  allocator_traits<Allocator>::deallocate( get<0>(*this), p, size );
+  const auto end = clock_type::now();
+
+  get<1>(*this).on_deallocate_latency( end - start );
+}
+
+template<typename Allocator, typename LatencyTracker>
+template<typename, typename>
+inline void bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::deallocate_n( void** ptrs, std::size_t n, std::size_t size )
+{
+  using ::bit::memory::get;
+
+  const auto start = clock_type::now();
+  get<0>(*this).deallocate_n( ptrs, n, size );
+  const auto end = clock_type::now();
+
+  get<1>(*this).on_deallocate_latency( end - start );
+}
+
+template<typename Allocator, typename LatencyTracker>
+template<typename, typename>
+inline void bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::deallocate_all()
+{
+  using ::bit::memory::get;
+
+  get<0>(*this).deallocate_all();
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename LatencyTracker>
+template<typename, typename>
+inline bool bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::owns( const void* p )
+  const noexcept
+{
+  using ::bit::memory::get;
+
+  return get<0>(*this).owns( p );
+}
+
+template<typename Allocator, typename LatencyTracker>
+inline bit::memory::allocator_info
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>::info()
+  const noexcept
+{
+  using ::bit::memory::get;
+
+  return allocator_traits<Allocator>::info( get<0>(*this) );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename LatencyTracker>
+template<typename, typename>
+inline std::size_t
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>::max_size()
+  const noexcept
+{
+  using ::bit::memory::get;
+
+  return get<0>(*this).max_size();
+}
+
+template<typename Allocator, typename LatencyTracker>
+template<typename, typename>
+inline std::size_t
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>::min_size()
+  const noexcept
+{
+  using ::bit::memory::get;
+
+  return get<0>(*this).min_size();
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename LatencyTracker>
+inline typename bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>::allocator_type&
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::backing_allocator()
+  noexcept
+{
+  using ::bit::memory::get;
+
+  return get<0>(*this);
+}
+
+template<typename Allocator, typename LatencyTracker>
+inline const typename bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>::allocator_type&
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>
+  ::backing_allocator()
+  const noexcept
+{
+  using ::bit::memory::get;
+
+  return get<0>(*this);
+}
+
+template<typename Allocator, typename LatencyTracker>
+inline typename bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>::tracker_type&
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>::tracker()
+  noexcept
+{
+  using ::bit::memory::get;
+
+  return get<1>(*this);
+}
+
+template<typename Allocator, typename LatencyTracker>
+inline const typename bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>::tracker_type&
+  bit::memory::latency_tracking_allocator<Allocator,LatencyTracker>::tracker()
+  const noexcept
+{
+  using ::bit::memory::get;
+
+  return get<1>(*this);
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_LATENCY_TRACKING_ALLOCATOR_INL */
@@ -0,0 +1,202 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the size classes and magazines shared by the
+ *        caching allocators
+ *
+ * \note This is an internal header file, included by other library headers.
+ *       Do not attempt to use it directly.
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_MAGAZINE_CACHE_HPP
+#define BIT_MEMORY_ALLOCATORS_DETAIL_MAGAZINE_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "../../traits/allocator_traits.hpp" // allocator_traits
+
+#include "../../utilities/bit_scan.hpp" // ceil_log2
+#include "../../utilities/freelist.hpp" // freelist
+#include "../../utilities/macros.hpp"   // BIT_MEMORY_UNLIKELY
+#include "../../utilities/owner.hpp"    // owner
+
+#include <cstddef>     // std::size_t, std::max_align_t
+#include <mutex>       // std::lock_guard
+#include <type_traits> // std::integral_constant
+
+namespace bit {
+  namespace memory {
+    namespace detail {
+
+      /////////////////////////////////////////////////////////////////////////
+      /// \brief A set of magazines of free chunks, one for every power-of-two
+      ///        size class, in front of a central allocator
+      ///
+      /// This is the cache that both the thread_caching_allocator and the
+      /// per_cpu_allocator keep -- per thread and per processor respectively.
+      /// Magazines are refilled from, and flushed back to, the central
+      /// allocator in batches under a single lock.
+      ///
+      /// A magazine_cache is not synchronized; its owner must ensure that
+      /// only one thread uses it at a time.
+      /////////////////////////////////////////////////////////////////////////
+      class magazine_cache
+      {
+        //---------------------------------------------------------------------
+        // Public Member Types
+        //---------------------------------------------------------------------
+      public:
+
+        /// Every cached chunk is aligned to the fundamental alignment, since
+        /// the size of a deallocation alone must identify its size class
+        using max_alignment = std::integral_constant<std::size_t,alignof(std::max_align_t)>;
+
+        /// The smallest size class
+        using min_cached_size = std::integral_constant<std::size_t,alignof(std::max_align_t)>;
+
+        /// The largest size class; larger requests are not cached
+        using max_cached_size = std::integral_constant<std::size_t,4096>;
+
+        /// The number of size classes
+        using size_classes = std::integral_constant<std::size_t,9>;
+
+        static_assert( (min_cached_size::value << (size_classes::value - 1)) >= max_cached_size::value,
+                       "size classes must cover every cached size" );
+
+        //---------------------------------------------------------------------
+        // Caching
+        //---------------------------------------------------------------------
+      public:
+
+        /// \brief Requests a chunk of size-class \p index, refilling its
+        ///        magazine with up to \p refill_count chunks from
+        ///        \p allocator if it is empty
+        ///
+        /// \param index the size-class of the chunk
+        /// \param allocator the central allocator
+        /// \param lock the lock guarding the central allocator
+        /// \param refill_count the number of chunks to refill with
+        /// \return the chunk, or \c nullptr if the central allocator is out
+        ///         of memory
+        template<typename Allocator, typename BasicLockable>
+        owner<void*> request( std::size_t index,
+                              Allocator& allocator,
+                              BasicLockable& lock,
+                              std::size_t refill_count ) noexcept;
+
+        /// \brief Stores the chunk \p p of size-class \p index, flushing its
+        ///        magazine down to \p low_water_mark chunks if it grows past
+        ///        \p high_water_mark
+        ///
+        /// \param p the chunk to store
+        /// \param index the size-class of the chunk
+        /// \param allocator the central allocator
+        /// \param lock the lock guarding the central allocator
+        /// \param high_water_mark the most chunks a magazine may hold
+        /// \param low_water_mark the chunks left in a magazine after a flush
+        template<typename Allocator, typename BasicLockable>
+        void store( owner<void*> p,
+                    std::size_t index,
+                    Allocator& allocator,
+                    BasicLockable& lock,
+                    std::size_t high_water_mark,
+                    std::size_t low_water_mark );
+
+        /// \brief Flushes every magazine back to \p allocator
+        ///
+        /// \param allocator the central allocator
+        /// \param lock the lock guarding the central allocator
+        template<typename Allocator, typename BasicLockable>
+        void flush( Allocator& allocator, BasicLockable& lock );
+
+        //---------------------------------------------------------------------
+        // Size Classes
+        //---------------------------------------------------------------------
+      public:
+
+        /// \brief Gets the index of the size class that \p size rounds up to
+        ///
+        /// \pre \p size does not exceed \c max_cached_size
+        ///
+        /// \param size the size of the request
+        /// \return the index of the size class
+        static std::size_t size_class_index( std::size_t size ) noexcept;
+
+        /// \brief Gets the size of the chunks of the size class \p index
+        ///
+        /// \param index the index of the size class
+        /// \return the size of the size class
+        static std::size_t size_class_size( std::size_t index ) noexcept;
+
+        //---------------------------------------------------------------------
+        // Private Member Types
+        //---------------------------------------------------------------------
+      private:
+
+        /// \brief A bounded stack of free chunks of a single size class
+        struct magazine
+        {
+          freelist    chunks;
+          std::size_t count = 0;
+        };
+
+        //---------------------------------------------------------------------
+        // Private Members
+        //---------------------------------------------------------------------
+      private:
+
+        magazine m_magazines[size_classes::value];
+
+        //---------------------------------------------------------------------
+        // Private Member Functions
+        //---------------------------------------------------------------------
+      private:
+
+        /// \brief Refills the magazine of size-class \p index with up to
+        ///        \p count chunks from the central allocator
+        template<typename Allocator, typename BasicLockable>
+        void refill( std::size_t index,
+                     Allocator& allocator,
+                     BasicLockable& lock,
+                     std::size_t count ) noexcept;
+
+        /// \brief Flushes the magazine of size-class \p index to the central
+        ///        allocator until it holds at most \p count chunks
+        template<typename Allocator, typename BasicLockable>
+        void flush( std::size_t index,
+                    Allocator& allocator,
+                    BasicLockable& lock,
+                    std::size_t count );
+      };
+
+    } // namespace detail
+  } // namespace memory
+} // namespace bit
+
+#include "magazine_cache.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_MAGAZINE_CACHE_HPP */
@@ -0,0 +1,130 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_MAGAZINE_CACHE_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_MAGAZINE_CACHE_INL
+
+//=============================================================================
+// magazine_cache
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Caching
+//-----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::owner<void*> bit::memory::detail::magazine_cache
+  ::request( std::size_t index,
+             Allocator& allocator,
+             BasicLockable& lock,
+             std::size_t refill_count )
+  noexcept
+{
+  auto& m = m_magazines[index];
+
+  if( BIT_MEMORY_UNLIKELY(m.count == 0) ) {
+    refill( index, allocator, lock, refill_count );
+
+    if( m.count == 0 ) return nullptr;
+  }
+
+  --m.count;
+  return m.chunks.request();
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::detail::magazine_cache
+  ::store( owner<void*> p,
+           std::size_t index,
+           Allocator& allocator,
+           BasicLockable& lock,
+           std::size_t high_water_mark,
+           std::size_t low_water_mark )
+{
+  auto& m = m_magazines[index];
+
+  m.chunks.store( p );
+  ++m.count;
+
+  if( BIT_MEMORY_UNLIKELY(m.count > high_water_mark) ) {
+    flush( index, allocator, lock, low_water_mark );
+  }
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::detail::magazine_cache
+  ::flush( Allocator& allocator, BasicLockable& lock )
+{
+  for( auto i = 0u; i < size_classes::value; ++i ) {
+    if( m_magazines[i].count != 0 ) {
+      flush( i, allocator, lock, 0u );
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Size Classes
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::detail::magazine_cache
+  ::size_class_index( std::size_t size )
+  noexcept
+{
+  // Classes are powers of two, starting at 'min_cached_size'
+  const auto units = (size + min_cached_size::value - 1) / min_cached_size::value;
+
+  return (units <= 1) ? 0u : ceil_log2(units);
+}
+
+inline std::size_t bit::memory::detail::magazine_cache
+  ::size_class_size( std::size_t index )
+  noexcept
+{
+  return min_cached_size::value << index;
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::detail::magazine_cache
+  ::refill( std::size_t index,
+            Allocator& allocator,
+            BasicLockable& lock,
+            std::size_t count )
+  noexcept
+{
+  auto& m         = m_magazines[index];
+  const auto size = size_class_size( index );
+
+  std::lock_guard<BasicLockable> guard(lock);
+
+  for( auto i = 0u; i < count; ++i ) {
+    auto p = allocator_traits<Allocator>::try_allocate( allocator,
+                                                        size,
+                                                        max_alignment::value );
+    if( p == nullptr ) break;
+
+    m.chunks.store( p );
+    ++m.count;
+  }
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::detail::magazine_cache
+  ::flush( std::size_t index,
+           Allocator& allocator,
+           BasicLockable& lock,
+           std::size_t count )
+{
+  auto& m         = m_magazines[index];
+  const auto size = size_class_size( index );
+
+  std::lock_guard<BasicLockable> guard(lock);
+
+  for( ; m.count > count; --m.count ) {
+    allocator_traits<Allocator>::deallocate( allocator,
+                                             m.chunks.request(),
+                                             size );
+  }
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_MAGAZINE_CACHE_INL */
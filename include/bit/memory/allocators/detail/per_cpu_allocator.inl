@@ -0,0 +1,304 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_PER_CPU_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_PER_CPU_ALLOCATOR_INL
+
+//----------------------------------------------------------------------------
+// Constructors / Destructor
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+template<typename...Args, typename>
+inline bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::per_cpu_allocator( Args&&...args )
+  : base_type( std::forward_as_tuple(std::forward<Args>(args)...),
+               std::forward_as_tuple() ),
+    m_storage(nullptr),
+    m_shards(nullptr),
+    m_shard_count(cpu_count()),
+    m_magazine_size(32),
+    m_high_water_mark(64),
+    m_low_water_mark(32)
+{
+  // Over-aligned types are not supported by 'new' until C++17, so the
+  // shards are aligned to their cache lines by hand
+  m_storage = ::operator new( sizeof(shard) * m_shard_count + cache_line_size );
+  m_shards  = static_cast<shard*>(align_forward( m_storage, cache_line_size ));
+
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    new (m_shards + i) shard{};
+  }
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::~per_cpu_allocator()
+{
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    flush_shard( m_shards[i] );
+    m_shards[i].~shard();
+  }
+  ::operator delete( m_storage );
+}
+
+//----------------------------------------------------------------------------
+// Allocation / Deallocation
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::owner<void*>
+  bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::try_allocate( std::size_t size, std::size_t align )
+  noexcept
+{
+  assert( align <= max_alignment::value && "alignment exceeds max_alignment" );
+  BIT_MEMORY_UNUSED(align);
+
+  if( BIT_MEMORY_UNLIKELY(size > max_cached_size::value) ) {
+    return allocate_uncached( size, align );
+  }
+
+  const auto index = magazine_cache::size_class_index( size );
+  auto* s          = claim_shard();
+
+  if( BIT_MEMORY_UNLIKELY(s == nullptr) ) {
+    return allocate_uncached( magazine_cache::size_class_size(index), max_alignment::value );
+  }
+
+  auto* p = s->magazines.request( index,
+                                  get<0>(*this),
+                                  get<1>(*this),
+                                  m_magazine_size );
+
+  release_shard( *s );
+  return p;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::deallocate( owner<void*> p, std::size_t size )
+{
+  if( BIT_MEMORY_UNLIKELY(size > max_cached_size::value) ) {
+    deallocate_uncached( p, size );
+    return;
+  }
+
+  const auto index = magazine_cache::size_class_index( size );
+  auto* s          = claim_shard();
+
+  if( BIT_MEMORY_UNLIKELY(s == nullptr) ) {
+    deallocate_uncached( p, magazine_cache::size_class_size(index) );
+    return;
+  }
+
+  s->magazines.store( p,
+                      index,
+                      get<0>(*this),
+                      get<1>(*this),
+                      m_high_water_mark,
+                      m_low_water_mark );
+
+  release_shard( *s );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::flush_caches()
+{
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    auto* s = try_claim_shard( i );
+
+    if( s != nullptr ) {
+      flush_shard( *s );
+      release_shard( *s );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Tuning
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::set_magazine_size( std::size_t size )
+  noexcept
+{
+  assert( size > 0 && "magazine size must be non-zero" );
+
+  m_magazine_size = size;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::set_high_water_mark( std::size_t mark )
+  noexcept
+{
+  assert( mark >= m_low_water_mark && "high water mark must not be below the low water mark" );
+
+  m_high_water_mark = mark;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::set_low_water_mark( std::size_t mark )
+  noexcept
+{
+  assert( mark <= m_high_water_mark && "low water mark must not exceed the high water mark" );
+
+  m_low_water_mark = mark;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::magazine_size()
+  const noexcept
+{
+  return m_magazine_size;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::high_water_mark()
+  const noexcept
+{
+  return m_high_water_mark;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::low_water_mark()
+  const noexcept
+{
+  return m_low_water_mark;
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::allocator_info
+  bit::memory::per_cpu_allocator<Allocator,BasicLockable>::info()
+  const noexcept
+{
+  return {"per_cpu_allocator",this};
+}
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::per_cpu_allocator<Allocator,BasicLockable>::shards()
+  const noexcept
+{
+  return m_shard_count;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline typename bit::memory::per_cpu_allocator<Allocator,BasicLockable>::allocator_type&
+  bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::central_allocator()
+  noexcept
+{
+  return get<0>(*this);
+}
+
+template<typename Allocator, typename BasicLockable>
+inline const typename bit::memory::per_cpu_allocator<Allocator,BasicLockable>::allocator_type&
+  bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::central_allocator()
+  const noexcept
+{
+  return get<0>(*this);
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline typename bit::memory::per_cpu_allocator<Allocator,BasicLockable>::shard*
+  bit::memory::per_cpu_allocator<Allocator,BasicLockable>::claim_shard()
+  noexcept
+{
+  const auto cpu = current_cpu();
+  auto* s        = try_claim_shard( cpu );
+
+  if( BIT_MEMORY_LIKELY(s != nullptr) ) return s;
+
+  // The shard is held either by a thread that was preempted on this
+  // processor, or by one that migrated away from it -- or this thread has
+  // itself migrated since the processor was read. Only the last case is
+  // worth another try; the caller falls back to the central allocator
+  const auto other = current_cpu();
+
+  if( other == cpu ) return nullptr;
+
+  return try_claim_shard( other );
+}
+
+template<typename Allocator, typename BasicLockable>
+inline typename bit::memory::per_cpu_allocator<Allocator,BasicLockable>::shard*
+  bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::try_claim_shard( std::size_t index )
+  noexcept
+{
+  auto& s = m_shards[index % m_shard_count];
+
+  // Testing first keeps a claimed shard's line shared rather than
+  // bouncing it between processors
+  if( s.claimed.load(std::memory_order_relaxed) ||
+      s.claimed.exchange(true, std::memory_order_acquire) ) {
+    return nullptr;
+  }
+  return &s;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::release_shard( shard& s )
+  noexcept
+{
+  s.claimed.store( false, std::memory_order_release );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::flush_shard( shard& s )
+{
+  s.magazines.flush( get<0>(*this), get<1>(*this) );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::owner<void*>
+  bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::allocate_uncached( std::size_t size, std::size_t align )
+  noexcept
+{
+  std::lock_guard<lock_type> lock(get<1>(*this));
+
+  return allocator_traits<Allocator>::try_allocate( get<0>(*this), size, align );
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::per_cpu_allocator<Allocator,BasicLockable>
+  ::deallocate_uncached( owner<void*> p, std::size_t size )
+{
+  std::lock_guard<lock_type> lock(get<1>(*this));
+
+  allocator_traits<Allocator>::deallocate( get<0>(*this), p, size );
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_PER_CPU_ALLOCATOR_INL */
@@ -60,16 +60,21 @@ void* bit::memory::policy_allocator<ExtendedAllocator,Tagger,Tracker,Checker,Loc
   { // critical section
     std::lock_guard<lock_type> scope(lock);
 
-    auto* p = allocator_traits<ExtendedAllocator>::try_allocate( allocator, new_size, align, offset );
+    auto* p = extended_allocator_traits<ExtendedAllocator>::try_allocate( allocator, new_size, align, offset );
     byte_ptr = static_cast<byte_t*>(p);
 
     // nullptr being returned is not the hot code-path
     if( BIT_MEMORY_UNLIKELY(!byte_ptr) ) return nullptr;
 
     // Track the allocation
-    tracker.on_allocate( byte_ptr + Checker::front_size, new_size, align );
+    if( s_track_in_lock ) {
+      tracker.on_allocate( byte_ptr + Checker::front_size, new_size, align );
+    }
   }
 
+  if( !s_track_in_lock ) {
+    tracker.on_allocate( byte_ptr + Checker::front_size, new_size, align );
+  }
 
   // Check the boundary, and tag the allocation
   checker.prepare_front_fence( byte_ptr, Checker::front_size );
@@ -80,6 +85,63 @@ void* bit::memory::policy_allocator<ExtendedAllocator,Tagger,Tracker,Checker,Loc
   return byte_ptr + Checker::front_size;
 }
 
+template<typename ExtendedAllocator, typename Tagger, typename Tracker,typename Checker, typename Lock>
+std::size_t bit::memory::policy_allocator<ExtendedAllocator,Tagger,Tracker,Checker,Lock>
+  ::try_allocate_n( std::size_t size, std::size_t align, std::size_t n, void** out )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  const auto new_size = Checker::front_size + size + Checker::back_size;
+  const auto offset   = Checker::front_size;
+
+  auto& allocator = get<0>(*this);
+  auto& tagger    = get<1>(*this);
+  auto& tracker   = get<2>(*this);
+  auto& checker   = get<3>(*this);
+  auto& lock      = get<4>(*this);
+
+  auto count = std::size_t{0};
+
+  { // critical section
+    std::lock_guard<lock_type> scope(lock);
+
+    if( offset == 0 ) {
+      count = allocator_traits<ExtendedAllocator>::try_allocate_n( allocator, new_size, align, n, out );
+    } else {
+      for( ; count < n; ++count ) {
+        out[count] = extended_allocator_traits<ExtendedAllocator>::try_allocate( allocator, new_size, align, offset );
+
+        if( BIT_MEMORY_UNLIKELY(!out[count]) ) break;
+      }
+    }
+
+    // Track the allocations
+    if( s_track_in_lock ) {
+      for( auto i = std::size_t{0}; i < count; ++i ) {
+        tracker.on_allocate( static_cast<byte_t*>(out[i]) + Checker::front_size, new_size, align );
+      }
+    }
+  }
+
+  for( auto i = std::size_t{0}; i < count; ++i ) {
+    auto* byte_ptr = static_cast<byte_t*>(out[i]);
+
+    if( !s_track_in_lock ) {
+      tracker.on_allocate( byte_ptr + Checker::front_size, new_size, align );
+    }
+
+    // Check the boundary, and tag the allocation
+    checker.prepare_front_fence( byte_ptr, Checker::front_size );
+    tagger.tag_allocation( byte_ptr + Checker::front_size, size );
+    checker.prepare_back_fence( byte_ptr + Checker::front_size + size, Checker::back_size );
+
+    out[i] = byte_ptr + Checker::front_size;
+  }
+
+  return count;
+}
+
 template<typename ExtendedAllocator, typename Tagger, typename Tracker,typename Checker, typename Lock>
 void bit::memory::policy_allocator<ExtendedAllocator,Tagger,Tracker,Checker,Lock>
   ::deallocate( void* p, std::size_t size )
@@ -104,16 +166,76 @@ void bit::memory::policy_allocator<ExtendedAllocator,Tagger,Tracker,Checker,Lock
   tagger.tag_deallocation( byte_ptr + Checker::front_size, size );
   checker.check_back_fence( info, byte_ptr + Checker::front_size + size , Checker::back_size );
 
+  if( !s_track_in_lock ) {
+    tracker.on_deallocate( info, p, new_size );
+  }
+
   { // critical section
     std::lock_guard<lock_type> scope(lock);
 
     // Untrack the deallocation
-    tracker.on_deallocate( info, p, new_size );
+    if( s_track_in_lock ) {
+      tracker.on_deallocate( info, p, new_size );
+    }
 
     allocator_traits<ExtendedAllocator>::deallocate( allocator, byte_ptr, new_size );
   }
 }
 
+template<typename ExtendedAllocator, typename Tagger, typename Tracker,typename Checker, typename Lock>
+void bit::memory::policy_allocator<ExtendedAllocator,Tagger,Tracker,Checker,Lock>
+  ::deallocate_n( void** ptrs, std::size_t n, std::size_t size )
+{
+  using byte_t = unsigned char;
+
+  auto& allocator = get<0>(*this);
+  auto& tagger    = get<1>(*this);
+  auto& tracker   = get<2>(*this);
+  auto& checker   = get<3>(*this);
+  auto& lock      = get<4>(*this);
+
+  const auto new_size = Checker::front_size + size + Checker::back_size;
+  const auto offset   = Checker::front_size;
+
+  const auto info = allocator_traits<ExtendedAllocator>::info(allocator);
+
+  for( auto i = std::size_t{0}; i < n; ++i ) {
+    auto* byte_ptr = static_cast<byte_t*>(ptrs[i]) - offset;
+
+    // Check the boundary, and tag the deallocation
+    checker.check_front_fence( info, byte_ptr, Checker::front_size );
+    tagger.tag_deallocation( byte_ptr + Checker::front_size, size );
+    checker.check_back_fence( info, byte_ptr + Checker::front_size + size , Checker::back_size );
+  }
+
+  if( !s_track_in_lock ) {
+    for( auto i = std::size_t{0}; i < n; ++i ) {
+      tracker.on_deallocate( info, ptrs[i], new_size );
+    }
+  }
+
+  { // critical section
+    std::lock_guard<lock_type> scope(lock);
+
+    // Untrack the deallocations
+    if( s_track_in_lock ) {
+      for( auto i = std::size_t{0}; i < n; ++i ) {
+        tracker.on_deallocate( info, ptrs[i], new_size );
+      }
+    }
+
+    if( offset == 0 ) {
+      allocator_traits<ExtendedAllocator>::deallocate_n( allocator, ptrs, n, new_size );
+    } else {
+      for( auto i = std::size_t{0}; i < n; ++i ) {
+        auto* byte_ptr = static_cast<byte_t*>(ptrs[i]) - offset;
+
+        allocator_traits<ExtendedAllocator>::deallocate( allocator, byte_ptr, new_size );
+      }
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------
 
 template<typename ExtendedAllocator, typename Tagger, typename Tracker,typename Checker, typename Lock>
@@ -156,4 +278,30 @@ bit::memory::allocator_info
   return allocator_traits<ExtendedAllocator>::info( allocator );
 }
 
+//-----------------------------------------------------------------------------
+// Capacity
+//-----------------------------------------------------------------------------
+
+template<typename ExtendedAllocator, typename Tagger, typename Tracker,typename Checker, typename Lock>
+template<typename, typename>
+std::size_t bit::memory::policy_allocator<ExtendedAllocator,Tagger,Tracker,Checker,Lock>
+  ::max_size()
+  const noexcept
+{
+  const auto& allocator = get<0>(*this);
+
+  return allocator_traits<ExtendedAllocator>::max_size( allocator );
+}
+
+template<typename ExtendedAllocator, typename Tagger, typename Tracker,typename Checker, typename Lock>
+template<typename, typename>
+std::size_t bit::memory::policy_allocator<ExtendedAllocator,Tagger,Tracker,Checker,Lock>
+  ::min_size()
+  const noexcept
+{
+  const auto& allocator = get<0>(*this);
+
+  return allocator_traits<ExtendedAllocator>::min_size( allocator );
+}
+
 #endif /* BIT_MEMORY_ALLOCATORS_DETAIL_POLICY_ALLOCATOR_INL */
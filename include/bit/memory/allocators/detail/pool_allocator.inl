@@ -8,6 +8,7 @@
 inline bit::memory::pool_allocator::pool_allocator( std::size_t chunk_size,
                                                     memory_block block )
   : m_block(block),
+    m_current(block.data()),
     m_chunk_size(chunk_size)
 {
   // It is a requirement that chunk_size is a power-of-2 that is greater
@@ -17,8 +18,6 @@ inline bit::memory::pool_allocator::pool_allocator( std::size_t chunk_size,
   assert( chunk_size >= sizeof(void*) );
   assert( chunk_size >= alignof(void*) );
   assert( chunk_size <= m_block.size() );
-
-  create_pool();
 }
 
 //-----------------------------------------------------------------------------
@@ -33,21 +32,63 @@ inline bit::memory::owner<void*>
 {
   using byte_t = unsigned char;
 
-  auto p = m_freelist.request();
+  auto p = request_chunk();
 
   if( BIT_MEMORY_UNLIKELY(p==nullptr) ) return nullptr;
 
-  auto adjust = std::size_t{};
-  p           = offset_align_forward(p, align, offset+1, &adjust);
+  auto adjust  = std::size_t{};
+  auto* result = offset_align_forward(p, align, offset+1, &adjust);
 
   const auto new_size = (size + 1 + adjust);
 
-  if( BIT_MEMORY_UNLIKELY(new_size > max_size()) ) return nullptr;
+  if( BIT_MEMORY_UNLIKELY(new_size > max_size()) ) {
+    m_freelist.store( p );
+    return nullptr;
+  }
 
   // Store the adjustment made to align correctly
-  *static_cast<byte_t*>(p) = static_cast<byte_t>(adjust);
+  *static_cast<byte_t*>(result) = static_cast<byte_t>(adjust);
 
-  return static_cast<byte_t*>(p) + 1;
+  return static_cast<byte_t*>(result) + 1;
+}
+
+inline std::size_t
+  bit::memory::pool_allocator::try_allocate_n( std::size_t size,
+                                               std::size_t align,
+                                               std::size_t n,
+                                               void** out )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  // Take every recycled chunk needed at once, then bump out the rest
+  auto count = m_freelist.request_n( out, n );
+
+  const auto* end = static_cast<byte_t*>(m_block.end_address());
+  while( count < n && distance(m_current,end) >= m_chunk_size ) {
+    out[count++] = m_current;
+    m_current    = static_cast<byte_t*>(m_current) + m_chunk_size;
+  }
+
+  for( auto i = std::size_t{0}; i < count; ++i ) {
+    auto adjust  = std::size_t{};
+    auto* result = offset_align_forward(out[i], align, 1, &adjust);
+
+    if( BIT_MEMORY_UNLIKELY((size + 1 + adjust) > max_size()) ) {
+      // Return every chunk that could not satisfy the request
+      for( auto j = i; j < count; ++j ) {
+        m_freelist.store( out[j] );
+      }
+      return i;
+    }
+
+    // Store the adjustment made to align correctly
+    *static_cast<byte_t*>(result) = static_cast<byte_t>(adjust);
+
+    out[i] = static_cast<byte_t*>(result) + 1;
+  }
+
+  return count;
 }
 
 inline void bit::memory::pool_allocator::deallocate( owner<void*> p,
@@ -64,10 +105,40 @@ inline void bit::memory::pool_allocator::deallocate( owner<void*> p,
   m_freelist.store( p );
 }
 
+inline void bit::memory::pool_allocator::deallocate_n( void** ptrs,
+                                                       std::size_t n,
+                                                       std::size_t size )
+{
+  BIT_MEMORY_UNUSED(size);
+
+  using byte_t = unsigned char;
+  using pointer = void*;
+
+  if( BIT_MEMORY_UNLIKELY(n == 0) ) return;
+
+  const auto to_chunk = [](void* p) -> void* {
+    p           = static_cast<byte_t*>(p) - 1;
+    auto adjust = static_cast<std::ptrdiff_t>(*static_cast<byte_t*>(p));
+    return static_cast<byte_t*>(p) - adjust;
+  };
+
+  // Link the chunks in order, and splice the chain into the freelist
+  auto* const first = to_chunk( ptrs[0] );
+  auto* last = first;
+
+  for( auto i = std::size_t{1}; i < n; ++i ) {
+    auto* chunk = to_chunk( ptrs[i] );
+    uninitialized_construct_at<pointer>(last,chunk);
+    last = chunk;
+  }
+
+  m_freelist.splice( first, last );
+}
+
 inline void bit::memory::pool_allocator::deallocate_all()
 {
   m_freelist.clear();
-  create_pool();
+  m_current = m_block.data();
 }
 
 //-----------------------------------------------------------------------------
@@ -94,17 +165,29 @@ inline bit::memory::allocator_info bit::memory::pool_allocator::info()
   return {"pool_allocator",this};
 }
 
-void bit::memory::pool_allocator::create_pool()
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+inline void* bit::memory::pool_allocator::request_chunk()
+  noexcept
 {
   using byte_t = unsigned char;
 
-  auto* p = m_block.data();
-  const auto chunks = m_block.size() / m_chunk_size;
+  auto p = m_freelist.request();
+
+  if( p != nullptr ) return p;
 
-  // Store each entry in the freelist in reverse order
-  for( auto i = chunks-1; i != 0; --i ) {
-    m_freelist.store( static_cast<byte_t*>(p) + (i * m_chunk_size) );
+  // Hand out the next chunk that has never been used
+  const auto* end = static_cast<byte_t*>(m_block.end_address());
+  if( BIT_MEMORY_UNLIKELY(distance(m_current,end) < m_chunk_size) ) {
+    return nullptr;
   }
+
+  p         = m_current;
+  m_current = static_cast<byte_t*>(m_current) + m_chunk_size;
+
+  return p;
 }
 
 #endif /* BIT_MEMORY_ALLOCATORS_DETAIL_POOL_ALLOCATOR_INL */
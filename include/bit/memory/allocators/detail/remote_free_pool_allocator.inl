@@ -0,0 +1,195 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_REMOTE_FREE_POOL_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_REMOTE_FREE_POOL_ALLOCATOR_INL
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+inline bit::memory::remote_free_pool_allocator
+  ::remote_free_pool_allocator( std::size_t chunk_size, memory_block block )
+  : m_block(block),
+    m_current(block.data()),
+    m_chunk_size(chunk_size),
+    m_owner(std::this_thread::get_id()),
+    m_remote(nullptr)
+{
+  // It is a requirement that chunk_size is a power-of-2 that is greater
+  // than alignof(void*) and sizeof(void*) -- otherwise the pool would
+  // suffer misalignment issues on the internal freelists
+  assert( is_power_of_two(chunk_size) );
+  assert( chunk_size >= sizeof(void*) );
+  assert( chunk_size >= alignof(void*) );
+  assert( chunk_size <= m_block.size() );
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+inline bit::memory::owner<void*>
+  bit::memory::remote_free_pool_allocator::try_allocate( std::size_t size,
+                                                         std::size_t align,
+                                                         std::size_t offset )
+  noexcept
+{
+  assert( std::this_thread::get_id() == m_owner &&
+          "only the owning thread may allocate" );
+
+  using byte_t = unsigned char;
+
+  auto p = request_chunk();
+
+  if( BIT_MEMORY_UNLIKELY(p==nullptr) ) return nullptr;
+
+  auto adjust  = std::size_t{};
+  auto* result = offset_align_forward(p, align, offset+1, &adjust);
+
+  const auto new_size = (size + 1 + adjust);
+
+  if( BIT_MEMORY_UNLIKELY(new_size > max_size()) ) {
+    m_freelist.store( p );
+    return nullptr;
+  }
+
+  // Store the adjustment made to align correctly
+  *static_cast<byte_t*>(result) = static_cast<byte_t>(adjust);
+
+  return static_cast<byte_t*>(result) + 1;
+}
+
+inline void
+  bit::memory::remote_free_pool_allocator::deallocate( owner<void*> p,
+                                                       std::size_t size )
+{
+  BIT_MEMORY_UNUSED(size);
+
+  using pointer = void*;
+
+  auto* const chunk = chunk_of( p );
+
+  if( BIT_MEMORY_LIKELY(std::this_thread::get_id() == m_owner) ) {
+    m_freelist.store( chunk );
+    return;
+  }
+
+  // Push onto the remote-free queue. The release ordering publishes the
+  // link, along with every write the caller made to the chunk, to the owner
+  auto head = m_remote.load(std::memory_order_relaxed);
+  do {
+    uninitialized_construct_at<pointer>(chunk,head);
+  } while( !m_remote.compare_exchange_weak( head, chunk,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed ) );
+}
+
+inline void bit::memory::remote_free_pool_allocator::deallocate_all()
+{
+  m_freelist.clear();
+  m_remote.store( nullptr, std::memory_order_relaxed );
+  m_current = m_block.data();
+}
+
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::remote_free_pool_allocator::drain_remote_frees()
+  noexcept
+{
+  assert( std::this_thread::get_id() == m_owner &&
+          "only the owning thread may drain remote frees" );
+
+  auto* const first = m_remote.exchange( nullptr, std::memory_order_acquire );
+
+  if( first == nullptr ) return 0u;
+
+  // The chain is already linked; find its end to splice it in whole
+  auto count = std::size_t{1};
+  auto* last = first;
+  for( auto* next = *static_cast<void**>(last); next != nullptr;
+       next = *static_cast<void**>(last) ) {
+    last = next;
+    ++count;
+  }
+
+  m_freelist.splice( first, last );
+
+  return count;
+}
+
+inline void bit::memory::remote_free_pool_allocator::take_ownership()
+  noexcept
+{
+  m_owner = std::this_thread::get_id();
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+inline bool bit::memory::remote_free_pool_allocator::owns( const void* p )
+  const noexcept
+{
+  return m_block.contains(p);
+}
+
+inline std::size_t bit::memory::remote_free_pool_allocator::max_size()
+  const noexcept
+{
+  return m_chunk_size;
+}
+
+inline std::thread::id
+  bit::memory::remote_free_pool_allocator::owning_thread()
+  const noexcept
+{
+  return m_owner;
+}
+
+//-----------------------------------------------------------------------------
+
+inline bit::memory::allocator_info
+  bit::memory::remote_free_pool_allocator::info()
+  const noexcept
+{
+  return {"remote_free_pool_allocator",this};
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+inline void* bit::memory::remote_free_pool_allocator::request_chunk()
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  auto p = m_freelist.request();
+
+  if( p != nullptr ) return p;
+
+  // Recycle chunks freed by other threads before touching fresh memory
+  if( drain_remote_frees() != 0 ) return m_freelist.request();
+
+  // Hand out the next chunk that has never been used
+  const auto* end = static_cast<byte_t*>(m_block.end_address());
+  if( BIT_MEMORY_UNLIKELY(distance(m_current,end) < m_chunk_size) ) {
+    return nullptr;
+  }
+
+  p         = m_current;
+  m_current = static_cast<byte_t*>(m_current) + m_chunk_size;
+
+  return p;
+}
+
+inline void* bit::memory::remote_free_pool_allocator::chunk_of( void* p )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  p           = static_cast<byte_t*>(p) - 1;
+  auto adjust = static_cast<std::ptrdiff_t>(*static_cast<byte_t*>(p));
+
+  return static_cast<byte_t*>(p) - adjust;
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_REMOTE_FREE_POOL_ALLOCATOR_INL */
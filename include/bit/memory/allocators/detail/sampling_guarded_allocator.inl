@@ -0,0 +1,164 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_SAMPLING_GUARDED_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_SAMPLING_GUARDED_ALLOCATOR_INL
+
+//----------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------
+
+template<typename Allocator>
+template<typename...Args, typename>
+inline bit::memory::sampling_guarded_allocator<Allocator>
+  ::sampling_guarded_allocator( std::size_t sample_rate,
+                                std::size_t slots,
+                                Args&&...args )
+  : base_type( std::forward_as_tuple(std::forward<Args>(args)...) ),
+    m_guarded( virtual_memory_page_size(), slots ),
+    m_sample_rate(sample_rate),
+    m_countdown(sample_rate)
+{
+
+}
+
+//----------------------------------------------------------------------------
+// Allocations / Deallocations
+//----------------------------------------------------------------------------
+
+template<typename Allocator>
+inline bit::memory::owner<void*>
+  bit::memory::sampling_guarded_allocator<Allocator>
+  ::try_allocate( std::size_t size, std::size_t align )
+  noexcept
+{
+  using ::bit::memory::get;
+
+  if( BIT_MEMORY_UNLIKELY(m_countdown != 0 && --m_countdown == 0) ) {
+    m_countdown = m_sample_rate;
+
+    if( size <= m_guarded.max_size() && align <= m_guarded.max_size() ) {
+      auto* const p = m_guarded.try_allocate( size, align );
+
+      if( p != nullptr ) {
+        debug_tag_fence_end_bytes( static_cast<unsigned char*>(p) + size,
+                                   slack_of( p, size ) );
+        return p;
+      }
+    }
+  }
+
+  return allocator_traits<Allocator>::try_allocate( get<0>(*this), size, align );
+}
+
+template<typename Allocator>
+inline void bit::memory::sampling_guarded_allocator<Allocator>
+  ::deallocate( owner<void*> p, std::size_t size )
+{
+  using ::bit::memory::get;
+
+  if( BIT_MEMORY_LIKELY(!m_guarded.owns(p)) ) {
+    allocator_traits<Allocator>::deallocate( get<0>(*this), p, size );
+    return;
+  }
+
+  // The slot of a freed allocation is decommitted, so it must not be read
+  if( BIT_MEMORY_UNLIKELY(!m_guarded.is_allocated(p)) ) {
+    (*get_double_delete_handler())( info(), p, static_cast<std::ptrdiff_t>(size) );
+    return;
+  }
+
+  auto stomped = std::size_t{};
+  auto* const end = static_cast<unsigned char*>(p) + size;
+
+  if( auto start = debug_untag_fence_end_bytes( end, slack_of( p, size ), &stomped ) ) {
+    (*get_buffer_overflow_handler())( info(), start, static_cast<std::ptrdiff_t>(stomped) );
+  }
+
+  m_guarded.deallocate( p, size );
+}
+
+//----------------------------------------------------------------------------
+// Sampling
+//----------------------------------------------------------------------------
+
+template<typename Allocator>
+inline void bit::memory::sampling_guarded_allocator<Allocator>
+  ::set_sample_rate( std::size_t rate )
+  noexcept
+{
+  m_sample_rate = rate;
+  m_countdown   = rate;
+}
+
+template<typename Allocator>
+inline std::size_t bit::memory::sampling_guarded_allocator<Allocator>
+  ::sample_rate()
+  const noexcept
+{
+  return m_sample_rate;
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename Allocator>
+inline bool bit::memory::sampling_guarded_allocator<Allocator>
+  ::is_sampled( const void* p )
+  const noexcept
+{
+  return m_guarded.owns(p);
+}
+
+template<typename Allocator>
+inline bit::memory::allocator_info
+  bit::memory::sampling_guarded_allocator<Allocator>::info()
+  const noexcept
+{
+  return {"sampling_guarded_allocator",this};
+}
+
+template<typename Allocator>
+inline typename bit::memory::sampling_guarded_allocator<Allocator>::allocator_type&
+  bit::memory::sampling_guarded_allocator<Allocator>::backing_allocator()
+  noexcept
+{
+  using ::bit::memory::get;
+
+  return get<0>(*this);
+}
+
+template<typename Allocator>
+inline const typename bit::memory::sampling_guarded_allocator<Allocator>::allocator_type&
+  bit::memory::sampling_guarded_allocator<Allocator>::backing_allocator()
+  const noexcept
+{
+  using ::bit::memory::get;
+
+  return get<0>(*this);
+}
+
+template<typename Allocator>
+inline const bit::memory::guard_page_allocator&
+  bit::memory::sampling_guarded_allocator<Allocator>::guarded_allocator()
+  const noexcept
+{
+  return m_guarded;
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename Allocator>
+inline std::size_t bit::memory::sampling_guarded_allocator<Allocator>
+  ::slack_of( void* p, std::size_t size )
+  const noexcept
+{
+  auto* const end   = static_cast<unsigned char*>(p) + size;
+  auto* const guard = static_cast<unsigned char*>(
+    align_forward( end, virtual_memory_page_size() )
+  );
+
+  return static_cast<std::size_t>(guard - end);
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_SAMPLING_GUARDED_ALLOCATOR_INL */
@@ -0,0 +1,209 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_SLAB_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_SLAB_ALLOCATOR_INL
+
+//============================================================================
+// slab_allocator
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructors / Destructor
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+template<typename...Args, typename>
+inline bit::memory::slab_allocator<BlockAllocator>
+  ::slab_allocator( Args&&...args )
+  : base_type( std::forward_as_tuple(std::forward<Args>(args)...) ),
+    m_slabs(),
+    m_classes()
+{
+
+}
+
+template<typename BlockAllocator>
+inline bit::memory::slab_allocator<BlockAllocator>::~slab_allocator()
+{
+  deallocate_all();
+}
+
+//----------------------------------------------------------------------------
+// Allocation / Deallocation
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline bit::memory::owner<void*>
+  bit::memory::slab_allocator<BlockAllocator>
+  ::try_allocate( std::size_t size, std::size_t align )
+  noexcept
+{
+  assert( align <= max_alignment::value && "alignment exceeds max_alignment" );
+  BIT_MEMORY_UNUSED(align);
+
+  using byte_t = unsigned char;
+
+  if( BIT_MEMORY_UNLIKELY(size == 0 || size > max_size()) ) return nullptr;
+
+  const auto index      = size_class_index( size );
+  const auto chunk_size = size_class_size( index );
+  auto& c               = m_classes[index];
+
+  auto p = c.chunks.request();
+  if( p != nullptr ) return p;
+
+  // Hand out the next untouched chunk, requesting a new slab if needed
+  if( BIT_MEMORY_UNLIKELY(c.current == nullptr ||
+                          distance(c.current,c.end) < chunk_size) ) {
+    if( !acquire_slab( c, chunk_size ) ) return nullptr;
+  }
+
+  p         = c.current;
+  c.current = static_cast<byte_t*>(c.current) + chunk_size;
+
+  return p;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline void bit::memory::slab_allocator<BlockAllocator>
+  ::deallocate( owner<void*> p, std::size_t size )
+{
+  assert( size != 0 && size <= max_size() );
+
+  m_classes[size_class_index(size)].chunks.store( p );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline void bit::memory::slab_allocator<BlockAllocator>::deallocate_all()
+{
+  auto& allocator = block_allocator();
+
+  while( !m_slabs.empty() ) {
+    block_allocator_traits<BlockAllocator>::deallocate_block(
+      allocator,
+      m_slabs.request_block()
+    );
+  }
+
+  for( auto& c : m_classes ) {
+    c.chunks.clear();
+    c.current = nullptr;
+    c.end     = nullptr;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline bool bit::memory::slab_allocator<BlockAllocator>
+  ::owns( const void* p )
+  const noexcept
+{
+  return m_slabs.contains( p );
+}
+
+template<typename BlockAllocator>
+inline std::size_t bit::memory::slab_allocator<BlockAllocator>::max_size()
+  const noexcept
+{
+  return size_class_size( size_classes::value - 1 );
+}
+
+template<typename BlockAllocator>
+inline bit::memory::allocator_info
+  bit::memory::slab_allocator<BlockAllocator>::info()
+  const noexcept
+{
+  return {"slab_allocator",this};
+}
+
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline typename bit::memory::slab_allocator<BlockAllocator>::block_allocator_type&
+  bit::memory::slab_allocator<BlockAllocator>::block_allocator()
+  noexcept
+{
+  return get<0>(*this);
+}
+
+template<typename BlockAllocator>
+inline const typename bit::memory::slab_allocator<BlockAllocator>::block_allocator_type&
+  bit::memory::slab_allocator<BlockAllocator>::block_allocator()
+  const noexcept
+{
+  return get<0>(*this);
+}
+
+//----------------------------------------------------------------------------
+// Size Classes
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline std::size_t bit::memory::slab_allocator<BlockAllocator>
+  ::size_class_index( std::size_t size )
+  noexcept
+{
+  assert( size != 0 );
+
+  // The first 4 classes are spaced 16 bytes apart
+  if( size <= 64 ) return (size - 1) >> 4;
+
+  // Every power-of-two range (2^k, 2^(k+1)] above 64 is split into 4 classes
+  // spaced 2^(k-2) bytes apart
+  const auto k = floor_log2(size - 1);
+
+  return ((k - 6) << 2) + ((size - 1) >> (k - 2));
+}
+
+template<typename BlockAllocator>
+inline constexpr std::size_t bit::memory::slab_allocator<BlockAllocator>
+  ::size_class_size( std::size_t index )
+  noexcept
+{
+  return (index < 4) ? ((index + 1) << 4)
+                     : ((std::size_t{64} << ((index - 4) >> 2)) +
+                        (((index & 3u) + 1) << (((index - 4) >> 2) + 4)));
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename BlockAllocator>
+inline bool bit::memory::slab_allocator<BlockAllocator>
+  ::acquire_slab( size_class& c, std::size_t chunk_size )
+{
+  using byte_t = unsigned char;
+
+  auto& allocator = block_allocator();
+
+  // Don't bother requesting a slab that could never fit the chunk
+  const auto next_size = block_allocator_traits<BlockAllocator>
+                         ::next_block_size( allocator );
+  if( BIT_MEMORY_UNLIKELY(header_size::value + chunk_size > next_size) ) {
+    return false;
+  }
+
+  auto block = block_allocator_traits<BlockAllocator>::allocate_block( allocator );
+
+  if( BIT_MEMORY_UNLIKELY(block == nullblock) ) return false;
+
+  // The start of the slab is reserved for the link to the previous slab,
+  // and the first chunk is aligned past it
+  auto* first = static_cast<byte_t*>(block.data()) + sizeof(memory_block);
+
+  m_slabs.store_block( block );
+  c.current = align_forward( first, max_alignment::value );
+  c.end     = block.end_address();
+
+  // A block that is less aligned than the chunks may need more padding than
+  // the header accounts for; the slab is kept until 'deallocate_all'
+  return distance(c.current,c.end) >= chunk_size;
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_SLAB_ALLOCATOR_INL */
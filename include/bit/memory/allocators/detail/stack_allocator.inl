@@ -8,7 +8,8 @@
 template<std::size_t Size, std::size_t Align>
 inline bit::memory::stack_allocator<Size,Align>::stack_allocator()
   noexcept
-  : m_current(&m_storage[0])
+  : m_current(&m_storage[0]),
+    m_last(nullptr)
 {
 
 }
@@ -56,10 +57,30 @@ inline void* bit::memory::stack_allocator<Size,Align>
 
   // bump the pointer
   m_current = p_end;
+  m_last    = byte_ptr;
 
   return byte_ptr;
 }
 
+template<std::size_t Size, std::size_t Align>
+inline bool bit::memory::stack_allocator<Size,Align>
+  ::expand( void* p, std::size_t new_size )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  if( p != m_last ) return false;
+
+  auto* p_end = static_cast<byte_t*>(p) + new_size;
+
+  if( BIT_MEMORY_UNLIKELY( p_end > static_cast<void*>(&m_storage[Size]) ) )
+    return false;
+
+  m_current = p_end;
+
+  return true;
+}
+
 template<std::size_t Size, std::size_t Align>
 inline void bit::memory::stack_allocator<Size,Align>
   ::deallocate( void* p, std::size_t size )
@@ -79,12 +100,40 @@ inline void bit::memory::stack_allocator<Size,Align>
   byte_ptr -= adjust;
 
   m_current = byte_ptr;
+
+  // The start of the allocation before this one is not known
+  m_last = nullptr;
 }
 
 template<std::size_t Size, std::size_t Align>
 inline void bit::memory::stack_allocator<Size,Align>::deallocate_all()
 {
   m_current = static_cast<void*>(&m_storage[0]);
+  m_last    = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Checkpoints
+//-----------------------------------------------------------------------------
+
+template<std::size_t Size, std::size_t Align>
+inline typename bit::memory::stack_allocator<Size,Align>::checkpoint_type
+  bit::memory::stack_allocator<Size,Align>::checkpoint()
+  const noexcept
+{
+  return {m_current};
+}
+
+template<std::size_t Size, std::size_t Align>
+inline void bit::memory::stack_allocator<Size,Align>
+  ::rewind( checkpoint_type marker )
+  noexcept
+{
+  assert( static_cast<void*>(&m_storage[0]) <= marker.current &&
+          marker.current <= static_cast<void*>(&m_storage[Size]) );
+
+  m_current = marker.current;
+  m_last    = nullptr;
 }
 
 //-----------------------------------------------------------------------------
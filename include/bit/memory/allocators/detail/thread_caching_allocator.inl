@@ -0,0 +1,393 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_THREAD_CACHING_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_THREAD_CACHING_ALLOCATOR_INL
+
+//============================================================================
+// thread_caching_allocator::thread_cache_list
+//============================================================================
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::thread_cache_list::~thread_cache_list()
+{
+  while( head != nullptr ) {
+    auto* cache = head;
+    head = cache->next_local;
+
+    {
+      std::lock_guard<std::mutex> lock(registry_mutex());
+
+      // The owning allocator may have been destroyed before this thread
+      // exited, in which case it has already flushed this cache
+      auto* allocator = cache->owner.load(std::memory_order_relaxed);
+      if( allocator != nullptr ) {
+        allocator->flush_cache( *cache );
+        allocator->unregister_cache( *cache );
+      }
+    }
+    delete cache;
+  }
+  last = nullptr;
+}
+
+//============================================================================
+// thread_caching_allocator
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructors / Destructor
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+template<typename...Args, typename>
+inline bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::thread_caching_allocator( Args&&...args )
+  : base_type( std::forward_as_tuple(std::forward<Args>(args)...),
+               std::forward_as_tuple() ),
+    m_caches(nullptr),
+    m_magazine_size(32),
+    m_high_water_mark(64),
+    m_low_water_mark(32)
+{
+
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::~thread_caching_allocator()
+{
+  std::lock_guard<std::mutex> lock(registry_mutex());
+
+  // Caches are left in their thread's list, and are deleted by that thread
+  // the next time it looks up a cache, or when it exits. The cache must not
+  // be touched once its owner is cleared
+  while( m_caches != nullptr ) {
+    auto* cache = m_caches;
+    m_caches = cache->next;
+
+    flush_cache( *cache );
+    cache->owner.store( nullptr, std::memory_order_release );
+  }
+}
+
+//----------------------------------------------------------------------------
+// Allocation / Deallocation
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::owner<void*>
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::try_allocate( std::size_t size, std::size_t align )
+  noexcept
+{
+  assert( align <= max_alignment::value && "alignment exceeds max_alignment" );
+  BIT_MEMORY_UNUSED(align);
+
+  if( BIT_MEMORY_UNLIKELY(size > max_cached_size::value) ) {
+    return allocate_uncached( size, align );
+  }
+
+  const auto index = magazine_cache::size_class_index( size );
+  auto* cache      = local_cache();
+
+  if( BIT_MEMORY_UNLIKELY(cache == nullptr) ) {
+    return allocate_uncached( magazine_cache::size_class_size(index), max_alignment::value );
+  }
+
+  return cache->magazines.request( index,
+                                   get<0>(*this),
+                                   get<1>(*this),
+                                   m_magazine_size );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::deallocate( owner<void*> p, std::size_t size )
+{
+  if( BIT_MEMORY_UNLIKELY(size > max_cached_size::value) ) {
+    deallocate_uncached( p, size );
+    return;
+  }
+
+  const auto index = magazine_cache::size_class_index( size );
+  auto* cache      = local_cache();
+
+  if( BIT_MEMORY_UNLIKELY(cache == nullptr) ) {
+    deallocate_uncached( p, magazine_cache::size_class_size(index) );
+    return;
+  }
+
+  cache->magazines.store( p,
+                          index,
+                          get<0>(*this),
+                          get<1>(*this),
+                          m_high_water_mark,
+                          m_low_water_mark );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::flush_thread_cache()
+{
+  auto* cache = find_local_cache();
+
+  if( cache != nullptr ) flush_cache( *cache );
+}
+
+//----------------------------------------------------------------------------
+// Tuning
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::set_magazine_size( std::size_t size )
+  noexcept
+{
+  assert( size > 0 && "magazine size must be non-zero" );
+
+  m_magazine_size = size;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::set_high_water_mark( std::size_t mark )
+  noexcept
+{
+  assert( mark >= m_low_water_mark && "high water mark must not be below the low water mark" );
+
+  m_high_water_mark = mark;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::set_low_water_mark( std::size_t mark )
+  noexcept
+{
+  assert( mark <= m_high_water_mark && "low water mark must not exceed the high water mark" );
+
+  m_low_water_mark = mark;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::magazine_size()
+  const noexcept
+{
+  return m_magazine_size;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::high_water_mark()
+  const noexcept
+{
+  return m_high_water_mark;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::low_water_mark()
+  const noexcept
+{
+  return m_low_water_mark;
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline std::size_t
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::local_cache_count()
+  noexcept
+{
+  auto count = std::size_t{0};
+
+  for( auto* cache = thread_caches().head; cache != nullptr; cache = cache->next_local ) {
+    ++count;
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::allocator_info
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>::info()
+  const noexcept
+{
+  return {"thread_caching_allocator",this};
+}
+
+template<typename Allocator, typename BasicLockable>
+inline typename bit::memory::thread_caching_allocator<Allocator,BasicLockable>::allocator_type&
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::central_allocator()
+  noexcept
+{
+  return get<0>(*this);
+}
+
+template<typename Allocator, typename BasicLockable>
+inline const typename bit::memory::thread_caching_allocator<Allocator,BasicLockable>::allocator_type&
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::central_allocator()
+  const noexcept
+{
+  return get<0>(*this);
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline typename bit::memory::thread_caching_allocator<Allocator,BasicLockable>::thread_cache*
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>::local_cache()
+  noexcept
+{
+  auto& caches = thread_caches();
+
+  // Fast-path: the same allocator is usually used repeatedly
+  if( BIT_MEMORY_LIKELY(caches.last != nullptr &&
+                        caches.last->owner.load(std::memory_order_relaxed) == this) ) {
+    return caches.last;
+  }
+
+  auto* cache = find_local_cache();
+  if( cache != nullptr ) return cache;
+
+  cache = new (std::nothrow) thread_cache{};
+  if( BIT_MEMORY_UNLIKELY(cache == nullptr) ) return nullptr;
+
+  cache->owner.store( this, std::memory_order_relaxed );
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+
+    cache->next = m_caches;
+    if( m_caches != nullptr ) m_caches->previous = cache;
+    m_caches = cache;
+  }
+
+  cache->next_local = caches.head;
+  caches.head = cache;
+  caches.last = cache;
+
+  return cache;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline typename bit::memory::thread_caching_allocator<Allocator,BasicLockable>::thread_cache*
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::find_local_cache()
+  noexcept
+{
+  auto& caches = thread_caches();
+  auto* link   = &caches.head;
+
+  while( *link != nullptr ) {
+    auto* cache = *link;
+    auto* owner = cache->owner.load(std::memory_order_acquire);
+
+    if( owner == this ) {
+      caches.last = cache;
+      return cache;
+    }
+
+    // Reclaim the caches of destroyed allocators, so that a thread that
+    // outlives many allocators does not accumulate their caches
+    if( owner == nullptr ) {
+      *link = cache->next_local;
+      if( caches.last == cache ) caches.last = nullptr;
+
+      delete cache;
+      continue;
+    }
+    link = &cache->next_local;
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::flush_cache( thread_cache& cache )
+{
+  cache.magazines.flush( get<0>(*this), get<1>(*this) );
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::unregister_cache( thread_cache& cache )
+  noexcept
+{
+  if( cache.previous != nullptr ) {
+    cache.previous->next = cache.next;
+  } else {
+    m_caches = cache.next;
+  }
+  if( cache.next != nullptr ) {
+    cache.next->previous = cache.previous;
+  }
+  cache.owner.store( nullptr, std::memory_order_relaxed );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline bit::memory::owner<void*>
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::allocate_uncached( std::size_t size, std::size_t align )
+  noexcept
+{
+  std::lock_guard<lock_type> lock(get<1>(*this));
+
+  return allocator_traits<Allocator>::try_allocate( get<0>(*this), size, align );
+}
+
+template<typename Allocator, typename BasicLockable>
+inline void bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::deallocate_uncached( owner<void*> p, std::size_t size )
+{
+  std::lock_guard<lock_type> lock(get<1>(*this));
+
+  allocator_traits<Allocator>::deallocate( get<0>(*this), p, size );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Allocator, typename BasicLockable>
+inline std::mutex&
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::registry_mutex()
+  noexcept
+{
+  static std::mutex mutex;
+
+  return mutex;
+}
+
+template<typename Allocator, typename BasicLockable>
+inline typename bit::memory::thread_caching_allocator<Allocator,BasicLockable>::thread_cache_list&
+  bit::memory::thread_caching_allocator<Allocator,BasicLockable>
+  ::thread_caches()
+  noexcept
+{
+  static thread_local thread_cache_list caches;
+
+  return caches;
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_THREAD_CACHING_ALLOCATOR_INL */
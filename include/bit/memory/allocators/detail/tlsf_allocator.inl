@@ -0,0 +1,436 @@
+#ifndef BIT_MEMORY_ALLOCATORS_DETAIL_TLSF_ALLOCATOR_INL
+#define BIT_MEMORY_ALLOCATORS_DETAIL_TLSF_ALLOCATOR_INL
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+inline bit::memory::tlsf_allocator::tlsf_allocator()
+  noexcept
+  : m_blocks(),
+    m_max_size(0),
+    m_fl_bitmap(0),
+    m_sl_bitmap(),
+    m_free_lists()
+{
+
+}
+
+inline bit::memory::tlsf_allocator::tlsf_allocator( memory_block block )
+  noexcept
+  : tlsf_allocator()
+{
+  add_block( block );
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::tlsf_allocator::add_block( memory_block block )
+  noexcept
+{
+  assert( block != nullblock );
+  assert( align_of(block.data()) >= alignof(memory_block) );
+
+  m_blocks.store_block( block );
+
+  initialize_block( block );
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+inline bit::memory::owner<void*>
+  bit::memory::tlsf_allocator::try_allocate( std::size_t size,
+                                             std::size_t align,
+                                             std::size_t offset )
+  noexcept
+{
+  assert( size && "cannot allocate 0 bytes");
+  assert( is_power_of_two(align) && "alignment must be a power of two" );
+
+  using byte_t = unsigned char;
+
+  if( BIT_MEMORY_UNLIKELY(size > m_max_size) ) return nullptr;
+
+  // Blocks are always 16-byte aligned, so any adjustment for an alignment
+  // of 16 or less (offset or not) stays within the first 16 bytes of the
+  // block. Larger alignments request enough slack to split a free block
+  // off the front.
+  const auto inner      = (s_align_size - (offset % s_align_size)) % s_align_size;
+  const auto block_size = (size + inner + s_flag_mask) & ~s_flag_mask;
+  const auto slack      = (align > s_align_size)
+                          ? (align + s_header_size + s_min_block_size)
+                          : std::size_t{0};
+
+  auto* block = request_free_block( block_size + slack );
+
+  if( BIT_MEMORY_UNLIKELY(block == nullptr) ) return nullptr;
+
+  auto* memory = static_cast<byte_t*>(block_memory(block));
+  auto* result = static_cast<byte_t*>(offset_align_forward(memory, align, offset));
+
+  if( BIT_MEMORY_UNLIKELY(slack != 0) ) {
+    auto gap = static_cast<std::size_t>(
+      static_cast<byte_t*>(align_backward(result, s_align_size)) - memory
+    );
+
+    // The leading gap must be large enough to form a block of its own
+    if( gap != 0 && gap < (s_header_size + s_min_block_size) ) {
+      result += align;
+      gap    += align;
+    }
+    if( gap != 0 ) {
+      block = trim_leading( block, gap - s_header_size );
+    }
+  }
+
+  trim_trailing( block, block_size );
+
+  // Mark the block as used
+  block->size &= ~s_free_bit;
+  next_block(block)->size &= ~s_previous_free_bit;
+
+  return result;
+}
+
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::tlsf_allocator::deallocate( owner<void*> p,
+                                                     std::size_t size )
+{
+  BIT_MEMORY_UNUSED(size);
+
+  assert( owns(p) && "pointer must be owned by this allocator" );
+
+  auto* block = block_from_memory( p );
+
+  assert( (block->size & s_free_bit) == 0 && "double free detected" );
+
+  block->size |= s_free_bit;
+
+  // Coalesce with the previous block
+  if( block->size & s_previous_free_bit ) {
+    auto* previous = block->previous;
+
+    remove_free_block( previous );
+    previous->size += s_header_size + block_size(block);
+    block = previous;
+  }
+
+  // Coalesce with the next block
+  auto* next = next_block( block );
+  if( next->size & s_free_bit ) {
+    remove_free_block( next );
+    block->size += s_header_size + block_size(next);
+    next = next_block( block );
+  }
+
+  next->previous = block;
+  next->size    |= s_previous_free_bit;
+
+  insert_free_block( block );
+}
+
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::tlsf_allocator::deallocate_all()
+{
+  auto blocks = memory_block_cache{};
+  blocks.swap( m_blocks );
+
+  m_max_size  = 0;
+  m_fl_bitmap = 0;
+  for( auto& bitmap : m_sl_bitmap ) {
+    bitmap = 0;
+  }
+  for( auto& lists : m_free_lists ) {
+    for( auto& list : lists ) {
+      list = nullptr;
+    }
+  }
+
+  while( !blocks.empty() ) {
+    add_block( blocks.request_block() );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+inline bool bit::memory::tlsf_allocator::owns( const void* p )
+  const noexcept
+{
+  return m_blocks.contains( p );
+}
+
+inline std::size_t bit::memory::tlsf_allocator::max_size()
+  const noexcept
+{
+  return m_max_size;
+}
+
+//-----------------------------------------------------------------------------
+
+inline bit::memory::allocator_info bit::memory::tlsf_allocator::info()
+  const noexcept
+{
+  return {"tlsf_allocator",this};
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::tlsf_allocator::initialize_block( memory_block block )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  // The start of the block is reserved for the link to the previous block
+  auto* start = static_cast<byte_t*>(block.data()) + sizeof(memory_block);
+  start = static_cast<byte_t*>(align_forward(start, s_align_size));
+  auto* end = static_cast<byte_t*>(align_backward(block.end_address(), s_align_size));
+
+  // Room is needed for the block header, the smallest block, and the
+  // sentinel that terminates the block
+  assert( end > start );
+  assert( static_cast<std::size_t>(end - start) >=
+          (2 * s_header_size + s_min_block_size) );
+
+  const auto size = static_cast<std::size_t>(end - start) - 2 * s_header_size;
+
+  assert( size < (std::size_t{1} << s_fl_max) );
+
+  auto* first = static_cast<block_header*>(static_cast<void*>(start));
+  first->previous = nullptr;
+  first->size     = size | s_free_bit;
+
+  // The sentinel is permanently 'used', so it never coalesces
+  auto* sentinel = next_block( first );
+  sentinel->previous = first;
+  sentinel->size     = s_previous_free_bit;
+
+  insert_free_block( first );
+
+  if( size > m_max_size ) m_max_size = size;
+}
+
+//-----------------------------------------------------------------------------
+
+inline bit::memory::tlsf_allocator::block_header*
+  bit::memory::tlsf_allocator::request_free_block( std::size_t size )
+  noexcept
+{
+  auto index  = mapping_search( size );
+  auto sl_map = std::uint32_t{0};
+  auto fl_map = std::uint64_t{0};
+
+  // Search the current first-level list for a second-level list that is
+  // large enough, otherwise take the smallest list of any larger
+  // first-level list
+  if( BIT_MEMORY_LIKELY(index.first < s_fl_count) ) {
+    sl_map = m_sl_bitmap[index.first] & (~std::uint32_t{0} << index.second);
+    fl_map = m_fl_bitmap & (~std::uint64_t{0} << (index.first + 1));
+  }
+
+  if( !sl_map && fl_map ) {
+    index.first = count_trailing_zeros( fl_map );
+    sl_map      = m_sl_bitmap[index.first];
+  }
+
+  block_header* block = nullptr;
+
+  if( BIT_MEMORY_LIKELY(sl_map != 0) ) {
+    index.second = count_trailing_zeros( sl_map );
+    block        = m_free_lists[index.first][index.second];
+  } else {
+    // No list is guaranteed to fit, but the head of the list that 'size'
+    // itself maps to may still be large enough. This is what allows the
+    // largest free block to be allocated in its entirety.
+    index = mapping_insert( size );
+
+    if( BIT_MEMORY_UNLIKELY(index.first >= s_fl_count) ) return nullptr;
+
+    block = m_free_lists[index.first][index.second];
+
+    if( block == nullptr || block_size(block) < size ) return nullptr;
+  }
+
+  remove_free_block( block );
+
+  return block;
+}
+
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::tlsf_allocator::trim_trailing( block_header* block,
+                                                        std::size_t size )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  const auto current_size = block_size( block );
+
+  if( current_size < (size + s_header_size + s_min_block_size) ) return;
+
+  auto* remaining = static_cast<block_header*>(
+    static_cast<void*>(static_cast<byte_t*>(block_memory(block)) + size)
+  );
+  remaining->previous = block;
+  remaining->size     = (current_size - size - s_header_size) | s_free_bit;
+
+  // The block that follows was already marked as following a free block,
+  // since 'block' was free
+  next_block(remaining)->previous = remaining;
+
+  block->size = size | (block->size & s_flag_mask);
+
+  insert_free_block( remaining );
+}
+
+inline bit::memory::tlsf_allocator::block_header*
+  bit::memory::tlsf_allocator::trim_leading( block_header* block,
+                                             std::size_t size )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  const auto current_size = block_size( block );
+
+  assert( current_size >= (size + s_header_size) );
+
+  auto* remaining = static_cast<block_header*>(
+    static_cast<void*>(static_cast<byte_t*>(block_memory(block)) + size)
+  );
+  remaining->previous = block;
+  remaining->size     = (current_size - size - s_header_size) |
+                        s_free_bit | s_previous_free_bit;
+
+  next_block(remaining)->previous = remaining;
+
+  block->size = size | (block->size & s_flag_mask);
+
+  insert_free_block( block );
+
+  return remaining;
+}
+
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::tlsf_allocator::insert_free_block( block_header* block )
+  noexcept
+{
+  const auto index = mapping_insert( block_size(block) );
+
+  auto*& head = m_free_lists[index.first][index.second];
+
+  block->next_free     = head;
+  block->previous_free = nullptr;
+  if( head != nullptr ) {
+    head->previous_free = block;
+  }
+  head = block;
+
+  m_fl_bitmap |= (std::uint64_t{1} << index.first);
+  m_sl_bitmap[index.first] |= (std::uint32_t{1} << index.second);
+}
+
+inline void bit::memory::tlsf_allocator::remove_free_block( block_header* block )
+  noexcept
+{
+  const auto index = mapping_insert( block_size(block) );
+
+  auto*& head = m_free_lists[index.first][index.second];
+
+  auto* previous = block->previous_free;
+  auto* next     = block->next_free;
+
+  if( next != nullptr ) next->previous_free = previous;
+  if( previous != nullptr ) previous->next_free = next;
+
+  if( head == block ) {
+    head = next;
+
+    if( head == nullptr ) {
+      m_sl_bitmap[index.first] &= ~(std::uint32_t{1} << index.second);
+
+      if( m_sl_bitmap[index.first] == 0 ) {
+        m_fl_bitmap &= ~(std::uint64_t{1} << index.first);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Private Static Functions
+//-----------------------------------------------------------------------------
+
+inline bit::memory::tlsf_allocator::list_index
+  bit::memory::tlsf_allocator::mapping_insert( std::size_t size )
+  noexcept
+{
+  if( size < s_small_size ) {
+    return { 0, size / (s_small_size / s_sl_count) };
+  }
+
+  const auto fl = floor_log2( size );
+  const auto sl = (size >> (fl - s_sl_count_log2)) ^ s_sl_count;
+
+  return { fl - (s_fl_shift - 1), sl };
+}
+
+inline bit::memory::tlsf_allocator::list_index
+  bit::memory::tlsf_allocator::mapping_search( std::size_t size )
+  noexcept
+{
+  // Round up to the next list, so that every block in it is large enough
+  if( size >= s_small_size ) {
+    size += (std::size_t{1} << (floor_log2(size) - s_sl_count_log2)) - 1;
+  }
+
+  return mapping_insert( size );
+}
+
+//-----------------------------------------------------------------------------
+
+inline std::size_t
+  bit::memory::tlsf_allocator::block_size( const block_header* block )
+  noexcept
+{
+  return block->size & ~s_flag_mask;
+}
+
+inline void* bit::memory::tlsf_allocator::block_memory( block_header* block )
+  noexcept
+{
+  return static_cast<unsigned char*>(static_cast<void*>(block)) + s_header_size;
+}
+
+inline bit::memory::tlsf_allocator::block_header*
+  bit::memory::tlsf_allocator::block_from_memory( void* p )
+  noexcept
+{
+  // Allocations with an offset may start anywhere in the first 16 bytes of
+  // the block
+  auto* memory = static_cast<unsigned char*>(align_backward(p, s_align_size));
+
+  return static_cast<block_header*>(
+    static_cast<void*>(memory - s_header_size)
+  );
+}
+
+inline bit::memory::tlsf_allocator::block_header*
+  bit::memory::tlsf_allocator::next_block( block_header* block )
+  noexcept
+{
+  return static_cast<block_header*>(
+    static_cast<void*>(static_cast<unsigned char*>(block_memory(block)) +
+                       block_size(block))
+  );
+}
+
+#endif /* BIT_MEMORY_ALLOCATORS_DETAIL_TLSF_ALLOCATOR_INL */
@@ -0,0 +1,464 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for an allocator that defers
+ *        the reclamation of retired memory with epochs
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_EPOCH_RECLAIMING_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_EPOCH_RECLAIMING_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../concepts/Allocator.hpp"     // is_allocator
+#include "../concepts/BasicLockable.hpp" // is_basic_lockable
+
+#include "../traits/allocator_traits.hpp" // allocator_traits
+
+#include "../utilities/allocator_info.hpp" // allocator_info
+#include "../utilities/ebo_storage.hpp"    // ebo_storage
+#include "../utilities/macros.hpp"         // BIT_MEMORY_UNLIKELY
+#include "../utilities/owner.hpp"          // owner
+
+#include <atomic>      // std::atomic
+#include <cassert>     // assert
+#include <cstddef>     // std::size_t
+#include <mutex>       // std::mutex, std::lock_guard, std::unique_lock
+#include <tuple>       // std::forward_as_tuple
+#include <type_traits> // std::enable_if_t
+#include <utility>     // std::forward
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief An allocator that defers returning retired memory to the
+    ///        underlying allocator until no thread can still be reading it
+    ///
+    /// This implements epoch-based reclamation for lock-free data
+    /// structures. Readers bracket every access to shared nodes with
+    /// \c enter_critical and \c exit_critical (or a \c critical_section).
+    /// A node that has been unlinked from the structure is passed to
+    /// \c retire rather than \c deallocate.
+    ///
+    /// Each participating thread has a record that announces the global
+    /// epoch it observed on entering its critical section. Retired nodes
+    /// are placed in the calling thread's limbo list for the current epoch.
+    /// The global epoch only advances once every thread inside a critical
+    /// section has observed the current epoch, so once it has advanced
+    /// twice past a limbo list, no reader can still hold a node from it.
+    /// The whole list is then returned to the underlying allocator in a
+    /// single batch, under a single lock.
+    ///
+    /// Entering and leaving a critical section, and retiring, touch only the
+    /// calling thread's record. Only attempts to advance the epoch, made
+    /// every \c batch_size retirements or through \c reclaim, scan the other
+    /// records, and they never wait to do so.
+    ///
+    /// Paired with a concurrent_pool_allocator and a null_lock, node churn
+    /// in a lock-free structure takes no locks on the common paths.
+    ///
+    /// Readers may still be reading retired memory, so nothing is written
+    /// into it; the limbo lists are kept in separate blocks of entries that
+    /// each thread recycles.
+    ///
+    /// \satisfies{Allocator}
+    ///
+    /// \tparam Allocator the allocator to draw memory from
+    /// \tparam BasicLockable the lock used to guard the underlying allocator
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename Allocator, typename BasicLockable = std::mutex>
+    class epoch_reclaiming_allocator
+      : private ebo_storage<Allocator,BasicLockable>
+    {
+      static_assert( is_allocator<Allocator>::value,
+                     "Allocator must be an Allocator" );
+      static_assert( is_basic_lockable<BasicLockable>::value,
+                     "BasicLockable must be BasicLockable" );
+
+      using base_type = ebo_storage<Allocator,BasicLockable>;
+
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using allocator_type = Allocator;
+      using lock_type      = BasicLockable;
+
+      class critical_section;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an epoch_reclaiming_allocator by forwarding all
+      ///        arguments to the underlying Allocator
+      ///
+      /// \param args the arguments to forward to the underlying Allocator
+      template<typename...Args, typename = std::enable_if_t<std::is_constructible<Allocator,Args...>::value>>
+      explicit epoch_reclaiming_allocator( Args&&...args );
+
+      // Deleted move constructor
+      epoch_reclaiming_allocator( epoch_reclaiming_allocator&& other ) = delete;
+
+      // Deleted copy constructor
+      epoch_reclaiming_allocator( const epoch_reclaiming_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Destructs this allocator, returning every retired allocation
+      ///        to the underlying allocator
+      ///
+      /// \note No other thread may be using this allocator while it is being
+      ///       destroyed
+      ~epoch_reclaiming_allocator();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      epoch_reclaiming_allocator& operator=( epoch_reclaiming_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      epoch_reclaiming_allocator& operator=( const epoch_reclaiming_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size, std::size_t align ) noexcept;
+
+      /// \brief Deallocates memory immediately
+      ///
+      /// This must only be used for memory that no other thread can be
+      /// reading, such as a node that was never published. Use \c retire
+      /// otherwise.
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate( owner<void*> p, std::size_t size );
+
+      //-----------------------------------------------------------------------
+      // Reclamation
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Enters a critical section on the calling thread
+      ///
+      /// Memory retired by any thread after this call will not be
+      /// deallocated until the matching \c exit_critical. Critical sections
+      /// may be nested.
+      ///
+      /// \note The first call on each thread allocates the thread's record,
+      ///       and may throw \c std::bad_alloc
+      void enter_critical();
+
+      /// \brief Exits a critical section previously entered on the calling
+      ///        thread
+      void exit_critical() noexcept;
+
+      /// \brief Retires memory that has been unlinked from a shared
+      ///        structure, so that it is deallocated once no thread can
+      ///        still be reading it
+      ///
+      /// \note This may throw \c std::bad_alloc if the calling thread needs
+      ///       a new block for its limbo list
+      ///
+      /// \param p the pointer to the memory to retire
+      /// \param size the size of the memory previously provided to try_allocate
+      void retire( owner<void*> p, std::size_t size );
+
+      /// \brief Tries to advance the epoch, and deallocates every allocation
+      ///        retired by the calling thread that has become safe to free
+      ///
+      /// \return the number of allocations that were deallocated
+      std::size_t reclaim();
+
+      //-----------------------------------------------------------------------
+      // Tuning
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Sets the number of retirements on a thread between attempts
+      ///        to advance the epoch
+      ///
+      /// \note This must not be changed while other threads are using this
+      ///       allocator
+      ///
+      /// \param size the number of retirements per attempt
+      void set_batch_size( std::size_t size ) noexcept;
+
+      /// \brief Gets the number of retirements on a thread between attempts
+      ///        to advance the epoch
+      ///
+      /// \return the batch size
+      std::size_t batch_size() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the current global epoch
+      ///
+      /// \return the epoch
+      std::size_t epoch() const noexcept;
+
+      /// \brief Gets the number of allocations retired by the calling thread
+      ///        that have not yet been deallocated
+      ///
+      /// \return the number of pending retirements
+      std::size_t pending() noexcept;
+
+      /// \brief Gets the number of records held by the calling thread across
+      ///        every epoch_reclaiming_allocator of this type
+      ///
+      /// The records of destroyed allocators are reclaimed the next time the
+      /// thread switches to another allocator, so this does not grow with
+      /// the number of allocators that the thread outlives
+      ///
+      /// \return the number of records held by the calling thread
+      static std::size_t local_record_count() noexcept;
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'epoch_reclaiming_allocator'. Use a
+      /// named_epoch_reclaiming_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      /// \brief Gets a reference to the underlying allocator
+      ///
+      /// \note Accessing the underlying allocator is not synchronized
+      ///
+      /// \return reference to the underlying allocator
+      allocator_type& backing_allocator() noexcept;
+
+      /// \copydoc backing_allocator()
+      const allocator_type& backing_allocator() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      /// The number of limbo lists; a list may be freed two epochs after
+      /// it was filled, so the third is the one being filled
+      static constexpr std::size_t limbo_lists = 3;
+
+      /// \brief A single retired allocation
+      struct retired_entry
+      {
+        void*       pointer;
+        std::size_t size;
+      };
+
+      /// \brief A block of retired allocations in a limbo list
+      struct limbo_block
+      {
+        static constexpr std::size_t capacity = 62;
+
+        limbo_block*  next  = nullptr;
+        std::size_t   count = 0;
+        retired_entry entries[capacity];
+      };
+
+      /// \brief The memory retired by a thread during one epoch
+      struct limbo_list
+      {
+        limbo_block* head  = nullptr; ///< The block being filled
+        std::size_t  epoch = 0;
+        std::size_t  count = 0;
+      };
+
+      /// \brief The record of a single thread for a single allocator
+      struct thread_record
+      {
+        std::atomic<epoch_reclaiming_allocator*> owner;
+
+        /// (epoch << 1) | 1 while in a critical section; 0 otherwise
+        std::atomic<std::size_t> state{0u};
+
+        thread_record* next       = nullptr; ///< next record of the allocator
+        thread_record* previous   = nullptr; ///< previous record of the allocator
+        thread_record* next_local = nullptr; ///< next record of the thread
+        std::size_t    nesting    = 0;
+        std::size_t    retired    = 0; ///< retirements since the last attempt
+        limbo_block*   spare      = nullptr; ///< emptied blocks to reuse
+        limbo_list     limbo[limbo_lists];
+      };
+
+      /// \brief Every record owned by a thread, orphaned when the thread
+      ///        exits
+      struct thread_record_list
+      {
+        thread_record* head = nullptr;
+        thread_record* last = nullptr; ///< the most recently used record
+
+        ~thread_record_list();
+      };
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      std::atomic<std::size_t> m_epoch;
+      thread_record*           m_records;
+      limbo_list               m_orphans; ///< Limbo of exited threads
+      std::size_t              m_batch_size;
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Gets the record of the calling thread, creating it if needed
+      thread_record& local_record();
+
+      /// \brief Finds the record of the calling thread without creating one,
+      ///        deleting any records of destroyed allocators on the way
+      ///
+      /// \return the record, or \c nullptr if the thread has none
+      thread_record* find_local_record() noexcept;
+
+      /// \brief Advances the epoch if every thread in a critical section has
+      ///        observed it, and collects the orphaned limbo if it is safe
+      ///
+      /// This never waits for the registry; if it is busy, nothing happens
+      ///
+      /// \param orphans set to the orphaned limbo that is now safe to free
+      void try_advance( limbo_list& orphans ) noexcept;
+
+      /// \brief Deallocates every limbo list of \p record that is safe
+      ///
+      /// \return the number of allocations that were deallocated
+      std::size_t collect( thread_record& record );
+
+      /// \brief Returns every allocation in \p list to the underlying
+      ///        allocator in a single batch
+      ///
+      /// The emptied blocks are kept as spares of \p record, or deleted if
+      /// \p record is \c nullptr
+      ///
+      /// \return the number of allocations that were deallocated
+      std::size_t release_list( limbo_list& list, thread_record* record );
+
+      /// \brief Moves the limbo of the exiting \p record into the orphans
+      ///
+      /// \pre The registry mutex must be held
+      void orphan_record( thread_record& record ) noexcept;
+
+      /// \brief Removes \p record from this allocator's list of records
+      ///
+      /// \pre The registry mutex must be held
+      void unregister_record( thread_record& record ) noexcept;
+
+      /// \brief Deletes \p record along with its spare limbo blocks
+      static void destroy_record( thread_record* record ) noexcept;
+
+      /// \brief Gets the mutex guarding the registration of thread records
+      static std::mutex& registry_mutex() noexcept;
+
+      /// \brief Gets the records of the calling thread
+      static thread_record_list& thread_records() noexcept;
+    };
+
+    //=========================================================================
+    // epoch_reclaiming_allocator::critical_section
+    //=========================================================================
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A scoped critical section of an epoch_reclaiming_allocator
+    ///
+    /// The critical section is entered on construction, and exited on
+    /// destruction
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename Allocator, typename BasicLockable>
+    class epoch_reclaiming_allocator<Allocator,BasicLockable>::critical_section
+    {
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Enters a critical section of \p allocator
+      ///
+      /// \param allocator the allocator to enter the critical section of
+      explicit critical_section( epoch_reclaiming_allocator& allocator );
+
+      // Deleted move constructor
+      critical_section( critical_section&& other ) = delete;
+
+      // Deleted copy constructor
+      critical_section( const critical_section& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Exits the critical section
+      ~critical_section();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      critical_section& operator=( critical_section&& other ) = delete;
+
+      // Deleted copy assignment
+      critical_section& operator=( const critical_section& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      epoch_reclaiming_allocator& m_allocator;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    template<typename Allocator, typename BasicLockable = std::mutex>
+    using named_epoch_reclaiming_allocator
+      = detail::named_allocator<epoch_reclaiming_allocator<Allocator,BasicLockable>>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/epoch_reclaiming_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_EPOCH_RECLAIMING_ALLOCATOR_HPP */
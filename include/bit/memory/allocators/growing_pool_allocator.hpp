@@ -0,0 +1,283 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a pool allocator that grows
+ *        by requesting new slabs from a BlockAllocator
+ *****************************************************************************/
+
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_GROWING_POOL_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_GROWING_POOL_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../concepts/BlockAllocator.hpp" // is_block_allocator
+
+#include "../traits/block_allocator_traits.hpp" // block_allocator_traits
+
+#include "../utilities/allocator_info.hpp"    // allocator_info
+#include "../utilities/ebo_storage.hpp"       // ebo_storage
+#include "../utilities/freelist.hpp"          // freelist
+#include "../utilities/macros.hpp"            // BIT_MEMORY_UNLIKELY
+#include "../utilities/memory_block.hpp"      // memory_block
+#include "../utilities/owner.hpp"             // owner
+#include "../utilities/pointer_utilities.hpp" // offset_align_forward
+
+#include <cassert>     // assert
+#include <cstddef>     // std::size_t, std::max_align_t
+#include <new>         // placement new
+#include <tuple>       // std::forward_as_tuple
+#include <type_traits> // std::integral_constant, std::enable_if_t
+#include <utility>     // std::forward
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A pool of fixed-sized chunks that grows by requesting new slabs
+    ///        from a BlockAllocator on demand
+    ///
+    /// Each slab works like a pool_allocator: chunks that have never been
+    /// used are bumped out of the slab, and freed chunks are recycled through
+    /// the slab's own freelist. Allocations are made from the first slab
+    /// that still has a free chunk, and a new slab is only requested once
+    /// every slab is full.
+    ///
+    /// Every slab keeps a count of its allocated chunks in a header at the
+    /// front of its block. Once a slab becomes entirely free, it is returned
+    /// to the BlockAllocator -- unless it is the only slab left with a free
+    /// chunk, which avoids requesting and returning a block on every
+    /// allocation at the boundary of a slab.
+    ///
+    /// If every block from the BlockAllocator is aligned to its own size,
+    /// and all blocks have the same size (such as from an
+    /// aligned_block_allocator), the slab of a chunk is found in O(1) on
+    /// deallocation. Otherwise the slabs are searched in O(slabs).
+    ///
+    /// \satisfies{ExtendedAllocator}
+    ///
+    /// \tparam BlockAllocator the block allocator to request slabs from
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename BlockAllocator>
+    class growing_pool_allocator
+      : private ebo_storage<BlockAllocator>
+    {
+      static_assert( is_block_allocator<BlockAllocator>::value,
+                     "BlockAllocator must be a BlockAllocator" );
+
+      using base_type = ebo_storage<BlockAllocator>;
+
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using block_allocator_type = BlockAllocator;
+
+      /// The max alignment is limited to 128 bytes due to an internal
+      /// requirement that it stores the offset information
+      using max_alignment = std::integral_constant<std::size_t,128>;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a growing_pool_allocator with chunk sizes of
+      ///        \p chunk_size, forwarding all other arguments to the
+      ///        underlying BlockAllocator
+      ///
+      /// No slabs are requested until the first allocation
+      ///
+      /// \param chunk_size the size of each entry in the pool allocator
+      /// \param args the arguments to forward to the BlockAllocator
+      template<typename...Args, typename = std::enable_if_t<std::is_constructible<BlockAllocator,Args...>::value>>
+      explicit growing_pool_allocator( std::size_t chunk_size, Args&&...args );
+
+      // Deleted move constructor
+      growing_pool_allocator( growing_pool_allocator&& other ) = delete;
+
+      // Deleted copy constructor
+      growing_pool_allocator( const growing_pool_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Destructs this growing_pool_allocator, returning every slab
+      ///        to the underlying BlockAllocator
+      ~growing_pool_allocator();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      growing_pool_allocator& operator=( growing_pool_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      growing_pool_allocator& operator=( const growing_pool_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align,
+      ///        offset by \p offset
+      ///
+      /// If no slab has a free chunk, a new slab is requested from the
+      /// underlying BlockAllocator
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \param offset the amount to offset the alignment
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size,
+                                 std::size_t align,
+                                 std::size_t offset = 0 ) noexcept;
+
+      /// \brief Deallocates memory previously allocated from a call to
+      ///        \c try_allocate
+      ///
+      /// If this leaves the slab entirely free, the slab may be returned to
+      /// the underlying BlockAllocator
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate( owner<void*> p, std::size_t size );
+
+      /// \brief Deallocates all memory in this growing_pool_allocator,
+      ///        returning every slab to the underlying BlockAllocator
+      void deallocate_all();
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Determines whether the pointer \p p is owned by this allocator
+      ///
+      /// \note This is O(slabs)
+      ///
+      /// \return \c true if the pointer \p p is originally from this allocator
+      bool owns( const void* p ) const noexcept;
+
+      /// \brief Determines the max size that this allocator can allocate
+      ///
+      /// \return the max size
+      std::size_t max_size() const noexcept;
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'growing_pool_allocator'. Use a
+      /// named_growing_pool_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Gets the number of slabs currently in use by this allocator
+      ///
+      /// \return the number of slabs
+      std::size_t slabs() const noexcept;
+
+      /// \brief Gets a reference to the underlying block allocator
+      ///
+      /// \return reference to the block allocator
+      block_allocator_type& block_allocator() noexcept;
+
+      /// \copydoc block_allocator()
+      const block_allocator_type& block_allocator() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      /// The bookkeeping for a slab, stored at the front of its block
+      struct slab
+      {
+        memory_block block;          ///< The block from the BlockAllocator
+        slab*        previous;       ///< The previous slab
+        slab*        next;           ///< The next slab
+        slab*        previous_free;  ///< The previous slab with a free chunk
+        slab*        next_free;      ///< The next slab with a free chunk
+        freelist     chunks;         ///< The recycled chunks
+        void*        current;        ///< The first chunk never used
+        void*        end;            ///< The end of the last chunk
+        std::size_t  allocated;      ///< The number of allocated chunks
+      };
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      slab*       m_slabs;      ///< Every slab
+      slab*       m_free_slabs; ///< The slabs with a free chunk
+      std::size_t m_slab_count; ///< The number of slabs
+      std::size_t m_slab_align; ///< The size every slab is aligned to, or 0
+      std::size_t m_chunk_size; ///< The size of each chunk
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Requests a new slab from the block allocator, making it the
+      ///        first slab with a free chunk
+      ///
+      /// \return the slab, or \c nullptr on failure
+      slab* acquire_slab();
+
+      /// \brief Returns the slab \p s to the block allocator
+      void release_slab( slab* s );
+
+      /// \brief Finds the slab that contains \p p
+      slab* find_slab( const void* p ) const noexcept;
+
+      /// \brief Links \p s into the list of slabs with a free chunk
+      void push_free_slab( slab* s ) noexcept;
+
+      /// \brief Unlinks \p s from the list of slabs with a free chunk
+      void remove_free_slab( slab* s ) noexcept;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    template<typename BlockAllocator>
+    using named_growing_pool_allocator
+      = detail::named_allocator<growing_pool_allocator<BlockAllocator>>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/growing_pool_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_GROWING_POOL_ALLOCATOR_HPP */
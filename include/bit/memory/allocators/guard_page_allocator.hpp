@@ -0,0 +1,265 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for an allocator that places
+ *        every allocation against an inaccessible guard page
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_GUARD_PAGE_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_GUARD_PAGE_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../regions/virtual_memory.hpp" // virtual_memory_reserve, etc
+
+#include "../utilities/allocator_info.hpp"    // allocator_info
+#include "../utilities/errors.hpp"            // get_double_delete_handler
+#include "../utilities/macros.hpp"            // BIT_MEMORY_UNLIKELY
+#include "../utilities/owner.hpp"             // owner
+#include "../utilities/pointer_utilities.hpp" // align_backward
+
+#include <cassert>     // assert
+#include <cstddef>     // std::size_t
+#include <type_traits> // std::integral_constant
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Which end of an allocation is placed against a guard page
+    ///////////////////////////////////////////////////////////////////////////
+    enum class guard_page_alignment
+    {
+      overflow,  ///< The end of each allocation abuts the following guard
+                 ///< page, catching reads and writes past the end
+      underflow, ///< The start of each allocation abuts the preceding guard
+                 ///< page, catching reads and writes before the start
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief An allocator that places each allocation in its own slot of
+    ///        virtual memory, against a page that is never committed
+    ///
+    /// Any access past the guarded end of an allocation faults immediately
+    /// in hardware, so this detects buffer overflows (or underflows) with
+    /// no cost on access and no fence checking on deallocation.
+    ///
+    /// Each slot is separated from the next by a guard page, and is
+    /// decommitted when its allocation is deallocated, so that any use
+    /// after free also faults. Free slots are reused in the order they are
+    /// freed, which keeps freed memory inaccessible for as long as possible.
+    /// Deallocating a slot that is already free is reported to the
+    /// double-delete handler.
+    ///
+    /// When guarding against overflow, the end of an allocation can only be
+    /// placed as close to the guard page as its alignment allows; so an
+    /// overflow of fewer than \c align bytes may go undetected.
+    ///
+    /// Since every allocation costs at least two pages of address space,
+    /// this allocator is intended for debugging and for canary deployments,
+    /// rather than general use.
+    ///
+    /// \satisfies{Allocator}
+    ///////////////////////////////////////////////////////////////////////////
+    class guard_page_allocator
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      /// Allocations are aligned to at most one virtual page
+      using max_alignment = std::integral_constant<std::size_t,4096>;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a guard_page_allocator with \p slots slots, each
+      ///        able to hold an allocation of up to \p max_size bytes
+      ///
+      /// \param max_size the largest allocation size
+      /// \param slots the number of concurrent allocations
+      /// \param alignment which end of each allocation is guarded
+      guard_page_allocator( std::size_t max_size,
+                            std::size_t slots,
+                            guard_page_alignment alignment = guard_page_alignment::overflow );
+
+      /// \brief Move-constructs the guard_page_allocator from another
+      ///        allocator
+      ///
+      /// \param other the other allocator to move
+      guard_page_allocator( guard_page_allocator&& other ) noexcept;
+
+      // Deleted copy construction
+      guard_page_allocator( const guard_page_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Releases all virtual memory reserved by this allocator
+      ~guard_page_allocator();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      guard_page_allocator& operator=( guard_page_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      guard_page_allocator& operator=( const guard_page_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align
+      ///
+      /// \pre \p align does not exceed the virtual page size
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size, std::size_t align ) noexcept;
+
+      /// \brief Deallocates memory previously allocated from a call to
+      ///        \c try_allocate, decommitting its pages
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate( owner<void*> p, std::size_t size );
+
+      /// \brief Deallocates all memory in this guard_page_allocator, and
+      ///        decommits every slot
+      void deallocate_all();
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Determines whether the pointer \p p is owned by this allocator
+      ///
+      /// \return \c true if the pointer \p p is originally from this allocator
+      bool owns( const void* p ) const noexcept;
+
+      /// \brief Determines whether the slot containing \p p is currently
+      ///        allocated
+      ///
+      /// \pre \c owns(p)
+      ///
+      /// \param p the pointer to check
+      /// \return \c true if \p p is within a live allocation's slot
+      bool is_allocated( const void* p ) const noexcept;
+
+      /// \brief Determines the max size that this allocator can allocate
+      ///
+      /// \return the size of each slot, in bytes
+      std::size_t max_size() const noexcept;
+
+      /// \brief Gets the number of slots in this allocator
+      ///
+      /// \return the number of slots
+      std::size_t capacity() const noexcept;
+
+      /// \brief Gets the number of slots that are currently allocated
+      ///
+      /// \return the number of allocated slots
+      std::size_t size() const noexcept;
+
+      /// \brief Gets which end of each allocation is guarded
+      ///
+      /// \return the guard page alignment
+      guard_page_alignment alignment() const noexcept;
+
+      //----------------------------------------------------------------------
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'guard_page_allocator'. Use a
+      /// named_guard_page_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      void*                m_memory;         ///< The reserved slots and guards
+      std::size_t          m_slot_pages;     ///< Pages in each slot
+      std::size_t          m_slots;          ///< The number of slots
+      guard_page_alignment m_alignment;      ///< Which end is guarded
+
+      void*                m_metadata;       ///< Memory for the bookkeeping
+      std::size_t          m_metadata_pages; ///< Pages of bookkeeping
+      std::size_t*         m_free;           ///< Ring of free slot indices
+      unsigned char*       m_allocated;      ///< Whether each slot is in use
+      std::size_t          m_free_head;      ///< The oldest free slot in m_free
+      std::size_t          m_free_count;     ///< The number of free slots
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Gets the total number of pages reserved for the slots
+      std::size_t reserved_pages() const noexcept;
+
+      /// \brief Gets the address of the first page of the slot \p index
+      unsigned char* slot_address( std::size_t index ) const noexcept;
+
+      /// \brief Gets the index of the slot containing \p p
+      std::size_t slot_of( const void* p ) const noexcept;
+
+      /// \brief Gets the committed pages [first, last) that hold the
+      ///        allocation \p p of \p size bytes
+      void pages_of( void* p,
+                     std::size_t size,
+                     unsigned char** first,
+                     unsigned char** last ) const noexcept;
+
+      /// \brief Marks every slot as free, in address order
+      void reset_slots() noexcept;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    using named_guard_page_allocator
+      = detail::named_allocator<guard_page_allocator>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/guard_page_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_GUARD_PAGE_ALLOCATOR_HPP */
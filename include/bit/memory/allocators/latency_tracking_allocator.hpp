@@ -0,0 +1,341 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for an allocator that times
+ *        the allocations and deallocations of another allocator
+ *****************************************************************************/
+
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_LATENCY_TRACKING_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_LATENCY_TRACKING_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../concepts/Allocator.hpp"         // is_allocator, etc
+#include "../concepts/ExtendedAllocator.hpp" // is_extended_allocator, etc
+
+#include "../policies/trackers/latency_tracker.hpp" // latency_tracker
+
+#include "../traits/allocator_traits.hpp" // allocator_traits
+
+#include "../utilities/allocator_info.hpp" // allocator_info
+#include "../utilities/ebo_storage.hpp"    // ebo_storage
+#include "../utilities/owner.hpp"          // owner
+
+#include <cstddef>     // std::size_t
+#include <tuple>       // std::forward_as_tuple
+#include <type_traits> // std::enable_if_t, std::is_constructible
+#include <utility>     // std::forward
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief An allocator that times every allocation and deallocation of
+    ///        the underlying Allocator, and reports the latencies to a
+    ///        LatencyTracker
+    ///
+    /// This is intended for measuring what a policy_allocator costs on the
+    /// hot path, including its tail latency. The time is read from the
+    /// LatencyTracker's \c clock_type immediately before and after each call
+    /// to the underlying Allocator, so the latencies include any locking,
+    /// tracking and bounds-checking of a policy_allocator.
+    ///
+    /// Composing this with the \c null_latency_tracker disables the timing
+    /// entirely; the clock is never read, and the tracker takes no space.
+    ///
+    /// Every optional member of the underlying Allocator, such as
+    /// \c deallocate_all, \c owns or \c expand, is forwarded when it
+    /// exists, so that timing an allocator does not change what it can be
+    /// used for. Only allocations and deallocations are timed.
+    ///
+    /// A LatencyTracker must provide:
+    /// - \c clock_type, with a static \c now() that returns an unsigned
+    ///   \c clock_type::rep
+    /// - \c on_allocate_latency(clock_type::rep)
+    /// - \c on_deallocate_latency(clock_type::rep)
+    ///
+    /// \note This allocator is only as synchronized as its Allocator and
+    ///       LatencyTracker. The tracker is notified outside of any lock the
+    ///       Allocator takes, so it must be safe to notify from multiple
+    ///       threads if the Allocator is shared; the default
+    ///       \c latency_tracker is.
+    ///
+    /// \satisfies{Allocator}
+    ///
+    /// \tparam Allocator the allocator to time
+    /// \tparam LatencyTracker the tracker to report the latencies to
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename Allocator, typename LatencyTracker = latency_tracker>
+    class latency_tracking_allocator
+      : private ebo_storage<Allocator,LatencyTracker>
+    {
+      static_assert( is_allocator<Allocator>::value,
+                     "Allocator must be an Allocator" );
+
+      using base_type = ebo_storage<Allocator,LatencyTracker>;
+
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using allocator_type = Allocator;
+      using tracker_type   = LatencyTracker;
+      using clock_type     = typename LatencyTracker::clock_type;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a latency_tracking_allocator by forwarding
+      ///        \p args to the underlying Allocator
+      ///
+      /// \param args the arguments to forward to the underlying Allocator
+      template<typename...Args, typename = std::enable_if_t<std::is_constructible<Allocator,Args...>::value>>
+      explicit latency_tracking_allocator( Args&&...args );
+
+      /// \brief Move-constructs a latency_tracking_allocator from another
+      ///        allocator
+      ///
+      /// \param other the other allocator to move
+      latency_tracking_allocator( latency_tracking_allocator&& other ) = default;
+
+      // Deleted copy constructor
+      latency_tracking_allocator( const latency_tracking_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      latency_tracking_allocator& operator=( latency_tracking_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      latency_tracking_allocator& operator=( const latency_tracking_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align,
+      ///        recording how long the underlying allocator took
+      ///
+      /// Failed allocations are recorded as well, since they are paid for
+      /// on the hot path all the same
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size, std::size_t align ) noexcept;
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align
+      ///        offset by \p offset, recording how long the underlying
+      ///        allocator took
+      ///
+      /// \note This function is only enabled if the underlying Allocator
+      ///       is an ExtendedAllocator
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \param offset the offset of the alignment
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      template<typename U = Allocator, typename = std::enable_if_t<is_extended_allocator<U>::value>>
+      owner<void*> try_allocate( std::size_t size,
+                                 std::size_t align,
+                                 std::size_t offset ) noexcept;
+
+      /// \brief Allocates \p size bytes with the alignment of \p align,
+      ///        recording how long the underlying allocator took
+      ///
+      /// \note This function is only enabled if the underlying Allocator
+      ///       supports it
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \return pointer to the allocated memory
+      template<typename U = Allocator, typename = std::enable_if_t<allocator_has_allocate<U>::value>>
+      owner<void*> allocate( std::size_t size, std::size_t align );
+
+      /// \brief Allocates \p size bytes with the alignment of \p align
+      ///        offset by \p offset, recording how long the underlying
+      ///        allocator took
+      ///
+      /// \note This function is only enabled if the underlying Allocator
+      ///       supports it
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \param offset the offset of the alignment
+      /// \return pointer to the allocated memory
+      template<typename U = Allocator, typename = std::enable_if_t<allocator_has_extended_allocate<U>::value>>
+      owner<void*> allocate( std::size_t size,
+                             std::size_t align,
+                             std::size_t offset );
+
+      /// \brief Tries to make \p n allocations of \p size bytes with the
+      ///        alignment of \p align, recording how long the underlying
+      ///        allocator took for the whole batch
+      ///
+      /// \note This function is only enabled if the underlying Allocator
+      ///       supports it
+      ///
+      /// \param size the size of each allocation
+      /// \param align the alignment of each allocation
+      /// \param n the number of allocations to make
+      /// \param out the array to write the allocations to
+      /// \return the number of allocations written to \p out
+      template<typename U = Allocator, typename = std::enable_if_t<allocator_has_try_allocate_n<U>::value>>
+      std::size_t try_allocate_n( std::size_t size,
+                                  std::size_t align,
+                                  std::size_t n,
+                                  void** out ) noexcept;
+
+      /// \brief Attempts to expand the allocation \p p in place to
+      ///        \p new_size bytes
+      ///
+      /// \note This function is only enabled if the underlying Allocator
+      ///       supports it
+      ///
+      /// \param p the pointer to the allocation to expand
+      /// \param new_size the new size of the allocation
+      /// \return \c true if the allocation was expanded
+      template<typename U = Allocator, typename = std::enable_if_t<allocator_has_expand<U>::value>>
+      bool expand( void* p, std::size_t new_size ) noexcept;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Deallocates memory previously allocated from a call to
+      ///        \c try_allocate, recording how long the underlying allocator
+      ///        took
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate( owner<void*> p, std::size_t size );
+
+      /// \brief Deallocates the \p n pointers in \p ptrs, each with the
+      ///        size \p size, recording how long the underlying allocator
+      ///        took for the whole batch
+      ///
+      /// \note This function is only enabled if the underlying Allocator
+      ///       supports it
+      ///
+      /// \param ptrs the pointers to deallocate
+      /// \param n the number of pointers in \p ptrs
+      /// \param size the size originally requested to 'try_allocate_n'
+      template<typename U = Allocator, typename = std::enable_if_t<allocator_has_deallocate_n<U>::value>>
+      void deallocate_n( void** ptrs, std::size_t n, std::size_t size );
+
+      /// \brief Deallocates all memory in the underlying allocator
+      ///
+      /// \note This function is only enabled if the underlying Allocator
+      ///       supports it
+      template<typename U = Allocator, typename = std::enable_if_t<allocator_can_truncate_deallocations<U>::value>>
+      void deallocate_all();
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Checks if \p p is owned by the underlying allocator
+      ///
+      /// \note This function is only enabled if the underlying Allocator
+      ///       supports it
+      ///
+      /// \param p the pointer to check
+      /// \return \c true if \p p is owned by this allocator
+      template<typename U = Allocator, typename = std::enable_if_t<allocator_knows_ownership<U>::value>>
+      bool owns( const void* p ) const noexcept;
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to the info of the underlying allocator, so that
+      /// diagnostics name the allocator being timed. Use a
+      /// named_latency_tracking_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Gets the maximum size allocateable from the underlying
+      ///        allocator
+      ///
+      /// \note This function is only enabled if the underlying Allocator
+      ///       supports it
+      ///
+      /// \return the amount of bytes available for the largest possible
+      ///         allocation
+      template<typename U = Allocator, typename = std::enable_if_t<allocator_has_max_size<U>::value>>
+      std::size_t max_size() const noexcept;
+
+      /// \brief Gets the minimum size allocateable from the underlying
+      ///        allocator
+      ///
+      /// \note This function is only enabled if the underlying Allocator
+      ///       supports it
+      ///
+      /// \return the minimum amount of bytes able to allocated
+      template<typename U = Allocator, typename = std::enable_if_t<allocator_has_min_size<U>::value>>
+      std::size_t min_size() const noexcept;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Gets a reference to the underlying allocator
+      ///
+      /// \return reference to the underlying allocator
+      allocator_type& backing_allocator() noexcept;
+
+      /// \copydoc backing_allocator()
+      const allocator_type& backing_allocator() const noexcept;
+
+      /// \brief Gets a reference to the latency tracker
+      ///
+      /// \return reference to the tracker
+      tracker_type& tracker() noexcept;
+
+      /// \copydoc tracker()
+      const tracker_type& tracker() const noexcept;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    template<typename Allocator, typename LatencyTracker = latency_tracker>
+    using named_latency_tracking_allocator
+      = detail::named_allocator<latency_tracking_allocator<Allocator,LatencyTracker>>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/latency_tracking_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_LATENCY_TRACKING_ALLOCATOR_HPP */
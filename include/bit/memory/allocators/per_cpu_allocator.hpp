@@ -0,0 +1,337 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for an allocator that caches
+ *        free chunks in one shard per processor
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_PER_CPU_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_PER_CPU_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/magazine_cache.hpp"  // detail::magazine_cache
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../concepts/Allocator.hpp"     // is_allocator
+#include "../concepts/BasicLockable.hpp" // is_basic_lockable
+
+#include "../traits/allocator_traits.hpp" // allocator_traits
+
+#include "../utilities/allocator_info.hpp"    // allocator_info
+#include "../utilities/cpu.hpp"               // current_cpu, cpu_count
+#include "../utilities/ebo_storage.hpp"       // ebo_storage
+#include "../utilities/macros.hpp"            // BIT_MEMORY_UNLIKELY
+#include "../utilities/owner.hpp"             // owner
+#include "../utilities/pointer_utilities.hpp" // align_forward
+
+#include <atomic>      // std::atomic
+#include <cassert>     // assert
+#include <cstddef>     // std::size_t
+#include <mutex>       // std::mutex, std::lock_guard
+#include <new>         // ::operator new, placement new
+#include <tuple>       // std::forward_as_tuple
+#include <type_traits> // std::enable_if_t, std::is_constructible
+#include <utility>     // std::forward
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief An allocator that keeps one shard of free chunks per processor
+    ///        in front of a shared central allocator
+    ///
+    /// This is the per-processor counterpart to the thread_caching_allocator.
+    /// Rather than each thread owning its own magazines, every processor owns
+    /// a shard of magazines, so the memory held in caches is bounded by the
+    /// number of processors rather than by the number of threads. This suits
+    /// programs that run many short-lived threads or fibers.
+    ///
+    /// Requests up to \c max_cached_size bytes are rounded up to a
+    /// power-of-two size class, and are served from the shard of the
+    /// processor that the calling thread is running on, as reported by
+    /// \c current_cpu. Each shard is claimed with a single atomic exchange on
+    /// its own cache line; no mutex is involved, and no two processors
+    /// touch the same shard in the common case.
+    ///
+    /// A thread may be preempted, or migrate to another processor, while it
+    /// has a shard claimed. Another thread that finds the shard of its
+    /// processor claimed never waits on it: it re-reads its processor once
+    /// and tries that shard, and otherwise falls back to the central
+    /// allocator under its lock.
+    ///
+    /// Magazines are refilled from, and flushed back to, the central
+    /// Allocator in batches, exactly as with the thread_caching_allocator.
+    /// Requests larger than \c max_cached_size are forwarded to the central
+    /// allocator directly.
+    ///
+    /// \satisfies{Allocator}
+    ///
+    /// \tparam Allocator the central allocator to draw chunks from
+    /// \tparam BasicLockable the lock used to guard the central allocator
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename Allocator, typename BasicLockable = std::mutex>
+    class per_cpu_allocator
+      : private ebo_storage<Allocator,BasicLockable>
+    {
+      static_assert( is_allocator<Allocator>::value,
+                     "Allocator must be an Allocator" );
+      static_assert( is_basic_lockable<BasicLockable>::value,
+                     "BasicLockable must be BasicLockable" );
+
+      using base_type = ebo_storage<Allocator,BasicLockable>;
+
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using allocator_type = Allocator;
+      using lock_type      = BasicLockable;
+
+      /// Every cached chunk is aligned to the fundamental alignment, since the
+      /// size of a deallocation alone must identify its size class
+      using max_alignment = detail::magazine_cache::max_alignment;
+
+      /// The smallest size class
+      using min_cached_size = detail::magazine_cache::min_cached_size;
+
+      /// The largest size class; larger requests are not cached
+      using max_cached_size = detail::magazine_cache::max_cached_size;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a per_cpu_allocator with one shard for every
+      ///        processor, forwarding all arguments to the central Allocator
+      ///
+      /// \param args the arguments to forward to the central Allocator
+      template<typename...Args, typename = std::enable_if_t<std::is_constructible<Allocator,Args...>::value>>
+      explicit per_cpu_allocator( Args&&...args );
+
+      // Deleted move constructor
+      per_cpu_allocator( per_cpu_allocator&& other ) = delete;
+
+      // Deleted copy constructor
+      per_cpu_allocator( const per_cpu_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Destructs this allocator, flushing every shard back to the
+      ///        central allocator
+      ///
+      /// \note No other thread may be using this allocator while it is being
+      ///       destroyed
+      ~per_cpu_allocator();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      per_cpu_allocator& operator=( per_cpu_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      per_cpu_allocator& operator=( const per_cpu_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align
+      ///
+      /// \pre \p align does not exceed \c max_alignment
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size, std::size_t align ) noexcept;
+
+      /// \brief Deallocates memory previously allocated from a call to
+      ///        \c try_allocate
+      ///
+      /// The memory may be deallocated from any thread, on any processor
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate( owner<void*> p, std::size_t size );
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Flushes every chunk cached in every shard back to the central
+      ///        allocator
+      ///
+      /// Shards that are claimed by another thread at the time are skipped
+      void flush_caches();
+
+      //-----------------------------------------------------------------------
+      // Tuning
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Sets the number of chunks moved from the central allocator
+      ///        into a magazine when it runs dry
+      ///
+      /// \note This must not be changed while other threads are using this
+      ///       allocator
+      ///
+      /// \param size the number of chunks per refill
+      void set_magazine_size( std::size_t size ) noexcept;
+
+      /// \brief Sets the number of chunks a magazine may hold before it is
+      ///        flushed to the central allocator
+      ///
+      /// \note This must not be changed while other threads are using this
+      ///       allocator
+      ///
+      /// \param mark the high water mark
+      void set_high_water_mark( std::size_t mark ) noexcept;
+
+      /// \brief Sets the number of chunks left in a magazine after it has
+      ///        been flushed to the central allocator
+      ///
+      /// \note This must not be changed while other threads are using this
+      ///       allocator
+      ///
+      /// \param mark the low water mark
+      void set_low_water_mark( std::size_t mark ) noexcept;
+
+      /// \brief Gets the number of chunks moved into a magazine per refill
+      ///
+      /// \return the magazine size
+      std::size_t magazine_size() const noexcept;
+
+      /// \brief Gets the number of chunks a magazine may hold before being
+      ///        flushed
+      ///
+      /// \return the high water mark
+      std::size_t high_water_mark() const noexcept;
+
+      /// \brief Gets the number of chunks left in a magazine after a flush
+      ///
+      /// \return the low water mark
+      std::size_t low_water_mark() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'per_cpu_allocator'. Use a
+      /// named_per_cpu_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      /// \brief Gets the number of shards, which is one per processor
+      ///
+      /// \return the number of shards
+      std::size_t shards() const noexcept;
+
+      /// \brief Gets a reference to the central allocator
+      ///
+      /// \note Accessing the central allocator is not synchronized
+      ///
+      /// \return reference to the central allocator
+      allocator_type& central_allocator() noexcept;
+
+      /// \copydoc central_allocator()
+      const allocator_type& central_allocator() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      using magazine_cache = detail::magazine_cache;
+
+      /// \brief The cache for a single processor, on its own cache lines
+      struct alignas(cache_line_size) shard
+      {
+        std::atomic<bool> claimed{false};
+        magazine_cache    magazines;
+      };
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      void*       m_storage; ///< The unaligned storage of the shards
+      shard*      m_shards;
+      std::size_t m_shard_count;
+      std::size_t m_magazine_size;
+      std::size_t m_high_water_mark;
+      std::size_t m_low_water_mark;
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Claims the shard of the current processor
+      ///
+      /// If that shard is already claimed, the processor is queried once more
+      /// in case the thread migrated, before giving up
+      ///
+      /// \return the claimed shard, or \c nullptr if none could be claimed
+      shard* claim_shard() noexcept;
+
+      /// \brief Claims the shard at \p index, without waiting
+      ///
+      /// \return the claimed shard, or \c nullptr if it is already claimed
+      shard* try_claim_shard( std::size_t index ) noexcept;
+
+      /// \brief Releases a shard previously claimed by this thread
+      static void release_shard( shard& s ) noexcept;
+
+      /// \brief Flushes every magazine of \p s to the central allocator
+      void flush_shard( shard& s );
+
+      owner<void*> allocate_uncached( std::size_t size,
+                                      std::size_t align ) noexcept;
+
+      void deallocate_uncached( owner<void*> p, std::size_t size );
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    template<typename Allocator, typename BasicLockable = std::mutex>
+    using named_per_cpu_allocator
+      = detail::named_allocator<per_cpu_allocator<Allocator,BasicLockable>>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/per_cpu_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_PER_CPU_ALLOCATOR_HPP */
@@ -41,8 +41,10 @@
 
 #include "../concepts/Allocator.hpp"         // Allocator
 #include "../concepts/ExtendedAllocator.hpp" // ExtendedAllocator
+#include "../concepts/MemoryTracker.hpp"     // memory_tracker_is_thread_safe
 
-#include "../traits/allocator_traits.hpp" // allocator_traits
+#include "../traits/allocator_traits.hpp"          // allocator_traits
+#include "../traits/extended_allocator_traits.hpp" // extended_allocator_traits
 
 #include <cstddef> // std::size_t, std::ptrdiff_t
 #include <mutex>   // std::lock_guard
@@ -69,6 +71,8 @@ namespace bit {
     /// \tparam MemoryTagger A class used for tagging memory on allocations and
     ///                      on deallocations.
     /// \tparam MemoryTracker A class used for tracking memory allocations.
+    ///                       Trackers that declare themselves thread-safe
+    ///                       are notified outside of the lock.
     /// \tparam BoundsChecker A class used for bounds checking; used to
     ///                       catch buffer-overflow issues
     /// \tparam BasicLockable A lockable type for thread-synchronization
@@ -92,6 +96,11 @@ namespace bit {
                                             BoundsChecker,
                                             BasicLockable>;
 
+      /// Thread-safe trackers are notified outside of the lock, so that they
+      /// do not lengthen the critical section
+      static constexpr bool s_track_in_lock
+        = !memory_tracker_is_thread_safe<MemoryTracker>::value;
+
       //-----------------------------------------------------------------------
       // Public Member Types
       //-----------------------------------------------------------------------
@@ -177,12 +186,37 @@ namespace bit {
       /// \return an allocated pointer on success, \c nullptr on failure
       void* try_allocate( std::size_t size, std::size_t align ) noexcept;
 
+      /// \brief Attempts to make \p n allocations of \p size bytes aligned
+      ///        to a boundary of \p align using the underlying allocator
+      ///
+      /// The lock is only acquired once for the whole batch
+      ///
+      /// \param size the size of each allocation
+      /// \param align the alignment of each allocation
+      /// \param n the number of allocations to make
+      /// \param out the array to write the allocations to
+      /// \return the number of allocations written to \p out
+      std::size_t try_allocate_n( std::size_t size,
+                                  std::size_t align,
+                                  std::size_t n,
+                                  void** out ) noexcept;
+
       /// \brief Deallocates the pointer \p p with the size \p size
       ///
       /// \param p the pointer to deallocate
       /// \param size the size originally requested to 'try_allocate'
       void deallocate( void* p, std::size_t size );
 
+      /// \brief Deallocates the \p n pointers in \p ptrs, each with the
+      ///        size \p size
+      ///
+      /// The lock is only acquired once for the whole batch
+      ///
+      /// \param ptrs the pointers to deallocate
+      /// \param n the number of pointers in \p ptrs
+      /// \param size the size originally requested to 'try_allocate_n'
+      void deallocate_n( void** ptrs, std::size_t n, std::size_t size );
+
       //-----------------------------------------------------------------------
 
       /// \brief Deallocates all memory in this allocator
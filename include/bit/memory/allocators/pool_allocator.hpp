@@ -36,11 +36,12 @@
 
 #include "detail/named_allocator.hpp" // detail::named_allocator
 
-#include "../utilities/freelist.hpp"          // freelist
-#include "../utilities/macros.hpp"            // BIT_MEMORY_ASSUME
-#include "../utilities/memory_block.hpp"      // memory_block
-#include "../utilities/owner.hpp"             // owner
-#include "../utilities/pointer_utilities.hpp" // is_power_of_two
+#include "../utilities/freelist.hpp"              // freelist
+#include "../utilities/macros.hpp"                // BIT_MEMORY_ASSUME
+#include "../utilities/memory_block.hpp"          // memory_block
+#include "../utilities/owner.hpp"                 // owner
+#include "../utilities/pointer_utilities.hpp"     // is_power_of_two
+#include "../utilities/uninitialized_storage.hpp" // uninitialized_construct_at
 
 #include <cassert>
 
@@ -51,6 +52,12 @@ namespace bit {
     /// \brief This allocator creates a pool of fixed-sized chunk entries for
     ///        allocations
     ///
+    /// The pool is initialized lazily: chunks that have never been used are
+    /// handed out from a bump cursor, and only recycled chunks are linked
+    /// into the freelist. This keeps both construction and
+    /// \c deallocate_all O(1), and avoids touching (and faulting in) any
+    /// memory in the block until it is actually used.
+    ///
     /// \satisfies{ExtendedAllocator}
     ///////////////////////////////////////////////////////////////////////////
     class pool_allocator
@@ -110,6 +117,21 @@ namespace bit {
                                  std::size_t align,
                                  std::size_t offset = 0 ) noexcept;
 
+      /// \brief Tries to make \p n allocations of \p size bytes with the
+      ///        alignment of \p align
+      ///
+      /// Recycled chunks are taken from the freelist in a single pass
+      ///
+      /// \param size the requested size of each allocation
+      /// \param align the requested alignment of each allocation
+      /// \param n the number of allocations to make
+      /// \param out the array to write the allocations to
+      /// \return the number of allocations written to \p out
+      std::size_t try_allocate_n( std::size_t size,
+                                  std::size_t align,
+                                  std::size_t n,
+                                  void** out ) noexcept;
+
       /// \brief Deallocates memory previously allocated from a call to
       ///        \c try_allocate
       ///
@@ -117,6 +139,16 @@ namespace bit {
       /// \param size the size of the memory previously provided to try_allocate
       void deallocate( owner<void*> p, std::size_t size );
 
+      /// \brief Deallocates the \p n pointers in \p ptrs
+      ///
+      /// The chunks are linked together, and spliced into the freelist at
+      /// once
+      ///
+      /// \param ptrs the pointers to deallocate
+      /// \param n the number of pointers in \p ptrs
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate_n( void** ptrs, std::size_t n, std::size_t size );
+
       /// \brief Deallocates all memory in this pool_allocator
       void deallocate_all();
 
@@ -152,6 +184,7 @@ namespace bit {
 
       freelist     m_freelist;
       memory_block m_block;
+      void*        m_current;
       std::size_t  m_chunk_size;
 
       //-----------------------------------------------------------------------
@@ -159,8 +192,11 @@ namespace bit {
       //-----------------------------------------------------------------------
     private:
 
-      /// \brief Creates the pool of instances to be used by the allocator
-      void create_pool();
+      /// \brief Requests a chunk that has been recycled, or one that has not
+      ///        yet been used from the untouched portion of the block
+      ///
+      /// \return pointer to the chunk, or \c nullptr if the pool is exhausted
+      void* request_chunk() noexcept;
     };
 
     //-------------------------------------------------------------------------
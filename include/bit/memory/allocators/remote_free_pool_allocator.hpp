@@ -0,0 +1,243 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a pool allocator owned by
+ *        a single thread, that other threads may deallocate to
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_REMOTE_FREE_POOL_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_REMOTE_FREE_POOL_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../utilities/allocator_info.hpp"        // allocator_info
+#include "../utilities/freelist.hpp"              // freelist
+#include "../utilities/macros.hpp"                // BIT_MEMORY_UNLIKELY
+#include "../utilities/memory_block.hpp"          // memory_block
+#include "../utilities/owner.hpp"                 // owner
+#include "../utilities/pointer_utilities.hpp"     // is_power_of_two
+#include "../utilities/uninitialized_storage.hpp" // uninitialized_construct_at
+
+#include <atomic>      // std::atomic
+#include <cassert>     // assert
+#include <cstddef>     // std::size_t
+#include <thread>      // std::thread::id, std::this_thread
+#include <type_traits> // std::integral_constant
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A pool allocator that is owned by a single thread, but that
+    ///        any thread may deallocate to
+    ///
+    /// Only the owning thread may allocate, and its deallocations go to a
+    /// plain freelist exactly as with the pool_allocator. Deallocations from
+    /// any other thread are instead pushed onto a lock-free
+    /// multiple-producer, single-consumer 'remote-free' queue.
+    ///
+    /// The owner only looks at the remote-free queue once its own freelist
+    /// runs dry: it then takes the whole queue with a single atomic exchange
+    /// and splices it into its freelist, before falling back to chunks that
+    /// have never been used. Since the owner is the only consumer, and always
+    /// takes every entry at once, the queue is immune to the ABA problem
+    /// without needing a tagged pointer.
+    ///
+    /// This suits producer/consumer pipelines, where objects are allocated
+    /// on one thread and released on another, without sharing a pool under
+    /// a lock.
+    ///
+    /// The owner is the thread that constructs the allocator, and may be
+    /// changed with \c take_ownership.
+    ///
+    /// \satisfies{ExtendedAllocator}
+    ///////////////////////////////////////////////////////////////////////////
+    class remote_free_pool_allocator
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      /// The max alignment is limited to 128 bytes due to an internal
+      /// requirement that it stores the offset information
+      using max_alignment = std::integral_constant<std::size_t,128>;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a remote_free_pool_allocator with chunk sizes of
+      ///        \p chunk_size, in the arena indicated by \p block
+      ///
+      /// The calling thread becomes the owner of the pool
+      ///
+      /// \param chunk_size the size of each entry in the pool allocator
+      /// \param block the block to allocate from
+      remote_free_pool_allocator( std::size_t chunk_size, memory_block block );
+
+      // Deleted move construction
+      remote_free_pool_allocator( remote_free_pool_allocator&& other ) = delete;
+
+      // Deleted copy construction
+      remote_free_pool_allocator( const remote_free_pool_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      remote_free_pool_allocator& operator=( remote_free_pool_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      remote_free_pool_allocator& operator=( const remote_free_pool_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align,
+      ///        offset by \p offset
+      ///
+      /// \pre This must be called from the owning thread
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \param offset the amount to offset the alignment
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size,
+                                 std::size_t align,
+                                 std::size_t offset = 0 ) noexcept;
+
+      /// \brief Deallocates memory previously allocated from a call to
+      ///        \c try_allocate
+      ///
+      /// This may be called from any thread. Memory deallocated from a thread
+      /// other than the owner is queued until the owner next runs out of
+      /// recycled chunks.
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate( owner<void*> p, std::size_t size );
+
+      /// \brief Deallocates all memory in this remote_free_pool_allocator
+      ///
+      /// \pre This must be called from the owning thread, and no other thread
+      ///      may be deallocating at the same time
+      void deallocate_all();
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Moves every chunk queued by other threads into the owner's
+      ///        freelist
+      ///
+      /// This happens automatically when the owner's freelist runs dry, but
+      /// may be done early to bound the size of the queue
+      ///
+      /// \pre This must be called from the owning thread
+      ///
+      /// \return the number of chunks that were moved
+      std::size_t drain_remote_frees() noexcept;
+
+      /// \brief Makes the calling thread the owner of this pool
+      ///
+      /// \note No other thread may be allocating from this pool at the time
+      void take_ownership() noexcept;
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Determines whether the pointer \p p is owned by this allocator
+      ///
+      /// \return \c true if the pointer \p p is originally from this allocator
+      bool owns( const void* p ) const noexcept;
+
+      /// \brief Determines the max size that this allocator can allocate
+      ///
+      /// \return the max size
+      std::size_t max_size() const noexcept;
+
+      /// \brief Gets the id of the thread that owns this pool
+      ///
+      /// \return the id of the owning thread
+      std::thread::id owning_thread() const noexcept;
+
+      //----------------------------------------------------------------------
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'remote_free_pool_allocator'. Use a
+      /// named_remote_free_pool_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      freelist           m_freelist; ///< Chunks freed by the owner
+      memory_block       m_block;
+      void*              m_current;
+      std::size_t        m_chunk_size;
+      std::thread::id    m_owner;
+      std::atomic<void*> m_remote;   ///< Chunks freed by other threads
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Requests a chunk that has been recycled locally or remotely,
+      ///        or one that has not yet been used from the untouched portion
+      ///        of the block
+      ///
+      /// \return pointer to the chunk, or \c nullptr if the pool is exhausted
+      void* request_chunk() noexcept;
+
+      /// \brief Gets the start of the chunk of the allocation \p p
+      static void* chunk_of( void* p ) noexcept;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    using named_remote_free_pool_allocator
+      = detail::named_allocator<remote_free_pool_allocator>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/remote_free_pool_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_REMOTE_FREE_POOL_ALLOCATOR_HPP */
@@ -0,0 +1,233 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for an allocator that samples
+ *        a fraction of allocations into guard-paged slots
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_SAMPLING_GUARDED_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_SAMPLING_GUARDED_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "guard_page_allocator.hpp" // guard_page_allocator
+
+#include "../concepts/Allocator.hpp" // is_allocator
+
+#include "../traits/allocator_traits.hpp" // allocator_traits
+
+#include "../utilities/allocator_info.hpp"    // allocator_info
+#include "../utilities/debugging.hpp"         // debug_tag_fence_end_bytes
+#include "../utilities/ebo_storage.hpp"       // ebo_storage
+#include "../utilities/errors.hpp"            // get_buffer_overflow_handler
+#include "../utilities/macros.hpp"            // BIT_MEMORY_UNLIKELY
+#include "../utilities/owner.hpp"             // owner
+#include "../utilities/pointer_utilities.hpp" // align_forward
+
+#include <cstddef>     // std::size_t
+#include <tuple>       // std::forward_as_tuple
+#include <type_traits> // std::enable_if_t, std::is_constructible
+#include <utility>     // std::forward
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief An allocator that routes one in every \c sample_rate()
+    ///        allocations into a small pool of guard-paged slots, and every
+    ///        other allocation to the underlying Allocator
+    ///
+    /// Sampled allocations are placed against a guard page, so that an
+    /// overflow past the end of the allocation faults in hardware. The few
+    /// bytes between the end of the allocation and the guard page that
+    /// alignment leaves are tagged, and checked when the allocation is
+    /// deallocated; any overwrite is reported to the buffer-overflow
+    /// handler. Sampled slots are decommitted once deallocated, so that
+    /// any use after free faults, and deallocating one twice is reported to
+    /// the double-delete handler.
+    ///
+    /// Since only a fraction of allocations pay for the guard pages, this is
+    /// suitable for catching memory errors in production. Allocations that
+    /// are larger than a page, or that are sampled when every slot is in
+    /// use, are served by the underlying Allocator instead.
+    ///
+    /// \note This allocator is not synchronized
+    ///
+    /// \satisfies{Allocator}
+    ///
+    /// \tparam Allocator the allocator used for allocations that are not
+    ///         sampled
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename Allocator>
+    class sampling_guarded_allocator
+      : private ebo_storage<Allocator>
+    {
+      static_assert( is_allocator<Allocator>::value,
+                     "Allocator must be an Allocator" );
+
+      using base_type = ebo_storage<Allocator>;
+
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using allocator_type = Allocator;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a sampling_guarded_allocator that samples one in
+      ///        every \p sample_rate allocations into \p slots guarded slots,
+      ///        forwarding \p args to the underlying Allocator
+      ///
+      /// \param sample_rate the number of allocations per sample; 0 disables
+      ///        sampling
+      /// \param slots the number of guarded slots
+      /// \param args the arguments to forward to the underlying Allocator
+      template<typename...Args, typename = std::enable_if_t<std::is_constructible<Allocator,Args...>::value>>
+      sampling_guarded_allocator( std::size_t sample_rate,
+                                  std::size_t slots,
+                                  Args&&...args );
+
+      // Deleted move constructor
+      sampling_guarded_allocator( sampling_guarded_allocator&& other ) = delete;
+
+      // Deleted copy constructor
+      sampling_guarded_allocator( const sampling_guarded_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      sampling_guarded_allocator& operator=( sampling_guarded_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      sampling_guarded_allocator& operator=( const sampling_guarded_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size, std::size_t align ) noexcept;
+
+      /// \brief Deallocates memory previously allocated from a call to
+      ///        \c try_allocate
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate( owner<void*> p, std::size_t size );
+
+      //-----------------------------------------------------------------------
+      // Sampling
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Sets the number of allocations per sampled allocation
+      ///
+      /// \param rate the sample rate; 0 disables sampling
+      void set_sample_rate( std::size_t rate ) noexcept;
+
+      /// \brief Gets the number of allocations per sampled allocation
+      ///
+      /// \return the sample rate
+      std::size_t sample_rate() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Determines whether \p p was a sampled allocation
+      ///
+      /// \param p the pointer to check
+      /// \return \c true if \p p is in a guarded slot
+      bool is_sampled( const void* p ) const noexcept;
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'sampling_guarded_allocator'. Use a
+      /// named_sampling_guarded_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      /// \brief Gets a reference to the underlying allocator
+      ///
+      /// \return reference to the underlying allocator
+      allocator_type& backing_allocator() noexcept;
+
+      /// \copydoc backing_allocator()
+      const allocator_type& backing_allocator() const noexcept;
+
+      /// \brief Gets a reference to the allocator of the guarded slots
+      ///
+      /// \return reference to the guarded allocator
+      const guard_page_allocator& guarded_allocator() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      guard_page_allocator m_guarded;     ///< The guarded slots
+      std::size_t          m_sample_rate; ///< Allocations per sample
+      std::size_t          m_countdown;   ///< Allocations until the next sample
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Gets the slack between the end of the sampled allocation
+      ///        \p p of \p size bytes and its guard page
+      std::size_t slack_of( void* p, std::size_t size ) const noexcept;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    template<typename Allocator>
+    using named_sampling_guarded_allocator
+      = detail::named_allocator<sampling_guarded_allocator<Allocator>>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/sampling_guarded_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_SAMPLING_GUARDED_ALLOCATOR_HPP */
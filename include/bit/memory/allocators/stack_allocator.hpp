@@ -72,6 +72,12 @@ namespace bit {
 
       using max_alignment = std::integral_constant<std::size_t,Align>;
 
+      /// A marker of the allocation state, returned from \c checkpoint
+      struct checkpoint_type
+      {
+        void* current;
+      };
+
       //-----------------------------------------------------------------------
       // Constructors
       //-----------------------------------------------------------------------
@@ -115,6 +121,17 @@ namespace bit {
                           std::size_t align,
                           std::size_t offset = 0 ) noexcept;
 
+      /// \brief Expands the most recent allocation at \p p in place so that
+      ///        it holds \p new_size bytes
+      ///
+      /// Only the most recent allocation that has not been deallocated can be
+      /// expanded. On failure, nothing is changed.
+      ///
+      /// \param p the pointer to the most recent allocation
+      /// \param new_size the new size of the allocation
+      /// \return \c true if the allocation now holds \p new_size bytes
+      bool expand( void* p, std::size_t new_size ) noexcept;
+
       /// \brief Does nothing for linear_allocator. Use deallocate_all
       ///
       /// \param p the pointer
@@ -124,6 +141,25 @@ namespace bit {
       /// \brief Deallocates all memory in this allocator
       void deallocate_all();
 
+      //-----------------------------------------------------------------------
+      // Checkpoints
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Records the current allocation state of this allocator
+      ///
+      /// \return a marker that can later be passed to \c rewind
+      checkpoint_type checkpoint() const noexcept;
+
+      /// \brief Deallocates everything that was allocated since \p marker
+      ///        was recorded, in O(1)
+      ///
+      /// \pre \p marker was returned from \c checkpoint on this allocator,
+      ///      and no earlier marker has been rewound to since
+      ///
+      /// \param marker the marker to rewind to
+      void rewind( checkpoint_type marker ) noexcept;
+
       //-----------------------------------------------------------------------
       // Observers
       //-----------------------------------------------------------------------
@@ -150,6 +186,7 @@ namespace bit {
 
       alignas(Align) char m_storage[Size];
       void* m_current;
+      void* m_last;    ///< The most recent allocation
     };
 
     //-------------------------------------------------------------------------
@@ -0,0 +1,358 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for an allocator that caches
+ *        freed chunks per-thread in front of a shared central allocator
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_THREAD_CACHING_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_THREAD_CACHING_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/magazine_cache.hpp"  // detail::magazine_cache
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../concepts/Allocator.hpp"     // is_allocator
+#include "../concepts/BasicLockable.hpp" // is_basic_lockable
+
+#include "../traits/allocator_traits.hpp" // allocator_traits
+
+#include "../utilities/ebo_storage.hpp" // ebo_storage
+#include "../utilities/macros.hpp"      // BIT_MEMORY_UNLIKELY
+#include "../utilities/owner.hpp"       // owner
+
+#include <atomic>      // std::atomic
+#include <cassert>     // assert
+#include <cstddef>     // std::size_t
+#include <mutex>       // std::mutex, std::lock_guard
+#include <new>         // std::nothrow
+#include <tuple>       // std::forward_as_tuple
+#include <type_traits> // std::enable_if_t, std::is_constructible
+#include <utility>     // std::forward
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief An allocator that keeps per-thread magazines of free chunks in
+    ///        front of a shared central allocator
+    ///
+    /// Requests up to \c max_cached_size bytes are rounded up to a
+    /// power-of-two size class. Each thread that uses the allocator owns a
+    /// magazine of free chunks for every size class, so the common
+    /// allocation and deallocation paths touch only thread-local state and
+    /// never take a lock.
+    ///
+    /// When a magazine runs dry it is refilled from the central Allocator
+    /// with a batch of \c magazine_size chunks under a single lock; when it
+    /// grows past the \c high_water_mark, it is flushed back to the central
+    /// Allocator down to the \c low_water_mark under a single lock.
+    ///
+    /// Chunks are interchangeable within a size class, so memory freed on a
+    /// thread other than the one that allocated it is simply cached by the
+    /// freeing thread, and eventually flows back to the central allocator.
+    /// Every thread's cache is flushed back to the central allocator when
+    /// the thread exits, or when this allocator is destroyed -- whichever
+    /// happens first.
+    ///
+    /// \note Remote frees follow tcmalloc's semantics rather than being
+    ///       returned to the cache of the allocating thread: the chunk is
+    ///       reused by the freeing thread, and only becomes available to the
+    ///       allocating thread again once it is flushed to the central
+    ///       allocator.
+    ///
+    /// Requests larger than \c max_cached_size are forwarded to the central
+    /// allocator directly.
+    ///
+    /// \satisfies{Allocator}
+    ///
+    /// \tparam Allocator the central allocator to draw chunks from
+    /// \tparam BasicLockable the lock used to guard the central allocator
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename Allocator, typename BasicLockable = std::mutex>
+    class thread_caching_allocator
+      : private ebo_storage<Allocator,BasicLockable>
+    {
+      static_assert( is_allocator<Allocator>::value,
+                     "Allocator must be an Allocator" );
+      static_assert( is_basic_lockable<BasicLockable>::value,
+                     "BasicLockable must be BasicLockable" );
+
+      using base_type = ebo_storage<Allocator,BasicLockable>;
+
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using allocator_type = Allocator;
+      using lock_type      = BasicLockable;
+
+      /// Every cached chunk is aligned to the fundamental alignment, since the
+      /// size of a deallocation alone must identify its size class
+      using max_alignment = detail::magazine_cache::max_alignment;
+
+      /// The smallest size class
+      using min_cached_size = detail::magazine_cache::min_cached_size;
+
+      /// The largest size class; larger requests are not cached
+      using max_cached_size = detail::magazine_cache::max_cached_size;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a thread_caching_allocator by forwarding all
+      ///        arguments to the central Allocator
+      ///
+      /// \param args the arguments to forward to the central Allocator
+      template<typename...Args, typename = std::enable_if_t<std::is_constructible<Allocator,Args...>::value>>
+      explicit thread_caching_allocator( Args&&...args );
+
+      // Deleted move constructor
+      thread_caching_allocator( thread_caching_allocator&& other ) = delete;
+
+      // Deleted copy constructor
+      thread_caching_allocator( const thread_caching_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Destructs this allocator, flushing every thread's cache back
+      ///        to the central allocator
+      ///
+      /// \note No other thread may be using this allocator while it is being
+      ///       destroyed
+      ~thread_caching_allocator();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      thread_caching_allocator& operator=( thread_caching_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      thread_caching_allocator& operator=( const thread_caching_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align
+      ///
+      /// \pre \p align does not exceed \c max_alignment
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size, std::size_t align ) noexcept;
+
+      /// \brief Deallocates memory previously allocated from a call to
+      ///        \c try_allocate
+      ///
+      /// The memory may be deallocated from any thread
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate( owner<void*> p, std::size_t size );
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Flushes every chunk cached by the calling thread back to the
+      ///        central allocator
+      void flush_thread_cache();
+
+      //-----------------------------------------------------------------------
+      // Tuning
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Sets the number of chunks moved from the central allocator
+      ///        into a magazine when it runs dry
+      ///
+      /// \note This must not be changed while other threads are using this
+      ///       allocator
+      ///
+      /// \param size the number of chunks per refill
+      void set_magazine_size( std::size_t size ) noexcept;
+
+      /// \brief Sets the number of chunks a magazine may hold before it is
+      ///        flushed to the central allocator
+      ///
+      /// \note This must not be changed while other threads are using this
+      ///       allocator
+      ///
+      /// \param mark the high water mark
+      void set_high_water_mark( std::size_t mark ) noexcept;
+
+      /// \brief Sets the number of chunks left in a magazine after it has
+      ///        been flushed to the central allocator
+      ///
+      /// \note This must not be changed while other threads are using this
+      ///       allocator
+      ///
+      /// \param mark the low water mark
+      void set_low_water_mark( std::size_t mark ) noexcept;
+
+      /// \brief Gets the number of chunks moved into a magazine per refill
+      ///
+      /// \return the magazine size
+      std::size_t magazine_size() const noexcept;
+
+      /// \brief Gets the number of chunks a magazine may hold before being
+      ///        flushed
+      ///
+      /// \return the high water mark
+      std::size_t high_water_mark() const noexcept;
+
+      /// \brief Gets the number of chunks left in a magazine after a flush
+      ///
+      /// \return the low water mark
+      std::size_t low_water_mark() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the number of caches held by the calling thread across
+      ///        every thread_caching_allocator of this type
+      ///
+      /// The caches of destroyed allocators are reclaimed the next time the
+      /// thread switches to another allocator, so this does not grow with
+      /// the number of allocators that the thread outlives
+      ///
+      /// \return the number of caches held by the calling thread
+      static std::size_t local_cache_count() noexcept;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'thread_caching_allocator'. Use a
+      /// named_thread_caching_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      /// \brief Gets a reference to the central allocator
+      ///
+      /// \note Accessing the central allocator is not synchronized
+      ///
+      /// \return reference to the central allocator
+      allocator_type& central_allocator() noexcept;
+
+      /// \copydoc central_allocator()
+      const allocator_type& central_allocator() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      using magazine_cache = detail::magazine_cache;
+
+      /// \brief The cache for a single thread of a single allocator
+      struct thread_cache
+      {
+        std::atomic<thread_caching_allocator*> owner;
+        thread_cache* next       = nullptr; ///< next cache of the allocator
+        thread_cache* previous   = nullptr; ///< previous cache of the allocator
+        thread_cache* next_local = nullptr; ///< next cache of the thread
+        magazine_cache magazines;
+      };
+
+      /// \brief Every cache owned by a thread, flushed when the thread exits
+      struct thread_cache_list
+      {
+        thread_cache* head = nullptr;
+        thread_cache* last = nullptr; ///< the most recently used cache
+
+        ~thread_cache_list();
+      };
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      thread_cache* m_caches;
+      std::size_t   m_magazine_size;
+      std::size_t   m_high_water_mark;
+      std::size_t   m_low_water_mark;
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Gets the cache of the calling thread, creating it if needed
+      ///
+      /// \return the cache, or \c nullptr if one could not be created
+      thread_cache* local_cache() noexcept;
+
+      /// \brief Finds the cache of the calling thread without creating one,
+      ///        deleting any caches of destroyed allocators on the way
+      ///
+      /// \return the cache, or \c nullptr if the thread has none
+      thread_cache* find_local_cache() noexcept;
+
+      /// \brief Flushes every magazine of \p cache to the central allocator
+      void flush_cache( thread_cache& cache );
+
+      /// \brief Removes \p cache from this allocator's list of caches
+      ///
+      /// \pre The registry mutex must be held
+      void unregister_cache( thread_cache& cache ) noexcept;
+
+      owner<void*> allocate_uncached( std::size_t size,
+                                      std::size_t align ) noexcept;
+
+      void deallocate_uncached( owner<void*> p, std::size_t size );
+
+      /// \brief Gets the mutex guarding the registration of thread caches
+      static std::mutex& registry_mutex() noexcept;
+
+      /// \brief Gets the caches of the calling thread
+      static thread_cache_list& thread_caches() noexcept;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    template<typename Allocator, typename BasicLockable = std::mutex>
+    using named_thread_caching_allocator
+      = detail::named_allocator<thread_caching_allocator<Allocator,BasicLockable>>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/thread_caching_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_THREAD_CACHING_ALLOCATOR_HPP */
@@ -0,0 +1,319 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a two-level segregated fit
+ *        (TLSF) allocator
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_ALLOCATORS_TLSF_ALLOCATOR_HPP
+#define BIT_MEMORY_ALLOCATORS_TLSF_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/named_allocator.hpp" // detail::named_allocator
+
+#include "../utilities/allocator_info.hpp"     // allocator_info
+#include "../utilities/bit_scan.hpp"           // count_trailing_zeros, floor_log2
+#include "../utilities/macros.hpp"             // BIT_MEMORY_UNLIKELY
+#include "../utilities/memory_block.hpp"       // memory_block
+#include "../utilities/memory_block_cache.hpp" // memory_block_cache
+#include "../utilities/owner.hpp"              // owner
+#include "../utilities/pointer_utilities.hpp"  // offset_align_forward
+
+#include <cassert>     // assert
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <type_traits> // std::integral_constant
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A general-purpose allocator with bounded, O(1) allocation and
+    ///        deallocation of variable sizes
+    ///
+    /// This is an implementation of the Two-Level Segregated Fit allocator
+    /// described by Masmano et al. Free blocks are segregated into lists
+    /// first by the power-of-two range of their size, and then linearly
+    /// into 16 subdivisions of that range. A bitmap for each level records
+    /// which lists are non-empty, so that a suitable free block is found
+    /// with a pair of count-trailing-zero instructions rather than a search.
+    ///
+    /// Blocks are split on allocation, and are coalesced immediately with
+    /// their free physical neighbours on deallocation, which keeps
+    /// fragmentation low without any deferred work.
+    ///
+    /// Each allocation carries a 2-pointer header, and every allocation is
+    /// rounded up to a multiple of 16 bytes. The allocator manages one or
+    /// more memory_blocks; each block reserves its first
+    /// \c sizeof(memory_block) bytes to link the blocks together.
+    ///
+    /// \satisfies{ExtendedAllocator}
+    ///////////////////////////////////////////////////////////////////////////
+    class tlsf_allocator
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      /// Over-aligned allocations are satisfied by splitting off the leading
+      /// portion of a larger free block, so any power-of-two alignment is
+      /// supported up to the size of the managed blocks
+      using max_alignment = std::integral_constant<std::size_t,4096>;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a tlsf_allocator that does not yet manage any
+      ///        memory
+      ///
+      /// Memory must be provided with \c add_block before allocating
+      tlsf_allocator() noexcept;
+
+      /// \brief Constructs a tlsf_allocator that manages the memory in
+      ///        \p block
+      ///
+      /// \param block the block to allocate from
+      explicit tlsf_allocator( memory_block block ) noexcept;
+
+      /// \brief Move-constructs the tlsf_allocator from another allocator
+      ///
+      /// \param other the other allocator to move
+      tlsf_allocator( tlsf_allocator&& other ) noexcept = default;
+
+      // Deleted copy construction
+      tlsf_allocator( const tlsf_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      tlsf_allocator& operator=( tlsf_allocator&& other ) = delete;
+
+      // Deleted copy assignment
+      tlsf_allocator& operator=( const tlsf_allocator& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Modifiers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Adds the memory in \p block to the memory managed by this
+      ///        allocator
+      ///
+      /// \pre \p block is at least 16-byte aligned, and is large enough to
+      ///      hold at least one allocation
+      ///
+      /// \param block the block to add
+      void add_block( memory_block block ) noexcept;
+
+      //-----------------------------------------------------------------------
+      // Allocations / Deallocations
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Tries to allocate \p size bytes with the alignment of \p align,
+      ///        offset by \p offset
+      ///
+      /// \param size the requested size of the allocation
+      /// \param align the requested alignment of the allocation
+      /// \param offset the amount to offset the alignment
+      /// \return pointer to the allocated memory, or \c nullptr on failure
+      owner<void*> try_allocate( std::size_t size,
+                                 std::size_t align,
+                                 std::size_t offset = 0 ) noexcept;
+
+      /// \brief Deallocates memory previously allocated from a call to
+      ///        \c try_allocate
+      ///
+      /// The freed block is immediately coalesced with any free neighbours
+      ///
+      /// \param p the pointer to the memory to deallocate
+      /// \param size the size of the memory previously provided to try_allocate
+      void deallocate( owner<void*> p, std::size_t size );
+
+      /// \brief Deallocates all memory in this tlsf_allocator
+      ///
+      /// \note This is O(blocks)
+      void deallocate_all();
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Determines whether the pointer \p p is owned by this allocator
+      ///
+      /// \note This is O(blocks)
+      ///
+      /// \return \c true if the pointer \p p is originally from this allocator
+      bool owns( const void* p ) const noexcept;
+
+      /// \brief Determines the max size that this allocator can allocate
+      ///
+      /// \return the size of the largest free block when this allocator
+      ///         holds no allocations
+      std::size_t max_size() const noexcept;
+
+      //----------------------------------------------------------------------
+
+      /// \brief Gets the info about this allocator
+      ///
+      /// This defaults to 'tlsf_allocator'. Use a
+      /// named_tlsf_allocator to override this
+      ///
+      /// \return the info for this allocator
+      allocator_info info() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief The header preceding every block, free or used
+      ///
+      /// The free-list links are only valid while the block is free, and
+      /// otherwise overlap the user's memory
+      struct block_header
+      {
+        block_header* previous; ///< the previous block in physical memory
+        std::size_t   size;     ///< the block size, along with the flags
+        block_header* next_free;
+        block_header* previous_free;
+      };
+
+      /// \brief A pair of first and second-level list indices
+      struct list_index
+      {
+        std::size_t first;
+        std::size_t second;
+      };
+
+      //-----------------------------------------------------------------------
+
+      /// Every block size and address is a multiple of this alignment
+      static constexpr auto s_align_size = std::size_t{16};
+
+      /// The number of bytes between a header and its block's memory. This
+      /// is padded to the alignment on targets with smaller pointers, so that
+      /// the memory of every block stays aligned
+      static constexpr auto s_header_size = std::size_t{16};
+
+      static_assert( s_header_size % s_align_size == 0,
+                     "the header must preserve the alignment of the memory" );
+      static_assert( s_header_size >= 2 * sizeof(void*),
+                     "the header must fit the physical links of a block" );
+
+      /// The smallest block that can hold the free-list links
+      static constexpr auto s_min_block_size = std::size_t{2 * sizeof(void*)};
+
+      /// Each power-of-two range is split into (1 << s_sl_count_log2) lists
+      static constexpr auto s_sl_count_log2 = std::size_t{4};
+      static constexpr auto s_sl_count      = std::size_t{1} << s_sl_count_log2;
+
+      /// Blocks smaller than this are linearly mapped into the first list
+      static constexpr auto s_fl_shift      = s_sl_count_log2 + 4;
+      static constexpr auto s_small_size    = std::size_t{1} << s_fl_shift;
+
+      /// Blocks are limited to less than 2^s_fl_max bytes
+      static constexpr auto s_fl_max        = std::size_t{40};
+      static constexpr auto s_fl_count      = s_fl_max - s_fl_shift + 1;
+
+      static constexpr auto s_free_bit          = std::size_t{1};
+      static constexpr auto s_previous_free_bit = std::size_t{2};
+      static constexpr auto s_flag_mask         = s_align_size - 1;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      memory_block_cache m_blocks;
+      std::size_t        m_max_size;
+      std::uint64_t      m_fl_bitmap;
+      std::uint32_t      m_sl_bitmap[s_fl_count];
+      block_header*      m_free_lists[s_fl_count][s_sl_count];
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Lays out a single free block, followed by a sentinel, over
+      ///        the usable portion of \p block
+      void initialize_block( memory_block block ) noexcept;
+
+      /// \brief Finds a free block of at least \p size bytes, and removes it
+      ///        from the free lists
+      ///
+      /// \return the block, or \c nullptr if none is large enough
+      block_header* request_free_block( std::size_t size ) noexcept;
+
+      /// \brief Splits the trailing portion of \p block beyond \p size bytes
+      ///        off into a new free block, if it is large enough to be one
+      void trim_trailing( block_header* block, std::size_t size ) noexcept;
+
+      /// \brief Splits the leading \p size bytes of \p block off into a free
+      ///        block, returning the remainder
+      block_header* trim_leading( block_header* block,
+                                  std::size_t size ) noexcept;
+
+      void insert_free_block( block_header* block ) noexcept;
+      void remove_free_block( block_header* block ) noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Static Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Maps a block size to the list that it is stored in
+      static list_index mapping_insert( std::size_t size ) noexcept;
+
+      /// \brief Maps a requested size to the first list whose blocks are all
+      ///        guaranteed to satisfy it
+      static list_index mapping_search( std::size_t size ) noexcept;
+
+      static std::size_t block_size( const block_header* block ) noexcept;
+      static void* block_memory( block_header* block ) noexcept;
+      static block_header* block_from_memory( void* p ) noexcept;
+      static block_header* next_block( block_header* block ) noexcept;
+    };
+
+    //-------------------------------------------------------------------------
+    // Utilities
+    //-------------------------------------------------------------------------
+
+    using named_tlsf_allocator = detail::named_allocator<tlsf_allocator>;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/tlsf_allocator.inl"
+
+#endif /* BIT_MEMORY_ALLOCATORS_TLSF_ALLOCATOR_HPP */
@@ -49,6 +49,7 @@ inline bit::memory::owner<bit::memory::memory_block>
   auto& lock      = get<3>(*this);
 
   auto block = memory_block();
+  auto align = std::size_t{};
 
   { // critical section
     std::lock_guard<lock_type> scope(lock);
@@ -57,7 +58,15 @@ inline bit::memory::owner<bit::memory::memory_block>
 
     if( BIT_MEMORY_UNLIKELY( block == nullblock ) ) return nullblock;
 
-    tracker.on_allocate( block.data(), block.size(), traits_type::next_block_alignment(allocator) );
+    align = traits_type::next_block_alignment(allocator);
+
+    if( s_track_in_lock ) {
+      tracker.on_allocate( block.data(), block.size(), align );
+    }
+  }
+
+  if( !s_track_in_lock ) {
+    tracker.on_allocate( block.data(), block.size(), align );
   }
 
   tagger.tag_allocation( block.data(), block.size() );
@@ -81,11 +90,17 @@ inline void bit::memory::policy_block_allocator<BlockAllocator,Tagger,Tracker,Lo
   // Tag the deallocation
   tagger.tag_deallocation( block.data(), block.size() );
 
+  if( !s_track_in_lock ) {
+    tracker.on_deallocate( info, block.data(), block.size() );
+  }
+
   { // critical section
     std::lock_guard<lock_type> scope(lock);
 
     // Untrack the deallocation
-    tracker.on_deallocate( info, block.data(), block.size() );
+    if( s_track_in_lock ) {
+      tracker.on_deallocate( info, block.data(), block.size() );
+    }
 
     traits_type::deallocate_block( allocator, block );
   }
@@ -11,7 +11,15 @@ inline bit::memory::virtual_block_allocator<Pages,GrowthMultiplier>
   ::virtual_block_allocator( GrowthMultiplier growth )
   : base_type( std::forward_as_tuple(std::move(growth)) ),
     m_memory( virtual_memory_reserve( Pages ) ),
-    m_active_page(0)
+    m_active_page(0),
+    m_cache(nullptr),
+    m_cache_size(0),
+    m_mode(virtual_memory_page_mode::standard),
+    m_released(nullptr),
+    m_released_count(0),
+    m_released_pages(0),
+    m_commit_mode(virtual_memory_commit_mode::lazy),
+    m_prefault_threads(1)
 {
 
 }
@@ -20,24 +28,88 @@ template<std::size_t Pages, typename GrowthMultiplier>
 template<std::size_t UPages, typename>
 inline bit::memory::virtual_block_allocator<Pages,GrowthMultiplier>
   ::virtual_block_allocator( std::size_t pages, GrowthMultiplier growth )
-  : pages_member(pages),
-    base_type( std::forward_as_tuple(std::move(growth)) ),
+  : base_type( std::forward_as_tuple(std::move(growth)) ),
+    pages_member(pages),
     m_memory( virtual_memory_reserve( pages ) ),
-    m_active_page(0)
+    m_active_page(0),
+    m_cache(nullptr),
+    m_cache_size(0),
+    m_mode(virtual_memory_page_mode::standard),
+    m_released(nullptr),
+    m_released_count(0),
+    m_released_pages(0),
+    m_commit_mode(virtual_memory_commit_mode::lazy),
+    m_prefault_threads(1)
 {
 
 }
 
+template<std::size_t Pages, typename GrowthMultiplier>
+template<std::size_t UPages, typename>
+inline bit::memory::virtual_block_allocator<Pages,GrowthMultiplier>
+  ::virtual_block_allocator( virtual_memory_page_mode mode,
+                             GrowthMultiplier growth )
+  : base_type( std::forward_as_tuple(std::move(growth)) ),
+    m_memory(nullptr),
+    m_active_page(0),
+    m_cache(nullptr),
+    m_cache_size(0),
+    m_mode(mode),
+    m_released(nullptr),
+    m_released_count(0),
+    m_released_pages(0),
+    m_commit_mode(virtual_memory_commit_mode::lazy),
+    m_prefault_threads(1)
+{
+  m_memory = virtual_memory_reserve( Pages, mode, &m_mode );
+}
+
+template<std::size_t Pages, typename GrowthMultiplier>
+template<std::size_t UPages, typename>
+inline bit::memory::virtual_block_allocator<Pages,GrowthMultiplier>
+  ::virtual_block_allocator( std::size_t pages,
+                             virtual_memory_page_mode mode,
+                             GrowthMultiplier growth )
+  : base_type( std::forward_as_tuple(std::move(growth)) ),
+    pages_member(pages),
+    m_memory(nullptr),
+    m_active_page(0),
+    m_cache(nullptr),
+    m_cache_size(0),
+    m_mode(mode),
+    m_released(nullptr),
+    m_released_count(0),
+    m_released_pages(0),
+    m_commit_mode(virtual_memory_commit_mode::lazy),
+    m_prefault_threads(1)
+{
+  m_memory = virtual_memory_reserve( pages, mode, &m_mode );
+}
+
 template<std::size_t Pages, typename GrowthMultiplier>
 inline bit::memory::virtual_block_allocator<Pages,GrowthMultiplier>
   ::virtual_block_allocator( virtual_block_allocator&& other )
   noexcept
-  : m_memory( other.m_memory ),
+  : base_type( static_cast<base_type&&>(other) ),
+    pages_member( static_cast<pages_member&&>(other) ),
+    m_memory( other.m_memory ),
     m_active_page( other.m_active_page ),
-    m_cache( std::move(other.m_cache) )
+    m_cache( other.m_cache ),
+    m_cache_size( other.m_cache_size ),
+    m_mode( other.m_mode ),
+    m_released( other.m_released ),
+    m_released_count( other.m_released_count ),
+    m_released_pages( other.m_released_pages ),
+    m_commit_mode( other.m_commit_mode ),
+    m_prefault_threads( other.m_prefault_threads )
 {
-  other.m_memory      = nullptr;
-  other.m_active_page = 0;
+  other.m_memory         = nullptr;
+  other.m_active_page    = 0;
+  other.m_cache          = nullptr;
+  other.m_cache_size     = 0;
+  other.m_released       = nullptr;
+  other.m_released_count = 0;
+  other.m_released_pages = 0;
 }
 
 template<std::size_t Pages, typename GrowthMultiplier>
@@ -46,7 +118,10 @@ inline bit::memory::virtual_block_allocator<Pages,GrowthMultiplier>
 {
   // Releasing also decommits memory
   if( m_memory ) {
-    virtual_memory_release( m_memory, pages_member::value() );
+    virtual_memory_release( m_memory, pages_member::value(), m_mode );
+  }
+  if( m_released ) {
+    virtual_memory_release( m_released, released_capacity_pages() );
   }
 }
 
@@ -64,8 +139,27 @@ inline bit::memory::owner<bit::memory::memory_block>
 
   const auto total_pages = pages_member::value();
 
-  if( !m_cache.empty() ) {
-    return m_cache.request_block();
+  if( m_cache != nullptr ) {
+    const auto block = m_cache->block;
+
+    m_cache       = m_cache->next;
+    m_cache_size -= block.size();
+
+    return block;
+  }
+
+  // Previously released blocks are recommitted before any new pages
+  if( m_released_count != 0 ) {
+    const auto block = m_released[m_released_count - 1];
+    const auto pages = block.size() / page_size();
+
+    if( commit_pages( block.data(), pages ) == nullptr ) {
+      return nullblock;
+    }
+
+    --m_released_count;
+
+    return block;
   }
 
   if( (static_cast<std::size_t>(m_active_page) >= total_pages) ) {
@@ -76,11 +170,11 @@ inline bit::memory::owner<bit::memory::memory_block>
   const auto multiplier = growth.multiplier();
   const auto remaining  = total_pages - m_active_page;
   const auto pages      = (multiplier < remaining) ? multiplier : remaining;
-  const auto page_size  = virtual_memory_page_size();
+  const auto page_size  = this->page_size();
   const auto block_size = page_size * pages;
 
   auto v = static_cast<byte_t*>(m_memory) + (m_active_page * page_size);
-  auto p = virtual_memory_commit( v, pages );
+  auto p = commit_pages( v, pages );
 
   m_active_page += pages;
 
@@ -96,7 +190,71 @@ inline void bit::memory::virtual_block_allocator<Pages,GrowthPolicy>
   ::deallocate_block( owner<memory_block> block )
   noexcept
 {
-  m_cache.store_block( block );
+  auto* const entry = static_cast<cache_entry*>(block.data());
+
+  m_cache = uninitialized_construct_at<cache_entry>(
+    entry, cache_entry{ block, m_cache, clock_type::now() }
+  );
+  m_cache_size += block.size();
+}
+
+//-----------------------------------------------------------------------------
+// Commit Mode
+//-----------------------------------------------------------------------------
+
+template<std::size_t Pages, typename GrowthPolicy>
+inline void bit::memory::virtual_block_allocator<Pages,GrowthPolicy>
+  ::set_commit_mode( virtual_memory_commit_mode mode, std::size_t threads )
+  noexcept
+{
+  m_commit_mode      = mode;
+  m_prefault_threads = threads;
+}
+
+template<std::size_t Pages, typename GrowthPolicy>
+inline bit::memory::virtual_memory_commit_mode
+  bit::memory::virtual_block_allocator<Pages,GrowthPolicy>::commit_mode()
+  const noexcept
+{
+  return m_commit_mode;
+}
+
+//-----------------------------------------------------------------------------
+// Trimming
+//-----------------------------------------------------------------------------
+
+template<std::size_t Pages, typename GrowthPolicy>
+inline std::size_t bit::memory::virtual_block_allocator<Pages,GrowthPolicy>
+  ::release_unused( std::size_t max_retained_bytes )
+  noexcept
+{
+  auto retained = std::size_t{0};
+  auto entry    = &m_cache;
+
+  // Keep the most recent blocks that fit within the retained budget
+  while( *entry != nullptr &&
+         (retained + (*entry)->block.size()) <= max_retained_bytes ) {
+    retained += (*entry)->block.size();
+    entry = &(*entry)->next;
+  }
+
+  return release_from( entry );
+}
+
+template<std::size_t Pages, typename GrowthPolicy>
+inline std::size_t bit::memory::virtual_block_allocator<Pages,GrowthPolicy>
+  ::release_idle( clock_type::duration max_idle, clock_type::time_point now )
+  noexcept
+{
+  auto entry = &m_cache;
+
+  // Blocks are cached in order of release, so every block after the first
+  // idle one is also idle
+  while( *entry != nullptr && (now - (*entry)->released) < max_idle ) {
+    entry = &(*entry)->next;
+  }
+
+  return release_from( entry );
 }
 
 //-----------------------------------------------------------------------------
@@ -110,8 +268,12 @@ inline std::size_t bit::memory::virtual_block_allocator<Pages,GrowthPolicy>
 {
   using ::bit::memory::get;
 
-  if( !m_cache.empty() ) {
-    return m_cache.peek().size();
+  if( m_cache != nullptr ) {
+    return m_cache->block.size();
+  }
+
+  if( m_released_count != 0 ) {
+    return m_released[m_released_count - 1].size();
   }
 
   const auto total_pages = pages_member::value();
@@ -123,9 +285,32 @@ inline std::size_t bit::memory::virtual_block_allocator<Pages,GrowthPolicy>
   const auto remaining  = total_pages - m_active_page;
   const auto multiplier = get<0>(*this).multiplier();
   const auto pages      = (multiplier < remaining) ? multiplier : remaining;
-  const auto page_size  = virtual_memory_page_size();
 
-  return page_size * pages;
+  return page_size() * pages;
+}
+
+template<std::size_t Pages, typename GrowthPolicy>
+inline std::size_t bit::memory::virtual_block_allocator<Pages,GrowthPolicy>
+  ::retained_size()
+  const noexcept
+{
+  return m_cache_size;
+}
+
+template<std::size_t Pages, typename GrowthPolicy>
+inline std::size_t bit::memory::virtual_block_allocator<Pages,GrowthPolicy>
+  ::page_size()
+  const noexcept
+{
+  return virtual_memory_page_size( m_mode );
+}
+
+template<std::size_t Pages, typename GrowthPolicy>
+inline bit::memory::virtual_memory_page_mode
+  bit::memory::virtual_block_allocator<Pages,GrowthPolicy>::page_mode()
+  const noexcept
+{
+  return m_mode;
 }
 
 template<std::size_t Pages, typename GrowthPolicy>
@@ -136,4 +321,77 @@ inline bit::memory::allocator_info
   return {"virtual_block_allocator",this};
 }
 
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+template<std::size_t Pages, typename GrowthPolicy>
+inline std::size_t bit::memory::virtual_block_allocator<Pages,GrowthPolicy>
+  ::release_from( cache_entry** entry )
+  noexcept
+{
+  using byte_t = unsigned char;
+
+  // Every block spans at least one page, so there can never be more
+  // released blocks than there are pages
+  if( *entry != nullptr && m_released == nullptr ) {
+    m_released = static_cast<memory_block*>(
+      virtual_memory_reserve( released_capacity_pages() )
+    );
+    if( m_released == nullptr ) return 0;
+  }
+
+  const auto standard_page_size = virtual_memory_page_size();
+  auto released = std::size_t{0};
+
+  while( *entry != nullptr ) {
+    const auto required = (m_released_count + 1) * sizeof(memory_block);
+
+    if( required > (m_released_pages * standard_page_size) ) {
+      auto* const page = static_cast<byte_t*>(static_cast<void*>(m_released))
+                       + (m_released_pages * standard_page_size);
+
+      if( virtual_memory_commit( page, 1 ) == nullptr ) break;
+
+      ++m_released_pages;
+    }
+
+    const auto block = (*entry)->block;
+    *entry = (*entry)->next;
+
+    virtual_memory_decommit( block.data(), block.size() / page_size(), m_mode );
+
+    m_released[m_released_count++] = block;
+    m_cache_size -= block.size();
+    released     += block.size();
+  }
+
+  return released;
+}
+
+template<std::size_t Pages, typename GrowthPolicy>
+inline void* bit::memory::virtual_block_allocator<Pages,GrowthPolicy>
+  ::commit_pages( void* p, std::size_t pages )
+  noexcept
+{
+  if( virtual_memory_commit( p, pages, m_mode ) == nullptr ) return nullptr;
+
+  if( m_commit_mode == virtual_memory_commit_mode::prefault ) {
+    virtual_memory_prefault( p, pages * page_size(), m_prefault_threads );
+  }
+
+  return p;
+}
+
+template<std::size_t Pages, typename GrowthPolicy>
+inline std::size_t bit::memory::virtual_block_allocator<Pages,GrowthPolicy>
+  ::released_capacity_pages()
+  const noexcept
+{
+  const auto standard_page_size = virtual_memory_page_size();
+  const auto bytes = pages_member::value() * sizeof(memory_block);
+
+  return (bytes + standard_page_size - 1) / standard_page_size;
+}
+
 #endif /* BIT_MEMORY_BLOCK_ALLOCATORS_DETAIL_VIRTUAL_BLOCK_ALLOCATOR_INL */
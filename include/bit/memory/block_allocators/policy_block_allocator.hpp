@@ -40,6 +40,7 @@
 #include "../utilities/owner.hpp"                  // owner
 
 #include "../concepts/BlockAllocator.hpp" // block_allocator_has
+#include "../concepts/MemoryTracker.hpp"  // memory_tracker_is_thread_safe
 
 #include "../traits/block_allocator_traits.hpp" // block_allocator_traits
 
@@ -90,6 +91,8 @@ namespace bit {
     /// \tparam MemoryTagger A class used for tagging memory on allocations and
     ///                      on deallocations.
     /// \tparam MemoryTracker A class used for tracking memory allocations.
+    ///                       Trackers that declare themselves thread-safe
+    ///                       are notified outside of the lock.
     /// \tparam BoundsChecker A class used for bounds checking; used to
     ///                       catch buffer-overflow issues
     /// \tparam BasicLockable A lockable type for thread-synchronization
@@ -108,6 +111,11 @@ namespace bit {
                                             MemoryTracker,
                                             BasicLockable>;
 
+      /// Thread-safe trackers are notified outside of the lock, so that they
+      /// do not lengthen the critical section
+      static constexpr bool s_track_in_lock
+        = !memory_tracker_is_thread_safe<MemoryTracker>::value;
+
       //-----------------------------------------------------------------------
       // Public Member Types
       //-----------------------------------------------------------------------
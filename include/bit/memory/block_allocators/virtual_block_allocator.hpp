@@ -35,17 +35,19 @@
 
 #include "detail/named_block_allocator.hpp" // detail::named_block_allocator
 
-#include "../regions/virtual_memory.hpp"
+#include "../regions/virtual_memory.hpp" // virtual_memory_reserve, etc
 
-#include "../utilities/ebo_storage.hpp"        // ebo_storage
-#include "../utilities/dynamic_size_type.hpp"  // dynamic_size, etc
-#include "../utilities/allocator_info.hpp"     // allocator_info
-#include "../utilities/memory_block_cache.hpp" // memory_block_cache
-#include "../utilities/owner.hpp"              // owner
+#include "../utilities/ebo_storage.hpp"           // ebo_storage
+#include "../utilities/dynamic_size_type.hpp"     // dynamic_size, etc
+#include "../utilities/allocator_info.hpp"        // allocator_info
+#include "../utilities/memory_block.hpp"          // memory_block
+#include "../utilities/owner.hpp"                 // owner
+#include "../utilities/uninitialized_storage.hpp" // uninitialized_construct_at
 
 #include "../policies/growth_multipliers/no_growth.hpp" // no_growth
 
-#include <cstddef> // std::size_t
+#include <chrono>      // std::chrono::steady_clock
+#include <cstddef>     // std::size_t
 #include <type_traits> // std::enable_if
 
 namespace bit {
@@ -58,6 +60,23 @@ namespace bit {
     /// them as they get requested. Any blocks that get deleted are simply
     /// cached for later use, rather than being decommitted each time.
     ///
+    /// Cached blocks can be given back to the system with
+    /// \c release_unused, which retains only a bounded number of bytes, or
+    /// with \c release_idle, which decommits blocks that have sat unused in
+    /// the cache for longer than a given duration. Released blocks keep
+    /// their reservation, and are committed again before any fresh pages
+    /// are used.
+    ///
+    /// The pages may optionally be huge pages, by constructing with a
+    /// \ref virtual_memory_page_mode. In that case, \p Pages counts huge
+    /// pages, and each block is committed in whole huge-page granules. The
+    /// page size in effect is available from \c page_size().
+    ///
+    /// Committed pages are faulted in lazily on first access by default.
+    /// Latency-sensitive programs can instead have each block prefaulted
+    /// as it is committed, optionally split across several threads, with
+    /// \c set_commit_mode.
+    ///
     /// \satisfies{BlockAllocator}
     ///////////////////////////////////////////////////////////////////////////
     template<std::size_t Pages, typename GrowthMultiplier=no_growth_multiplier>
@@ -68,6 +87,14 @@ namespace bit {
       using base_type    = ebo_storage<GrowthMultiplier>;
       using pages_member = dynamic_size_type<0,Pages>;
 
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      /// The clock used to determine how long a block has been cached
+      using clock_type = std::chrono::steady_clock;
+
       //-----------------------------------------------------------------------
       // Constructors
       //-----------------------------------------------------------------------
@@ -91,6 +118,34 @@ namespace bit {
       explicit virtual_block_allocator( std::size_t pages,
                                         GrowthMultiplier growth = GrowthMultiplier{} );
 
+      /// \brief Constructs a virtual_block_allocator that reserves the
+      ///        specified number of \p pages up front, of the page \p mode
+      ///
+      /// If the system cannot provide pages of \p mode, this falls back to
+      /// the nearest supported mode; see \c page_mode()
+      ///
+      /// \param mode the requested page mode
+      /// \param growth the growth multiplier
+      template<std::size_t UPages=Pages,
+               typename=std::enable_if_t<UPages!=dynamic_size>>
+      explicit virtual_block_allocator( virtual_memory_page_mode mode,
+                                        GrowthMultiplier growth = GrowthMultiplier{} );
+
+      /// \brief Constructs a virtual_block_allocator that reserves the
+      ///        specified number of \p pages up front, of the page \p mode
+      ///
+      /// If the system cannot provide pages of \p mode, this falls back to
+      /// the nearest supported mode; see \c page_mode()
+      ///
+      /// \param pages the number of pages to reserve
+      /// \param mode the requested page mode
+      /// \param growth the growth multiplier
+      template<std::size_t UPages=Pages,
+               typename=std::enable_if_t<UPages==dynamic_size>>
+      virtual_block_allocator( std::size_t pages,
+                               virtual_memory_page_mode mode,
+                               GrowthMultiplier growth = GrowthMultiplier{} );
+
       /// \brief Move-constructs a virtual_block_allocator from another one
       ///
       /// \param other the other virtual_block_allocator to move
@@ -128,6 +183,51 @@ namespace bit {
       /// \param block the block to deallocate
       void deallocate_block( owner<memory_block> block ) noexcept;
 
+      //-----------------------------------------------------------------------
+      // Commit Mode
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Sets how pages are made resident when blocks are committed
+      ///
+      /// \param mode the commit mode
+      /// \param threads the number of threads used to prefault each block
+      void set_commit_mode( virtual_memory_commit_mode mode,
+                            std::size_t threads = 1 ) noexcept;
+
+      /// \brief Gets how pages are made resident when blocks are committed
+      ///
+      /// \return the commit mode
+      virtual_memory_commit_mode commit_mode() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Trimming
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Decommits cached blocks so that no more than
+      ///        \p max_retained_bytes remain committed in the cache
+      ///
+      /// The most recently deallocated blocks are retained, since they are
+      /// the most likely to still be resident in the caches.
+      ///
+      /// \param max_retained_bytes the number of cached bytes to keep
+      /// \return the number of bytes decommitted
+      std::size_t release_unused( std::size_t max_retained_bytes = 0 ) noexcept;
+
+      /// \brief Decommits every cached block that was deallocated at least
+      ///        \p max_idle before \p now
+      ///
+      /// This is intended to be invoked periodically by long-running
+      /// programs, so that memory retained after a spike in usage decays
+      /// back to the system over time.
+      ///
+      /// \param max_idle the longest time a block may remain cached
+      /// \param now the current time
+      /// \return the number of bytes decommitted
+      std::size_t release_idle( clock_type::duration max_idle,
+                                clock_type::time_point now = clock_type::now() ) noexcept;
+
       //-----------------------------------------------------------------------
       // Observers
       //-----------------------------------------------------------------------
@@ -138,6 +238,22 @@ namespace bit {
       /// \return the size of the next allocated block
       std::size_t next_block_size() const noexcept;
 
+      /// \brief Gets the number of bytes that are committed, but are cached
+      ///        in this allocator rather than in use
+      ///
+      /// \return the number of retained bytes
+      std::size_t retained_size() const noexcept;
+
+      /// \brief Gets the size of each page committed by this allocator
+      ///
+      /// \return the page size, in bytes
+      std::size_t page_size() const noexcept;
+
+      /// \brief Gets the page mode in effect for this allocator
+      ///
+      /// \return the page mode
+      virtual_memory_page_mode page_mode() const noexcept;
+
       /// \brief Gets the info about this allocator
       ///
       /// This defaults to 'virtual_block_allocator'.
@@ -146,14 +262,57 @@ namespace bit {
       /// \return the info for this allocator
       allocator_info info() const noexcept;
 
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief The entry stored at the start of each cached block
+      struct cache_entry
+      {
+        memory_block           block;    ///< The cached block
+        cache_entry*           next;     ///< The next (less recent) entry
+        clock_type::time_point released; ///< When the block was cached
+      };
+
       //-----------------------------------------------------------------------
       // Private Members
       //-----------------------------------------------------------------------
     private:
 
-      void*              m_memory;      ///< The virtual memory to access from
-      std::ptrdiff_t     m_active_page; ///< The currently active page
-      memory_block_cache m_cache;       ///< Cache of already committed pages
+      void*                    m_memory;      ///< The virtual memory to access from
+      std::ptrdiff_t           m_active_page; ///< The currently active page
+      cache_entry*             m_cache;       ///< Cache of already committed pages
+      std::size_t              m_cache_size;  ///< Bytes in the cache
+      virtual_memory_page_mode m_mode;        ///< The page mode in effect
+
+      memory_block*            m_released;       ///< Stack of decommitted blocks
+      std::size_t              m_released_count; ///< Entries in m_released
+      std::size_t              m_released_pages; ///< Committed pages of m_released
+
+      virtual_memory_commit_mode m_commit_mode;      ///< How blocks are committed
+      std::size_t                m_prefault_threads; ///< Threads used to prefault
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Decommits \p entry and every entry after it in the cache
+      ///
+      /// \param entry the first entry to decommit
+      /// \return the number of bytes decommitted
+      std::size_t release_from( cache_entry** entry ) noexcept;
+
+      /// \brief Commits the \p pages pages at \p p, prefaulting them if
+      ///        requested
+      ///
+      /// \return \p p on success, \c nullptr on failure
+      void* commit_pages( void* p, std::size_t pages ) noexcept;
+
+      /// \brief Gets the number of standard pages needed to record every
+      ///        released block
+      std::size_t released_capacity_pages() const noexcept;
     };
 
     //-------------------------------------------------------------------------
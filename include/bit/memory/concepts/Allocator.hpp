@@ -164,6 +164,28 @@ namespace bit {
     /// - - - - -
     ///
     /// \code
+    /// k = a.try_allocate_n( s, n, c, o )
+    /// \endcode
+    /// \c a tries to make \c c allocations of at least \c s bytes aligned to
+    /// the boundary \c n, writing each pointer to the array \c o. Returns the
+    /// number of allocations \c k that were written to the front of \c o,
+    /// which is less than \c c if the allocator was exhausted.
+    ///
+    /// The default is to call \c a.try_allocate \c c times.
+    ///
+    /// - - - - -
+    ///
+    /// \code
+    /// a.deallocate_n( o, c, s )
+    /// \endcode
+    /// Deallocates the \c c pointers in the array \c o, each with the
+    /// allocation size \c s.
+    ///
+    /// The default is to call \c a.deallocate \c c times.
+    ///
+    /// - - - - -
+    ///
+    /// \code
     /// A::default_alignment::value
     /// \endcode
     /// Determines the default-alignment of allocations from the given
@@ -459,6 +481,34 @@ namespace bit {
         >
       > : std::true_type{};
 
+      //----------------------------------------------------------------------
+
+      template<typename T, typename = void>
+      struct allocator_has_try_allocate_n : std::false_type{};
+
+      template<typename T>
+      struct allocator_has_try_allocate_n<T,
+        void_t<decltype(std::declval<allocator_size_type_t<T>&>()
+          = std::declval<T&>().try_allocate_n( std::declval<allocator_size_type_t<T>>(),
+                                               std::declval<allocator_size_type_t<T>>(),
+                                               std::declval<allocator_size_type_t<T>>(),
+                                               std::declval<allocator_pointer_t<T>*>() ))
+        >
+      > : std::true_type{};
+
+      //----------------------------------------------------------------------
+
+      template<typename T, typename = void>
+      struct allocator_has_deallocate_n : std::false_type{};
+
+      template<typename T>
+      struct allocator_has_deallocate_n<T,
+        void_t<decltype(std::declval<T&>().deallocate_n( std::declval<allocator_pointer_t<T>*>(),
+                                                         std::declval<allocator_size_type_t<T>>(),
+                                                         std::declval<allocator_size_type_t<T>>() ))
+        >
+      > : std::true_type{};
+
     } // namespace detail
 
     /// \brief Type-trait to determine whether \p T has a 'try_allocate'
@@ -820,6 +870,44 @@ namespace bit {
 
     //-------------------------------------------------------------------------
 
+    /// \brief Type trait to determine whether the allocator has the
+    ///        try_allocate_n function for batch allocations
+    ///
+    /// The result is aliased as \c ::value
+    ///
+    /// \tparam T the type to check
+    template<typename T>
+    struct allocator_has_try_allocate_n
+      : detail::allocator_has_try_allocate_n<T>{};
+
+    /// \brief Convenience template bool for accessing
+    ///        \c allocator_has_try_allocate_n<T>::value
+    ///
+    /// \tparam T the type to check
+    template<typename T>
+    constexpr bool allocator_has_try_allocate_n_v = allocator_has_try_allocate_n<T>::value;
+
+    //-------------------------------------------------------------------------
+
+    /// \brief Type trait to determine whether the allocator has the
+    ///        deallocate_n function for batch deallocations
+    ///
+    /// The result is aliased as \c ::value
+    ///
+    /// \tparam T the type to check
+    template<typename T>
+    struct allocator_has_deallocate_n
+      : detail::allocator_has_deallocate_n<T>{};
+
+    /// \brief Convenience template bool for accessing
+    ///        \c allocator_has_deallocate_n<T>::value
+    ///
+    /// \tparam T the type to check
+    template<typename T>
+    constexpr bool allocator_has_deallocate_n_v = allocator_has_deallocate_n<T>::value;
+
+    //-------------------------------------------------------------------------
+
     /// \brief Type-trait to determine whether \p T satisfies the minimum
     ///        requirements to be an \c Allocator
     ///
@@ -98,6 +98,17 @@ namespace bit {
     /// It is at this time that finalization of the tracking may occur (e.g.
     /// determining global memory leaks)
     ///
+    /// **Optional**
+    ///
+    /// \code
+    /// T::is_thread_safe
+    /// \endcode
+    ///
+    /// If this is \c std::true_type, \c T may be notified from multiple
+    /// threads at once, so it does not need to be serialized by the lock of
+    /// the allocator that owns it. If not specified, \c T is assumed to not
+    /// be thread-safe
+    ///
     ///////////////////////////////////////////////////////////////////////////
 #if __cplusplus >= 202000L
     // TODO(bitwize) replace 202000L with the correct __cplusplus when certified
@@ -156,6 +167,16 @@ namespace bit {
         decltype( std::declval<T&>().finalize( std::declval<allocator_info>() ) )
       >> : std::true_type{};
 
+      //-----------------------------------------------------------------------
+
+      template<typename T, typename = void>
+      struct memory_tracker_is_thread_safe_impl : std::false_type{};
+
+      template<typename T>
+      struct memory_tracker_is_thread_safe_impl<T,
+        void_t<typename T::is_thread_safe>>
+        : T::is_thread_safe{};
+
     } // namespace detail
 
     /// \brief Type-trait determining whether \p T is a \c MemoryTracker
@@ -179,6 +200,26 @@ namespace bit {
     template<typename T>
     constexpr bool is_memory_tracker_v = is_memory_tracker<T>::value;
 
+    //-------------------------------------------------------------------------
+
+    /// \brief Type-trait to determine whether the \c MemoryTracker \p T may
+    ///        be notified from multiple threads at once
+    ///
+    /// The result is aliased as \c ::value
+    ///
+    /// \tparam T the type to check
+    template<typename T>
+    struct memory_tracker_is_thread_safe
+      : detail::memory_tracker_is_thread_safe_impl<T>{};
+
+    /// \brief Convenience template variable for accessing
+    ///        \c memory_tracker_is_thread_safe<T>::value
+    ///
+    /// \tparam T the type to check
+    template<typename T>
+    constexpr bool memory_tracker_is_thread_safe_v
+      = memory_tracker_is_thread_safe<T>::value;
+
   } // namespace memory
 } // namespace bit
 
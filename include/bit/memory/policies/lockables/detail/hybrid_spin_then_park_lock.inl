@@ -0,0 +1,88 @@
+#ifndef BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_HYBRID_SPIN_THEN_PARK_LOCK_INL
+#define BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_HYBRID_SPIN_THEN_PARK_LOCK_INL
+
+//=============================================================================
+// class definitions : hybrid_spin_then_park_lock
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+inline bit::memory::hybrid_spin_then_park_lock::hybrid_spin_then_park_lock()
+  : hybrid_spin_then_park_lock(default_spin_count)
+{
+
+}
+
+inline bit::memory::hybrid_spin_then_park_lock
+  ::hybrid_spin_then_park_lock( std::size_t spin_count )
+  : m_state(s_unlocked),
+    m_spin_count(spin_count),
+    m_park_mutex(),
+    m_park_condition()
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Locking
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::hybrid_spin_then_park_lock::lock()
+{
+  if( try_lock() ) return;
+
+  for( auto i = std::size_t{0}; i < m_spin_count; ++i ) {
+    detail::cpu_relax();
+
+    // Don't compete with parked threads for the lock
+    const auto state = m_state.load(std::memory_order_relaxed);
+    if( state == s_parked ) break;
+    if( state == s_unlocked && try_lock() ) return;
+  }
+
+  // Mark the lock as having waiters; taking it while doing so is also
+  // marked, since other threads may still be parked behind us
+  while( m_state.exchange(s_parked, std::memory_order_acquire) != s_unlocked ) {
+    auto guard = std::unique_lock<std::mutex>{m_park_mutex};
+
+    // The state is re-checked under the mutex, which unlock acquires before
+    // notifying, so the wake-up cannot be lost
+    m_park_condition.wait(guard, [this]{
+      return m_state.load(std::memory_order_relaxed) != s_parked;
+    });
+  }
+}
+
+inline bool bit::memory::hybrid_spin_then_park_lock::try_lock()
+  noexcept
+{
+  auto expected = s_unlocked;
+
+  return m_state.compare_exchange_strong( expected, s_locked,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed );
+}
+
+inline void bit::memory::hybrid_spin_then_park_lock::unlock()
+{
+  if( m_state.exchange(s_unlocked, std::memory_order_release) == s_parked ) {
+    {
+      std::lock_guard<std::mutex> guard{m_park_mutex};
+    }
+    m_park_condition.notify_one();
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::hybrid_spin_then_park_lock::spin_count()
+  const noexcept
+{
+  return m_spin_count;
+}
+
+#endif /* BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_HYBRID_SPIN_THEN_PARK_LOCK_INL */
@@ -0,0 +1,128 @@
+#ifndef BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_MCS_LOCK_INL
+#define BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_MCS_LOCK_INL
+
+//=============================================================================
+// class definitions : mcs_lock
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+inline bit::memory::mcs_lock::mcs_lock()
+  noexcept
+  : m_tail(nullptr),
+    m_holder(nullptr)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Locking
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::mcs_lock::lock()
+  noexcept
+{
+  auto* const node = acquire_node();
+
+  node->next.store(nullptr, std::memory_order_relaxed);
+  node->waiting.store(true, std::memory_order_relaxed);
+
+  auto* const prev = m_tail.exchange(node, std::memory_order_acq_rel);
+
+  if( prev != nullptr ) {
+    prev->next.store(node, std::memory_order_release);
+
+    // The predecessor clears 'waiting' when it hands the lock over
+    auto backoff = detail::spin_backoff{};
+    while( node->waiting.load(std::memory_order_acquire) ) {
+      backoff.pause();
+    }
+  }
+
+  m_holder = node;
+}
+
+inline bool bit::memory::mcs_lock::try_lock()
+  noexcept
+{
+  auto* const node = acquire_node();
+
+  node->next.store(nullptr, std::memory_order_relaxed);
+  node->waiting.store(false, std::memory_order_relaxed);
+
+  auto* expected = static_cast<queue_node*>(nullptr);
+  if( m_tail.compare_exchange_strong( expected, node,
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_relaxed ) ) {
+    m_holder = node;
+    return true;
+  }
+
+  release_node(node);
+  return false;
+}
+
+inline void bit::memory::mcs_lock::unlock()
+  noexcept
+{
+  auto* const node = m_holder;
+  auto* next = node->next.load(std::memory_order_acquire);
+
+  if( next == nullptr ) {
+    auto* expected = node;
+
+    // No successor; the queue is empty if we are still the tail
+    if( m_tail.compare_exchange_strong( expected, nullptr,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed ) ) {
+      release_node(node);
+      return;
+    }
+
+    // A successor has swapped the tail, but has not linked itself in yet
+    auto backoff = detail::spin_backoff{};
+    while( (next = node->next.load(std::memory_order_acquire)) == nullptr ) {
+      backoff.pause();
+    }
+  }
+
+  next->waiting.store(false, std::memory_order_release);
+  release_node(node);
+}
+
+//-----------------------------------------------------------------------------
+// Private Static Functions
+//-----------------------------------------------------------------------------
+
+inline bit::memory::mcs_lock::queue_node*
+  bit::memory::mcs_lock::acquire_node()
+  noexcept
+{
+  struct node_cache
+  {
+    queue_node nodes[max_held_locks];
+  };
+
+  // Zero-initialized, as with any object of thread storage duration
+  static thread_local node_cache cache;
+
+  for( auto& node : cache.nodes ) {
+    if( !node.in_use ) {
+      node.in_use = true;
+      return &node;
+    }
+  }
+
+  assert( false && "thread holds too many mcs_locks" );
+  return nullptr;
+}
+
+inline void bit::memory::mcs_lock::release_node( queue_node* node )
+  noexcept
+{
+  node->in_use = false;
+}
+
+#endif /* BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_MCS_LOCK_INL */
@@ -0,0 +1,129 @@
+/*****************************************************************************
+ * \file
+ * \brief This internal header contains the spin-wait utilities shared by the
+ *        spinning lock policies
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_SPIN_BACKOFF_HPP
+#define BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_SPIN_BACKOFF_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <thread> // std::this_thread::yield
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+# include <intrin.h> // _mm_pause
+#endif
+
+namespace bit {
+  namespace memory {
+    namespace detail {
+
+      /// \brief Hints to the processor that the calling thread is in a
+      ///        spin-wait loop
+      ///
+      /// This lowers the cost of spinning on a hyper-threaded core, and
+      /// avoids the memory-order mis-speculation penalty on exiting the loop
+      inline void cpu_relax()
+        noexcept
+      {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+        _mm_pause();
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+        __builtin_ia32_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+        __asm__ __volatile__("yield");
+#endif
+      }
+
+      /////////////////////////////////////////////////////////////////////////
+      /// \brief Truncated exponential backoff for spin-wait loops
+      ///
+      /// Each call to \c pause spins for twice as many \c cpu_relax
+      /// instructions as the last, up to \c max_spins. Once saturated, the
+      /// thread yields its time slice instead, so that a preempted lock
+      /// holder is able to make progress.
+      /////////////////////////////////////////////////////////////////////////
+      class spin_backoff
+      {
+        //---------------------------------------------------------------------
+        // Public Constants
+        //---------------------------------------------------------------------
+      public:
+
+        /// The largest number of relax instructions issued by one pause
+        static constexpr unsigned max_spins = 1024;
+
+        //---------------------------------------------------------------------
+        // Backoff
+        //---------------------------------------------------------------------
+      public:
+
+        /// \brief Waits for the current backoff period, and doubles it
+        void pause()
+          noexcept
+        {
+          if( m_spins > max_spins ) {
+            std::this_thread::yield();
+            return;
+          }
+          for( auto i = 0u; i < m_spins; ++i ) {
+            cpu_relax();
+          }
+          m_spins <<= 1;
+        }
+
+        /// \brief Determines whether the backoff has reached its limit
+        ///
+        /// \return \c true if the next pause will yield
+        bool is_saturated()
+          const noexcept
+        {
+          return m_spins > max_spins;
+        }
+
+        /// \brief Resets the backoff period to a single relax
+        void reset()
+          noexcept
+        {
+          m_spins = 1;
+        }
+
+        //---------------------------------------------------------------------
+        // Private Members
+        //---------------------------------------------------------------------
+      private:
+
+        unsigned m_spins = 1;
+      };
+
+    } // namespace detail
+  } // namespace memory
+} // namespace bit
+
+#endif /* BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_SPIN_BACKOFF_HPP */
@@ -0,0 +1,49 @@
+#ifndef BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_SPIN_LOCK_INL
+#define BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_SPIN_LOCK_INL
+
+//=============================================================================
+// class definitions : spin_lock
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+inline bit::memory::spin_lock::spin_lock()
+  noexcept
+  : m_locked(false)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Locking
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::spin_lock::lock()
+  noexcept
+{
+  auto backoff = detail::spin_backoff{};
+
+  while( m_locked.exchange(true, std::memory_order_acquire) ) {
+    // Wait on a read-only load, so the line stays shared while it is held
+    do {
+      backoff.pause();
+    } while( m_locked.load(std::memory_order_relaxed) );
+  }
+}
+
+inline bool bit::memory::spin_lock::try_lock()
+  noexcept
+{
+  return !m_locked.load(std::memory_order_relaxed) &&
+         !m_locked.exchange(true, std::memory_order_acquire);
+}
+
+inline void bit::memory::spin_lock::unlock()
+  noexcept
+{
+  m_locked.store(false, std::memory_order_release);
+}
+
+#endif /* BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_SPIN_LOCK_INL */
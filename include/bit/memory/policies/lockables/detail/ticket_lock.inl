@@ -0,0 +1,72 @@
+#ifndef BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_TICKET_LOCK_INL
+#define BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_TICKET_LOCK_INL
+
+//=============================================================================
+// class definitions : ticket_lock
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+inline bit::memory::ticket_lock::ticket_lock()
+  noexcept
+  : m_next(0),
+    m_serving(0)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Locking
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::ticket_lock::lock()
+  noexcept
+{
+  const auto ticket = m_next.fetch_add(1, std::memory_order_relaxed);
+
+  auto spins = std::uint32_t{0};
+
+  while( true ) {
+    // Unsigned wrap-around keeps the distance correct once tickets overflow
+    const auto ahead = ticket - m_serving.load(std::memory_order_acquire);
+
+    if( ahead == 0 ) return;
+
+    // Yield once the wait is too long to be worth spinning through, so that
+    // a preempted holder (or waiter ahead of us) is able to run
+    if( ahead > s_max_spinning_waiters || spins >= s_max_spins ) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    for( auto i = std::uint32_t{0}; i < ahead * s_spins_per_waiter; ++i ) {
+      detail::cpu_relax();
+    }
+    spins += ahead * s_spins_per_waiter;
+  }
+}
+
+inline bool bit::memory::ticket_lock::try_lock()
+  noexcept
+{
+  // Acquire synchronizes with the release of the previous holder
+  auto ticket = m_serving.load(std::memory_order_acquire);
+
+  // Only take a ticket if it would be served immediately
+  return m_next.compare_exchange_strong( ticket, ticket + 1,
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed );
+}
+
+inline void bit::memory::ticket_lock::unlock()
+  noexcept
+{
+  // Only the holder writes to m_serving, so no read-modify-write is needed
+  const auto next = m_serving.load(std::memory_order_relaxed) + 1;
+
+  m_serving.store(next, std::memory_order_release);
+}
+
+#endif /* BIT_MEMORY_POLICIES_LOCKABLES_DETAIL_TICKET_LOCK_INL */
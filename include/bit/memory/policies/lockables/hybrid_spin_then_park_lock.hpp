@@ -0,0 +1,156 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a lock that spins briefly
+ *        before parking the waiting thread
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_POLICIES_LOCKABLES_HYBRID_SPIN_THEN_PARK_LOCK_HPP
+#define BIT_MEMORY_POLICIES_LOCKABLES_HYBRID_SPIN_THEN_PARK_LOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/spin_backoff.hpp" // detail::cpu_relax
+
+#include "../../concepts/BasicLockable.hpp"
+
+#include <atomic>             // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <cstdint>            // std::uint32_t
+#include <mutex>              // std::mutex
+
+namespace bit {
+  namespace memory {
+
+    //=========================================================================
+    // class : hybrid_spin_then_park_lock
+    //=========================================================================
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A BasicLockable that spins for a bounded number of attempts,
+    ///        and then parks the waiting thread until the lock is released
+    ///
+    /// Acquiring and releasing an uncontended lock is a single atomic
+    /// operation each. Short waits are absorbed by spinning, as with a
+    /// \c spin_lock, while long waits park the thread on a condition
+    /// variable so that an oversubscribed system does not burn processor
+    /// time on threads that cannot make progress.
+    ///
+    /// The lock word records whether any thread may be parked, so that
+    /// \c unlock only signals the condition variable when it is needed.
+    ///
+    /// \satisfies{BasicLockable}
+    ///////////////////////////////////////////////////////////////////////////
+    class hybrid_spin_then_park_lock
+    {
+      //-----------------------------------------------------------------------
+      // Public Constants
+      //-----------------------------------------------------------------------
+    public:
+
+      /// The default number of attempts made before parking
+      static constexpr std::size_t default_spin_count = 128;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an unlocked hybrid_spin_then_park_lock that
+      ///        spins \c default_spin_count times before parking
+      hybrid_spin_then_park_lock();
+
+      /// \brief Constructs an unlocked hybrid_spin_then_park_lock that
+      ///        spins \p spin_count times before parking
+      ///
+      /// \param spin_count the number of attempts made before parking
+      explicit hybrid_spin_then_park_lock( std::size_t spin_count );
+
+      // Deleted copy construction
+      hybrid_spin_then_park_lock( const hybrid_spin_then_park_lock& other ) = delete;
+
+      // Deleted copy assignment
+      hybrid_spin_then_park_lock& operator=( const hybrid_spin_then_park_lock& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Locking
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Blocks until the lock is acquired
+      void lock();
+
+      /// \brief Attempts to acquire the lock without blocking
+      ///
+      /// \return \c true if the lock was acquired
+      bool try_lock() noexcept;
+
+      /// \brief Releases the lock, waking a parked thread if there is one
+      ///
+      /// \pre the lock is held by the calling thread
+      void unlock();
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the number of attempts made before parking
+      ///
+      /// \return the spin count
+      std::size_t spin_count() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Constants
+      //-----------------------------------------------------------------------
+    private:
+
+      static constexpr std::uint32_t s_unlocked = 0;
+      static constexpr std::uint32_t s_locked   = 1;
+      static constexpr std::uint32_t s_parked   = 2; ///< locked, with waiters
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      std::atomic<std::uint32_t> m_state;
+      std::size_t                m_spin_count;
+      std::mutex                 m_park_mutex;
+      std::condition_variable    m_park_condition;
+    };
+
+    static_assert( is_basic_lockable_v<hybrid_spin_then_park_lock>,
+                   "hybrid_spin_then_park_lock must satisfy BasicLockable" );
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/hybrid_spin_then_park_lock.inl"
+
+#endif /* BIT_MEMORY_POLICIES_LOCKABLES_HYBRID_SPIN_THEN_PARK_LOCK_HPP */
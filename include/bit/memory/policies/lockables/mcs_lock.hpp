@@ -0,0 +1,158 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a queue-based MCS lock
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_POLICIES_LOCKABLES_MCS_LOCK_HPP
+#define BIT_MEMORY_POLICIES_LOCKABLES_MCS_LOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/spin_backoff.hpp" // detail::spin_backoff
+
+#include "../../concepts/BasicLockable.hpp"
+#include "../../utilities/cpu.hpp" // cache_line_size
+
+#include <atomic>  // std::atomic
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+
+namespace bit {
+  namespace memory {
+
+    //=========================================================================
+    // class : mcs_lock
+    //=========================================================================
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A fair BasicLockable where each waiter spins on its own cache
+    ///        line
+    ///
+    /// Waiting threads form a linked queue behind the lock's tail pointer,
+    /// and each spins only on a flag in its own queue node. A release hands
+    /// the lock directly to the next node, so it touches a single remote
+    /// cache line regardless of how many threads are waiting.
+    ///
+    /// The classic MCS interface passes the queue node to both \c lock and
+    /// \c unlock. To satisfy BasicLockable, the nodes are instead drawn from
+    /// a small per-thread cache, and the holder's node is remembered in the
+    /// lock itself. A thread may therefore hold at most \c max_held_locks
+    /// mcs_locks at once.
+    ///
+    /// \satisfies{BasicLockable}
+    ///////////////////////////////////////////////////////////////////////////
+    class mcs_lock
+    {
+      //-----------------------------------------------------------------------
+      // Public Constants
+      //-----------------------------------------------------------------------
+    public:
+
+      /// The number of mcs_locks that a single thread may hold at once
+      static constexpr std::size_t max_held_locks = 16;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an unlocked mcs_lock
+      mcs_lock() noexcept;
+
+      // Deleted copy construction
+      mcs_lock( const mcs_lock& other ) = delete;
+
+      // Deleted copy assignment
+      mcs_lock& operator=( const mcs_lock& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Locking
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Blocks until every earlier waiter has released the lock, and
+      ///        the lock is acquired
+      ///
+      /// \pre the calling thread holds fewer than \c max_held_locks
+      ///      mcs_locks
+      void lock() noexcept;
+
+      /// \brief Attempts to acquire the lock without blocking
+      ///
+      /// \pre the calling thread holds fewer than \c max_held_locks
+      ///      mcs_locks
+      ///
+      /// \return \c true if the lock was acquired
+      bool try_lock() noexcept;
+
+      /// \brief Releases the lock to the next waiting thread
+      ///
+      /// \pre the lock is held by the calling thread
+      void unlock() noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      struct alignas(cache_line_size) queue_node
+      {
+        std::atomic<queue_node*> next;
+        std::atomic<bool>        waiting;
+        bool                     in_use;
+      };
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      std::atomic<queue_node*> m_tail;   ///< The last node in the queue
+      queue_node*              m_holder; ///< The node of the lock's holder
+
+      //-----------------------------------------------------------------------
+      // Private Static Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Takes an unused queue node from the calling thread's cache
+      static queue_node* acquire_node() noexcept;
+
+      /// \brief Returns \p node to the calling thread's cache
+      static void release_node( queue_node* node ) noexcept;
+    };
+
+    static_assert( is_basic_lockable_v<mcs_lock>,
+                   "mcs_lock must satisfy BasicLockable" );
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/mcs_lock.inl"
+
+#endif /* BIT_MEMORY_POLICIES_LOCKABLES_MCS_LOCK_HPP */
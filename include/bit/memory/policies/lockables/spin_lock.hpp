@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a test-and-test-and-set
+ *        spin lock
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_POLICIES_LOCKABLES_SPIN_LOCK_HPP
+#define BIT_MEMORY_POLICIES_LOCKABLES_SPIN_LOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/spin_backoff.hpp" // detail::spin_backoff
+
+#include "../../concepts/BasicLockable.hpp"
+
+#include <atomic> // std::atomic
+
+namespace bit {
+  namespace memory {
+
+    //=========================================================================
+    // class : spin_lock
+    //=========================================================================
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A BasicLockable that busy-waits until the lock is available
+    ///
+    /// Waiting threads spin on a plain load, so that the cache line is only
+    /// written when the lock appears to be free, and back off exponentially
+    /// between attempts. This is intended for critical sections that are a
+    /// few nanoseconds long, where parking a thread costs far more than the
+    /// work being protected.
+    ///
+    /// The lock is not fair; a thread that has just released it may
+    /// immediately reacquire it.
+    ///
+    /// \satisfies{BasicLockable}
+    ///////////////////////////////////////////////////////////////////////////
+    class spin_lock
+    {
+      //-----------------------------------------------------------------------
+      // Constructors / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an unlocked spin_lock
+      spin_lock() noexcept;
+
+      // Deleted copy construction
+      spin_lock( const spin_lock& other ) = delete;
+
+      // Deleted copy assignment
+      spin_lock& operator=( const spin_lock& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Locking
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Blocks until the lock is acquired
+      void lock() noexcept;
+
+      /// \brief Attempts to acquire the lock without blocking
+      ///
+      /// \return \c true if the lock was acquired
+      bool try_lock() noexcept;
+
+      /// \brief Releases the lock
+      ///
+      /// \pre the lock is held by the calling thread
+      void unlock() noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      std::atomic<bool> m_locked;
+    };
+
+    static_assert( is_basic_lockable_v<spin_lock>,
+                   "spin_lock must satisfy BasicLockable" );
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/spin_lock.inl"
+
+#endif /* BIT_MEMORY_POLICIES_LOCKABLES_SPIN_LOCK_HPP */
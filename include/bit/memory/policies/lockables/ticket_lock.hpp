@@ -0,0 +1,131 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a first-in first-out
+ *        ticket lock
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_POLICIES_LOCKABLES_TICKET_LOCK_HPP
+#define BIT_MEMORY_POLICIES_LOCKABLES_TICKET_LOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "detail/spin_backoff.hpp" // detail::cpu_relax
+
+#include "../../concepts/BasicLockable.hpp"
+
+#include <atomic>  // std::atomic
+#include <cstdint> // std::uint32_t
+#include <thread>  // std::this_thread::yield
+
+namespace bit {
+  namespace memory {
+
+    //=========================================================================
+    // class : ticket_lock
+    //=========================================================================
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A fair BasicLockable that grants the lock in the order that it
+    ///        was requested
+    ///
+    /// Each thread takes the next ticket with a single atomic increment, and
+    /// spins until the ticket is being served. Since a waiter knows how many
+    /// threads are ahead of it, it backs off in proportion to its place in
+    /// the queue rather than exponentially, and yields once it has spun for
+    /// too long.
+    ///
+    /// Every waiter spins on the same cache line, so the cost of a release
+    /// grows with the number of waiters; prefer \c mcs_lock under heavy
+    /// contention.
+    ///
+    /// \satisfies{BasicLockable}
+    ///////////////////////////////////////////////////////////////////////////
+    class ticket_lock
+    {
+      //-----------------------------------------------------------------------
+      // Constructors / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an unlocked ticket_lock
+      ticket_lock() noexcept;
+
+      // Deleted copy construction
+      ticket_lock( const ticket_lock& other ) = delete;
+
+      // Deleted copy assignment
+      ticket_lock& operator=( const ticket_lock& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Locking
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Blocks until every earlier request has been served, and the
+      ///        lock is acquired
+      void lock() noexcept;
+
+      /// \brief Attempts to acquire the lock without blocking
+      ///
+      /// This only succeeds if the lock is free and nobody is waiting for it
+      ///
+      /// \return \c true if the lock was acquired
+      bool try_lock() noexcept;
+
+      /// \brief Releases the lock to the next waiting thread
+      ///
+      /// \pre the lock is held by the calling thread
+      void unlock() noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      /// The number of waiters for which a thread spins, rather than yields
+      static constexpr std::uint32_t s_max_spinning_waiters = 8;
+
+      /// The number of relax instructions issued per waiter ahead
+      static constexpr std::uint32_t s_spins_per_waiter = 64;
+
+      /// The number of relax instructions issued before a waiter yields
+      static constexpr std::uint32_t s_max_spins = 2 * 1024;
+
+      std::atomic<std::uint32_t> m_next;    ///< The next ticket to hand out
+      std::atomic<std::uint32_t> m_serving; ///< The ticket that holds the lock
+    };
+
+    static_assert( is_basic_lockable_v<ticket_lock>,
+                   "ticket_lock must satisfy BasicLockable" );
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/ticket_lock.inl"
+
+#endif /* BIT_MEMORY_POLICIES_LOCKABLES_TICKET_LOCK_HPP */
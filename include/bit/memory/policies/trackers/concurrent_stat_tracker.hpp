@@ -0,0 +1,288 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a statistic-recording
+ *        MemoryTracker that may be notified from many threads at once
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_POLICIES_TRACKERS_CONCURRENT_STAT_TRACKER_HPP
+#define BIT_MEMORY_POLICIES_TRACKERS_CONCURRENT_STAT_TRACKER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "../../utilities/allocator_info.hpp"    // allocator_info
+#include "../../utilities/cpu.hpp"               // cache_line_size, etc
+#include "../../utilities/macros.hpp"            // BIT_MEMORY_UNUSED
+#include "../../utilities/pointer_utilities.hpp" // align_forward
+
+#include "../../concepts/MemoryTracker.hpp" // is_memory_tracker
+
+#include <atomic>      // std::atomic
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <new>         // placement new
+#include <type_traits> // std::true_type
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A MemoryTracker that records the same statistics as a
+    ///        \c stat_recording_null_tracker, without requiring a lock
+    ///
+    /// Statistics are recorded with relaxed atomics into one cache-line
+    /// sized shard per processor, selected with \c current_cpu(), so that
+    /// threads on different processors never write to the same line. The
+    /// shards are only combined when a statistic is queried.
+    ///
+    /// The peak size can't be derived from the shards alone, so each shard
+    /// publishes its change in size to a shared total once it exceeds
+    /// \c publish_threshold bytes. Each allocation samples the peak from the
+    /// shared total and its own shard's change, so the peak may under-report
+    /// the true peak by at most \c publish_threshold bytes for every other
+    /// shard. The shared total is only read on the hot path, and is only
+    /// written when a shard publishes or the peak grows.
+    ///
+    /// Since this tracker declares itself thread-safe, a policy_allocator
+    /// notifies it outside of its lock.
+    ///
+    /// \satisfies{MemoryTracker}
+    ///////////////////////////////////////////////////////////////////////////
+    class concurrent_stat_tracker
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using is_thread_safe = std::true_type;
+
+      //-----------------------------------------------------------------------
+      // Public Constants
+      //-----------------------------------------------------------------------
+    public:
+
+      /// The change in size, in bytes, that a shard accumulates before
+      /// publishing it to the shared total
+      static constexpr std::ptrdiff_t publish_threshold = 16 * 1024;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a concurrent_stat_tracker with one shard for each
+      ///        processor
+      concurrent_stat_tracker();
+
+      /// \brief Move-constructs a concurrent_stat_tracker from another one
+      ///
+      /// \note The moved-from tracker must not be notified again
+      ///
+      /// \param other the other tracker to move
+      concurrent_stat_tracker( concurrent_stat_tracker&& other ) noexcept;
+
+      // Deleted copy construction
+      concurrent_stat_tracker( const concurrent_stat_tracker& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Destroys the shards of this tracker
+      ~concurrent_stat_tracker();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      concurrent_stat_tracker& operator=( concurrent_stat_tracker&& other ) = delete;
+
+      // Deleted copy assignment
+      concurrent_stat_tracker& operator=( const concurrent_stat_tracker& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Tracking
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Records an allocation occurring of size \p bytes
+      ///
+      /// \param p the pointer allocated
+      /// \param bytes the number of bytes allocated
+      /// \param align the alignment of the allocation
+      void on_allocate( void* p, std::size_t bytes, std::size_t align ) noexcept;
+
+      /// \brief Records a deallocation occuring of size \p bytes
+      ///
+      /// \param info the info for the allocator
+      /// \param p the pointer to the memory being deallocated
+      /// \param bytes the nuber of bytes being deallocated
+      void on_deallocate( const allocator_info& info, void* p, std::size_t bytes ) noexcept;
+
+      /// \brief Records all memory being truncated deallocated
+      ///
+      /// \note This must not be called concurrently with any other tracking
+      void on_deallocate_all() noexcept;
+
+      /// \brief Finalizes the tracking (called during destruction)
+      ///
+      /// \param info the info about the allocator that is finalizing the
+      ///             tracking
+      void finalize( const allocator_info& info ) noexcept;
+
+      //-----------------------------------------------------------------------
+      // Element Access
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns the largest request size from this tracker
+      ///
+      /// \return the largest request size, in bytes
+      std::size_t largest_request() const noexcept;
+
+      /// \brief Returns the smallest request size from this tracker
+      ///
+      /// \return the smallest request size, in bytes
+      std::size_t smallest_request() const noexcept;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Returns the largest alignment request size from this tracker
+      ///
+      /// \return the largest alignment request size, in bytes
+      std::size_t largest_alignment_request() const noexcept;
+
+      /// \brief Returns the smallest alignment request size from this tracker
+      ///
+      /// \return the smallest alignment request size, in bytes
+      std::size_t smallest_alignment_request() const noexcept;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Returns the peak size of this tracker
+      ///
+      /// This is the maximum size the tracked allocator reached before being
+      /// deallocated, to within \c publish_threshold bytes per shard
+      ///
+      /// \return the peak size, in bytes
+      std::size_t peak_size() const noexcept;
+
+      /// \brief Returns the total amount of memory allocated
+      ///
+      /// This is the total amount of memory allocated from the tracked
+      /// allocator; meaning it does not pay attention to any deallocations.
+      ///
+      /// \return the total size allocated, in bytes
+      std::size_t total_allocated() const noexcept;
+
+      /// \brief Returns the total number of allocations (e.g. calls to either
+      ///        'try_allocate' or 'allocate')
+      ///
+      /// \return the number of allocations
+      std::size_t allocations() const noexcept;
+
+      /// \brief Returns the total number of deallocations (e.g. calls to
+      ///        'deallocate')
+      ///
+      /// Note that this does not include calls to 'deallocate_all', since
+      /// that truncates all deallocations
+      ///
+      /// \return the number of deallocations
+      std::size_t deallocations() const noexcept;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Gets the number of shards that statistics are recorded into
+      ///
+      /// \return the number of shards
+      std::size_t shards() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      struct alignas(cache_line_size) totals
+      {
+        std::atomic<std::ptrdiff_t> size;      ///< The published size
+        std::atomic<std::ptrdiff_t> peak_size; ///< The largest sampled size
+      };
+
+      struct alignas(cache_line_size) shard
+      {
+        std::atomic<std::size_t>    allocations;
+        std::atomic<std::size_t>    deallocations;
+        std::atomic<std::size_t>    total_allocated;
+        std::atomic<std::ptrdiff_t> unpublished;  ///< Change in size
+        std::atomic<std::size_t>    largest_request;
+        std::atomic<std::size_t>    smallest_request;
+        std::atomic<std::size_t>    largest_alignment;
+        std::atomic<std::size_t>    smallest_alignment;
+      };
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      void*       m_storage;     ///< Storage for the totals and shards
+      totals*     m_totals;      ///< The totals shared by every shard
+      shard*      m_shards;      ///< The aligned shards
+      std::size_t m_shard_count; ///< The number of shards
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Gets the shard for the processor the caller is running on
+      shard& local_shard() noexcept;
+
+      /// \brief Publishes the unpublished change in size of \p s
+      void publish( shard& s ) noexcept;
+
+      /// \brief Computes the current size, including unpublished changes
+      std::ptrdiff_t current_size() const noexcept;
+
+      /// \brief Stores \p value in \p a if it exceeds the stored value
+      template<typename T>
+      static void record_max( std::atomic<T>& a, T value ) noexcept;
+
+      /// \brief Stores \p value in \p a if it is below the stored value, or
+      ///        if no value has been stored
+      static void record_min( std::atomic<std::size_t>& a,
+                              std::size_t value ) noexcept;
+    };
+
+    static_assert( is_memory_tracker_v<concurrent_stat_tracker>,
+                   "concurrent_stat_tracker must satisfy MemoryTracker" );
+    static_assert( memory_tracker_is_thread_safe_v<concurrent_stat_tracker>,
+                   "concurrent_stat_tracker must be thread-safe" );
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/concurrent_stat_tracker.inl"
+
+#endif /* BIT_MEMORY_POLICIES_TRACKERS_CONCURRENT_STAT_TRACKER_HPP */
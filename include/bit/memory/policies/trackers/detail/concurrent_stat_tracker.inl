@@ -0,0 +1,277 @@
+#ifndef BIT_MEMORY_POLICIES_TRACKERS_DETAIL_CONCURRENT_STAT_TRACKER_INL
+#define BIT_MEMORY_POLICIES_TRACKERS_DETAIL_CONCURRENT_STAT_TRACKER_INL
+
+//-----------------------------------------------------------------------------
+// Constructors / Destructor
+//-----------------------------------------------------------------------------
+
+inline bit::memory::concurrent_stat_tracker::concurrent_stat_tracker()
+  : m_storage(nullptr),
+    m_totals(nullptr),
+    m_shards(nullptr),
+    m_shard_count(cpu_count())
+{
+  // Over-aligned types are not supported by 'new' until C++17, so the
+  // totals and shards are aligned to their cache lines by hand
+  m_storage = ::operator new( sizeof(totals) + sizeof(shard) * m_shard_count + cache_line_size );
+  m_totals  = static_cast<totals*>(align_forward( m_storage, cache_line_size ));
+  m_shards  = static_cast<shard*>(static_cast<void*>(m_totals + 1));
+
+  new (m_totals) totals{};
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    new (m_shards + i) shard{};
+  }
+}
+
+inline bit::memory::concurrent_stat_tracker
+  ::concurrent_stat_tracker( concurrent_stat_tracker&& other )
+  noexcept
+  : m_storage(other.m_storage),
+    m_totals(other.m_totals),
+    m_shards(other.m_shards),
+    m_shard_count(other.m_shard_count)
+{
+  other.m_storage     = nullptr;
+  other.m_totals      = nullptr;
+  other.m_shards      = nullptr;
+  other.m_shard_count = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+inline bit::memory::concurrent_stat_tracker::~concurrent_stat_tracker()
+{
+  if( m_totals == nullptr ) return;
+
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    m_shards[i].~shard();
+  }
+  m_totals->~totals();
+  ::operator delete( m_storage );
+}
+
+//-----------------------------------------------------------------------------
+// Tracking
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::concurrent_stat_tracker::on_allocate( void* p,
+                                                               std::size_t bytes,
+                                                               std::size_t align )
+  noexcept
+{
+  BIT_MEMORY_UNUSED(p);
+
+  auto& s = local_shard();
+
+  s.allocations.fetch_add( 1, std::memory_order_relaxed );
+  s.total_allocated.fetch_add( bytes, std::memory_order_relaxed );
+
+  record_max( s.largest_request, bytes );
+  record_min( s.smallest_request, bytes );
+  record_max( s.largest_alignment, align );
+  record_min( s.smallest_alignment, align );
+
+  const auto delta = static_cast<std::ptrdiff_t>(bytes);
+  const auto size  = s.unpublished.fetch_add( delta, std::memory_order_relaxed ) + delta;
+
+  if( size >= publish_threshold ) {
+    publish(s);
+  } else {
+    record_max( m_totals->peak_size,
+                m_totals->size.load(std::memory_order_relaxed) + size );
+  }
+}
+
+inline void bit::memory::concurrent_stat_tracker
+  ::on_deallocate( const allocator_info& info, void* p, std::size_t bytes )
+  noexcept
+{
+  BIT_MEMORY_UNUSED(info);
+  BIT_MEMORY_UNUSED(p);
+
+  auto& s = local_shard();
+
+  s.deallocations.fetch_add( 1, std::memory_order_relaxed );
+
+  const auto delta = static_cast<std::ptrdiff_t>(bytes);
+  const auto size  = s.unpublished.fetch_sub( delta, std::memory_order_relaxed ) - delta;
+
+  if( size <= -publish_threshold ) publish(s);
+}
+
+inline void bit::memory::concurrent_stat_tracker::on_deallocate_all()
+  noexcept
+{
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    m_shards[i].unpublished.store( 0, std::memory_order_relaxed );
+  }
+  m_totals->size.store( 0, std::memory_order_relaxed );
+}
+
+inline void bit::memory::concurrent_stat_tracker
+  ::finalize( const allocator_info& info )
+  noexcept
+{
+  BIT_MEMORY_UNUSED(info);
+}
+
+//-----------------------------------------------------------------------------
+// Element Access
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::concurrent_stat_tracker::largest_request()
+  const noexcept
+{
+  auto result = std::size_t{0};
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    const auto value = m_shards[i].largest_request.load(std::memory_order_relaxed);
+    if( value > result ) result = value;
+  }
+  return result;
+}
+
+inline std::size_t bit::memory::concurrent_stat_tracker::smallest_request()
+  const noexcept
+{
+  auto result = std::size_t{0};
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    const auto value = m_shards[i].smallest_request.load(std::memory_order_relaxed);
+    if( value != 0 && (result == 0 || value < result) ) result = value;
+  }
+  return result;
+}
+
+//-----------------------------------------------------------------------------
+
+inline std::size_t
+  bit::memory::concurrent_stat_tracker::largest_alignment_request()
+  const noexcept
+{
+  auto result = std::size_t{0};
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    const auto value = m_shards[i].largest_alignment.load(std::memory_order_relaxed);
+    if( value > result ) result = value;
+  }
+  return result;
+}
+
+inline std::size_t
+  bit::memory::concurrent_stat_tracker::smallest_alignment_request()
+  const noexcept
+{
+  auto result = std::size_t{0};
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    const auto value = m_shards[i].smallest_alignment.load(std::memory_order_relaxed);
+    if( value != 0 && (result == 0 || value < result) ) result = value;
+  }
+  return result;
+}
+
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::concurrent_stat_tracker::peak_size()
+  const noexcept
+{
+  if( m_totals == nullptr ) return 0;
+
+  const auto peak = m_totals->peak_size.load(std::memory_order_relaxed);
+  const auto size = current_size();
+
+  return static_cast<std::size_t>( size > peak ? size : peak );
+}
+
+inline std::size_t bit::memory::concurrent_stat_tracker::total_allocated()
+  const noexcept
+{
+  auto result = std::size_t{0};
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    result += m_shards[i].total_allocated.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+inline std::size_t bit::memory::concurrent_stat_tracker::allocations()
+  const noexcept
+{
+  auto result = std::size_t{0};
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    result += m_shards[i].allocations.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+inline std::size_t bit::memory::concurrent_stat_tracker::deallocations()
+  const noexcept
+{
+  auto result = std::size_t{0};
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    result += m_shards[i].deallocations.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::concurrent_stat_tracker::shards()
+  const noexcept
+{
+  return m_shard_count;
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+inline bit::memory::concurrent_stat_tracker::shard&
+  bit::memory::concurrent_stat_tracker::local_shard()
+  noexcept
+{
+  // A stale cpu only costs some sharing; every shard update is atomic
+  return m_shards[ current_cpu() % m_shard_count ];
+}
+
+inline void bit::memory::concurrent_stat_tracker::publish( shard& s )
+  noexcept
+{
+  const auto delta = s.unpublished.exchange( 0, std::memory_order_relaxed );
+  const auto size  = m_totals->size.fetch_add( delta, std::memory_order_relaxed ) + delta;
+
+  record_max( m_totals->peak_size, size );
+}
+
+inline std::ptrdiff_t bit::memory::concurrent_stat_tracker::current_size()
+  const noexcept
+{
+  auto result = m_totals->size.load(std::memory_order_relaxed);
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    result += m_shards[i].unpublished.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+template<typename T>
+inline void bit::memory::concurrent_stat_tracker::record_max( std::atomic<T>& a,
+                                                              T value )
+  noexcept
+{
+  // Loading first avoids writing to the line once the maximum is settled
+  auto current = a.load(std::memory_order_relaxed);
+  while( value > current &&
+         !a.compare_exchange_weak( current, value, std::memory_order_relaxed ) ) {
+    // 'current' is reloaded by the failed exchange
+  }
+}
+
+inline void
+  bit::memory::concurrent_stat_tracker::record_min( std::atomic<std::size_t>& a,
+                                                    std::size_t value )
+  noexcept
+{
+  auto current = a.load(std::memory_order_relaxed);
+  while( (current == 0 || value < current) &&
+         !a.compare_exchange_weak( current, value, std::memory_order_relaxed ) ) {
+    // 'current' is reloaded by the failed exchange
+  }
+}
+
+#endif /* BIT_MEMORY_POLICIES_TRACKERS_DETAIL_CONCURRENT_STAT_TRACKER_INL */
@@ -0,0 +1,187 @@
+#ifndef BIT_MEMORY_POLICIES_TRACKERS_DETAIL_HISTOGRAM_TRACKER_INL
+#define BIT_MEMORY_POLICIES_TRACKERS_DETAIL_HISTOGRAM_TRACKER_INL
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+inline bit::memory::histogram_tracker::histogram_tracker()
+  : m_sizes(),
+    m_alignments(),
+    m_lifetimes(),
+    m_table( std::size_t{1} << s_table_bits, lifetime_entry{nullptr,0} ),
+    m_live(0),
+    m_clock(0),
+    m_untracked(0)
+{
+  static_assert( max_tracked_lifetimes < (std::size_t{1} << s_table_bits),
+                 "the lifetime table must always have an unused slot" );
+}
+
+//-----------------------------------------------------------------------------
+// Tracking
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::histogram_tracker::on_allocate( void* p,
+                                                         std::size_t bytes,
+                                                         std::size_t align )
+  noexcept
+{
+  m_sizes.record( bytes );
+  m_alignments.record( align );
+
+  const auto birth = m_clock++;
+
+  if( m_live == max_tracked_lifetimes ) {
+    ++m_untracked;
+    return;
+  }
+
+  const auto mask = m_table.size() - 1;
+  auto slot = home_slot(p);
+  while( m_table[slot].pointer != nullptr ) {
+    slot = (slot + 1) & mask;
+  }
+
+  m_table[slot] = lifetime_entry{ p, birth };
+  ++m_live;
+}
+
+inline void bit::memory::histogram_tracker
+  ::on_deallocate( const allocator_info& info, void* p, std::size_t bytes )
+  noexcept
+{
+  BIT_MEMORY_UNUSED(info);
+  BIT_MEMORY_UNUSED(bytes);
+
+  const auto mask = m_table.size() - 1;
+  for( auto slot = home_slot(p); m_table[slot].pointer != nullptr;
+       slot = (slot + 1) & mask ) {
+
+    if( m_table[slot].pointer == p ) {
+      m_lifetimes.record( m_clock - m_table[slot].birth );
+      erase_slot( slot );
+      return;
+    }
+  }
+  // The allocation was made while the table was full
+}
+
+inline void bit::memory::histogram_tracker::on_deallocate_all()
+  noexcept
+{
+  for( auto& entry : m_table ) {
+    if( entry.pointer == nullptr ) continue;
+
+    m_lifetimes.record( m_clock - entry.birth );
+    entry.pointer = nullptr;
+  }
+  m_live = 0;
+}
+
+inline void bit::memory::histogram_tracker
+  ::finalize( const allocator_info& info )
+  noexcept
+{
+  BIT_MEMORY_UNUSED(info);
+}
+
+//-----------------------------------------------------------------------------
+// Element Access
+//-----------------------------------------------------------------------------
+
+inline const bit::memory::histogram_tracker::histogram_type&
+  bit::memory::histogram_tracker::sizes()
+  const noexcept
+{
+  return m_sizes;
+}
+
+inline const bit::memory::histogram_tracker::histogram_type&
+  bit::memory::histogram_tracker::alignments()
+  const noexcept
+{
+  return m_alignments;
+}
+
+inline const bit::memory::histogram_tracker::histogram_type&
+  bit::memory::histogram_tracker::lifetimes()
+  const noexcept
+{
+  return m_lifetimes;
+}
+
+inline std::uint64_t bit::memory::histogram_tracker::untracked_lifetimes()
+  const noexcept
+{
+  return m_untracked;
+}
+
+//-----------------------------------------------------------------------------
+// Output
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::histogram_tracker::dump( std::FILE* stream )
+  const
+{
+  const auto dump_histogram = [stream]( const char* name,
+                                        const histogram_type& histogram ) {
+    histogram.for_each_bucket([&]( std::uint64_t lower,
+                                   std::uint64_t upper,
+                                   std::uint64_t count ) {
+      std::fprintf( stream, "%s,%llu,%llu,%llu\n",
+                    name,
+                    static_cast<unsigned long long>(lower),
+                    static_cast<unsigned long long>(upper),
+                    static_cast<unsigned long long>(count) );
+    });
+  };
+
+  std::fprintf( stream, "histogram,lower,upper,count\n" );
+  dump_histogram( "size", m_sizes );
+  dump_histogram( "alignment", m_alignments );
+  dump_histogram( "lifetime", m_lifetimes );
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::histogram_tracker::home_slot( const void* p )
+  noexcept
+{
+  // Fibonacci hashing spreads the (aligned, and so low-entropy) low bits of
+  // the address across the top bits that select the slot
+  const auto address = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(p));
+
+  return static_cast<std::size_t>(
+    (address * 0x9E3779B97F4A7C15ull) >> (64 - s_table_bits)
+  );
+}
+
+inline void bit::memory::histogram_tracker::erase_slot( std::size_t slot )
+  noexcept
+{
+  const auto mask = m_table.size() - 1;
+
+  // Backward-shift deletion keeps every probe sequence unbroken without
+  // leaving tombstones behind
+  auto hole = slot;
+  for( auto next = (hole + 1) & mask; m_table[next].pointer != nullptr;
+       next = (next + 1) & mask ) {
+
+    const auto home = home_slot( m_table[next].pointer );
+
+    // The entry may fill the hole only if its home is not cyclically
+    // within (hole, next]
+    if( ((next - home) & mask) >= ((next - hole) & mask) ) {
+      m_table[hole] = m_table[next];
+      hole = next;
+    }
+  }
+
+  m_table[hole].pointer = nullptr;
+  --m_live;
+}
+
+#endif /* BIT_MEMORY_POLICIES_TRACKERS_DETAIL_HISTOGRAM_TRACKER_INL */
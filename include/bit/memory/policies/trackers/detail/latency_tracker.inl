@@ -0,0 +1,192 @@
+#ifndef BIT_MEMORY_POLICIES_TRACKERS_DETAIL_LATENCY_TRACKER_INL
+#define BIT_MEMORY_POLICIES_TRACKERS_DETAIL_LATENCY_TRACKER_INL
+
+//-----------------------------------------------------------------------------
+// Constructors / Destructor
+//-----------------------------------------------------------------------------
+
+inline bit::memory::latency_tracker::latency_tracker()
+  : m_storage(nullptr),
+    m_shards(nullptr),
+    m_shard_count(cpu_count())
+{
+  // Over-aligned types are not supported by 'new' until C++17, so the
+  // shards are aligned to their cache lines by hand
+  m_storage = ::operator new( sizeof(shard) * m_shard_count + cache_line_size );
+  m_shards  = static_cast<shard*>(align_forward( m_storage, cache_line_size ));
+
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    new (m_shards + i) shard{};
+  }
+}
+
+inline bit::memory::latency_tracker
+  ::latency_tracker( latency_tracker&& other )
+  noexcept
+  : m_storage(other.m_storage),
+    m_shards(other.m_shards),
+    m_shard_count(other.m_shard_count)
+{
+  other.m_storage     = nullptr;
+  other.m_shards      = nullptr;
+  other.m_shard_count = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+inline bit::memory::latency_tracker::~latency_tracker()
+{
+  if( m_shards == nullptr ) return;
+
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    m_shards[i].~shard();
+  }
+  ::operator delete( m_storage );
+}
+
+//-----------------------------------------------------------------------------
+// Tracking
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::latency_tracker
+  ::on_allocate_latency( clock_type::rep ticks )
+  noexcept
+{
+  // A moved-from tracker has no shards to record into
+  if( BIT_MEMORY_UNLIKELY(m_shards == nullptr) ) return;
+
+  auto& s = local_shard();
+
+  std::lock_guard<spin_lock> guard{s.lock};
+  s.allocations.record( ticks );
+}
+
+inline void bit::memory::latency_tracker
+  ::on_deallocate_latency( clock_type::rep ticks )
+  noexcept
+{
+  // A moved-from tracker has no shards to record into
+  if( BIT_MEMORY_UNLIKELY(m_shards == nullptr) ) return;
+
+  auto& s = local_shard();
+
+  std::lock_guard<spin_lock> guard{s.lock};
+  s.deallocations.record( ticks );
+}
+
+inline void bit::memory::latency_tracker::clear()
+  noexcept
+{
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    std::lock_guard<spin_lock> guard{m_shards[i].lock};
+
+    m_shards[i].allocations.clear();
+    m_shards[i].deallocations.clear();
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Element Access
+//-----------------------------------------------------------------------------
+
+inline bit::memory::latency_tracker::histogram_type
+  bit::memory::latency_tracker::allocate_latencies()
+  const noexcept
+{
+  return merge( &shard::allocations );
+}
+
+inline bit::memory::latency_tracker::histogram_type
+  bit::memory::latency_tracker::deallocate_latencies()
+  const noexcept
+{
+  return merge( &shard::deallocations );
+}
+
+inline bit::memory::latency_summary
+  bit::memory::latency_tracker::allocate_summary()
+  const noexcept
+{
+  return summarize( allocate_latencies() );
+}
+
+inline bit::memory::latency_summary
+  bit::memory::latency_tracker::deallocate_summary()
+  const noexcept
+{
+  return summarize( deallocate_latencies() );
+}
+
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::latency_tracker::shards()
+  const noexcept
+{
+  return m_shard_count;
+}
+
+//-----------------------------------------------------------------------------
+// Output
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::latency_tracker::dump( std::FILE* stream )
+  const
+{
+  const auto dump_summary = [stream]( const char* name,
+                                      const latency_summary& summary ) {
+    std::fprintf( stream, "%s,%llu,%llu,%llu,%llu,%llu\n",
+                  name,
+                  static_cast<unsigned long long>(summary.count),
+                  static_cast<unsigned long long>(summary.p50),
+                  static_cast<unsigned long long>(summary.p99),
+                  static_cast<unsigned long long>(summary.p999),
+                  static_cast<unsigned long long>(summary.max) );
+  };
+
+  std::fprintf( stream, "operation,count,p50,p99,p99.9,max\n" );
+  dump_summary( "allocate", allocate_summary() );
+  dump_summary( "deallocate", deallocate_summary() );
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+inline bit::memory::latency_tracker::shard&
+  bit::memory::latency_tracker::local_shard()
+  noexcept
+{
+  assert( m_shard_count != 0 && "latency_tracker has been moved from" );
+
+  // A stale cpu only costs some contention; every shard is locked
+  return m_shards[ current_cpu() % m_shard_count ];
+}
+
+inline bit::memory::latency_tracker::histogram_type
+  bit::memory::latency_tracker::merge( histogram_type shard::* member )
+  const noexcept
+{
+  auto result = histogram_type{};
+
+  for( auto i = 0u; i < m_shard_count; ++i ) {
+    std::lock_guard<spin_lock> guard{m_shards[i].lock};
+
+    result.merge( m_shards[i].*member );
+  }
+  return result;
+}
+
+inline bit::memory::latency_summary
+  bit::memory::latency_tracker::summarize( const histogram_type& histogram )
+  noexcept
+{
+  return {
+    histogram.count(),
+    histogram.value_at_percentile( 50.0 ),
+    histogram.value_at_percentile( 99.0 ),
+    histogram.value_at_percentile( 99.9 ),
+    histogram.max()
+  };
+}
+
+#endif /* BIT_MEMORY_POLICIES_TRACKERS_DETAIL_LATENCY_TRACKER_INL */
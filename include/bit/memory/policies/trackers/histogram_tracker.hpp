@@ -0,0 +1,232 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a MemoryTracker that
+ *        records histograms of request sizes, alignments and lifetimes
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_POLICIES_TRACKERS_HISTOGRAM_TRACKER_HPP
+#define BIT_MEMORY_POLICIES_TRACKERS_HISTOGRAM_TRACKER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "../../utilities/allocator_info.hpp"       // allocator_info
+#include "../../utilities/log_linear_histogram.hpp" // log_linear_histogram
+#include "../../utilities/macros.hpp"               // BIT_MEMORY_UNUSED
+
+#include "../../concepts/MemoryTracker.hpp" // is_memory_tracker
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t, std::uintptr_t
+#include <cstdio>  // std::FILE, std::fprintf
+#include <vector>  // std::vector
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A MemoryTracker that records log-linear histograms of the
+    ///        size, alignment and lifetime of every allocation
+    ///
+    /// The histograms are intended for choosing the chunk sizes of pool
+    /// allocators and the size classes of slab allocators; values below 16
+    /// are recorded exactly, and larger values to within 12.5%.
+    ///
+    /// Lifetimes are measured in allocations; that is, the number of
+    /// allocations made by the tracked allocator while the allocation was
+    /// live. This is deterministic, and cheaper than reading a clock. The
+    /// birth of each live allocation is kept in a fixed-size table of
+    /// \c max_tracked_lifetimes entries; allocations made while the table
+    /// is full still have their size and alignment recorded, but not their
+    /// lifetime, and are counted by \c untracked_lifetimes().
+    ///
+    /// The recorded histograms can be written out as CSV with \c dump.
+    ///
+    /// \satisfies{MemoryTracker}
+    ///////////////////////////////////////////////////////////////////////////
+    class histogram_tracker
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using histogram_type = log_linear_histogram<3>;
+
+      //-----------------------------------------------------------------------
+      // Public Constants
+      //-----------------------------------------------------------------------
+    public:
+
+      /// The number of live allocations whose lifetimes can be measured
+      static constexpr std::size_t max_tracked_lifetimes = 3072;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a histogram_tracker with empty histograms
+      histogram_tracker();
+
+      /// \brief Move-constructs a histogram_tracker from another one
+      ///
+      /// \note The moved-from tracker must not be notified again
+      ///
+      /// \param other the other tracker to move
+      histogram_tracker( histogram_tracker&& other ) noexcept = default;
+
+      // Deleted copy construction
+      histogram_tracker( const histogram_tracker& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      histogram_tracker& operator=( histogram_tracker&& other ) = delete;
+
+      // Deleted copy assignment
+      histogram_tracker& operator=( const histogram_tracker& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Tracking
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Records an allocation after allocating the size
+      ///
+      /// \param p the pointer to the memory to allocate
+      /// \param bytes the size of the allocation, in bytes
+      /// \param align the alignment of the allocation
+      void on_allocate( void* p, std::size_t bytes, std::size_t align ) noexcept;
+
+      /// \brief Records the deallocation before deallocating the bytes
+      ///
+      /// \param info the info for the allocator deallocating
+      /// \param p the pointer to the memory to deallocate
+      /// \param bytes the size of the deallocation, in bytes
+      void on_deallocate( const allocator_info& info, void* p, std::size_t bytes ) noexcept;
+
+      /// \brief Records when deallocations have been truncated, ending the
+      ///        lifetime of every live allocation
+      void on_deallocate_all() noexcept;
+
+      /// \brief Finalizes the tracking (called during destruction)
+      ///
+      /// \param info the info about the allocator that is finalizing the
+      ///             tracking
+      void finalize( const allocator_info& info ) noexcept;
+
+      //-----------------------------------------------------------------------
+      // Element Access
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the histogram of requested sizes, in bytes
+      ///
+      /// \return the size histogram
+      const histogram_type& sizes() const noexcept;
+
+      /// \brief Gets the histogram of requested alignments, in bytes
+      ///
+      /// \return the alignment histogram
+      const histogram_type& alignments() const noexcept;
+
+      /// \brief Gets the histogram of allocation lifetimes, in allocations
+      ///
+      /// \return the lifetime histogram
+      const histogram_type& lifetimes() const noexcept;
+
+      /// \brief Gets the number of allocations whose lifetime could not be
+      ///        measured, because too many allocations were live
+      ///
+      /// \return the number of untracked lifetimes
+      std::uint64_t untracked_lifetimes() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Output
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Writes every non-empty bucket of the histograms to
+      ///        \p stream as CSV
+      ///
+      /// The first line is the header \c "histogram,lower,upper,count";
+      /// every following line is a bucket of the \c size, \c alignment or
+      /// \c lifetime histogram, with its inclusive bounds and count.
+      ///
+      /// \param stream the stream to write to
+      void dump( std::FILE* stream ) const;
+
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      struct lifetime_entry
+      {
+        void*         pointer; ///< The live allocation, or null if unused
+        std::uint64_t birth;   ///< The allocation clock at its allocation
+      };
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      /// The number of bits in an index of the lifetime table
+      static constexpr std::size_t s_table_bits = 12;
+
+      histogram_type              m_sizes;
+      histogram_type              m_alignments;
+      histogram_type              m_lifetimes;
+      std::vector<lifetime_entry> m_table;     ///< Open-addressed live births
+      std::size_t                 m_live;      ///< The entries in m_table
+      std::uint64_t               m_clock;     ///< The number of allocations
+      std::uint64_t               m_untracked; ///< Allocations not in m_table
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Gets the slot of the table that \p p is first probed at
+      static std::size_t home_slot( const void* p ) noexcept;
+
+      /// \brief Removes the entry in \p slot, shifting back any entries
+      ///        that were displaced past it
+      void erase_slot( std::size_t slot ) noexcept;
+    };
+
+    static_assert( is_memory_tracker_v<histogram_tracker>,
+                   "histogram_tracker must satisfy MemoryTracker" );
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/histogram_tracker.inl"
+
+#endif /* BIT_MEMORY_POLICIES_TRACKERS_HISTOGRAM_TRACKER_HPP */
@@ -0,0 +1,237 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains a tracker that records histograms of the time
+ *        taken by allocations and deallocations
+ *****************************************************************************/
+
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_POLICIES_TRACKERS_LATENCY_TRACKER_HPP
+#define BIT_MEMORY_POLICIES_TRACKERS_LATENCY_TRACKER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "../lockables/spin_lock.hpp" // spin_lock
+
+#include "../../utilities/cpu.hpp"                  // cache_line_size, etc
+#include "../../utilities/cycle_clock.hpp"          // cycle_clock
+#include "../../utilities/log_linear_histogram.hpp" // log_linear_histogram
+#include "../../utilities/macros.hpp"               // BIT_MEMORY_UNLIKELY
+#include "../../utilities/pointer_utilities.hpp"    // align_forward
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <cstdio>  // std::FILE, std::fprintf
+#include <mutex>   // std::lock_guard
+#include <new>     // placement new
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The latencies of an operation at the percentiles of interest
+    ///////////////////////////////////////////////////////////////////////////
+    struct latency_summary
+    {
+      std::uint64_t count; ///< The number of operations timed
+      std::uint64_t p50;   ///< The median latency
+      std::uint64_t p99;   ///< The 99th percentile latency
+      std::uint64_t p999;  ///< The 99.9th percentile latency
+      std::uint64_t max;   ///< The largest latency
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A latency tracker that records how long every allocation and
+    ///        deallocation takes, for use with a latency_tracking_allocator
+    ///
+    /// Latencies are measured in ticks of the \c cycle_clock, and recorded
+    /// in log-linear (HDR-style) histograms; each value is kept to within
+    /// about 3%, and the largest is kept exactly.
+    ///
+    /// This tracker may be notified from multiple threads at once, so that
+    /// it can time a policy_allocator that is shared between threads. The
+    /// histograms are kept in one cache-line aligned shard per processor,
+    /// selected with \c current_cpu(), and each shard is guarded by its own
+    /// spin_lock that is only contended if a thread migrates mid-record.
+    /// The shards are only combined when the latencies are queried.
+    ///
+    /// The shards are allocated once on construction, and their size is
+    /// fixed at about 31 KiB per processor regardless of the number or range
+    /// of latencies recorded.
+    ///////////////////////////////////////////////////////////////////////////
+    class latency_tracker
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using clock_type     = cycle_clock;
+      using histogram_type = log_linear_histogram<5>;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a latency_tracker with an empty shard for every
+      ///        processor
+      latency_tracker();
+
+      /// \brief Move-constructs a latency_tracker from another one
+      ///
+      /// \note Latencies reported to the moved-from tracker are discarded
+      ///
+      /// \param other the other tracker to move
+      latency_tracker( latency_tracker&& other ) noexcept;
+
+      // Deleted copy construction
+      latency_tracker( const latency_tracker& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Destroys the shards of this latency_tracker
+      ~latency_tracker();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      latency_tracker& operator=( latency_tracker&& other ) = delete;
+
+      // Deleted copy assignment
+      latency_tracker& operator=( const latency_tracker& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Tracking
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Records an allocation that took \p ticks
+      ///
+      /// \param ticks the duration of the allocation, in clock ticks
+      void on_allocate_latency( clock_type::rep ticks ) noexcept;
+
+      /// \brief Records a deallocation that took \p ticks
+      ///
+      /// \param ticks the duration of the deallocation, in clock ticks
+      void on_deallocate_latency( clock_type::rep ticks ) noexcept;
+
+      /// \brief Discards every recorded latency, such as after warming up
+      ///
+      /// \note Latencies recorded concurrently with this may or may not be
+      ///       discarded
+      void clear() noexcept;
+
+      //-----------------------------------------------------------------------
+      // Element Access
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the histogram of allocation latencies, in clock ticks
+      ///
+      /// \return the allocation histograms of every shard, merged
+      histogram_type allocate_latencies() const noexcept;
+
+      /// \brief Gets the histogram of deallocation latencies, in clock ticks
+      ///
+      /// \return the deallocation histograms of every shard, merged
+      histogram_type deallocate_latencies() const noexcept;
+
+      /// \brief Summarizes the allocation latencies
+      ///
+      /// \return the p50, p99, p99.9 and max allocation latencies
+      latency_summary allocate_summary() const noexcept;
+
+      /// \brief Summarizes the deallocation latencies
+      ///
+      /// \return the p50, p99, p99.9 and max deallocation latencies
+      latency_summary deallocate_summary() const noexcept;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Gets the number of shards that latencies are recorded into
+      ///
+      /// \return the number of shards
+      std::size_t shards() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Output
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Writes the summaries of the latencies to \p stream as CSV
+      ///
+      /// The first line is the header \c "operation,count,p50,p99,p99.9,max";
+      /// it is followed by one line for \c allocate and one for
+      /// \c deallocate, in clock ticks.
+      ///
+      /// \param stream the stream to write to
+      void dump( std::FILE* stream ) const;
+
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      struct alignas(cache_line_size) shard
+      {
+        spin_lock      lock;
+        histogram_type allocations;
+        histogram_type deallocations;
+      };
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      void*       m_storage;     ///< Storage for the shards
+      shard*      m_shards;      ///< The aligned shards
+      std::size_t m_shard_count; ///< The number of shards
+
+      //-----------------------------------------------------------------------
+      // Private Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Gets the shard for the processor the caller is running on
+      shard& local_shard() noexcept;
+
+      /// \brief Merges the histogram \p member of every shard
+      histogram_type merge( histogram_type shard::* member ) const noexcept;
+
+      /// \brief Summarizes the latencies recorded in \p histogram
+      static latency_summary summarize( const histogram_type& histogram ) noexcept;
+    };
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/latency_tracker.inl"
+
+#endif /* BIT_MEMORY_POLICIES_TRACKERS_LATENCY_TRACKER_HPP */
@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains a null (no-op) latency tracker
+ *****************************************************************************/
+
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_POLICIES_TRACKERS_NULL_LATENCY_TRACKER_HPP
+#define BIT_MEMORY_POLICIES_TRACKERS_NULL_LATENCY_TRACKER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstdint> // std::uint64_t
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief This is a null (no-op) latency tracker meant for composition in
+    ///        the latency_tracking_allocator
+    ///
+    /// Its clock never reads the time, so a latency_tracking_allocator
+    /// composed with this compiles down to the allocator that it wraps.
+    ///////////////////////////////////////////////////////////////////////////
+    struct null_latency_tracker
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      struct clock_type
+      {
+        using rep = std::uint64_t;
+
+        static constexpr rep now() noexcept{ return 0; }
+      };
+
+      //-----------------------------------------------------------------------
+      // Tracking
+      //-----------------------------------------------------------------------
+    public:
+
+      void on_allocate_latency( clock_type::rep ) noexcept{}
+      void on_deallocate_latency( clock_type::rep ) noexcept{}
+    };
+
+  } // namespace memory
+} // namespace bit
+
+#endif /* BIT_MEMORY_POLICIES_TRACKERS_NULL_LATENCY_TRACKER_HPP */
@@ -18,7 +18,7 @@ inline void* bit::memory::virtual_memory::get()
 inline std::size_t bit::memory::virtual_memory::size()
   const noexcept
 {
-  return m_pages * virtual_memory_page_size();
+  return m_pages * page_size();
 }
 
 inline std::size_t bit::memory::virtual_memory::pages()
@@ -27,4 +27,24 @@ inline std::size_t bit::memory::virtual_memory::pages()
   return m_pages;
 }
 
+inline std::size_t bit::memory::virtual_memory::page_size()
+  const noexcept
+{
+  return virtual_memory_page_size( m_mode );
+}
+
+inline bit::memory::virtual_memory_page_mode
+  bit::memory::virtual_memory::page_mode()
+  const noexcept
+{
+  return m_mode;
+}
+
+inline bit::memory::virtual_memory_commit_mode
+  bit::memory::virtual_memory::commit_mode()
+  const noexcept
+{
+  return m_commit_mode;
+}
+
 #endif /* BIT_MEMORY_REGIONS_DETAIL_VIRTUAL_MEMORY_INL */
@@ -43,6 +43,27 @@
 namespace bit {
   namespace memory {
 
+    //------------------------------------------------------------------------
+    // Enumerations
+    //------------------------------------------------------------------------
+
+    /// \brief The kind of pages that back reserved virtual memory
+    enum class virtual_memory_page_mode
+    {
+      standard,         ///< Standard virtual pages
+      transparent_huge, ///< Huge-page aligned memory, advised to the OS to be
+                        ///< backed by transparent huge pages
+      huge,             ///< Explicit huge pages, which fall back to
+                        ///< transparent_huge if none are available
+    };
+
+    /// \brief How pages are made resident when they are committed
+    enum class virtual_memory_commit_mode
+    {
+      lazy,     ///< Pages are faulted in by the system on first access
+      prefault, ///< Pages are faulted in at the time they are committed
+    };
+
     //------------------------------------------------------------------------
     // Global Constants
     //------------------------------------------------------------------------
@@ -52,6 +73,21 @@ namespace bit {
     /// \return the page size of the virtual memory
     std::size_t virtual_memory_page_size() noexcept;
 
+    /// \brief Retrieves the size of a huge page of virtual memory
+    ///
+    /// If the system does not support huge pages, this is the same as
+    /// \ref virtual_memory_page_size
+    ///
+    /// \return the huge page size of the virtual memory
+    std::size_t virtual_memory_huge_page_size() noexcept;
+
+    /// \brief Retrieves the size of a page of virtual memory in the given
+    ///        \p mode
+    ///
+    /// \param mode the page mode
+    /// \return the page size for \p mode
+    std::size_t virtual_memory_page_size( virtual_memory_page_mode mode ) noexcept;
+
     //------------------------------------------------------------------------
     // Global Functions
     //------------------------------------------------------------------------
@@ -66,6 +102,26 @@ namespace bit {
     /// \return pointer to the reserved memory
     void* virtual_memory_reserve( std::size_t n ) noexcept;
 
+    /// \brief Reserves \p n pages of virtual memory, backed by pages of the
+    ///        given \p mode
+    ///
+    /// Each page is \c virtual_memory_page_size(mode) in size, and the
+    /// memory is aligned to the page size. If the system is unable to
+    /// reserve memory in the requested mode, it falls back to the nearest
+    /// mode with the same page size; the mode in effect is written to
+    /// \p actual.
+    ///
+    /// Memory reserved this way must be committed, decommitted and released
+    /// with the overloads that accept the mode in effect.
+    ///
+    /// \param n the number of pages to reserve
+    /// \param mode the requested page mode
+    /// \param actual the page mode in effect, if not \c nullptr
+    /// \return pointer to the reserved memory
+    void* virtual_memory_reserve( std::size_t n,
+                                  virtual_memory_page_mode mode,
+                                  virtual_memory_page_mode* actual = nullptr ) noexcept;
+
     /// \brief Commits \p n pages of memory to virtual memory
     ///
     /// \param memory Memory pointing to a page to commit
@@ -73,18 +129,72 @@ namespace bit {
     /// \return pointer to the committed memory
     void* virtual_memory_commit( void* memory, std::size_t n ) noexcept;
 
+    /// \brief Commits \p n pages of memory of the page mode \p mode
+    ///
+    /// \param memory Memory pointing to a page to commit
+    /// \param n The number of pages to commit
+    /// \param mode the page mode the memory was reserved with
+    /// \return pointer to the committed memory
+    void* virtual_memory_commit( void* memory,
+                                 std::size_t n,
+                                 virtual_memory_page_mode mode ) noexcept;
+
+    /// \brief Faults in \p size bytes of committed memory starting at
+    ///        \p memory, so that the first access to it does not fault
+    ///
+    /// This uses \c MADV_POPULATE_WRITE where it is available, and
+    /// otherwise touches every page. The contents of the memory are
+    /// unchanged.
+    ///
+    /// \param memory the committed memory to fault in
+    /// \param size the number of bytes to fault in
+    void virtual_memory_prefault( void* memory, std::size_t size ) noexcept;
+
+    /// \brief Faults in \p size bytes of committed memory starting at
+    ///        \p memory, split across up to \p threads threads
+    ///
+    /// Faulting in multi-gigabyte ranges is bound by the kernel's page
+    /// fault path, which scales with the number of threads touching
+    /// distinct pages. If a thread cannot be started, its share of the
+    /// range is faulted in by the calling thread.
+    ///
+    /// \param memory the committed memory to fault in
+    /// \param size the number of bytes to fault in
+    /// \param threads the number of threads to use
+    void virtual_memory_prefault( void* memory,
+                                  std::size_t size,
+                                  std::size_t threads ) noexcept;
+
     /// \brief Decommits \p n pages of memory to virtual memory
     ///
     /// \param memory Memory pointing to a page to decommit
     /// \param n The number of pages to decommit
     void virtual_memory_decommit( void* memory, std::size_t n ) noexcept;
 
+    /// \brief Decommits \p n pages of memory of the page mode \p mode
+    ///
+    /// \param memory Memory pointing to a page to decommit
+    /// \param n The number of pages to decommit
+    /// \param mode the page mode the memory was reserved with
+    void virtual_memory_decommit( void* memory,
+                                  std::size_t n,
+                                  virtual_memory_page_mode mode ) noexcept;
+
     /// \brief Releases \p n pages of virtual memory
     ///
     /// \param memory The memory originally returned from virtual_memory_reserve
     /// \param n The number of pages to release
     void virtual_memory_release( void* memory, std::size_t n ) noexcept;
 
+    /// \brief Releases \p n pages of virtual memory of the page mode \p mode
+    ///
+    /// \param memory The memory originally returned from virtual_memory_reserve
+    /// \param n The number of pages to release
+    /// \param mode the page mode the memory was reserved with
+    void virtual_memory_release( void* memory,
+                                 std::size_t n,
+                                 virtual_memory_page_mode mode ) noexcept;
+
     //------------------------------------------------------------------------
     // Classes
     //------------------------------------------------------------------------
@@ -108,6 +218,13 @@ namespace bit {
       /// \param pages The number of pages
       explicit virtual_memory( std::size_t pages );
 
+      /// \brief Constructs a virtual_memory object containing \p pages,
+      ///        backed by pages of the given \p mode
+      ///
+      /// \param pages The number of pages
+      /// \param mode The requested page mode
+      virtual_memory( std::size_t pages, virtual_memory_page_mode mode );
+
       /// Deleted copy constructor
       virtual_memory( const virtual_memory& ) = delete;
 
@@ -145,6 +262,11 @@ namespace bit {
       /// \param n the page number to decommit
       void decommit( std::ptrdiff_t n ) noexcept;
 
+      /// \brief Sets how pages are made resident when they are committed
+      ///
+      /// \param mode the commit mode
+      void set_commit_mode( virtual_memory_commit_mode mode ) noexcept;
+
       /// \brief Releases the virtual memory controlled by this class
       ///
       /// The underlying data is \c nullptr after this call
@@ -172,6 +294,21 @@ namespace bit {
       /// \return the number of pages
       std::size_t pages() const noexcept;
 
+      /// \brief Returns the size of each page in this virtual_memory
+      ///
+      /// \return the size of each page in bytes
+      std::size_t page_size() const noexcept;
+
+      /// \brief Returns the page mode in effect for this virtual_memory
+      ///
+      /// \return the page mode
+      virtual_memory_page_mode page_mode() const noexcept;
+
+      /// \brief Returns how pages are made resident when they are committed
+      ///
+      /// \return the commit mode
+      virtual_memory_commit_mode commit_mode() const noexcept;
+
       //----------------------------------------------------------------------
       // Element Access
       //----------------------------------------------------------------------
@@ -195,8 +332,10 @@ namespace bit {
       //----------------------------------------------------------------------
     private:
 
-      void*       m_data;
-      std::size_t m_pages;
+      void*                      m_data;
+      std::size_t                m_pages;
+      virtual_memory_page_mode   m_mode;
+      virtual_memory_commit_mode m_commit_mode;
     };
 
   } // namespace memory
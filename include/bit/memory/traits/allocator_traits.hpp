@@ -45,6 +45,7 @@
 
 #include <type_traits> // std::true_type, std::false_type, etc
 #include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <cstring>     // std::memcpy
 #include <limits>      // std::numeric_limits
 #include <memory>      // std::addressof. std::pointer_traits
 #include <typeinfo>    // std::type_info
@@ -141,6 +142,27 @@ namespace bit {
                                    size_type align ) noexcept;
       /// \}
 
+      /// \brief Attempts to make \p n allocations of at least \p size bytes,
+      ///        aligned to \p align boundary
+      ///
+      /// Allocations are written to the front of \p out, stopping at the
+      /// first allocation that fails.
+      ///
+      /// \note The default implementation if this is not defined in
+      ///       \c Allocator is to call \c try_allocate \p n times
+      ///
+      /// \param alloc the allocator to allocate from
+      /// \param size the size of each allocation
+      /// \param align the alignment of each allocation
+      /// \param n the number of allocations to make
+      /// \param out the array to write the allocations to
+      /// \return the number of allocations written to \p out
+      static size_type try_allocate_n( Allocator& alloc,
+                                       size_type size,
+                                       size_type align,
+                                       size_type n,
+                                       pointer* out ) noexcept;
+
       //-----------------------------------------------------------------------
 
       /// \{
@@ -185,6 +207,29 @@ namespace bit {
                           size_type new_size );
       /// \}
 
+      /// \brief Reallocates the memory at \p p to contain \p new_size bytes
+      ///
+      /// The memory is first expanded in place with \c expand. If that fails,
+      /// a new allocation of \p new_size bytes is made, the first
+      /// \c min(old_size,new_size) bytes are copied into it, and \p p is
+      /// deallocated.
+      ///
+      /// \note If the new allocation fails, this invokes the out-of-memory
+      ///       handler in the same way as \c allocate, and \p p is left
+      ///       untouched
+      ///
+      /// \param alloc the allocator to reallocate with
+      /// \param p the pointer to reallocate
+      /// \param old_size the size of the allocation at \p p
+      /// \param new_size the new size of the allocation
+      /// \param align the alignment of the allocation
+      /// \return the pointer to the reallocated memory
+      static pointer reallocate( Allocator& alloc,
+                                 pointer p,
+                                 size_type old_size,
+                                 size_type new_size,
+                                 size_type align );
+
       //-----------------------------------------------------------------------
       // Deallocation
       //-----------------------------------------------------------------------
@@ -198,6 +243,21 @@ namespace bit {
       /// \param size the size of the allocation
       static void deallocate( Allocator& alloc, pointer p, size_type size );
 
+      /// \brief Deallocates \p n pointers previously allocated with
+      ///        \p allocate, try_allocate, or try_allocate_n
+      ///
+      /// \note The default implementation if this is not defined in
+      ///       \c Allocator is to call \c deallocate \p n times
+      ///
+      /// \param alloc the allocator to deallocate to
+      /// \param ptrs the array of pointers to deallocate
+      /// \param n the number of pointers in \p ptrs
+      /// \param size the size of each allocation
+      static void deallocate_n( Allocator& alloc,
+                                pointer* ptrs,
+                                size_type n,
+                                size_type size );
+
       /// \brief Deallocates all memory from the given allocator
       ///
       /// This is only enabled if the underlying allocator supports it
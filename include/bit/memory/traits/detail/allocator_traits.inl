@@ -97,6 +97,34 @@ namespace bit { namespace memory { namespace detail {
                            pointer p,
                            size_type new_size );
 
+    //-------------------------------------------------------------------------
+
+    static size_type do_try_allocate_n( std::true_type,
+                                        Allocator& alloc,
+                                        size_type size,
+                                        size_type align,
+                                        size_type n,
+                                        pointer* out );
+    static size_type do_try_allocate_n( std::false_type,
+                                        Allocator& alloc,
+                                        size_type size,
+                                        size_type align,
+                                        size_type n,
+                                        pointer* out );
+
+    //-------------------------------------------------------------------------
+
+    static void do_deallocate_n( std::true_type,
+                                 Allocator& alloc,
+                                 pointer* ptrs,
+                                 size_type n,
+                                 size_type size );
+    static void do_deallocate_n( std::false_type,
+                                 Allocator& alloc,
+                                 pointer* ptrs,
+                                 size_type n,
+                                 size_type size );
+
     //-------------------------------------------------------------------------
     // Observers
     //-------------------------------------------------------------------------
@@ -308,6 +336,21 @@ inline typename bit::memory::allocator_traits<Allocator>::pointer
   return impl_type::do_try_allocate_hint( tag, hint, size, align );
 }
 
+template<typename Allocator>
+inline typename bit::memory::allocator_traits<Allocator>::size_type
+  bit::memory::allocator_traits<Allocator>::try_allocate_n( Allocator& alloc,
+                                                            size_type size,
+                                                            size_type align,
+                                                            size_type n,
+                                                            pointer* out )
+  noexcept
+{
+  static constexpr auto tag = allocator_has_try_allocate_n<Allocator>{};
+  using impl_type = detail::allocator_traits_impl<Allocator>;
+
+  return impl_type::do_try_allocate_n( tag, alloc, size, align, n, out );
+}
+
 template<typename Allocator>
 inline typename bit::memory::allocator_traits<Allocator>::pointer
   bit::memory::allocator_traits<Allocator>::allocate( Allocator& alloc,
@@ -350,6 +393,28 @@ inline bool bit::memory::allocator_traits<Allocator>
   return impl_type::do_expand( tag, alloc, p, new_size );
 }
 
+template<typename Allocator>
+inline typename bit::memory::allocator_traits<Allocator>::pointer
+  bit::memory::allocator_traits<Allocator>::reallocate( Allocator& alloc,
+                                                        pointer p,
+                                                        size_type old_size,
+                                                        size_type new_size,
+                                                        size_type align )
+{
+  if( expand( alloc, p, new_size ) ) return p;
+
+  auto new_p = allocate( alloc, new_size, align );
+
+  const auto n = (old_size < new_size) ? old_size : new_size;
+  std::memcpy( ::bit::memory::to_raw_pointer(new_p),
+               ::bit::memory::to_raw_pointer(p),
+               static_cast<std::size_t>(n) );
+
+  deallocate( alloc, p, old_size );
+
+  return new_p;
+}
+
 //-----------------------------------------------------------------------------
 // Deallocation
 //-----------------------------------------------------------------------------
@@ -362,6 +427,16 @@ inline void bit::memory::allocator_traits<Allocator>
   alloc.deallocate( p, size );
 }
 
+template<typename Allocator>
+inline void bit::memory::allocator_traits<Allocator>
+  ::deallocate_n( Allocator& alloc, pointer* ptrs, size_type n, size_type size )
+{
+  static constexpr auto tag = allocator_has_deallocate_n<Allocator>{};
+  using impl_type = detail::allocator_traits_impl<Allocator>;
+
+  impl_type::do_deallocate_n( tag, alloc, ptrs, n, size );
+}
+
 template<typename Allocator>
 template<typename U,typename>
 inline void bit::memory::allocator_traits<Allocator>
@@ -704,6 +779,68 @@ inline bool
   return false;
 }
 
+//-----------------------------------------------------------------------------
+
+template<typename Allocator>
+inline typename bit::memory::detail::allocator_traits_impl<Allocator>::size_type
+  bit::memory::detail::allocator_traits_impl<Allocator>
+  ::do_try_allocate_n( std::true_type,
+                       Allocator& alloc,
+                       size_type size,
+                       size_type align,
+                       size_type n,
+                       pointer* out )
+{
+  return alloc.try_allocate_n( size, align, n, out );
+}
+
+template<typename Allocator>
+inline typename bit::memory::detail::allocator_traits_impl<Allocator>::size_type
+  bit::memory::detail::allocator_traits_impl<Allocator>
+  ::do_try_allocate_n( std::false_type,
+                       Allocator& alloc,
+                       size_type size,
+                       size_type align,
+                       size_type n,
+                       pointer* out )
+{
+  auto i = size_type{0};
+  for( ; i < n; ++i ) {
+    out[i] = alloc.try_allocate( size, align );
+
+    if( BIT_MEMORY_UNLIKELY(out[i] == nullptr) ) break;
+  }
+  return i;
+}
+
+//-----------------------------------------------------------------------------
+
+template<typename Allocator>
+inline void
+  bit::memory::detail::allocator_traits_impl<Allocator>
+  ::do_deallocate_n( std::true_type,
+                     Allocator& alloc,
+                     pointer* ptrs,
+                     size_type n,
+                     size_type size )
+{
+  alloc.deallocate_n( ptrs, n, size );
+}
+
+template<typename Allocator>
+inline void
+  bit::memory::detail::allocator_traits_impl<Allocator>
+  ::do_deallocate_n( std::false_type,
+                     Allocator& alloc,
+                     pointer* ptrs,
+                     size_type n,
+                     size_type size )
+{
+  for( auto i = size_type{0}; i < n; ++i ) {
+    alloc.deallocate( ptrs[i], size );
+  }
+}
+
 //-----------------------------------------------------------------------------
 // Observers
 //-----------------------------------------------------------------------------
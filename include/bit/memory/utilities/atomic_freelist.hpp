@@ -0,0 +1,177 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition of a lock-free freelist utility
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_UTILITIES_ATOMIC_FREELIST_HPP
+#define BIT_MEMORY_UTILITIES_ATOMIC_FREELIST_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "macros.hpp"            // BIT_MEMORY_NO_SANITIZE_THREAD
+#include "pointer_utilities.hpp" // align_of
+
+#include <atomic>  // std::atomic
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uintptr_t
+#include <cassert> // assert
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A lock-free freelist that uses intrusive pointers inside raw
+    ///        memory
+    ///
+    /// This is the thread-safe counterpart to the freelist. Entries are
+    /// linked in a Treiber stack, where the head of the stack is a pointer
+    /// paired with a generation tag that is updated together through a
+    /// double-width compare-and-swap. The tag is bumped on every
+    /// successful request, which prevents the ABA problem that would
+    /// otherwise occur if an entry is removed and re-stored while another
+    /// thread is still reading it.
+    ///
+    /// \note Since a thread may speculatively read the link of an entry that
+    ///       is concurrently being requested by another thread, the memory
+    ///       stored in the freelist must remain readable for as long as the
+    ///       atomic_freelist is in use (e.g. memory owned by a pool).
+    ///       The semantics, ownership, and validity of the pointers must all
+    ///       be managed from outside
+    ///////////////////////////////////////////////////////////////////////////
+    class atomic_freelist
+    {
+      //-----------------------------------------------------------------------
+      // Constructors
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Default constructs an empty atomic_freelist
+      atomic_freelist() noexcept;
+
+      // Deleted move construction
+      atomic_freelist( atomic_freelist&& other ) = delete;
+
+      // Deleted copy construction
+      atomic_freelist( const atomic_freelist& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      atomic_freelist& operator=( atomic_freelist&& other ) = delete;
+
+      // Deleted copy assignment
+      atomic_freelist& operator=( const atomic_freelist& other ) = delete;
+
+      //----------------------------------------------------------------------
+      // Observers
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns whether or not this atomic_freelist is empty
+      ///
+      /// \note The result is only a snapshot if other threads are accessing
+      ///       this freelist concurrently
+      ///
+      /// \return \c true if this atomic_freelist is empty, \c false otherwise
+      bool empty() const noexcept;
+
+      /// \brief Returns whether the operations on this atomic_freelist are
+      ///        lock-free on the current platform
+      ///
+      /// \return \c true if operations are lock-free
+      bool is_lock_free() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Modifiers
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Empties the atomic_freelist
+      ///
+      /// \note This does not synchronize with concurrent calls to
+      ///       \c request or \c store
+      void clear() noexcept;
+
+      //----------------------------------------------------------------------
+      // Caching
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Requests raw memory from the freelist, if any exists
+      ///
+      /// The size of the returned instance is not known to the freelist
+      ///
+      /// \return pointer to memory, if it exists
+      void* request() noexcept;
+
+      /// \brief Stores raw memory into this freelist
+      ///
+      /// \pre The pointer \p p must point to memory of at least
+      ///      \c sizeof(void*) bytes, and must be suitably aligned to support
+      ///      pointer types.
+      ///
+      /// \param p pointer to the raw memory to store
+      void store( void* p ) noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Member Types
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief The head of the stack, tagged with a generation count
+      struct alignas(2*sizeof(void*)) tagged_pointer
+      {
+        void*          pointer;
+        std::uintptr_t tag;
+      };
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      std::atomic<tagged_pointer> m_head;
+
+      //-----------------------------------------------------------------------
+      // Private Static Member Functions
+      //-----------------------------------------------------------------------
+    private:
+
+      /// \brief Atomically reads the link stored in the entry \p p
+      static void* load_link( const void* p ) noexcept;
+
+      /// \brief Atomically writes the link \p next into the entry \p p
+      static void store_link( void* p, void* next ) noexcept;
+    };
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/atomic_freelist.inl"
+
+#endif /* BIT_MEMORY_UTILITIES_ATOMIC_FREELIST_HPP */
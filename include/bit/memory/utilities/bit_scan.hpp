@@ -0,0 +1,101 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains utilities for scanning the bits of integral
+ *        values, used for size-classes and occupancy bitmaps
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_UTILITIES_BIT_SCAN_HPP
+#define BIT_MEMORY_UTILITIES_BIT_SCAN_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+
+#ifdef _MSC_VER
+#include <intrin.h> // _BitScanReverse64, _BitScanForward64, __popcnt64
+#endif
+
+namespace bit {
+  namespace memory {
+
+    //-------------------------------------------------------------------------
+    // Bit Scanning
+    //-------------------------------------------------------------------------
+
+    /// \brief Counts the number of leading (most-significant) zero bits in
+    ///        \p val
+    ///
+    /// \pre \p val is not 0
+    ///
+    /// \param val the value to scan
+    /// \return the number of leading zero bits
+    std::size_t count_leading_zeros( std::uint64_t val ) noexcept;
+
+    /// \brief Counts the number of trailing (least-significant) zero bits in
+    ///        \p val
+    ///
+    /// \pre \p val is not 0
+    ///
+    /// \param val the value to scan
+    /// \return the number of trailing zero bits
+    std::size_t count_trailing_zeros( std::uint64_t val ) noexcept;
+
+    /// \brief Counts the number of bits set in \p val
+    ///
+    /// \param val the value to count
+    /// \return the number of set bits
+    std::size_t count_set_bits( std::uint64_t val ) noexcept;
+
+    //-------------------------------------------------------------------------
+    // Logarithms
+    //-------------------------------------------------------------------------
+
+    /// \brief Computes the base-2 logarithm of \p val, rounded down
+    ///
+    /// \pre \p val is not 0
+    ///
+    /// \param val the value
+    /// \return the index of the most significant set bit
+    std::size_t floor_log2( std::uint64_t val ) noexcept;
+
+    /// \brief Computes the base-2 logarithm of \p val, rounded up
+    ///
+    /// \pre \p val is not 0
+    ///
+    /// \param val the value
+    /// \return the exponent of the smallest power of two not less than \p val
+    std::size_t ceil_log2( std::uint64_t val ) noexcept;
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/bit_scan.inl"
+
+#endif /* BIT_MEMORY_UTILITIES_BIT_SCAN_HPP */
@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains utilities for querying the processors that the
+ *        calling thread runs on
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_UTILITIES_CPU_HPP
+#define BIT_MEMORY_UTILITIES_CPU_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstddef> // std::size_t
+
+namespace bit {
+  namespace memory {
+
+    //------------------------------------------------------------------------
+    // Global Constants
+    //------------------------------------------------------------------------
+
+    /// The assumed size of a cache line, used to keep data that is written
+    /// by different processors from sharing a line
+    constexpr std::size_t cache_line_size = 64;
+
+    //------------------------------------------------------------------------
+    // Free Functions
+    //------------------------------------------------------------------------
+
+    /// \brief Gets the number of processors configured on this system
+    ///
+    /// \return the number of processors, which is at least 1
+    std::size_t cpu_count() noexcept;
+
+    /// \brief Gets the index of the processor the calling thread is running
+    ///        on
+    ///
+    /// On Linux this reads the cpu id that the kernel publishes in the
+    /// thread's restartable-sequence area when one is registered, and falls
+    /// back to \c sched_getcpu otherwise. Platforms without a way to query
+    /// the processor return a stable value derived from the thread instead.
+    ///
+    /// \note The thread may migrate to another processor at any time, so
+    ///       the result is only a hint; it must never be relied upon for
+    ///       mutual exclusion
+    ///
+    /// \return the index of the current processor
+    std::size_t current_cpu() noexcept;
+
+  } // namespace memory
+} // namespace bit
+
+#endif /* BIT_MEMORY_UTILITIES_CPU_HPP */
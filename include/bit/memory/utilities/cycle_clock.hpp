@@ -0,0 +1,100 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains a cheap clock for timing short operations
+ *****************************************************************************/
+
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_UTILITIES_CYCLE_CLOCK_HPP
+#define BIT_MEMORY_UTILITIES_CYCLE_CLOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdint> // std::uint64_t
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+# include <intrin.h> // __rdtsc
+# define BIT_MEMORY_CYCLE_CLOCK_USE_RDTSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+# include <x86intrin.h> // __rdtsc
+# define BIT_MEMORY_CYCLE_CLOCK_USE_RDTSC 1
+#endif
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A clock that reads the processor's time-stamp counter, for
+    ///        timing operations that only take a few nanoseconds
+    ///
+    /// On x86 this reads the counter with \c rdtsc, which costs a few dozen
+    /// cycles, and ticks at a constant rate on any processor of the last
+    /// decade. Elsewhere this falls back to \c std::chrono::steady_clock,
+    /// and ticks in nanoseconds.
+    ///
+    /// \note \c rdtsc is not a serializing instruction, so the processor may
+    ///       reorder it with the surrounding instructions by a few cycles.
+    ///       This is immaterial for the tail latencies this is meant for,
+    ///       and much cheaper than fencing every read.
+    ///////////////////////////////////////////////////////////////////////////
+    struct cycle_clock
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+
+      using rep = std::uint64_t;
+
+      //-----------------------------------------------------------------------
+      // Public Constants
+      //-----------------------------------------------------------------------
+
+      /// \c true if this clock ticks in cycles, or \c false if it ticks in
+      /// nanoseconds of \c std::chrono::steady_clock
+#if defined(BIT_MEMORY_CYCLE_CLOCK_USE_RDTSC)
+      static constexpr bool is_cycle_counter = true;
+#else
+      static constexpr bool is_cycle_counter = false;
+#endif
+
+      //-----------------------------------------------------------------------
+      // Static Member Functions
+      //-----------------------------------------------------------------------
+
+      /// \brief Reads the current tick of this clock
+      ///
+      /// \return the current tick
+      static rep now() noexcept;
+    };
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/cycle_clock.inl"
+
+#endif /* BIT_MEMORY_UTILITIES_CYCLE_CLOCK_HPP */
@@ -0,0 +1,120 @@
+#ifndef BIT_MEMORY_UTILITIES_DETAIL_ATOMIC_FREELIST_INL
+#define BIT_MEMORY_UTILITIES_DETAIL_ATOMIC_FREELIST_INL
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+inline bit::memory::atomic_freelist::atomic_freelist()
+  noexcept
+  : m_head(tagged_pointer{nullptr,0u})
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+inline bool bit::memory::atomic_freelist::empty()
+  const noexcept
+{
+  return m_head.load(std::memory_order_relaxed).pointer == nullptr;
+}
+
+inline bool bit::memory::atomic_freelist::is_lock_free()
+  const noexcept
+{
+  return m_head.is_lock_free();
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::atomic_freelist::clear()
+  noexcept
+{
+  auto head = m_head.load(std::memory_order_relaxed);
+
+  // The tag is preserved so that any stale reader still fails its exchange
+  m_head.store( tagged_pointer{nullptr,head.tag+1}, std::memory_order_release );
+}
+
+//-----------------------------------------------------------------------------
+// Caching
+//-----------------------------------------------------------------------------
+
+inline void* bit::memory::atomic_freelist::request()
+  noexcept
+{
+  auto head = m_head.load(std::memory_order_acquire);
+
+  while( head.pointer != nullptr ) {
+    // This read may observe an entry that was concurrently requested by
+    // another thread; the tag comparison rejects the exchange in that case
+    const auto next = tagged_pointer{
+      load_link( head.pointer ),
+      head.tag + 1
+    };
+
+    if( m_head.compare_exchange_weak( head, next,
+                                      std::memory_order_acquire,
+                                      std::memory_order_acquire ) ) {
+      return head.pointer;
+    }
+  }
+  return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::atomic_freelist::store( void* p )
+  noexcept
+{
+  assert( alignof(void*) <= align_of(p) );
+
+  auto head = m_head.load(std::memory_order_relaxed);
+  auto next = tagged_pointer{};
+  do {
+    store_link( p, head.pointer );
+    next = tagged_pointer{p,head.tag};
+  } while( !m_head.compare_exchange_weak( head, next,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed ) );
+}
+
+//-----------------------------------------------------------------------------
+// Private Static Member Functions
+//-----------------------------------------------------------------------------
+
+BIT_MEMORY_NO_SANITIZE_THREAD
+inline void* bit::memory::atomic_freelist::load_link( const void* p )
+  noexcept
+{
+  // The link may be written by a concurrent 'store' of the same entry, so it
+  // is always accessed atomically. Relaxed ordering suffices, since the
+  // exchange of the head orders everything else.
+  //
+  // A stale reader may also read an entry that has since been handed out
+  // and overwritten by its new owner; the value read is then discarded by
+  // the failed exchange. Such a read is benign, but the owner's writes are
+  // not atomic, so it is hidden from ThreadSanitizer.
+#if defined(__GNUC__) || defined(__clang__)
+  return __atomic_load_n( static_cast<void* const*>(p), __ATOMIC_RELAXED );
+#else
+  return *static_cast<void* const volatile*>(p);
+#endif
+}
+
+inline void bit::memory::atomic_freelist::store_link( void* p, void* next )
+  noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __atomic_store_n( static_cast<void**>(p), next, __ATOMIC_RELAXED );
+#else
+  *static_cast<void* volatile*>(p) = next;
+#endif
+}
+
+#endif /* BIT_MEMORY_UTILITIES_DETAIL_ATOMIC_FREELIST_INL */
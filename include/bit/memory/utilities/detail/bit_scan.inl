@@ -0,0 +1,82 @@
+#ifndef BIT_MEMORY_UTILITIES_DETAIL_BIT_SCAN_INL
+#define BIT_MEMORY_UTILITIES_DETAIL_BIT_SCAN_INL
+
+//-----------------------------------------------------------------------------
+// Bit Scanning
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::count_leading_zeros( std::uint64_t val )
+  noexcept
+{
+  assert( val != 0 && "cannot scan the bits of 0" );
+
+#if defined(__GNUC__)
+  return static_cast<std::size_t>(__builtin_clzll(val));
+#elif defined(_MSC_VER) && defined(_M_X64)
+  auto index = 0ul;
+  _BitScanReverse64(&index,val);
+  return 63u - index;
+#else
+  auto result = std::size_t{0};
+  for( auto mask = std::uint64_t{1} << 63; (val & mask) == 0; mask >>= 1 ) {
+    ++result;
+  }
+  return result;
+#endif
+}
+
+inline std::size_t bit::memory::count_trailing_zeros( std::uint64_t val )
+  noexcept
+{
+  assert( val != 0 && "cannot scan the bits of 0" );
+
+#if defined(__GNUC__)
+  return static_cast<std::size_t>(__builtin_ctzll(val));
+#elif defined(_MSC_VER) && defined(_M_X64)
+  auto index = 0ul;
+  _BitScanForward64(&index,val);
+  return index;
+#else
+  auto result = std::size_t{0};
+  for( auto mask = std::uint64_t{1}; (val & mask) == 0; mask <<= 1 ) {
+    ++result;
+  }
+  return result;
+#endif
+}
+
+inline std::size_t bit::memory::count_set_bits( std::uint64_t val )
+  noexcept
+{
+#if defined(__GNUC__)
+  return static_cast<std::size_t>(__builtin_popcountll(val));
+#elif defined(_MSC_VER) && defined(_M_X64)
+  return static_cast<std::size_t>(__popcnt64(val));
+#else
+  auto result = std::size_t{0};
+  for( ; val != 0; val &= (val - 1) ) {
+    ++result;
+  }
+  return result;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Logarithms
+//-----------------------------------------------------------------------------
+
+inline std::size_t bit::memory::floor_log2( std::uint64_t val )
+  noexcept
+{
+  return 63u - count_leading_zeros(val);
+}
+
+inline std::size_t bit::memory::ceil_log2( std::uint64_t val )
+  noexcept
+{
+  assert( val != 0 && "logarithm of 0 is undefined" );
+
+  return (val == 1) ? 0u : floor_log2(val - 1) + 1u;
+}
+
+#endif /* BIT_MEMORY_UTILITIES_DETAIL_BIT_SCAN_INL */
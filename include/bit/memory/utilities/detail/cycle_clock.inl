@@ -0,0 +1,22 @@
+#ifndef BIT_MEMORY_UTILITIES_DETAIL_CYCLE_CLOCK_INL
+#define BIT_MEMORY_UTILITIES_DETAIL_CYCLE_CLOCK_INL
+
+//-----------------------------------------------------------------------------
+// Static Member Functions
+//-----------------------------------------------------------------------------
+
+inline bit::memory::cycle_clock::rep bit::memory::cycle_clock::now()
+  noexcept
+{
+#if defined(BIT_MEMORY_CYCLE_CLOCK_USE_RDTSC)
+  return static_cast<rep>(__rdtsc());
+#else
+  using namespace std::chrono;
+
+  return static_cast<rep>(
+    duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count()
+  );
+#endif
+}
+
+#endif /* BIT_MEMORY_UTILITIES_DETAIL_CYCLE_CLOCK_INL */
@@ -71,11 +71,38 @@ inline void* bit::memory::freelist::request()
 
 //-----------------------------------------------------------------------------
 
+inline std::size_t bit::memory::freelist::request_n( void** out,
+                                                     std::size_t n )
+  noexcept
+{
+  auto i = std::size_t{0};
+  for( ; i < n && m_head; ++i ) {
+    out[i] = m_head;
+    m_head = (*static_cast<void**>(m_head));
+  }
+  return i;
+}
+
+//-----------------------------------------------------------------------------
+
 inline void bit::memory::freelist::steal( freelist& other )
   noexcept
 {
-  auto p = other.request();
-  if( p ) store(p);
+  if( other.m_head == nullptr ) return;
+
+  if( m_head == nullptr ) {
+    swap( other );
+    return;
+  }
+
+  // Find the last entry of the other list to link it to this one
+  auto last = other.m_head;
+  while( *static_cast<void**>(last) ) {
+    last = *static_cast<void**>(last);
+  }
+
+  splice( other.m_head, last );
+  other.m_head = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -91,6 +118,17 @@ inline void bit::memory::freelist::store( void* p )
   m_head = p;
 }
 
+//-----------------------------------------------------------------------------
+
+inline void bit::memory::freelist::splice( void* first, void* last )
+  noexcept
+{
+  using pointer = void*;
+
+  uninitialized_construct_at<pointer>(last,m_head);
+  m_head = first;
+}
+
 //-----------------------------------------------------------------------------
 // Comparisons
 //-----------------------------------------------------------------------------
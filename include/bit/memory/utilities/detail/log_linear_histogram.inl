@@ -0,0 +1,176 @@
+#ifndef BIT_MEMORY_UTILITIES_DETAIL_LOG_LINEAR_HISTOGRAM_INL
+#define BIT_MEMORY_UTILITIES_DETAIL_LOG_LINEAR_HISTOGRAM_INL
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+template<std::size_t Precision>
+inline bit::memory::log_linear_histogram<Precision>::log_linear_histogram()
+  noexcept
+{
+  clear();
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+template<std::size_t Precision>
+inline void bit::memory::log_linear_histogram<Precision>
+  ::record( std::uint64_t value )
+  noexcept
+{
+  ++m_counts[ bucket_of(value) ];
+  ++m_count;
+
+  if( value < m_min ) m_min = value;
+  if( value > m_max ) m_max = value;
+}
+
+template<std::size_t Precision>
+inline void bit::memory::log_linear_histogram<Precision>::clear()
+  noexcept
+{
+  for( auto& count : m_counts ) {
+    count = 0;
+  }
+  m_count = 0;
+  m_min   = std::numeric_limits<std::uint64_t>::max();
+  m_max   = 0;
+}
+
+template<std::size_t Precision>
+inline void bit::memory::log_linear_histogram<Precision>
+  ::merge( const log_linear_histogram& other )
+  noexcept
+{
+  for( auto i = std::size_t{0}; i < buckets; ++i ) {
+    m_counts[i] += other.m_counts[i];
+  }
+  m_count += other.m_count;
+
+  if( other.m_min < m_min ) m_min = other.m_min;
+  if( other.m_max > m_max ) m_max = other.m_max;
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template<std::size_t Precision>
+inline std::uint64_t bit::memory::log_linear_histogram<Precision>::count()
+  const noexcept
+{
+  return m_count;
+}
+
+template<std::size_t Precision>
+inline std::uint64_t bit::memory::log_linear_histogram<Precision>::min()
+  const noexcept
+{
+  return m_count == 0 ? 0 : m_min;
+}
+
+template<std::size_t Precision>
+inline std::uint64_t bit::memory::log_linear_histogram<Precision>::max()
+  const noexcept
+{
+  return m_max;
+}
+
+template<std::size_t Precision>
+inline std::uint64_t bit::memory::log_linear_histogram<Precision>
+  ::value_at_percentile( double percentile )
+  const noexcept
+{
+  assert( percentile >= 0.0 && percentile <= 100.0 );
+
+  if( m_count == 0 ) return 0;
+
+  // The nearest rank of the value, counting from 1
+  auto rank = static_cast<std::uint64_t>( std::ceil( (percentile / 100.0) * m_count ) );
+  if( rank == 0 ) rank = 1;
+  if( rank > m_count ) rank = m_count;
+
+  auto seen = std::uint64_t{0};
+  for( auto i = std::size_t{0}; i < buckets; ++i ) {
+    seen += m_counts[i];
+
+    if( seen >= rank ) {
+      const auto upper = bucket_upper_bound(i);
+      return upper < m_max ? upper : m_max;
+    }
+  }
+  return m_max;
+}
+
+template<std::size_t Precision>
+inline std::uint64_t bit::memory::log_linear_histogram<Precision>
+  ::count_at( std::size_t bucket )
+  const noexcept
+{
+  assert( bucket < buckets );
+
+  return m_counts[bucket];
+}
+
+//-----------------------------------------------------------------------------
+// Iteration
+//-----------------------------------------------------------------------------
+
+template<std::size_t Precision>
+template<typename Fn>
+inline void bit::memory::log_linear_histogram<Precision>
+  ::for_each_bucket( Fn&& fn )
+  const
+{
+  for( auto i = std::size_t{0}; i < buckets; ++i ) {
+    if( m_counts[i] == 0 ) continue;
+
+    fn( bucket_lower_bound(i), bucket_upper_bound(i), m_counts[i] );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Buckets
+//-----------------------------------------------------------------------------
+
+template<std::size_t Precision>
+inline std::size_t bit::memory::log_linear_histogram<Precision>
+  ::bucket_of( std::uint64_t value )
+  noexcept
+{
+  if( value < sub_buckets ) return static_cast<std::size_t>(value);
+
+  // Keep the top 'Precision + 1' bits; the leading bit selects the range
+  // with 'shift', and the remaining bits select the bucket within it
+  const auto shift = floor_log2(value) - Precision;
+
+  return shift * sub_buckets + static_cast<std::size_t>(value >> shift);
+}
+
+template<std::size_t Precision>
+inline std::uint64_t bit::memory::log_linear_histogram<Precision>
+  ::bucket_lower_bound( std::size_t bucket )
+  noexcept
+{
+  if( bucket < sub_buckets ) return bucket;
+
+  const auto shift    = (bucket / sub_buckets) - 1;
+  const auto mantissa = bucket - (shift * sub_buckets);
+
+  return std::uint64_t{mantissa} << shift;
+}
+
+template<std::size_t Precision>
+inline std::uint64_t bit::memory::log_linear_histogram<Precision>
+  ::bucket_upper_bound( std::size_t bucket )
+  noexcept
+{
+  if( bucket + 1 == buckets ) return std::numeric_limits<std::uint64_t>::max();
+
+  return bucket_lower_bound( bucket + 1 ) - 1;
+}
+
+#endif /* BIT_MEMORY_UTILITIES_DETAIL_LOG_LINEAR_HISTOGRAM_INL */
@@ -0,0 +1,44 @@
+#ifndef BIT_MEMORY_UTILITIES_DETAIL_SCOPED_ARENA_FRAME_INL
+#define BIT_MEMORY_UTILITIES_DETAIL_SCOPED_ARENA_FRAME_INL
+
+//-----------------------------------------------------------------------------
+// Constructors / Destructor
+//-----------------------------------------------------------------------------
+
+template<typename Arena>
+inline bit::memory::scoped_arena_frame<Arena>
+  ::scoped_arena_frame( Arena& arena )
+  noexcept
+  : m_arena(std::addressof(arena)),
+    m_marker(arena.checkpoint())
+{
+
+}
+
+template<typename Arena>
+inline bit::memory::scoped_arena_frame<Arena>::~scoped_arena_frame()
+{
+  m_arena->rewind( m_marker );
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template<typename Arena>
+inline typename bit::memory::scoped_arena_frame<Arena>::arena_type&
+  bit::memory::scoped_arena_frame<Arena>::arena()
+  const noexcept
+{
+  return *m_arena;
+}
+
+template<typename Arena>
+inline typename bit::memory::scoped_arena_frame<Arena>::checkpoint_type
+  bit::memory::scoped_arena_frame<Arena>::marker()
+  const noexcept
+{
+  return m_marker;
+}
+
+#endif /* BIT_MEMORY_UTILITIES_DETAIL_SCOPED_ARENA_FRAME_INL */
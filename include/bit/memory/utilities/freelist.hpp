@@ -119,7 +119,20 @@ namespace bit {
       /// \return pointer to memory, if it exists
       void* request() noexcept;
 
-      /// \brief Steals raw meory from an existing freelist
+      /// \brief Requests up to \p n entries of raw memory from the freelist
+      ///
+      /// \param out the array to write the entries to
+      /// \param n the number of entries to request
+      /// \return the number of entries written to \p out
+      std::size_t request_n( void** out, std::size_t n ) noexcept;
+
+      /// \brief Steals all raw memory from an existing freelist, leaving
+      ///        \p other empty
+      ///
+      /// \note This is O(1) if this freelist is empty, otherwise it is
+      ///       linear in the size of \p other
+      ///
+      /// \param other the freelist to steal from
       void steal( freelist& other ) noexcept;
 
       /// \brief Stores raw memory into this freelist
@@ -131,6 +144,15 @@ namespace bit {
       /// \param p pointer to the raw memory to store
       void store( void* p ) noexcept;
 
+      /// \brief Stores a chain of raw memory into this freelist in O(1)
+      ///
+      /// \pre Each entry from \p first to \p last must already point to the
+      ///      next entry, as if it were stored with \c store
+      ///
+      /// \param first the first entry of the chain
+      /// \param last the last entry of the chain
+      void splice( void* first, void* last ) noexcept;
+
       //-----------------------------------------------------------------------
       // Private Members
       //-----------------------------------------------------------------------
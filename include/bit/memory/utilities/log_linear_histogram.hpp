@@ -0,0 +1,194 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains the definition for a fixed-size histogram
+ *        with logarithmically spaced, linearly subdivided buckets
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_UTILITIES_LOG_LINEAR_HISTOGRAM_HPP
+#define BIT_MEMORY_UTILITIES_LOG_LINEAR_HISTOGRAM_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "bit_scan.hpp" // floor_log2
+
+#include <cassert> // assert
+#include <cmath>   // std::ceil
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <limits>  // std::numeric_limits
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A histogram of 64-bit values with a bounded relative error
+    ///
+    /// Each power-of-two range of values is split into \c 2^Precision
+    /// equally sized buckets, so a value is recorded with a relative error
+    /// of at most \c 2^-Precision. Values below \c 2^(Precision+1) each
+    /// have their own bucket, and so are recorded exactly.
+    ///
+    /// Recording a value is a bit-scan, a shift and an increment, and the
+    /// histogram never allocates; its size is fixed by \c Precision.
+    ///
+    /// \tparam Precision the number of bits of each value that are kept
+    ///////////////////////////////////////////////////////////////////////////
+    template<std::size_t Precision>
+    class log_linear_histogram
+    {
+      static_assert( Precision < 16, "Precision must be less than 16 bits" );
+
+      //-----------------------------------------------------------------------
+      // Public Constants
+      //-----------------------------------------------------------------------
+    public:
+
+      /// The number of buckets each power-of-two range is split into
+      static constexpr std::size_t sub_buckets = std::size_t{1} << Precision;
+
+      /// The total number of buckets in the histogram
+      static constexpr std::size_t buckets = (65 - Precision) * sub_buckets;
+
+      //-----------------------------------------------------------------------
+      // Constructors
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an empty histogram
+      log_linear_histogram() noexcept;
+
+      //-----------------------------------------------------------------------
+      // Modifiers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Records a single occurrence of \p value
+      ///
+      /// \param value the value to record
+      void record( std::uint64_t value ) noexcept;
+
+      /// \brief Removes every recorded value
+      void clear() noexcept;
+
+      /// \brief Records every value recorded in \p other into this histogram
+      ///
+      /// \param other the histogram to merge
+      void merge( const log_linear_histogram& other ) noexcept;
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the number of values recorded
+      ///
+      /// \return the number of values
+      std::uint64_t count() const noexcept;
+
+      /// \brief Gets the smallest value recorded
+      ///
+      /// \return the smallest value, or 0 if nothing is recorded
+      std::uint64_t min() const noexcept;
+
+      /// \brief Gets the largest value recorded
+      ///
+      /// \return the largest value, or 0 if nothing is recorded
+      std::uint64_t max() const noexcept;
+
+      /// \brief Gets the smallest value that is greater than or equal to
+      ///        \p percentile percent of the recorded values
+      ///
+      /// The result is the upper bound of the bucket holding the value, so
+      /// it is within the relative error of the histogram, and never
+      /// exceeds \c max()
+      ///
+      /// \param percentile the percentile, in the range [0,100]
+      /// \return the value at the percentile, or 0 if nothing is recorded
+      std::uint64_t value_at_percentile( double percentile ) const noexcept;
+
+      /// \brief Gets the number of values recorded in \p bucket
+      ///
+      /// \param bucket the index of the bucket
+      /// \return the number of values in the bucket
+      std::uint64_t count_at( std::size_t bucket ) const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Iteration
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Invokes \p fn for every bucket that holds a value, in
+      ///        increasing order
+      ///
+      /// \param fn a function invocable as
+      ///        \c fn(std::uint64_t lower, std::uint64_t upper, std::uint64_t count),
+      ///        where \c lower and \c upper are the inclusive bounds of the
+      ///        bucket
+      template<typename Fn>
+      void for_each_bucket( Fn&& fn ) const;
+
+      //-----------------------------------------------------------------------
+      // Buckets
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the index of the bucket that \p value is recorded in
+      ///
+      /// \param value the value
+      /// \return the index of the bucket
+      static std::size_t bucket_of( std::uint64_t value ) noexcept;
+
+      /// \brief Gets the smallest value recorded in \p bucket
+      ///
+      /// \param bucket the index of the bucket
+      /// \return the inclusive lower bound of the bucket
+      static std::uint64_t bucket_lower_bound( std::size_t bucket ) noexcept;
+
+      /// \brief Gets the largest value recorded in \p bucket
+      ///
+      /// \param bucket the index of the bucket
+      /// \return the inclusive upper bound of the bucket
+      static std::uint64_t bucket_upper_bound( std::size_t bucket ) noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      std::uint64_t m_counts[buckets];
+      std::uint64_t m_count;
+      std::uint64_t m_min;
+      std::uint64_t m_max;
+    };
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/log_linear_histogram.inl"
+
+#endif /* BIT_MEMORY_UTILITIES_LOG_LINEAR_HISTOGRAM_HPP */
@@ -53,6 +53,10 @@
 #error BIT_MEMORY_UNUSED cannot be defined outside of macros.hpp
 #endif
 
+#ifdef BIT_MEMORY_NO_SANITIZE_THREAD
+#error BIT_MEMORY_NO_SANITIZE_THREAD cannot be defined outside of macros.hpp
+#endif
+
 #ifdef __GNUC__
 #define BIT_MEMORY_LIKELY(x) __builtin_expect(!!(x),1)
 #else
@@ -85,4 +89,10 @@
 
 #define BIT_MEMORY_UNUSED(x) (void) x
 
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 8))
+#define BIT_MEMORY_NO_SANITIZE_THREAD __attribute__((no_sanitize("thread")))
+#else
+#define BIT_MEMORY_NO_SANITIZE_THREAD
+#endif
+
 #endif /* BIT_MEMORY_UTILITIES_MACROS_HPP */
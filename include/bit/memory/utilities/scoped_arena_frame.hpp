@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * \file
+ * \brief This header contains an RAII utility for rewinding an arena to a
+ *        checkpoint at the end of a scope
+ *****************************************************************************/
+
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2018 Matthew Rodusek
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef BIT_MEMORY_UTILITIES_SCOPED_ARENA_FRAME_HPP
+#define BIT_MEMORY_UTILITIES_SCOPED_ARENA_FRAME_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <memory> // std::addressof
+
+namespace bit {
+  namespace memory {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A scoped frame of allocations from an arena
+    ///
+    /// On construction, the state of the arena is recorded with
+    /// \c checkpoint. On destruction, the arena is rewound to that state with
+    /// \c rewind, deallocating everything that was allocated from the arena
+    /// during the lifetime of the frame at once.
+    ///
+    /// Frames may be nested, as long as they are destroyed in the reverse
+    /// order of construction.
+    ///
+    /// \tparam Arena an allocator with \c checkpoint() and
+    ///         \c rewind(checkpoint_type) functions, such as the
+    ///         bump_up_allocator, bump_down_allocator, stack_allocator, or
+    ///         arena_allocator
+    ///////////////////////////////////////////////////////////////////////////
+    template<typename Arena>
+    class scoped_arena_frame
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using arena_type      = Arena;
+      using checkpoint_type = typename Arena::checkpoint_type;
+
+      //-----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a frame that records the current state of \p arena
+      ///
+      /// \param arena the arena to rewind at the end of this frame
+      explicit scoped_arena_frame( Arena& arena ) noexcept;
+
+      // Deleted move constructor
+      scoped_arena_frame( scoped_arena_frame&& other ) = delete;
+
+      // Deleted copy constructor
+      scoped_arena_frame( const scoped_arena_frame& other ) = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Rewinds the arena to the state recorded on construction
+      ~scoped_arena_frame();
+
+      //-----------------------------------------------------------------------
+
+      // Deleted move assignment
+      scoped_arena_frame& operator=( scoped_arena_frame&& other ) = delete;
+
+      // Deleted copy assignment
+      scoped_arena_frame& operator=( const scoped_arena_frame& other ) = delete;
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the arena that this frame rewinds
+      ///
+      /// \return reference to the arena
+      arena_type& arena() const noexcept;
+
+      /// \brief Gets the marker that this frame rewinds to
+      ///
+      /// \return the marker
+      checkpoint_type marker() const noexcept;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      Arena*          m_arena;
+      checkpoint_type m_marker;
+    };
+
+  } // namespace memory
+} // namespace bit
+
+#include "detail/scoped_arena_frame.inl"
+
+#endif /* BIT_MEMORY_UTILITIES_SCOPED_ARENA_FRAME_HPP */
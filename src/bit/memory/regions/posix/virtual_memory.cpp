@@ -1,6 +1,8 @@
 #include <bit/memory/regions/virtual_memory.hpp>
 
 #include <cassert>
+#include <cstdint> // std::uintptr_t
+#include <cstdio>  // std::fopen, std::fscanf
 
 #include <sys/mman.h> // ::mmap
 #include <unistd.h>   // ::sysconf
@@ -23,6 +25,27 @@ namespace
   ///
   /// \return the virtual page size
   std::size_t get_virtual_page_size() noexcept;
+
+  /// \brief Determines the huge page size on posix
+  ///
+  /// \return the huge page size, or the virtual page size if huge pages
+  ///         are not supported
+  std::size_t get_huge_page_size() noexcept;
+
+  /// \brief Reserves \p size bytes of memory aligned to \p align, advising
+  ///        that it be backed by transparent huge pages
+  ///
+  /// \param size the number of bytes to reserve
+  /// \param align the alignment of the memory
+  /// \return the reserved memory, or \c nullptr on failure
+  void* reserve_transparent_huge( std::size_t size, std::size_t align ) noexcept;
+
+  /// \brief Reserves \p size bytes of memory backed by explicit huge pages
+  ///
+  /// \param size the number of bytes to reserve
+  /// \param page_size the size of each huge page
+  /// \return the reserved memory, or \c nullptr on failure
+  void* reserve_explicit_huge( std::size_t size, std::size_t page_size ) noexcept;
 }
 
 //--------------------------------------------------------------------------
@@ -37,6 +60,22 @@ std::size_t bit::memory::virtual_memory_page_size()
   return s_page_size;
 }
 
+std::size_t bit::memory::virtual_memory_huge_page_size()
+  noexcept
+{
+  static const std::size_t s_page_size = get_huge_page_size();
+
+  return s_page_size;
+}
+
+std::size_t bit::memory::virtual_memory_page_size( virtual_memory_page_mode mode )
+  noexcept
+{
+  return (mode == virtual_memory_page_mode::standard)
+         ? virtual_memory_page_size()
+         : virtual_memory_huge_page_size();
+}
+
 //--------------------------------------------------------------------------
 
 void* bit::memory::virtual_memory_reserve( std::size_t n )
@@ -49,6 +88,38 @@ void* bit::memory::virtual_memory_reserve( std::size_t n )
   return ptr == MAP_FAILED ? nullptr : ptr;
 }
 
+void* bit::memory::virtual_memory_reserve( std::size_t n,
+                                           virtual_memory_page_mode mode,
+                                           virtual_memory_page_mode* actual )
+  noexcept
+{
+  const auto page_size = virtual_memory_page_size(mode);
+
+  // Without huge page support, every mode uses standard pages
+  if( page_size == virtual_memory_page_size() ) {
+    mode = virtual_memory_page_mode::standard;
+  }
+
+  auto ptr = static_cast<void*>(nullptr);
+
+  if( mode == virtual_memory_page_mode::huge ) {
+    ptr = reserve_explicit_huge( n * page_size, page_size );
+
+    // Fall back to transparent huge pages if none are reserved in the system
+    if( !ptr ) mode = virtual_memory_page_mode::transparent_huge;
+  }
+
+  if( mode == virtual_memory_page_mode::transparent_huge ) {
+    ptr = reserve_transparent_huge( n * page_size, page_size );
+  } else if( mode == virtual_memory_page_mode::standard ) {
+    ptr = virtual_memory_reserve( n );
+  }
+
+  if( actual ) *actual = mode;
+
+  return ptr;
+}
+
 //--------------------------------------------------------------------------
 
 void* bit::memory::virtual_memory_commit( void* memory, std::size_t n )
@@ -70,6 +141,36 @@ void* bit::memory::virtual_memory_commit( void* memory, std::size_t n )
   return memory;
 }
 
+void* bit::memory::virtual_memory_commit( void* memory,
+                                          std::size_t n,
+                                          virtual_memory_page_mode mode )
+  noexcept
+{
+  auto size = n * virtual_memory_page_size(mode);
+
+  return virtual_memory_commit( memory, size / virtual_memory_page_size() );
+}
+
+//--------------------------------------------------------------------------
+
+void bit::memory::virtual_memory_prefault( void* memory, std::size_t size )
+  noexcept
+{
+#if defined(MADV_POPULATE_WRITE)
+  // Faults in every page with a single call, without touching it
+  if( ::madvise(memory, size, MADV_POPULATE_WRITE) == 0 ) return;
+#endif
+
+  // Older kernels; write to each page so that it is faulted in writable,
+  // preserving its contents
+  const auto page_size = virtual_memory_page_size();
+  auto* const begin    = static_cast<volatile char*>(memory);
+
+  for( auto offset = std::size_t{0}; offset < size; offset += page_size ) {
+    begin[offset] = begin[offset];
+  }
+}
+
 //--------------------------------------------------------------------------
 
 void bit::memory::virtual_memory_decommit( void* memory, std::size_t n )
@@ -92,6 +193,33 @@ void bit::memory::virtual_memory_decommit( void* memory, std::size_t n )
   (void) result;
 }
 
+void bit::memory::virtual_memory_decommit( void* memory,
+                                           std::size_t n,
+                                           virtual_memory_page_mode mode )
+  noexcept
+{
+  if( mode == virtual_memory_page_mode::standard ) {
+    virtual_memory_decommit( memory, n );
+    return;
+  }
+
+  auto size = n * virtual_memory_page_size(mode);
+
+  // Lazy freeing is not supported for explicit huge pages, and would only
+  // split transparent ones, so the pages are dropped eagerly
+#if defined(MADV_DONTNEED)
+  ::madvise(memory, size, MADV_DONTNEED);
+#elif defined(POSIX_MADV_DONTNEED)
+  ::posix_madvise(memory, size, POSIX_MADV_DONTNEED);
+#endif
+
+  auto result = ::mprotect(memory, size, PROT_NONE);
+
+  assert(result == 0 && "virtual_memory_decommit: unable to decommit memory");
+
+  (void) result;
+}
+
 //--------------------------------------------------------------------------
 
 void bit::memory::virtual_memory_release( void* memory, std::size_t n )
@@ -105,6 +233,19 @@ void bit::memory::virtual_memory_release( void* memory, std::size_t n )
   (void) result;
 }
 
+void bit::memory::virtual_memory_release( void* memory,
+                                          std::size_t n,
+                                          virtual_memory_page_mode mode )
+  noexcept
+{
+  auto size   = n * virtual_memory_page_size(mode);
+  auto result = ::munmap(memory, size);
+
+  assert(result == 0 && "virtual_memory_release: unable to release memory");
+
+  (void) result;
+}
+
 //--------------------------------------------------------------------------
 
 namespace {
@@ -115,4 +256,89 @@ namespace {
     return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
   }
 
+  std::size_t get_huge_page_size()
+    noexcept
+  {
+#if defined(MADV_HUGEPAGE) || defined(MAP_HUGETLB)
+    auto size = 0ul;
+
+    // The PMD-level page size used for transparent huge pages
+    if( auto file = std::fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size","r") ) {
+      if( std::fscanf(file, "%lu", &size) != 1 ) size = 0;
+      std::fclose(file);
+    }
+
+    // The default size of explicit huge pages, in KiB
+    if( size == 0 ) {
+      if( auto file = std::fopen("/proc/meminfo","r") ) {
+        char line[128];
+        while( std::fgets(line, sizeof(line), file) ) {
+          if( std::sscanf(line, "Hugepagesize: %lu kB", &size) == 1 ) {
+            size *= 1024;
+            break;
+          }
+        }
+        std::fclose(file);
+      }
+    }
+
+    if( size == 0 ) size = 2 * 1024 * 1024;
+
+    return static_cast<std::size_t>(size);
+#else
+    return get_virtual_page_size();
+#endif
+  }
+
+  void* reserve_transparent_huge( std::size_t size, std::size_t align )
+    noexcept
+  {
+    // Over-reserve by 'align' bytes (one huge page) so that a range aligned
+    // to it always fits, then give back the unused head and tail
+    auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    auto ptr   = ::mmap(nullptr, size + align, PROT_NONE, flags, -1, 0);
+
+    if( ptr == MAP_FAILED ) return nullptr;
+
+    auto* const begin   = static_cast<char*>(ptr);
+    auto* const aligned = reinterpret_cast<char*>(
+      (reinterpret_cast<std::uintptr_t>(begin) + align - 1) & ~(align - 1)
+    );
+    auto const  head = static_cast<std::size_t>(aligned - begin);
+    auto const  tail = align - head;
+
+    if( head != 0 ) ::munmap(begin, head);
+    if( tail != 0 ) ::munmap(aligned + size, tail);
+
+#if defined(MADV_HUGEPAGE)
+    ::madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+
+    return aligned;
+  }
+
+  void* reserve_explicit_huge( std::size_t size, std::size_t page_size )
+    noexcept
+  {
+#if defined(MAP_HUGETLB)
+    auto flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+
+# if defined(MAP_HUGE_SHIFT)
+    // Request pages of exactly page_size, rather than the system default
+    auto shift = 0;
+    while( (std::size_t{1} << shift) < page_size ) ++shift;
+    flags |= (shift << MAP_HUGE_SHIFT);
+# endif
+
+    auto ptr = ::mmap(nullptr, size, PROT_NONE, flags, -1, 0);
+
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#else
+    (void) size;
+    (void) page_size;
+
+    return nullptr;
+#endif
+  }
+
 } // anonymous namespace
@@ -1,5 +1,61 @@
 #include <bit/memory/regions/virtual_memory.hpp>
 
+#include <thread> // std::thread
+#include <vector> // std::vector
+
+//============================================================================
+// Free Functions
+//============================================================================
+
+void bit::memory::virtual_memory_prefault( void* memory,
+                                           std::size_t size,
+                                           std::size_t threads )
+  noexcept
+{
+  const auto page_size = virtual_memory_page_size();
+  const auto pages     = (size + page_size - 1) / page_size;
+
+  if( threads > pages ) threads = pages;
+  if( threads <= 1 ) {
+    virtual_memory_prefault( memory, size );
+    return;
+  }
+
+  // Each thread faults in a whole number of pages; the calling thread
+  // takes the first share
+  const auto share = ((pages + threads - 1) / threads) * page_size;
+  auto* const begin = static_cast<char*>(memory);
+  auto* const end   = begin + size;
+
+  auto workers = std::vector<std::thread>{};
+  auto* first  = begin + share;
+
+  try {
+    workers.reserve( threads - 1 );
+
+    for( ; first < end; first += share ) {
+      const auto n = (static_cast<std::size_t>(end - first) < share)
+                     ? static_cast<std::size_t>(end - first)
+                     : share;
+
+      workers.emplace_back([first, n]{
+        virtual_memory_prefault( first, n );
+      });
+    }
+  } catch( ... ) {
+    // Any share that could not be handed to a thread is done here instead
+    if( first < end ) {
+      virtual_memory_prefault( first, static_cast<std::size_t>(end - first) );
+    }
+  }
+
+  virtual_memory_prefault( begin, (size < share) ? size : share );
+
+  for( auto& worker : workers ) {
+    worker.join();
+  }
+}
+
 //============================================================================
 // virtual_memory
 //============================================================================
@@ -10,24 +66,38 @@
 
 bit::memory::virtual_memory::virtual_memory( std::size_t pages )
   : m_data(virtual_memory_reserve(pages)),
-    m_pages(pages)
+    m_pages(pages),
+    m_mode(virtual_memory_page_mode::standard),
+    m_commit_mode(virtual_memory_commit_mode::lazy)
 {
 
 }
 
+bit::memory::virtual_memory::virtual_memory( std::size_t pages,
+                                             virtual_memory_page_mode mode )
+  : m_data(nullptr),
+    m_pages(pages),
+    m_mode(mode),
+    m_commit_mode(virtual_memory_commit_mode::lazy)
+{
+  m_data = virtual_memory_reserve(pages,mode,&m_mode);
+}
+
 bit::memory::virtual_memory::virtual_memory( virtual_memory&& other )
   noexcept
   : m_data(other.m_data),
-    m_pages(other.m_pages)
+    m_pages(other.m_pages),
+    m_mode(other.m_mode),
+    m_commit_mode(other.m_commit_mode)
 {
-  m_data  = nullptr;
-  m_pages = 0;
+  other.m_data  = nullptr;
+  other.m_pages = 0;
 }
 
 bit::memory::virtual_memory::~virtual_memory()
 {
   if(m_data) {
-    virtual_memory_release(m_data,m_pages);
+    virtual_memory_release(m_data,m_pages,m_mode);
   }
 }
 
@@ -39,6 +109,8 @@ bit::memory::virtual_memory&
 {
   m_data  = other.m_data;
   m_pages = other.m_pages;
+  m_mode  = other.m_mode;
+  m_commit_mode = other.m_commit_mode;
   other.m_data  = nullptr;
   other.m_pages = 0;
 
@@ -52,18 +124,28 @@ bit::memory::virtual_memory&
 void bit::memory::virtual_memory::commit( std::ptrdiff_t n )
   noexcept
 {
-  auto ptr = static_cast<char*>(m_data) + (n * virtual_memory_page_size());
+  auto ptr = static_cast<char*>(m_data) + (n * page_size());
 
-  virtual_memory_commit( ptr, 1 );
+  if( virtual_memory_commit( ptr, 1, m_mode ) == nullptr ) return;
+
+  if( m_commit_mode == virtual_memory_commit_mode::prefault ) {
+    virtual_memory_prefault( ptr, page_size() );
+  }
 }
 
 
 void bit::memory::virtual_memory::decommit( std::ptrdiff_t n )
   noexcept
 {
-  auto ptr = static_cast<char*>(m_data) + (n * virtual_memory_page_size());
+  auto ptr = static_cast<char*>(m_data) + (n * page_size());
+
+  virtual_memory_decommit( ptr, 1, m_mode );
+}
 
-  virtual_memory_decommit( ptr, 1 );
+void bit::memory::virtual_memory::set_commit_mode( virtual_memory_commit_mode mode )
+  noexcept
+{
+  m_commit_mode = mode;
 }
 
 void* bit::memory::virtual_memory::release()
@@ -84,14 +166,14 @@ bit::memory::memory_block bit::memory::virtual_memory::at( std::ptrdiff_t n )
 {
   if( n < 0 || n >= static_cast<std::ptrdiff_t>(m_pages) ) throw std::out_of_range("virtual_memory::at: index out of bounds");
 
-  auto ptr = static_cast<char*>(m_data) + (n * virtual_memory_page_size());
-  return memory_block{ ptr, virtual_memory_page_size() };
+  auto ptr = static_cast<char*>(m_data) + (n * page_size());
+  return memory_block{ ptr, page_size() };
 }
 
 bit::memory::memory_block
   bit::memory::virtual_memory::operator[]( std::ptrdiff_t n )
   const noexcept
 {
-  auto ptr = static_cast<char*>(m_data) + (n * virtual_memory_page_size());
-  return memory_block{ ptr, virtual_memory_page_size() };
+  auto ptr = static_cast<char*>(m_data) + (n * page_size());
+  return memory_block{ ptr, page_size() };
 }
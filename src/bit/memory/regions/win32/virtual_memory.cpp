@@ -28,6 +28,20 @@ std::size_t bit::memory::virtual_memory_page_size()
   return s_page_size;
 }
 
+std::size_t bit::memory::virtual_memory_huge_page_size()
+  noexcept
+{
+  // Large pages require the SeLockMemoryPrivilege, and cannot be reserved
+  // and committed separately; so only standard pages are supported
+  return virtual_memory_page_size();
+}
+
+std::size_t bit::memory::virtual_memory_page_size( virtual_memory_page_mode )
+  noexcept
+{
+  return virtual_memory_page_size();
+}
+
 //-----------------------------------------------------------------------------
 
 void* bit::memory::virtual_memory_reserve( std::size_t n )
@@ -39,6 +53,16 @@ void* bit::memory::virtual_memory_reserve( std::size_t n )
   return ptr;
 }
 
+void* bit::memory::virtual_memory_reserve( std::size_t n,
+                                           virtual_memory_page_mode,
+                                           virtual_memory_page_mode* actual )
+  noexcept
+{
+  if( actual ) *actual = virtual_memory_page_mode::standard;
+
+  return virtual_memory_reserve( n );
+}
+
 //-----------------------------------------------------------------------------
 
 void* bit::memory::virtual_memory_commit( void* memory, std::size_t n )
@@ -54,6 +78,29 @@ void* bit::memory::virtual_memory_commit( void* memory, std::size_t n )
   return region;
 }
 
+void* bit::memory::virtual_memory_commit( void* memory,
+                                          std::size_t n,
+                                          virtual_memory_page_mode )
+  noexcept
+{
+  return virtual_memory_commit( memory, n );
+}
+
+//-----------------------------------------------------------------------------
+
+void bit::memory::virtual_memory_prefault( void* memory, std::size_t size )
+  noexcept
+{
+  // Write to each page so that it is faulted in writable, preserving its
+  // contents
+  const auto page_size = virtual_memory_page_size();
+  auto* const begin    = static_cast<volatile char*>(memory);
+
+  for( auto offset = std::size_t{0}; offset < size; offset += page_size ) {
+    begin[offset] = begin[offset];
+  }
+}
+
 //-----------------------------------------------------------------------------
 
 void bit::memory::virtual_memory_decommit( void* memory, std::size_t n )
@@ -65,6 +112,14 @@ void bit::memory::virtual_memory_decommit( void* memory, std::size_t n )
 //  assert(result == nullptr && "virtual_memory_decommit: unable to decommit memory");
 }
 
+void bit::memory::virtual_memory_decommit( void* memory,
+                                           std::size_t n,
+                                           virtual_memory_page_mode )
+  noexcept
+{
+  virtual_memory_decommit( memory, n );
+}
+
 //-----------------------------------------------------------------------------
 
 void bit::memory::virtual_memory_release( void* memory, std::size_t n )
@@ -77,6 +132,14 @@ void bit::memory::virtual_memory_release( void* memory, std::size_t n )
 //  assert(result != nullptr && "virtual_memory_release: unable to release memory");
 }
 
+void bit::memory::virtual_memory_release( void* memory,
+                                          std::size_t n,
+                                          virtual_memory_page_mode )
+  noexcept
+{
+  virtual_memory_release( memory, n );
+}
+
 
 //-----------------------------------------------------------------------------
 // Free Functions
@@ -30,7 +30,7 @@ void* bit::memory::debug_untag_bytes( void* p,
   void* stomp_ptr  = nullptr;
   auto  stomp_size = std::size_t(0);
 
-  while( --n ) {
+  for( ; n != 0; --n ) {
     if( *byte_ptr != static_cast<byte_t>(tag) ) {
       // If a stomp occurs, record the start of th estomp, and determine
       // the size
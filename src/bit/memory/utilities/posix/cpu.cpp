@@ -0,0 +1,95 @@
+#include <bit/memory/utilities/cpu.hpp>
+
+#include <functional> // std::hash
+#include <thread>     // std::this_thread
+
+#include <unistd.h> // ::sysconf
+
+#if defined(__linux__)
+# include <sched.h> // ::sched_getcpu
+# if defined(__has_include) && defined(__has_builtin)
+#   if __has_include(<sys/rseq.h>) && __has_builtin(__builtin_thread_pointer)
+#     include <sys/rseq.h> // __rseq_offset, __rseq_size, struct rseq
+#     define BIT_MEMORY_CPU_USE_RSEQ 1
+#   endif
+# endif
+#endif
+
+//-----------------------------------------------------------------------------
+// Forward Declarations
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  /// \brief Determines the number of configured processors on posix
+  ///
+  /// \return the number of processors
+  std::size_t get_cpu_count() noexcept;
+
+#if defined(BIT_MEMORY_CPU_USE_RSEQ)
+  /// \brief Reads the cpu id from the rseq area that glibc registered for
+  ///        the calling thread
+  ///
+  /// \return the cpu id, or a negative value if no area is registered
+  int get_rseq_cpu() noexcept;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Free Functions
+//-----------------------------------------------------------------------------
+
+std::size_t bit::memory::cpu_count()
+  noexcept
+{
+  static const std::size_t s_cpu_count = get_cpu_count();
+
+  return s_cpu_count;
+}
+
+std::size_t bit::memory::current_cpu()
+  noexcept
+{
+#if defined(BIT_MEMORY_CPU_USE_RSEQ)
+  const auto rseq_cpu = get_rseq_cpu();
+  if( rseq_cpu >= 0 ) return static_cast<std::size_t>(rseq_cpu);
+#endif
+
+#if defined(__linux__)
+  const auto cpu = ::sched_getcpu();
+  if( cpu >= 0 ) return static_cast<std::size_t>(cpu);
+#endif
+
+  // Without a processor id, threads are at least spread out consistently
+  return std::hash<std::thread::id>{}( std::this_thread::get_id() );
+}
+
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  std::size_t get_cpu_count()
+    noexcept
+  {
+    const auto count = ::sysconf(_SC_NPROCESSORS_CONF);
+
+    return (count > 0) ? static_cast<std::size_t>(count) : 1u;
+  }
+
+#if defined(BIT_MEMORY_CPU_USE_RSEQ)
+  int get_rseq_cpu()
+    noexcept
+  {
+    // glibc 2.35+ registers the area itself, unless disabled by a tunable
+    if( __rseq_size == 0 ) return -1;
+
+    auto* const thread_pointer = static_cast<const char*>(__builtin_thread_pointer());
+    auto* const area = reinterpret_cast<const volatile struct rseq*>(
+      thread_pointer + __rseq_offset
+    );
+
+    // The kernel stores a negative id when the area is not yet initialized
+    return static_cast<int>(area->cpu_id);
+  }
+#endif
+}
@@ -0,0 +1,49 @@
+#include <bit/memory/utilities/cpu.hpp>
+
+#include "../../regions/win32/windows.hpp"
+
+//-----------------------------------------------------------------------------
+// Forward Declarations
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  /// \brief Determines the number of processors on win32
+  ///
+  /// \return the number of processors
+  std::size_t get_cpu_count() noexcept;
+}
+
+//-----------------------------------------------------------------------------
+// Free Functions
+//-----------------------------------------------------------------------------
+
+std::size_t bit::memory::cpu_count()
+  noexcept
+{
+  static const std::size_t s_cpu_count = get_cpu_count();
+
+  return s_cpu_count;
+}
+
+std::size_t bit::memory::current_cpu()
+  noexcept
+{
+  return static_cast<std::size_t>(::GetCurrentProcessorNumber());
+}
+
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  std::size_t get_cpu_count()
+    noexcept
+  {
+    auto info = ::SYSTEM_INFO{};
+    ::GetSystemInfo(&info);
+
+    return (info.dwNumberOfProcessors > 0)
+           ? static_cast<std::size_t>(info.dwNumberOfProcessors)
+           : 1u;
+  }
+}
@@ -0,0 +1,190 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the arena_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/arena_allocator.hpp>
+#include <bit/memory/block_allocators/new_block_allocator.hpp>
+#include <bit/memory/concepts/ExtendedAllocator.hpp>
+#include <bit/memory/utilities/scoped_arena_frame.hpp>
+
+#include <catch.hpp>
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+namespace {
+  constexpr auto block_size = 256u;
+
+  using block_allocator_type = bit::memory::new_block_allocator<block_size>;
+  using static_type          = bit::memory::arena_allocator<block_allocator_type>;
+  using named_static_type    = bit::memory::named_arena_allocator<block_allocator_type>;
+}
+
+//=============================================================================
+
+static_assert( bit::memory::is_extended_allocator<static_type>::value,
+               "arena allocator must be an extended allocator" );
+
+static_assert( bit::memory::is_extended_allocator<named_static_type>::value,
+               "named arena allocator must be an extended allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("arena_allocator::try_allocate( std::size_t, std::size_t, std::size_t )")
+{
+  auto allocator = static_type{};
+
+  SECTION("Does not request a block until the first allocation")
+  {
+    REQUIRE( allocator.blocks() == 0 );
+  }
+
+  SECTION("Allocates aligned memory")
+  {
+    auto p = allocator.try_allocate(16,32);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( bit::memory::align_of(p) >= 32 );
+    REQUIRE( allocator.owns(p) );
+  }
+
+  SECTION("Allocations bump upwards within a block")
+  {
+    auto p0 = static_cast<char*>(allocator.try_allocate(16,1));
+    auto p1 = static_cast<char*>(allocator.try_allocate(16,1));
+
+    REQUIRE( p1 == p0 + 16 );
+    REQUIRE( allocator.blocks() == 1 );
+  }
+
+  SECTION("Requests a new block when the current block is exhausted")
+  {
+    for( auto i = 0; i < 16; ++i ) {
+      auto p = allocator.try_allocate(64,8);
+
+      REQUIRE( p != nullptr );
+      REQUIRE( allocator.owns(p) );
+    }
+
+    REQUIRE( allocator.blocks() > 1 );
+  }
+
+  SECTION("Returns nullptr if the request can never fit in a block")
+  {
+    REQUIRE( allocator.try_allocate(block_size,1) == nullptr );
+    REQUIRE( allocator.blocks() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("arena_allocator::deallocate_all()")
+{
+  auto allocator = static_type{};
+
+  for( auto i = 0; i < 16; ++i ) {
+    allocator.try_allocate(64,8);
+  }
+  allocator.deallocate_all();
+
+  SECTION("Returns every block")
+  {
+    REQUIRE( allocator.blocks() == 0 );
+  }
+
+  SECTION("Can allocate again")
+  {
+    auto p = allocator.try_allocate(64,8);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( allocator.owns(p) );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Checkpoints
+//-----------------------------------------------------------------------------
+
+TEST_CASE("arena_allocator::rewind( checkpoint_type )")
+{
+  auto allocator = static_type{};
+
+  auto p0 = allocator.try_allocate(64,8);
+  auto marker = allocator.checkpoint();
+
+  SECTION("Reuses memory allocated since the checkpoint")
+  {
+    auto p1 = allocator.try_allocate(64,8);
+    allocator.rewind(marker);
+
+    REQUIRE( allocator.try_allocate(64,8) == p1 );
+  }
+
+  SECTION("Returns blocks acquired since the checkpoint")
+  {
+    for( auto i = 0; i < 16; ++i ) {
+      allocator.try_allocate(64,8);
+    }
+    allocator.rewind(marker);
+
+    REQUIRE( allocator.blocks() == 1 );
+    REQUIRE( allocator.owns(p0) );
+  }
+
+  SECTION("Returns every block when rewound to an empty checkpoint")
+  {
+    auto empty = static_type{};
+    auto empty_marker = empty.checkpoint();
+
+    empty.try_allocate(64,8);
+    empty.rewind(empty_marker);
+
+    REQUIRE( empty.blocks() == 0 );
+    REQUIRE( empty.try_allocate(64,8) != nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("scoped_arena_frame<arena_allocator>")
+{
+  auto allocator = static_type{};
+
+  auto p0 = allocator.try_allocate(64,8);
+  auto p1 = static_cast<void*>(nullptr);
+
+  {
+    bit::memory::scoped_arena_frame<static_type> frame{allocator};
+
+    p1 = allocator.try_allocate(64,8);
+    {
+      bit::memory::scoped_arena_frame<static_type> inner{allocator};
+
+      for( auto i = 0; i < 16; ++i ) {
+        allocator.try_allocate(64,8);
+      }
+    }
+
+    SECTION("Nested frames rewind to their own checkpoints")
+    {
+      REQUIRE( allocator.blocks() == 1 );
+      REQUIRE( allocator.try_allocate(64,8) != p1 );
+    }
+  }
+
+  SECTION("Rewinds the arena at the end of the scope")
+  {
+    REQUIRE( allocator.blocks() == 1 );
+    REQUIRE( allocator.owns(p0) );
+    REQUIRE( allocator.try_allocate(64,8) == p1 );
+  }
+}
@@ -0,0 +1,176 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the bitmap_pool_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/bitmap_pool_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_allocator<bit::memory::bitmap_pool_allocator>::value,
+               "bitmap pool allocator must be an allocator" );
+
+static_assert( bit::memory::is_allocator<bit::memory::named_bitmap_pool_allocator>::value,
+               "named bitmap pool allocator must be an allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+TEST_CASE("bitmap_pool_allocator::bitmap_pool_allocator( std::size_t, memory_block )")
+{
+  alignas(16) unsigned char storage[1024];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  SECTION("Fits the bitmap and chunks within the block")
+  {
+    auto allocator = bit::memory::bitmap_pool_allocator{4,block};
+
+    // 1024 bytes holds 248 4-byte chunks after a 32-byte bitmap
+    REQUIRE( allocator.capacity() == 248 );
+  }
+
+  SECTION("Supports single-byte chunks")
+  {
+    auto allocator = bit::memory::bitmap_pool_allocator{1,block};
+
+    REQUIRE( allocator.capacity() >= 900 );
+  }
+
+  SECTION("Starts with no chunks allocated")
+  {
+    auto allocator = bit::memory::bitmap_pool_allocator{4,block};
+
+    REQUIRE( allocator.size() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("bitmap_pool_allocator::try_allocate( std::size_t, std::size_t )")
+{
+  alignas(16) unsigned char storage[1024];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  auto allocator = bit::memory::bitmap_pool_allocator{4,block};
+
+  SECTION("Allocates aligned chunks in address order")
+  {
+    auto p0 = static_cast<unsigned char*>(allocator.try_allocate(4,4));
+    auto p1 = static_cast<unsigned char*>(allocator.try_allocate(4,4));
+
+    REQUIRE( p0 != nullptr );
+    REQUIRE( allocator.owns(p0) );
+    REQUIRE( bit::memory::align_of(p0) >= 4 );
+    REQUIRE( (p1 - p0) == 4 );
+  }
+
+  SECTION("Returns nullptr when every chunk is allocated")
+  {
+    for( auto i = 0u; i < allocator.capacity(); ++i ) {
+      REQUIRE( allocator.try_allocate(4,4) != nullptr );
+    }
+
+    REQUIRE( allocator.try_allocate(4,4) == nullptr );
+  }
+
+  SECTION("Returns nullptr for requests larger than a chunk")
+  {
+    REQUIRE( allocator.try_allocate(5,4) == nullptr );
+    REQUIRE( allocator.size() == 0 );
+  }
+
+  SECTION("Returns nullptr for alignments the chunks can't satisfy")
+  {
+    REQUIRE( allocator.try_allocate(4,8) == nullptr );
+    REQUIRE( allocator.size() == 0 );
+  }
+
+  SECTION("Reuses the lowest free chunk")
+  {
+    auto p0 = allocator.try_allocate(4,4);
+    auto p1 = allocator.try_allocate(4,4);
+    auto p2 = allocator.try_allocate(4,4);
+
+    allocator.deallocate(p2,4);
+    allocator.deallocate(p0,4);
+
+    REQUIRE( allocator.try_allocate(4,4) == p0 );
+    REQUIRE( allocator.try_allocate(4,4) == p2 );
+    REQUIRE( p1 != nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("bitmap_pool_allocator::deallocate_all()")
+{
+  alignas(16) unsigned char storage[1024];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  auto allocator = bit::memory::bitmap_pool_allocator{4,block};
+
+  for( auto i = 0u; i < allocator.capacity(); ++i ) {
+    allocator.try_allocate(4,4);
+  }
+  allocator.deallocate_all();
+
+  SECTION("Frees every chunk")
+  {
+    REQUIRE( allocator.size() == 0 );
+
+    for( auto i = 0u; i < allocator.capacity(); ++i ) {
+      REQUIRE( allocator.try_allocate(4,4) != nullptr );
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Iteration
+//-----------------------------------------------------------------------------
+
+TEST_CASE("bitmap_pool_allocator::for_each_allocated( Fn&& )")
+{
+  alignas(16) unsigned char storage[1024];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  auto allocator = bit::memory::bitmap_pool_allocator{2,block};
+
+  auto allocated = std::vector<void*>{};
+  for( auto i = 0u; i < 200; ++i ) {
+    allocated.push_back( allocator.try_allocate(2,2) );
+  }
+  for( auto i = 0u; i < 200; i += 3 ) {
+    allocator.deallocate(allocated[i],2);
+  }
+
+  SECTION("Visits every live chunk in address order")
+  {
+    auto visited = std::vector<void*>{};
+    allocator.for_each_allocated([&](void* p){
+      visited.push_back(p);
+    });
+
+    auto expected = std::vector<void*>{};
+    for( auto i = 0u; i < 200; ++i ) {
+      if( i % 3 != 0 ) expected.push_back( allocated[i] );
+    }
+
+    REQUIRE( visited == expected );
+    REQUIRE( visited.size() == allocator.size() );
+  }
+}
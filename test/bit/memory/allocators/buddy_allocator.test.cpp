@@ -0,0 +1,234 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the buddy_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/buddy_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+#include <bit/memory/regions/virtual_memory.hpp>
+
+#include <catch.hpp>
+
+#include <cstring> // std::memset
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_allocator<bit::memory::buddy_allocator>::value,
+               "buddy allocator must be an allocator" );
+
+static_assert( bit::memory::is_allocator<bit::memory::named_buddy_allocator>::value,
+               "named buddy allocator must be an allocator" );
+
+static_assert( bit::memory::allocator_has_expand<bit::memory::buddy_allocator>::value,
+               "buddy allocator must be expandable" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+  const auto page_size = bit::memory::virtual_memory_page_size();
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+TEST_CASE("buddy_allocator::buddy_allocator( std::size_t, std::size_t )")
+{
+  auto allocator = bit::memory::buddy_allocator{ page_size * 5 };
+
+  SECTION("Reserves a power-of-two number of pages")
+  {
+    REQUIRE( allocator.max_size() == page_size * 8 );
+  }
+
+  SECTION("Does not commit any pages")
+  {
+    REQUIRE( allocator.committed_size() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("buddy_allocator::try_allocate( std::size_t, std::size_t )")
+{
+  auto allocator = bit::memory::buddy_allocator{ page_size * 16 };
+
+  SECTION("Allocates page-aligned memory")
+  {
+    auto p = allocator.try_allocate(100,8);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( allocator.owns(p) );
+    REQUIRE( bit::memory::align_of(p) >= page_size );
+  }
+
+  SECTION("Commits only the pages of the allocation")
+  {
+    auto p = allocator.try_allocate(page_size * 3,8);
+
+    REQUIRE( allocator.committed_size() == page_size * 4 );
+
+    // The memory must be writable
+    std::memset(p, 0xff, page_size * 3);
+  }
+
+  SECTION("Splits buddies to satisfy smaller allocations")
+  {
+    auto p0 = static_cast<char*>(allocator.try_allocate(page_size,8));
+    auto p1 = static_cast<char*>(allocator.try_allocate(page_size,8));
+    auto p2 = static_cast<char*>(allocator.try_allocate(page_size * 2,8));
+
+    REQUIRE( (p1 - p0) == static_cast<std::ptrdiff_t>(page_size) );
+    REQUIRE( (p2 - p0) == static_cast<std::ptrdiff_t>(page_size * 2) );
+  }
+
+  SECTION("Returns nullptr when no buddy is large enough")
+  {
+    auto p0 = allocator.try_allocate(page_size,8);
+    auto p1 = allocator.try_allocate(allocator.max_size(),8);
+
+    REQUIRE( p0 != nullptr );
+    REQUIRE( p1 == nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("buddy_allocator::expand( void*, std::size_t )")
+{
+  auto allocator = bit::memory::buddy_allocator{ page_size * 16 };
+
+  SECTION("Expands into free buddies in place")
+  {
+    auto p = allocator.try_allocate(page_size,8);
+
+    REQUIRE( allocator.expand(p, page_size * 8) );
+    REQUIRE( allocator.committed_size() == page_size * 8 );
+
+    std::memset(p, 0xff, page_size * 8);
+
+    // The whole upper half is still available
+    auto q = allocator.try_allocate(page_size * 8,8);
+    REQUIRE( q != nullptr );
+  }
+
+  SECTION("Fails when a buddy is in use")
+  {
+    auto p0 = allocator.try_allocate(page_size,8);
+    auto p1 = allocator.try_allocate(page_size,8);
+
+    REQUIRE_FALSE( allocator.expand(p0, page_size * 2) );
+    REQUIRE( p1 != nullptr );
+  }
+
+  SECTION("Fails when the allocation is a right buddy")
+  {
+    auto p0 = allocator.try_allocate(page_size,8);
+    auto p1 = allocator.try_allocate(page_size,8);
+    allocator.deallocate(p0, page_size);
+
+    REQUIRE_FALSE( allocator.expand(p1, page_size * 2) );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("buddy_allocator::expand( void*, std::size_t ) across words of pages")
+{
+  auto allocator = bit::memory::buddy_allocator{ page_size * 256, page_size * 256 };
+
+  auto p = allocator.try_allocate(page_size,8);
+  auto q = allocator.try_allocate(page_size,8);
+  allocator.deallocate(q, page_size);
+
+  SECTION("Commits only the uncommitted pages")
+  {
+    // Page 1 is still committed from 'q', leaving a run on either side of it
+    REQUIRE( allocator.expand(p, page_size * 160) );
+    REQUIRE( allocator.committed_size() == page_size * 256 );
+
+    std::memset(p, 0xff, page_size * 256);
+  }
+
+  SECTION("Decommits every page once the whole range is free")
+  {
+    REQUIRE( allocator.expand(p, page_size * 100) );
+
+    allocator.deallocate(p, page_size * 100);
+
+    REQUIRE( allocator.committed_size() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("buddy_allocator::deallocate( void*, std::size_t )")
+{
+  auto allocator = bit::memory::buddy_allocator{ page_size * 16, page_size * 8 };
+
+  SECTION("Merges buddies back into the whole range")
+  {
+    auto p0 = allocator.try_allocate(page_size,8);
+    auto p1 = allocator.try_allocate(page_size * 2,8);
+    auto p2 = allocator.try_allocate(page_size,8);
+
+    allocator.deallocate(p2, page_size);
+    allocator.deallocate(p0, page_size);
+    allocator.deallocate(p1, page_size * 2);
+
+    auto p = allocator.try_allocate(allocator.max_size(),8);
+
+    REQUIRE( p != nullptr );
+  }
+
+  SECTION("Decommits free buddies above the threshold")
+  {
+    auto p0 = allocator.try_allocate(page_size * 8,8);
+    auto p1 = allocator.try_allocate(page_size,8);
+
+    allocator.deallocate(p0, page_size * 8);
+
+    REQUIRE( allocator.committed_size() == page_size );
+    allocator.deallocate(p1, page_size);
+    REQUIRE( allocator.committed_size() == 0 );
+  }
+
+  SECTION("Retains free buddies below the threshold")
+  {
+    auto p0 = allocator.try_allocate(page_size * 2,8);
+    auto p1 = allocator.try_allocate(page_size,8);
+
+    allocator.deallocate(p0, page_size * 2);
+
+    REQUIRE( allocator.committed_size() == page_size * 3 );
+    REQUIRE( p1 != nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("buddy_allocator::deallocate_all()")
+{
+  auto allocator = bit::memory::buddy_allocator{ page_size * 16 };
+
+  allocator.try_allocate(page_size,8);
+  allocator.try_allocate(page_size * 4,8);
+  allocator.deallocate_all();
+
+  SECTION("Decommits every page")
+  {
+    REQUIRE( allocator.committed_size() == 0 );
+  }
+
+  SECTION("Restores the whole range")
+  {
+    REQUIRE( allocator.try_allocate(allocator.max_size(),8) != nullptr );
+  }
+}
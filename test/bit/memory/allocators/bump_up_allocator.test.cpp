@@ -0,0 +1,161 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the bump_up_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/bump_up_allocator.hpp>
+#include <bit/memory/concepts/ExtendedAllocator.hpp>
+#include <bit/memory/traits/allocator_traits.hpp>
+#include <bit/memory/utilities/scoped_arena_frame.hpp>
+
+#include <catch.hpp>
+
+#include <cstring> // std::memset
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_extended_allocator<bit::memory::bump_up_allocator>::value,
+               "bump up allocator must be an extended allocator" );
+
+static_assert( bit::memory::allocator_has_expand<bit::memory::bump_up_allocator>::value,
+               "bump up allocator must be expandable" );
+
+static_assert( bit::memory::allocator_has_expand<bit::memory::named_bump_up_allocator>::value,
+               "named bump up allocator must be expandable" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("bump_up_allocator::expand( void*, std::size_t )")
+{
+  alignas(16) unsigned char storage[256];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  auto allocator = bit::memory::bump_up_allocator{block};
+
+  SECTION("Expands the most recent allocation in place")
+  {
+    auto p0 = static_cast<unsigned char*>(allocator.try_allocate(16,16));
+
+    REQUIRE( allocator.expand(p0, 64) );
+
+    auto p1 = static_cast<unsigned char*>(allocator.try_allocate(16,1));
+    REQUIRE( p1 == (p0 + 64) );
+  }
+
+  SECTION("Fails to expand an older allocation")
+  {
+    auto p0 = allocator.try_allocate(16,16);
+    auto p1 = allocator.try_allocate(16,16);
+
+    REQUIRE_FALSE( allocator.expand(p0, 32) );
+    REQUIRE( p1 != nullptr );
+  }
+
+  SECTION("Fails to expand past the end of the block")
+  {
+    auto p0 = allocator.try_allocate(16,16);
+
+    REQUIRE_FALSE( allocator.expand(p0, sizeof(storage) + 1) );
+    REQUIRE( allocator.expand(p0, sizeof(storage)) );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Checkpoints
+//-----------------------------------------------------------------------------
+
+TEST_CASE("bump_up_allocator::rewind( checkpoint_type )")
+{
+  alignas(16) unsigned char storage[256];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  auto allocator = bit::memory::bump_up_allocator{block};
+
+  auto p0 = allocator.try_allocate(16,16);
+  auto marker = allocator.checkpoint();
+  auto p1 = allocator.try_allocate(16,16);
+  allocator.try_allocate(64,16);
+
+  allocator.rewind(marker);
+
+  SECTION("Reuses memory allocated since the checkpoint")
+  {
+    REQUIRE( allocator.try_allocate(16,16) == p1 );
+  }
+
+  SECTION("Keeps memory allocated before the checkpoint")
+  {
+    REQUIRE( allocator.owns(p0) );
+    REQUIRE_FALSE( allocator.owns(p1) );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("scoped_arena_frame<bump_up_allocator>")
+{
+  alignas(16) unsigned char storage[256];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  auto allocator = bit::memory::bump_up_allocator{block};
+  auto p = static_cast<void*>(nullptr);
+
+  {
+    bit::memory::scoped_arena_frame<bit::memory::bump_up_allocator> frame{allocator};
+
+    p = allocator.try_allocate(128,16);
+  }
+
+  SECTION("Rewinds the allocator at the end of the scope")
+  {
+    REQUIRE( allocator.try_allocate(128,16) == p );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Allocator Traits
+//-----------------------------------------------------------------------------
+
+TEST_CASE("allocator_traits<bump_up_allocator>::reallocate( ... )")
+{
+  using traits_type = bit::memory::allocator_traits<bit::memory::bump_up_allocator>;
+
+  alignas(16) unsigned char storage[256];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  auto allocator = bit::memory::bump_up_allocator{block};
+
+  SECTION("Reallocates the most recent allocation in place")
+  {
+    auto p0 = traits_type::allocate(allocator,16,16);
+    auto p1 = traits_type::reallocate(allocator,p0,16,128,16);
+
+    REQUIRE( p0 == p1 );
+  }
+
+  SECTION("Copies an older allocation into a new allocation")
+  {
+    auto p0 = traits_type::allocate(allocator,16,16);
+    traits_type::allocate(allocator,16,16);
+
+    std::memset(p0, 0x5a, 16);
+
+    auto p1 = static_cast<unsigned char*>(
+      traits_type::reallocate(allocator,p0,16,32,16)
+    );
+
+    REQUIRE( p1 != p0 );
+    for( auto i = 0; i < 16; ++i ) {
+      REQUIRE( p1[i] == 0x5a );
+    }
+  }
+}
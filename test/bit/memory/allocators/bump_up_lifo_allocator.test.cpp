@@ -0,0 +1,70 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the bump_up_lifo_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/bump_up_lifo_allocator.hpp>
+#include <bit/memory/concepts/ExtendedAllocator.hpp>
+
+#include <catch.hpp>
+
+#include <cstddef> // std::size_t
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_extended_allocator<bit::memory::bump_up_lifo_allocator>::value,
+               "bump up lifo allocator must be an extended allocator" );
+
+static_assert( bit::memory::allocator_has_expand<bit::memory::bump_up_lifo_allocator>::value,
+               "bump up lifo allocator must be expandable" );
+
+static_assert( bit::memory::allocator_has_expand<bit::memory::named_bump_up_lifo_allocator>::value,
+               "named bump up lifo allocator must be expandable" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("bump_up_lifo_allocator::expand( void*, std::size_t )")
+{
+  alignas(16) unsigned char storage[256];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  auto allocator = bit::memory::bump_up_lifo_allocator{block};
+
+  SECTION("Expands the most recent allocation in place")
+  {
+    auto p0 = static_cast<unsigned char*>(allocator.try_allocate(16,16));
+
+    REQUIRE( allocator.expand(p0, 64) );
+
+    // The next allocation follows its adjustment byte
+    auto p1 = static_cast<unsigned char*>(allocator.try_allocate(16,1));
+    REQUIRE( p1 == (p0 + 64 + 1) );
+  }
+
+  SECTION("Fails to expand an older allocation")
+  {
+    auto p0 = allocator.try_allocate(16,16);
+    auto p1 = allocator.try_allocate(16,16);
+
+    REQUIRE_FALSE( allocator.expand(p0, 32) );
+    REQUIRE( p1 != nullptr );
+  }
+
+  SECTION("Fails to expand past the end of the block")
+  {
+    auto p0 = static_cast<unsigned char*>(allocator.try_allocate(16,16));
+    const auto remaining = static_cast<std::size_t>((storage + sizeof(storage)) - p0);
+
+    REQUIRE_FALSE( allocator.expand(p0, remaining + 1) );
+    REQUIRE( allocator.expand(p0, remaining) );
+  }
+}
@@ -0,0 +1,145 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the concurrent_bump_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/concurrent_bump_allocator.hpp>
+#include <bit/memory/block_allocators/new_block_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm> // std::sort, std::adjacent_find
+#include <thread>    // std::thread
+#include <vector>    // std::vector
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+namespace {
+  constexpr auto block_size = 1024u;
+
+  using block_allocator_type = bit::memory::new_block_allocator<block_size>;
+  using static_type          = bit::memory::concurrent_bump_allocator<block_allocator_type>;
+  using named_static_type    = bit::memory::named_concurrent_bump_allocator<block_allocator_type>;
+}
+
+//=============================================================================
+
+static_assert( bit::memory::is_allocator<static_type>::value,
+               "concurrent bump allocator must be an allocator" );
+
+static_assert( bit::memory::is_allocator<named_static_type>::value,
+               "named concurrent bump allocator must be an allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("concurrent_bump_allocator::try_allocate( std::size_t, std::size_t )")
+{
+  static_type allocator{};
+
+  SECTION("Does not request a block until the first allocation")
+  {
+    REQUIRE( allocator.blocks() == 0 );
+  }
+
+  SECTION("Allocates aligned memory")
+  {
+    auto p0 = allocator.try_allocate(3,1);
+    auto p1 = allocator.try_allocate(16,64);
+
+    REQUIRE( p0 != nullptr );
+    REQUIRE( allocator.owns(p0) );
+    REQUIRE( bit::memory::align_of(p0) >= static_type::granule_size::value );
+    REQUIRE( bit::memory::align_of(p1) >= 64 );
+  }
+
+  SECTION("Allocations bump upwards within a block")
+  {
+    auto p0 = static_cast<char*>(allocator.try_allocate(16,1));
+    auto p1 = static_cast<char*>(allocator.try_allocate(16,1));
+
+    REQUIRE( p1 > p0 );
+    REQUIRE( allocator.blocks() == 1 );
+  }
+
+  SECTION("Chains a new block when the current block is exhausted")
+  {
+    for( auto i = 0; i < 4; ++i ) {
+      REQUIRE( allocator.try_allocate(block_size / 2,8) != nullptr );
+    }
+
+    REQUIRE( allocator.blocks() >= 2 );
+  }
+
+  SECTION("Returns nullptr for requests larger than a block")
+  {
+    REQUIRE( allocator.try_allocate(block_size,8) == nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("concurrent_bump_allocator::try_allocate( std::size_t, std::size_t ) concurrently")
+{
+  static constexpr auto threads     = 8u;
+  static constexpr auto allocations = 1000u;
+
+  static_type allocator{};
+
+  auto results = std::vector<std::vector<void*>>(threads);
+  auto workers = std::vector<std::thread>{};
+
+  for( auto t = 0u; t < threads; ++t ) {
+    workers.emplace_back([&allocator,&results,t]{
+      for( auto i = 0u; i < allocations; ++i ) {
+        results[t].push_back( allocator.try_allocate(24,8) );
+      }
+    });
+  }
+  for( auto& worker : workers ) worker.join();
+
+  auto all = std::vector<char*>{};
+  for( auto& result : results ) {
+    for( auto p : result ) all.push_back( static_cast<char*>(p) );
+  }
+  std::sort( all.begin(), all.end() );
+
+  SECTION("Every allocation succeeds")
+  {
+    REQUIRE( all.front() != nullptr );
+  }
+
+  SECTION("No two allocations overlap")
+  {
+    auto overlap = std::adjacent_find( all.begin(), all.end(), [](char* a, char* b){
+      return (b - a) < 24;
+    });
+
+    REQUIRE( overlap == all.end() );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("concurrent_bump_allocator::deallocate_all()")
+{
+  static_type allocator{};
+
+  allocator.try_allocate(block_size / 2,8);
+  allocator.try_allocate(block_size / 2,8);
+  allocator.deallocate_all();
+
+  SECTION("Returns every block")
+  {
+    REQUIRE( allocator.blocks() == 0 );
+  }
+}
@@ -0,0 +1,145 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the concurrent_pool_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/concurrent_pool_allocator.hpp>
+#include <bit/memory/concepts/ExtendedAllocator.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm> // std::sort, std::unique
+#include <thread>    // std::thread
+#include <vector>    // std::vector
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_extended_allocator<bit::memory::concurrent_pool_allocator>::value,
+               "concurrent pool allocator must be an extended allocator" );
+
+static_assert( bit::memory::is_extended_allocator<bit::memory::named_concurrent_pool_allocator>::value,
+               "named concurrent pool allocator must be an extended allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+  constexpr auto chunk_size = 64u;
+  constexpr auto chunks     = 64u;
+
+  alignas(chunk_size) char storage[chunk_size * chunks];
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("concurrent_pool_allocator::try_allocate( std::size_t, std::size_t, std::size_t )")
+{
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+  bit::memory::concurrent_pool_allocator allocator{chunk_size,block};
+
+  SECTION("Allocates every chunk in the pool")
+  {
+    auto pointers = std::vector<void*>{};
+    for( auto i = 0u; i < chunks; ++i ) {
+      auto p = allocator.try_allocate(chunk_size/2,8);
+      REQUIRE( p != nullptr );
+      REQUIRE( allocator.owns(p) );
+      pointers.push_back(p);
+    }
+
+    SECTION("Returns nullptr once exhausted")
+    {
+      REQUIRE( allocator.try_allocate(1,1) == nullptr );
+    }
+
+    for( auto p : pointers ) {
+      allocator.deallocate(p,chunk_size/2);
+    }
+  }
+
+  SECTION("Aligns allocations to the requested boundary")
+  {
+    auto p = allocator.try_allocate(8,32);
+
+    REQUIRE( bit::memory::align_of(p) >= 32 );
+
+    allocator.deallocate(p,8);
+  }
+
+  SECTION("Returns nullptr when the size exceeds the chunk size")
+  {
+    REQUIRE( allocator.try_allocate(chunk_size,1) == nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("concurrent_pool_allocator::deallocate( void*, std::size_t )")
+{
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+  bit::memory::concurrent_pool_allocator allocator{chunk_size,block};
+
+  SECTION("Deallocated memory is reused")
+  {
+    auto p = allocator.try_allocate(16,1);
+    allocator.deallocate(p,16);
+
+    auto q = allocator.try_allocate(16,1);
+    REQUIRE( p == q );
+
+    allocator.deallocate(q,16);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("concurrent_pool_allocator" "[thread safety]")
+{
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+  bit::memory::concurrent_pool_allocator allocator{chunk_size,block};
+
+  static constexpr auto threads    = 4u;
+  static constexpr auto iterations = 10000u;
+  static constexpr auto per_thread = chunks / threads;
+
+  SECTION("Concurrent allocations never hand out the same chunk twice")
+  {
+    auto results = std::vector<std::vector<void*>>(threads);
+    auto workers = std::vector<std::thread>{};
+
+    for( auto t = 0u; t < threads; ++t ) {
+      workers.emplace_back([&allocator,&results,t]()
+      {
+        auto& held = results[t];
+        for( auto i = 0u; i < iterations; ++i ) {
+          for( auto j = 0u; j < per_thread; ++j ) {
+            held.push_back( allocator.try_allocate(8,8) );
+          }
+          if( i + 1 == iterations ) break;
+          for( auto p : held ) {
+            allocator.deallocate(p,8);
+          }
+          held.clear();
+        }
+      });
+    }
+    for( auto& worker : workers ) {
+      worker.join();
+    }
+
+    auto all = std::vector<void*>{};
+    for( auto& held : results ) {
+      all.insert(all.end(),held.begin(),held.end());
+    }
+    std::sort(all.begin(),all.end());
+
+    REQUIRE( std::find(all.begin(),all.end(),nullptr) == all.end() );
+    REQUIRE( std::unique(all.begin(),all.end()) == all.end() );
+  }
+}
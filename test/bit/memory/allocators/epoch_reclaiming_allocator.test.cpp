@@ -0,0 +1,299 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the epoch_reclaiming_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/epoch_reclaiming_allocator.hpp>
+#include <bit/memory/allocators/concurrent_pool_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+#include <bit/memory/policies/lockables/null_lock.hpp>
+
+#include <catch.hpp>
+
+#include <atomic>  // std::atomic
+#include <cstdlib> // std::malloc, std::free
+#include <new>     // placement new
+#include <thread>  // std::thread
+#include <vector>  // std::vector
+
+namespace {
+
+  struct allocation_counts
+  {
+    std::size_t allocations   = 0;
+    std::size_t deallocations = 0;
+
+    std::size_t outstanding() const noexcept
+    {
+      return allocations - deallocations;
+    }
+  };
+
+  /// An allocator that counts the allocations it has outstanding
+  class counting_allocator
+  {
+  public:
+
+    explicit counting_allocator( allocation_counts& counts )
+      : m_counts(&counts)
+    {
+
+    }
+
+    void* try_allocate( std::size_t size, std::size_t )
+      noexcept
+    {
+      ++m_counts->allocations;
+      return std::malloc(size);
+    }
+
+    void deallocate( void* p, std::size_t )
+    {
+      ++m_counts->deallocations;
+      std::free(p);
+    }
+
+  private:
+
+    allocation_counts* m_counts;
+  };
+
+  using static_type       = bit::memory::epoch_reclaiming_allocator<counting_allocator>;
+  using named_static_type = bit::memory::named_epoch_reclaiming_allocator<counting_allocator>;
+
+} // anonymous namespace
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_allocator<static_type>::value,
+               "epoch reclaiming allocator must be an allocator" );
+
+static_assert( bit::memory::is_allocator<named_static_type>::value,
+               "named epoch reclaiming allocator must be an allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Reclamation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("epoch_reclaiming_allocator::retire( void*, std::size_t )")
+{
+  auto counts = allocation_counts{};
+  static_type allocator{counts};
+  allocator.set_batch_size(1000);
+
+  auto p = allocator.try_allocate(32,8);
+  allocator.retire(p,32);
+
+  SECTION("Defers the deallocation")
+  {
+    REQUIRE( counts.outstanding() == 1 );
+    REQUIRE( allocator.pending() == 1 );
+  }
+
+  SECTION("Deallocates once the epoch has advanced twice")
+  {
+    REQUIRE( allocator.reclaim() == 0 );
+    REQUIRE( allocator.reclaim() == 1 );
+    REQUIRE( counts.outstanding() == 0 );
+    REQUIRE( allocator.pending() == 0 );
+  }
+
+  SECTION("Attempts to reclaim every batch_size retirements")
+  {
+    allocator.set_batch_size(2);
+
+    for( auto i = 0u; i < 6u; ++i ) {
+      allocator.retire(allocator.try_allocate(32,8),32);
+    }
+
+    REQUIRE( counts.outstanding() < 7 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("epoch_reclaiming_allocator::enter_critical()")
+{
+  auto counts = allocation_counts{};
+  static_type allocator{counts};
+
+  std::atomic<bool> entered{false};
+  std::atomic<bool> leave{false};
+
+  auto reader = std::thread([&]{
+    static_type::critical_section section{allocator};
+    entered = true;
+    while( !leave ) std::this_thread::yield();
+  });
+  while( !entered ) std::this_thread::yield();
+
+  auto p = allocator.try_allocate(32,8);
+  allocator.retire(p,32);
+
+  SECTION("Retired memory outlives a concurrent critical section")
+  {
+    for( auto i = 0u; i < 4u; ++i ) {
+      allocator.reclaim();
+    }
+    REQUIRE( counts.outstanding() == 1 );
+
+    leave = true;
+    reader.join();
+
+    for( auto i = 0u; i < 4u; ++i ) {
+      allocator.reclaim();
+    }
+    REQUIRE( counts.outstanding() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("epoch_reclaiming_allocator" "[thread exit]")
+{
+  auto counts = allocation_counts{};
+  static_type allocator{counts};
+
+  std::thread([&]{
+    allocator.retire(allocator.try_allocate(32,8),32);
+  }).join();
+
+  SECTION("The limbo of an exited thread is reclaimed by other threads")
+  {
+    REQUIRE( counts.outstanding() == 1 );
+
+    for( auto i = 0u; i < 3u; ++i ) {
+      allocator.reclaim();
+    }
+    REQUIRE( counts.outstanding() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("epoch_reclaiming_allocator::~epoch_reclaiming_allocator()")
+{
+  auto counts = allocation_counts{};
+
+  {
+    static_type allocator{counts};
+
+    allocator.retire(allocator.try_allocate(32,8),32);
+
+    std::thread([&]{
+      allocator.retire(allocator.try_allocate(64,8),64);
+    }).join();
+  }
+
+  SECTION("Deallocates every pending retirement")
+  {
+    REQUIRE( counts.allocations == 2 );
+    REQUIRE( counts.outstanding() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("epoch_reclaiming_allocator::local_record_count()")
+{
+  auto counts = allocation_counts{};
+
+  SECTION("Reclaims the records of destroyed allocators")
+  {
+    for( auto i = 0; i < 100; ++i ) {
+      static_type allocator{counts};
+
+      allocator.retire(allocator.try_allocate(32,8),32);
+
+      REQUIRE( static_type::local_record_count() <= 2 );
+    }
+
+    REQUIRE( static_type::local_record_count() <= 1 );
+    REQUIRE( counts.outstanding() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("epoch_reclaiming_allocator" "[concurrency]")
+{
+  constexpr auto chunk_size = 64u;
+  constexpr auto chunks     = 4096u;
+
+  alignas(chunk_size) static char storage[chunk_size * chunks];
+
+  // The concurrent pool needs no lock, so no part of the churn below locks
+  using allocator_type = bit::memory::epoch_reclaiming_allocator<
+    bit::memory::concurrent_pool_allocator,
+    bit::memory::null_lock
+  >;
+
+  allocator_type allocator{
+    chunk_size,
+    bit::memory::memory_block{storage,sizeof(storage)}
+  };
+  allocator.set_batch_size(16);
+
+  struct node
+  {
+    std::size_t value;
+    std::size_t check;
+  };
+
+  auto make_node = [&]( std::size_t value ) {
+    auto* p = allocator.try_allocate(sizeof(node),alignof(node));
+    while( p == nullptr ) {
+      allocator.reclaim();
+      p = allocator.try_allocate(sizeof(node),alignof(node));
+    }
+    return new (p) node{value,~value};
+  };
+
+  std::atomic<node*> shared{make_node(0u)};
+  std::atomic<bool>  done{false};
+  std::atomic<unsigned> torn{0u};
+
+  auto readers = std::vector<std::thread>{};
+  for( auto t = 0u; t < 4u; ++t ) {
+    readers.emplace_back([&]{
+      while( !done ) {
+        allocator_type::critical_section section{allocator};
+
+        auto* n = shared.load(std::memory_order_acquire);
+        if( n->check != ~n->value ) ++torn;
+      }
+    });
+  }
+
+  auto writers = std::vector<std::thread>{};
+  for( auto t = 0u; t < 2u; ++t ) {
+    writers.emplace_back([&,t]{
+      for( auto i = 1u; i < 20000u; ++i ) {
+        auto* replacement = make_node( i * 2 + t );
+        auto* old = shared.exchange( replacement, std::memory_order_acq_rel );
+
+        // A node reclaimed too early has the pool's link written over it,
+        // or is reinitialized, either of which the readers would see
+        allocator.retire( old, sizeof(node) );
+      }
+    });
+  }
+
+  for( auto& writer : writers ) writer.join();
+  done = true;
+  for( auto& reader : readers ) reader.join();
+
+  SECTION("Readers never observe a reclaimed node")
+  {
+    REQUIRE( torn.load() == 0u );
+  }
+
+  allocator.deallocate( shared.load(), sizeof(node) );
+}
@@ -0,0 +1,157 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the growing_pool_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/growing_pool_allocator.hpp>
+#include <bit/memory/block_allocators/aligned_block_allocator.hpp>
+#include <bit/memory/block_allocators/new_block_allocator.hpp>
+#include <bit/memory/concepts/ExtendedAllocator.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+namespace {
+  constexpr auto block_size = 1024u;
+
+  using block_allocator_type = bit::memory::new_block_allocator<block_size>;
+  using static_type          = bit::memory::growing_pool_allocator<block_allocator_type>;
+  using named_static_type    = bit::memory::named_growing_pool_allocator<block_allocator_type>;
+
+  using aligned_block_allocator_type
+    = bit::memory::aligned_block_allocator<block_size,block_size>;
+  using aligned_type
+    = bit::memory::growing_pool_allocator<aligned_block_allocator_type>;
+}
+
+//=============================================================================
+
+static_assert( bit::memory::is_extended_allocator<static_type>::value,
+               "growing pool allocator must be an extended allocator" );
+
+static_assert( bit::memory::is_extended_allocator<named_static_type>::value,
+               "named growing pool allocator must be an extended allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("growing_pool_allocator::try_allocate( std::size_t, std::size_t, std::size_t )")
+{
+  static_type allocator{64};
+
+  SECTION("Does not request a slab until the first allocation")
+  {
+    REQUIRE( allocator.slabs() == 0 );
+  }
+
+  SECTION("Allocates aligned memory")
+  {
+    auto p = allocator.try_allocate(32,16);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( bit::memory::align_of(p) >= 16 );
+    REQUIRE( allocator.owns(p) );
+  }
+
+  SECTION("Requests new slabs once the current slab is full")
+  {
+    for( auto i = 0; i < 64; ++i ) {
+      REQUIRE( allocator.try_allocate(32,8) != nullptr );
+    }
+
+    REQUIRE( allocator.slabs() > 1 );
+  }
+
+  SECTION("Returns nullptr for allocations larger than a chunk")
+  {
+    REQUIRE( allocator.try_allocate(64,8) == nullptr );
+    REQUIRE( allocator.slabs() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("growing_pool_allocator::deallocate( void*, std::size_t )")
+{
+  SECTION("Returns slabs that become entirely free")
+  {
+    static_type allocator{64};
+
+    auto allocations = std::vector<void*>{};
+    for( auto i = 0; i < 64; ++i ) {
+      allocations.push_back( allocator.try_allocate(32,8) );
+    }
+    const auto slabs = allocator.slabs();
+
+    for( auto p : allocations ) {
+      allocator.deallocate(p,32);
+    }
+
+    REQUIRE( slabs > 1 );
+    REQUIRE( allocator.slabs() == 1 );
+  }
+
+  SECTION("Recycles deallocated chunks")
+  {
+    static_type allocator{64};
+
+    auto p0 = allocator.try_allocate(32,8);
+    auto p1 = allocator.try_allocate(32,8);
+    allocator.deallocate(p0,32);
+
+    REQUIRE( allocator.try_allocate(32,8) == p0 );
+    REQUIRE( p1 != nullptr );
+  }
+
+  SECTION("Finds slabs of blocks aligned to their size")
+  {
+    aligned_type allocator{64};
+
+    auto allocations = std::vector<void*>{};
+    for( auto i = 0; i < 64; ++i ) {
+      allocations.push_back( allocator.try_allocate(32,8) );
+    }
+
+    for( auto p : allocations ) {
+      allocator.deallocate(p,32);
+    }
+
+    REQUIRE( allocator.slabs() == 1 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("growing_pool_allocator::deallocate_all()")
+{
+  static_type allocator{64};
+
+  for( auto i = 0; i < 64; ++i ) {
+    allocator.try_allocate(32,8);
+  }
+  allocator.deallocate_all();
+
+  SECTION("Returns every slab")
+  {
+    REQUIRE( allocator.slabs() == 0 );
+  }
+
+  SECTION("Can allocate again")
+  {
+    auto p = allocator.try_allocate(32,8);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( allocator.owns(p) );
+  }
+}
@@ -0,0 +1,184 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the guard_page_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/guard_page_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+
+#include <catch.hpp>
+
+#include <cstring> // std::memset
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_allocator<bit::memory::guard_page_allocator>::value,
+               "guard page allocator must be an allocator" );
+
+static_assert( bit::memory::is_allocator<bit::memory::named_guard_page_allocator>::value,
+               "named guard page allocator must be an allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+  const auto page_size = bit::memory::virtual_memory_page_size();
+
+  int double_deletes = 0;
+
+  void count_double_delete( const bit::memory::allocator_info&,
+                            const void*,
+                            std::ptrdiff_t )
+  {
+    ++double_deletes;
+  }
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+TEST_CASE("guard_page_allocator::guard_page_allocator( std::size_t, std::size_t, guard_page_alignment )")
+{
+  auto allocator = bit::memory::guard_page_allocator{ page_size + 1, 4 };
+
+  SECTION("Rounds each slot up to whole pages")
+  {
+    REQUIRE( allocator.max_size() == page_size * 2 );
+  }
+
+  SECTION("Guards against overflow by default")
+  {
+    REQUIRE( allocator.alignment() == bit::memory::guard_page_alignment::overflow );
+  }
+
+  SECTION("Starts with every slot free")
+  {
+    REQUIRE( allocator.capacity() == 4 );
+    REQUIRE( allocator.size() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("guard_page_allocator::try_allocate( std::size_t, std::size_t )")
+{
+  SECTION("Places the end of the allocation against the guard page")
+  {
+    auto allocator = bit::memory::guard_page_allocator{
+      page_size, 4, bit::memory::guard_page_alignment::overflow
+    };
+
+    auto p = static_cast<unsigned char*>(allocator.try_allocate(100,4));
+
+    REQUIRE( p != nullptr );
+    REQUIRE( allocator.owns(p) );
+    REQUIRE( bit::memory::align_of(p + 100) >= page_size );
+
+    // The memory must be writable
+    std::memset(p, 0xff, 100);
+  }
+
+  SECTION("Places the start of the allocation against the guard page")
+  {
+    auto allocator = bit::memory::guard_page_allocator{
+      page_size, 4, bit::memory::guard_page_alignment::underflow
+    };
+
+    auto p = static_cast<unsigned char*>(allocator.try_allocate(100,4));
+
+    REQUIRE( p != nullptr );
+    REQUIRE( bit::memory::align_of(p) >= page_size );
+
+    std::memset(p, 0xff, 100);
+  }
+
+  SECTION("Separates slots with guard pages")
+  {
+    auto allocator = bit::memory::guard_page_allocator{ page_size, 4 };
+
+    auto p0 = static_cast<unsigned char*>(allocator.try_allocate(page_size,8));
+    auto p1 = static_cast<unsigned char*>(allocator.try_allocate(page_size,8));
+
+    REQUIRE( (p1 - p0) == static_cast<std::ptrdiff_t>(page_size * 2) );
+  }
+
+  SECTION("Returns nullptr when every slot is allocated")
+  {
+    auto allocator = bit::memory::guard_page_allocator{ page_size, 2 };
+
+    REQUIRE( allocator.try_allocate(8,8) != nullptr );
+    REQUIRE( allocator.try_allocate(8,8) != nullptr );
+    REQUIRE( allocator.try_allocate(8,8) == nullptr );
+  }
+
+  SECTION("Returns nullptr for allocations larger than a slot")
+  {
+    auto allocator = bit::memory::guard_page_allocator{ page_size, 2 };
+
+    REQUIRE( allocator.try_allocate(page_size + 1,8) == nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("guard_page_allocator::deallocate( void*, std::size_t )")
+{
+  auto allocator = bit::memory::guard_page_allocator{ page_size, 3 };
+
+  auto p0 = allocator.try_allocate(64,8);
+  auto p1 = allocator.try_allocate(64,8);
+
+  SECTION("Reuses slots in the order they are freed")
+  {
+    allocator.deallocate(p1,64);
+    allocator.deallocate(p0,64);
+
+    auto p2 = allocator.try_allocate(64,8);
+    auto p3 = allocator.try_allocate(64,8);
+    auto p4 = allocator.try_allocate(64,8);
+
+    REQUIRE( p2 != p0 );
+    REQUIRE( p2 != p1 );
+    REQUIRE( p3 == p1 );
+    REQUIRE( p4 == p0 );
+  }
+
+  SECTION("Reports deallocating a free slot as a double delete")
+  {
+    const auto old_handler = bit::memory::set_double_delete_handler(&count_double_delete);
+    double_deletes = 0;
+
+    allocator.deallocate(p0,64);
+    allocator.deallocate(p0,64);
+
+    bit::memory::set_double_delete_handler(old_handler);
+
+    REQUIRE( double_deletes == 1 );
+    REQUIRE( allocator.size() == 1 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("guard_page_allocator::deallocate_all()")
+{
+  auto allocator = bit::memory::guard_page_allocator{ page_size, 2 };
+
+  allocator.try_allocate(8,8);
+  allocator.try_allocate(8,8);
+  allocator.deallocate_all();
+
+  SECTION("Frees every slot")
+  {
+    REQUIRE( allocator.size() == 0 );
+    REQUIRE( allocator.try_allocate(8,8) != nullptr );
+    REQUIRE( allocator.try_allocate(8,8) != nullptr );
+  }
+}
@@ -0,0 +1,287 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the latency_tracking_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/latency_tracking_allocator.hpp>
+#include <bit/memory/allocators/malloc_allocator.hpp>
+#include <bit/memory/allocators/policy_allocator.hpp>
+#include <bit/memory/allocators/pool_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+#include <bit/memory/concepts/ExtendedAllocator.hpp>
+#include <bit/memory/policies/bounds_checkers/null_bounds_checker.hpp>
+#include <bit/memory/policies/taggers/null_tagger.hpp>
+#include <bit/memory/policies/trackers/null_latency_tracker.hpp>
+#include <bit/memory/policies/trackers/null_tracker.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint> // std::uint64_t
+#include <cstring> // std::strcmp
+#include <mutex>   // std::mutex
+#include <thread>  // std::thread
+#include <vector>  // std::vector
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+using timed_type = bit::memory::latency_tracking_allocator<bit::memory::malloc_allocator>;
+using untimed_type = bit::memory::latency_tracking_allocator<bit::memory::malloc_allocator,
+                                                             bit::memory::null_latency_tracker>;
+
+static_assert( bit::memory::is_allocator<timed_type>::value,
+               "latency tracking allocator must be an allocator" );
+
+static_assert( bit::memory::is_allocator<bit::memory::named_latency_tracking_allocator<bit::memory::malloc_allocator>>::value,
+               "named latency tracking allocator must be an allocator" );
+
+static_assert( sizeof(untimed_type) == sizeof(bit::memory::malloc_allocator),
+               "null latency tracker must take no space" );
+
+static_assert( bit::memory::is_extended_allocator<
+                 bit::memory::latency_tracking_allocator<bit::memory::pool_allocator,
+                                                         bit::memory::null_latency_tracker>
+               >::value,
+               "latency tracking allocator must preserve extended allocators" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+
+  /// A latency tracker whose clock advances by a fixed step on every read,
+  /// so that every call appears to take exactly 'step' ticks
+  struct stepping_latency_tracker
+  {
+    struct clock_type
+    {
+      using rep = std::uint64_t;
+
+      static rep now() noexcept{ return (ticks += step); }
+
+      static rep ticks;
+      static rep step;
+    };
+
+    void on_allocate_latency( clock_type::rep t ) noexcept{ allocations += t; }
+    void on_deallocate_latency( clock_type::rep t ) noexcept{ deallocations += t; }
+
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+  };
+
+  stepping_latency_tracker::clock_type::rep stepping_latency_tracker::clock_type::ticks = 0;
+  stepping_latency_tracker::clock_type::rep stepping_latency_tracker::clock_type::step = 0;
+
+  using locked_pool_allocator = bit::memory::policy_allocator<
+    bit::memory::pool_allocator,
+    bit::memory::null_tagger,
+    bit::memory::null_tracker,
+    bit::memory::null_bounds_checker,
+    std::mutex
+  >;
+
+  using untimed_policy_type = bit::memory::latency_tracking_allocator<
+    locked_pool_allocator,
+    bit::memory::null_latency_tracker
+  >;
+
+} // anonymous namespace
+
+static_assert( bit::memory::is_extended_allocator<untimed_policy_type>::value ==
+               bit::memory::is_extended_allocator<locked_pool_allocator>::value,
+               "latency tracking allocator must preserve extended allocators" );
+
+static_assert( bit::memory::allocator_has_try_allocate_n<untimed_policy_type>::value &&
+               bit::memory::allocator_has_deallocate_n<untimed_policy_type>::value,
+               "latency tracking allocator must forward batch allocations" );
+
+static_assert( bit::memory::allocator_can_truncate_deallocations<untimed_policy_type>::value,
+               "latency tracking allocator must forward deallocate_all" );
+
+static_assert( bit::memory::allocator_knows_ownership<untimed_policy_type>::value,
+               "latency tracking allocator must forward owns" );
+
+static_assert( bit::memory::allocator_has_max_size<untimed_policy_type>::value,
+               "latency tracking allocator must forward max_size" );
+
+static_assert( !bit::memory::allocator_has_min_size<untimed_policy_type>::value,
+               "latency tracking allocator must not add members" );
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("latency_tracking_allocator::try_allocate( std::size_t, std::size_t )")
+{
+  stepping_latency_tracker::clock_type::step = 7;
+
+  auto allocator = bit::memory::latency_tracking_allocator<
+    bit::memory::malloc_allocator,
+    stepping_latency_tracker
+  >{};
+
+  SECTION("Reports the time taken by the underlying allocator")
+  {
+    auto p = allocator.try_allocate(16,8);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( allocator.tracker().allocations == 7 );
+    REQUIRE( allocator.tracker().deallocations == 0 );
+
+    allocator.deallocate(p,16);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("latency_tracking_allocator::deallocate( void*, std::size_t )")
+{
+  stepping_latency_tracker::clock_type::step = 3;
+
+  auto allocator = bit::memory::latency_tracking_allocator<
+    bit::memory::malloc_allocator,
+    stepping_latency_tracker
+  >{};
+
+  SECTION("Reports the time taken by the underlying allocator")
+  {
+    auto p = allocator.try_allocate(16,8);
+    allocator.deallocate(p,16);
+
+    REQUIRE( allocator.tracker().deallocations == 3 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Latency Tracker
+//-----------------------------------------------------------------------------
+
+TEST_CASE("latency_tracking_allocator<policy_allocator, latency_tracker>")
+{
+  alignas(64) static char storage[64 * 128];
+
+  bit::memory::latency_tracking_allocator<locked_pool_allocator> allocator{
+    64u,
+    bit::memory::memory_block{storage,sizeof(storage)}
+  };
+
+  void* pointers[100];
+  for( auto& p : pointers ) {
+    p = allocator.try_allocate(32,8);
+  }
+  for( auto p : pointers ) {
+    allocator.deallocate(p,32);
+  }
+
+  SECTION("Records every allocation and deallocation")
+  {
+    REQUIRE( allocator.tracker().allocate_latencies().count() == 100 );
+    REQUIRE( allocator.tracker().deallocate_latencies().count() == 100 );
+  }
+
+  SECTION("Summarizes the latencies in increasing percentiles")
+  {
+    const auto summary = allocator.tracker().allocate_summary();
+
+    REQUIRE( summary.count == 100 );
+    REQUIRE( summary.p50 <= summary.p99 );
+    REQUIRE( summary.p99 <= summary.p999 );
+    REQUIRE( summary.p999 <= summary.max );
+    REQUIRE( summary.max == allocator.tracker().allocate_latencies().max() );
+  }
+
+  SECTION("Discards the latencies when cleared")
+  {
+    allocator.tracker().clear();
+
+    REQUIRE( allocator.tracker().allocate_summary().count == 0 );
+    REQUIRE( allocator.tracker().deallocate_summary().count == 0 );
+  }
+
+  SECTION("Records every allocation and deallocation from multiple threads")
+  {
+    const auto thread_count = 4u;
+    const auto iterations   = 5000u;
+
+    auto threads = std::vector<std::thread>{};
+    for( auto i = 0u; i < thread_count; ++i ) {
+      threads.emplace_back([&]{
+        for( auto j = 0u; j < iterations; ++j ) {
+          auto p = allocator.try_allocate(32,8);
+          allocator.deallocate(p,32);
+        }
+      });
+    }
+    for( auto& thread : threads ) {
+      thread.join();
+    }
+
+    const auto expected = 100u + thread_count * iterations;
+
+    REQUIRE( allocator.tracker().allocate_latencies().count() == expected );
+    REQUIRE( allocator.tracker().deallocate_latencies().count() == expected );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Forwarding
+//-----------------------------------------------------------------------------
+
+TEST_CASE("latency_tracking_allocator<policy_allocator, latency_tracker> forwarding")
+{
+  alignas(64) static char storage[64 * 128];
+
+  bit::memory::latency_tracking_allocator<locked_pool_allocator> allocator{
+    64u,
+    bit::memory::memory_block{storage,sizeof(storage)}
+  };
+
+  SECTION("Records a batch allocation and deallocation once each")
+  {
+    void* pointers[10];
+
+    REQUIRE( allocator.try_allocate_n(32,8,10,pointers) == 10 );
+    REQUIRE( allocator.owns(pointers[9]) );
+
+    allocator.deallocate_n(pointers,10,32);
+
+    REQUIRE( allocator.tracker().allocate_latencies().count() == 1 );
+    REQUIRE( allocator.tracker().deallocate_latencies().count() == 1 );
+  }
+
+  SECTION("Forwards the capacity of the underlying allocator")
+  {
+    REQUIRE( allocator.max_size() == allocator.backing_allocator().max_size() );
+  }
+
+  SECTION("Forwards the info of the underlying allocator")
+  {
+    REQUIRE( std::strcmp(allocator.info().name(), "pool_allocator") == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("latency_tracking_allocator::try_allocate( std::size_t, std::size_t, std::size_t )")
+{
+  alignas(64) static char storage[64 * 16];
+
+  bit::memory::latency_tracking_allocator<bit::memory::pool_allocator> allocator{
+    64u,
+    bit::memory::memory_block{storage,sizeof(storage)}
+  };
+
+  SECTION("Records the offset allocation")
+  {
+    auto p = allocator.try_allocate(32,8,0);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( allocator.tracker().allocate_latencies().count() == 1 );
+
+    allocator.deallocate(p,32);
+  }
+}
@@ -0,0 +1,243 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the per_cpu_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/per_cpu_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+
+#include <catch.hpp>
+
+#include <cstdlib> // std::malloc, std::free
+#include <cstring> // std::memset
+#include <thread>  // std::thread
+#include <vector>  // std::vector
+
+namespace {
+
+  struct allocation_counts
+  {
+    std::size_t allocations   = 0;
+    std::size_t deallocations = 0;
+
+    std::size_t outstanding() const noexcept
+    {
+      return allocations - deallocations;
+    }
+  };
+
+  /// A central allocator that counts the allocations it has outstanding
+  class counting_allocator
+  {
+  public:
+
+    explicit counting_allocator( allocation_counts& counts )
+      : m_counts(&counts)
+    {
+
+    }
+
+    void* try_allocate( std::size_t size, std::size_t )
+      noexcept
+    {
+      ++m_counts->allocations;
+      return std::malloc(size);
+    }
+
+    void deallocate( void* p, std::size_t )
+    {
+      ++m_counts->deallocations;
+      std::free(p);
+    }
+
+  private:
+
+    allocation_counts* m_counts;
+  };
+
+  using static_type       = bit::memory::per_cpu_allocator<counting_allocator>;
+  using named_static_type = bit::memory::named_per_cpu_allocator<counting_allocator>;
+
+} // anonymous namespace
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_allocator<static_type>::value,
+               "per cpu allocator must be an allocator" );
+
+static_assert( bit::memory::is_allocator<named_static_type>::value,
+               "named per cpu allocator must be an allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+TEST_CASE("per_cpu_allocator::per_cpu_allocator( Args&&... )")
+{
+  auto central = allocation_counts{};
+  static_type allocator{central};
+
+  SECTION("Creates one shard per processor")
+  {
+    REQUIRE( allocator.shards() == bit::memory::cpu_count() );
+    REQUIRE( allocator.shards() >= 1 );
+  }
+
+  SECTION("Does not allocate from the central allocator")
+  {
+    REQUIRE( central.allocations == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+// The thread may migrate between processors at any point in these tests, so
+// they only check properties that hold regardless of which shard is used
+
+TEST_CASE("per_cpu_allocator::try_allocate( std::size_t, std::size_t )")
+{
+  auto central = allocation_counts{};
+  static_type allocator{central};
+  allocator.set_magazine_size(8);
+
+  SECTION("Refills a magazine from the central allocator in a batch")
+  {
+    auto p = allocator.try_allocate(24,8);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( central.allocations % 8 == 0 );
+
+    allocator.deallocate(p,24);
+  }
+
+  SECTION("Returns chunks aligned to the fundamental alignment")
+  {
+    auto p = allocator.try_allocate(100,16);
+
+    REQUIRE( bit::memory::align_of(p) >= static_type::max_alignment::value );
+
+    allocator.deallocate(p,100);
+  }
+
+  SECTION("Forwards uncached sizes to the central allocator")
+  {
+    const auto size = static_type::max_cached_size::value + 1;
+    auto p = allocator.try_allocate(size,8);
+
+    REQUIRE( central.allocations == 1 );
+
+    allocator.deallocate(p,size);
+
+    REQUIRE( central.deallocations == 1 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("per_cpu_allocator::flush_caches()")
+{
+  auto central = allocation_counts{};
+  static_type allocator{central};
+
+  auto p0 = allocator.try_allocate(16,16);
+  auto p1 = allocator.try_allocate(1000,16);
+  allocator.deallocate(p1,1000);
+  allocator.deallocate(p0,16);
+
+  allocator.flush_caches();
+
+  SECTION("Returns every cached chunk to the central allocator")
+  {
+    REQUIRE( central.allocations != 0 );
+    REQUIRE( central.outstanding() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("per_cpu_allocator" "[concurrency]")
+{
+  auto central = allocation_counts{};
+  static_type allocator{central};
+
+  const auto thread_count = 8u;
+  const auto iterations   = 2000u;
+  const auto held         = 32u;
+
+  auto failures = std::vector<unsigned>(thread_count, 0u);
+  auto threads  = std::vector<std::thread>{};
+
+  for( auto t = 0u; t < thread_count; ++t ) {
+    threads.emplace_back([&,t]{
+      unsigned char* pointers[held] = {};
+
+      for( auto i = 0u; i < iterations; ++i ) {
+        auto& p = pointers[i % held];
+        if( p != nullptr ) {
+          // Another thread writing into the same chunk would clobber this
+          for( auto j = 0u; j < 48; ++j ) {
+            if( p[j] != static_cast<unsigned char>(t) ) ++failures[t];
+          }
+          allocator.deallocate(p,48);
+        }
+        p = static_cast<unsigned char*>(allocator.try_allocate(48,16));
+        std::memset(p, static_cast<int>(t), 48);
+      }
+      for( auto p : pointers ) {
+        allocator.deallocate(p,48);
+      }
+    });
+  }
+  for( auto& thread : threads ) {
+    thread.join();
+  }
+
+  SECTION("Never hands out a chunk to two threads at once")
+  {
+    for( auto f : failures ) {
+      REQUIRE( f == 0 );
+    }
+  }
+
+  SECTION("Every chunk is returned once the caches are flushed")
+  {
+    allocator.flush_caches();
+
+    REQUIRE( central.outstanding() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("per_cpu_allocator::~per_cpu_allocator()")
+{
+  auto central = allocation_counts{};
+
+  {
+    static_type allocator{central};
+    allocator.set_magazine_size(8);
+
+    auto p = allocator.try_allocate(16,16);
+    allocator.deallocate(p,16);
+
+    std::thread([&]{
+      auto p = allocator.try_allocate(256,16);
+      allocator.deallocate(p,256);
+    }).join();
+  }
+
+  SECTION("Flushes every shard")
+  {
+    REQUIRE( central.allocations >= 16 );
+    REQUIRE( central.outstanding() == 0 );
+  }
+}
@@ -0,0 +1,197 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the policy_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/policy_allocator.hpp>
+#include <bit/memory/allocators/pool_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+#include <bit/memory/policies/bounds_checkers/null_bounds_checker.hpp>
+#include <bit/memory/policies/taggers/null_tagger.hpp>
+
+#include <catch.hpp>
+
+#include <cstddef>     // std::size_t
+#include <type_traits> // std::integral_constant
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+
+  bool lock_held  = false;
+  int  lock_count = 0;
+
+  /// A lock that records whether it is currently held, and how often it
+  /// was acquired
+  struct observed_lock
+  {
+    void lock(){ lock_held = true; ++lock_count; }
+    void unlock(){ lock_held = false; }
+  };
+
+  /// A tracker that records whether the lock was held when it was notified
+  template<bool ThreadSafe>
+  struct lock_observing_tracker
+  {
+    using is_thread_safe = std::integral_constant<bool,ThreadSafe>;
+
+    static int  notified;
+    static bool notified_in_lock;
+
+    void on_allocate( void*, std::size_t, std::size_t ){ notify(); }
+    void on_deallocate( const bit::memory::allocator_info&, void*, std::size_t ){ notify(); }
+    void on_deallocate_all(){}
+    void finalize( const bit::memory::allocator_info& ){}
+
+    static void notify()
+    {
+      ++notified;
+      notified_in_lock = notified_in_lock || lock_held;
+    }
+
+    static void reset()
+    {
+      notified         = 0;
+      notified_in_lock = false;
+    }
+  };
+
+  template<bool ThreadSafe>
+  int lock_observing_tracker<ThreadSafe>::notified = 0;
+
+  template<bool ThreadSafe>
+  bool lock_observing_tracker<ThreadSafe>::notified_in_lock = false;
+
+  template<bool ThreadSafe>
+  using observed_pool_allocator = bit::memory::policy_allocator<
+    bit::memory::pool_allocator,
+    bit::memory::null_tagger,
+    lock_observing_tracker<ThreadSafe>,
+    bit::memory::null_bounds_checker,
+    observed_lock
+  >;
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Tracking
+//-----------------------------------------------------------------------------
+
+TEST_CASE("policy_allocator<..., MemoryTracker, ..., BasicLockable>")
+{
+  alignas(64) static char storage[64 * 16];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  SECTION("Notifies thread-safe trackers outside of the lock")
+  {
+    using tracker_type = lock_observing_tracker<true>;
+    tracker_type::reset();
+
+    observed_pool_allocator<true> allocator{64u,block};
+
+    auto p = allocator.try_allocate(16,8);
+    allocator.deallocate(p,16);
+
+    void* ptrs[4];
+    const auto count = allocator.try_allocate_n(16,8,4,ptrs);
+    allocator.deallocate_n(ptrs,count,16);
+
+    REQUIRE( tracker_type::notified == static_cast<int>(2 + 2 * count) );
+    REQUIRE_FALSE( tracker_type::notified_in_lock );
+  }
+
+  SECTION("Notifies other trackers inside of the lock")
+  {
+    using tracker_type = lock_observing_tracker<false>;
+    tracker_type::reset();
+
+    observed_pool_allocator<false> allocator{64u,block};
+
+    auto p = allocator.try_allocate(16,8);
+
+    REQUIRE( tracker_type::notified == 1 );
+    REQUIRE( tracker_type::notified_in_lock );
+
+    allocator.deallocate(p,16);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Batch Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("policy_allocator::try_allocate_n( std::size_t, std::size_t, std::size_t, void** )")
+{
+  alignas(64) static char storage[64 * 16];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  using tracker_type = lock_observing_tracker<false>;
+  tracker_type::reset();
+
+  observed_pool_allocator<false> allocator{64u,block};
+
+  lock_count = 0;
+
+  void* ptrs[8];
+  const auto count = allocator.try_allocate_n(16,8,8,ptrs);
+
+  SECTION("Makes every allocation")
+  {
+    REQUIRE( count == 8 );
+    REQUIRE( allocator.owns(ptrs[7]) );
+  }
+
+  SECTION("Takes the lock once for the whole batch")
+  {
+    REQUIRE( lock_count == 1 );
+  }
+
+  SECTION("Tracks each allocation once")
+  {
+    REQUIRE( tracker_type::notified == static_cast<int>(count) );
+  }
+
+  allocator.deallocate_n(ptrs,count,16);
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("policy_allocator::deallocate_n( void**, std::size_t, std::size_t )")
+{
+  alignas(64) static char storage[64 * 16];
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+
+  using tracker_type = lock_observing_tracker<false>;
+
+  observed_pool_allocator<false> allocator{64u,block};
+
+  void* ptrs[8];
+  const auto count = allocator.try_allocate_n(16,8,8,ptrs);
+
+  tracker_type::reset();
+  lock_count = 0;
+
+  allocator.deallocate_n(ptrs,count,16);
+
+  SECTION("Takes the lock once for the whole batch")
+  {
+    REQUIRE( lock_count == 1 );
+  }
+
+  SECTION("Tracks each deallocation once")
+  {
+    REQUIRE( tracker_type::notified == static_cast<int>(count) );
+  }
+
+  SECTION("Returns every allocation to the underlying allocator")
+  {
+    void* again[16];
+
+    REQUIRE( allocator.try_allocate_n(16,8,16,again) == 16 );
+
+    allocator.deallocate_n(again,16,16);
+  }
+}
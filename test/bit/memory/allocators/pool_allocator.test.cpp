@@ -0,0 +1,206 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the pool_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/pool_allocator.hpp>
+#include <bit/memory/concepts/ExtendedAllocator.hpp>
+#include <bit/memory/traits/allocator_traits.hpp>
+
+#include <catch.hpp>
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_extended_allocator<bit::memory::pool_allocator>::value,
+               "pool allocator must be an extended allocator" );
+
+static_assert( bit::memory::is_extended_allocator<bit::memory::named_pool_allocator>::value,
+               "named pool allocator must be an extended allocator" );
+
+static_assert( bit::memory::allocator_has_try_allocate_n<bit::memory::pool_allocator>::value,
+               "pool allocator must support batch allocations" );
+
+static_assert( bit::memory::allocator_has_deallocate_n<bit::memory::pool_allocator>::value,
+               "pool allocator must support batch deallocations" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+  constexpr auto chunk_size = 32u;
+  constexpr auto chunks     = 8u;
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("pool_allocator::try_allocate( std::size_t, std::size_t, std::size_t )")
+{
+  alignas(chunk_size) char storage[chunk_size * chunks];
+
+  auto block     = bit::memory::memory_block{storage,sizeof(storage)};
+  auto allocator = bit::memory::pool_allocator{chunk_size,block};
+
+  SECTION("Untouched chunks are handed out in address order")
+  {
+    for( auto i = 0u; i < chunks; ++i ) {
+      auto p = allocator.try_allocate(1,1);
+
+      REQUIRE( p == &storage[i * chunk_size + 1] );
+    }
+  }
+
+  SECTION("Returns nullptr once every chunk is in use")
+  {
+    for( auto i = 0u; i < chunks; ++i ) {
+      allocator.try_allocate(1,1);
+    }
+
+    REQUIRE( allocator.try_allocate(1,1) == nullptr );
+  }
+
+  SECTION("Returns nullptr when the size exceeds the chunk size")
+  {
+    REQUIRE( allocator.try_allocate(chunk_size,1) == nullptr );
+
+    SECTION("Does not consume a chunk")
+    {
+      for( auto i = 0u; i < chunks; ++i ) {
+        REQUIRE( allocator.try_allocate(1,1) != nullptr );
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("pool_allocator::deallocate( void*, std::size_t )")
+{
+  alignas(chunk_size) char storage[chunk_size * chunks];
+
+  auto block     = bit::memory::memory_block{storage,sizeof(storage)};
+  auto allocator = bit::memory::pool_allocator{chunk_size,block};
+
+  SECTION("Recycled chunks are reused before untouched chunks")
+  {
+    auto p0 = allocator.try_allocate(8,8);
+    auto p1 = allocator.try_allocate(8,8);
+
+    allocator.deallocate(p0,8);
+
+    auto p2 = allocator.try_allocate(8,8);
+    REQUIRE( p2 == p0 );
+
+    allocator.deallocate(p2,8);
+    allocator.deallocate(p1,8);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("pool_allocator::try_allocate_n( std::size_t, std::size_t, std::size_t, void** )")
+{
+  alignas(chunk_size) char storage[chunk_size * chunks];
+
+  auto block     = bit::memory::memory_block{storage,sizeof(storage)};
+  auto allocator = bit::memory::pool_allocator{chunk_size,block};
+
+  void* out[chunks + 1] = {};
+
+  SECTION("Takes recycled chunks before untouched chunks")
+  {
+    auto p0 = allocator.try_allocate(8,8);
+    auto p1 = allocator.try_allocate(8,8);
+    allocator.deallocate(p1,8);
+
+    REQUIRE( allocator.try_allocate_n(8,8,3,out) == 3 );
+    REQUIRE( out[0] == p1 );
+    REQUIRE( out[1] != p0 );
+    REQUIRE( out[2] != out[1] );
+  }
+
+  SECTION("Returns the number of chunks that were available")
+  {
+    REQUIRE( allocator.try_allocate_n(8,8,chunks + 1,out) == chunks );
+    REQUIRE( allocator.try_allocate(8,8) == nullptr );
+  }
+
+  SECTION("Does not consume chunks that exceed the chunk size")
+  {
+    REQUIRE( allocator.try_allocate_n(chunk_size,1,4,out) == 0 );
+    REQUIRE( allocator.try_allocate_n(8,8,chunks,out) == chunks );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("pool_allocator::deallocate_n( void**, std::size_t, std::size_t )")
+{
+  alignas(chunk_size) char storage[chunk_size * chunks];
+
+  auto block     = bit::memory::memory_block{storage,sizeof(storage)};
+  auto allocator = bit::memory::pool_allocator{chunk_size,block};
+
+  void* out[chunks] = {};
+  allocator.try_allocate_n(8,8,chunks,out);
+  allocator.deallocate_n(out,chunks,8);
+
+  SECTION("Makes every chunk available again in the same order")
+  {
+    for( auto i = 0u; i < chunks; ++i ) {
+      REQUIRE( allocator.try_allocate(8,8) == out[i] );
+    }
+    REQUIRE( allocator.try_allocate(8,8) == nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("allocator_traits<pool_allocator>::try_allocate_n( ... )")
+{
+  using traits_type = bit::memory::allocator_traits<bit::memory::pool_allocator>;
+
+  alignas(chunk_size) char storage[chunk_size * chunks];
+
+  auto block     = bit::memory::memory_block{storage,sizeof(storage)};
+  auto allocator = bit::memory::pool_allocator{chunk_size,block};
+
+  void* out[chunks] = {};
+
+  SECTION("Dispatches to the batch allocation functions")
+  {
+    REQUIRE( traits_type::try_allocate_n(allocator,8,8,chunks,out) == chunks );
+
+    traits_type::deallocate_n(allocator,out,chunks,8);
+
+    REQUIRE( traits_type::try_allocate_n(allocator,8,8,chunks,out) == chunks );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("pool_allocator::deallocate_all()")
+{
+  alignas(chunk_size) char storage[chunk_size * chunks];
+
+  auto block     = bit::memory::memory_block{storage,sizeof(storage)};
+  auto allocator = bit::memory::pool_allocator{chunk_size,block};
+
+  for( auto i = 0u; i < chunks; ++i ) {
+    allocator.try_allocate(1,1);
+  }
+  allocator.deallocate_all();
+
+  SECTION("Makes every chunk available again")
+  {
+    for( auto i = 0u; i < chunks; ++i ) {
+      REQUIRE( allocator.try_allocate(1,1) != nullptr );
+    }
+    REQUIRE( allocator.try_allocate(1,1) == nullptr );
+  }
+}
@@ -0,0 +1,198 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the remote_free_pool_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/remote_free_pool_allocator.hpp>
+#include <bit/memory/concepts/ExtendedAllocator.hpp>
+
+#include <catch.hpp>
+
+#include <atomic> // std::atomic
+#include <thread> // std::thread
+#include <vector> // std::vector
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_extended_allocator<bit::memory::remote_free_pool_allocator>::value,
+               "remote free pool allocator must be an extended allocator" );
+
+static_assert( bit::memory::is_extended_allocator<bit::memory::named_remote_free_pool_allocator>::value,
+               "named remote free pool allocator must be an extended allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+  constexpr auto chunk_size = 32u;
+  constexpr auto chunks     = 8u;
+}
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+TEST_CASE("remote_free_pool_allocator::remote_free_pool_allocator( std::size_t, memory_block )")
+{
+  alignas(chunk_size) char storage[chunk_size * chunks];
+
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+  bit::memory::remote_free_pool_allocator allocator{chunk_size,block};
+
+  SECTION("The constructing thread owns the pool")
+  {
+    REQUIRE( allocator.owning_thread() == std::this_thread::get_id() );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("remote_free_pool_allocator::deallocate( void*, std::size_t )")
+{
+  alignas(chunk_size) char storage[chunk_size * chunks];
+
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+  bit::memory::remote_free_pool_allocator allocator{chunk_size,block};
+
+  SECTION("The owner's deallocations are reused immediately")
+  {
+    auto p0 = allocator.try_allocate(16,8);
+    allocator.deallocate(p0,16);
+
+    REQUIRE( allocator.try_allocate(16,8) == p0 );
+  }
+
+  SECTION("Remote deallocations are reused once the owner's freelist is dry")
+  {
+    auto p0 = allocator.try_allocate(16,1);
+    auto p1 = allocator.try_allocate(16,1);
+
+    std::thread([&]{ allocator.deallocate(p0,16); }).join();
+    allocator.deallocate(p1,16);
+
+    // The local freelist is drained first, then the remote queue, and only
+    // then are untouched chunks used
+    REQUIRE( allocator.try_allocate(16,1) == p1 );
+    REQUIRE( allocator.try_allocate(16,1) == p0 );
+    REQUIRE( allocator.try_allocate(16,1) == &storage[2 * chunk_size + 1] );
+  }
+
+  SECTION("Remote deallocations make an exhausted pool usable again")
+  {
+    void* pointers[chunks];
+    for( auto& p : pointers ) {
+      p = allocator.try_allocate(16,8);
+    }
+    REQUIRE( allocator.try_allocate(16,8) == nullptr );
+
+    std::thread([&]{
+      for( auto p : pointers ) {
+        allocator.deallocate(p,16);
+      }
+    }).join();
+
+    for( auto i = 0u; i < chunks; ++i ) {
+      REQUIRE( allocator.try_allocate(16,8) != nullptr );
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("remote_free_pool_allocator::drain_remote_frees()")
+{
+  alignas(chunk_size) char storage[chunk_size * chunks];
+
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+  bit::memory::remote_free_pool_allocator allocator{chunk_size,block};
+
+  auto p0 = allocator.try_allocate(16,8);
+  auto p1 = allocator.try_allocate(16,8);
+  auto p2 = allocator.try_allocate(16,8);
+
+  std::thread([&]{
+    allocator.deallocate(p0,16);
+    allocator.deallocate(p2,16);
+  }).join();
+
+  SECTION("Moves every queued chunk to the owner")
+  {
+    REQUIRE( allocator.drain_remote_frees() == 2 );
+    REQUIRE( allocator.drain_remote_frees() == 0 );
+    REQUIRE( p1 != nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("remote_free_pool_allocator" "[producer consumer]")
+{
+  constexpr auto pipeline_chunks = 256u;
+  constexpr auto messages        = 20000u;
+
+  alignas(chunk_size) static char storage[chunk_size * pipeline_chunks];
+
+  auto block = bit::memory::memory_block{storage,sizeof(storage)};
+  bit::memory::remote_free_pool_allocator allocator{chunk_size,block};
+
+  // A single-slot-per-message ring hands allocations to the consumers
+  std::atomic<void*> ring[pipeline_chunks] = {};
+  std::atomic<unsigned> consumed{0u};
+
+  auto consumers = std::vector<std::thread>{};
+  for( auto t = 0u; t < 4u; ++t ) {
+    consumers.emplace_back([&]{
+      while( consumed.load() < messages ) {
+        for( auto& slot : ring ) {
+          auto* p = slot.exchange(nullptr, std::memory_order_acquire);
+          if( p != nullptr ) {
+            allocator.deallocate(p,16);
+            ++consumed;
+          }
+        }
+      }
+    });
+  }
+
+  auto produced = 0u;
+  auto failures = 0u;
+  while( produced < messages ) {
+    auto* p = allocator.try_allocate(16,8);
+    if( p == nullptr ) continue;
+
+    // Post into any empty slot
+    auto posted = false;
+    while( !posted ) {
+      for( auto& slot : ring ) {
+        void* expected = nullptr;
+        if( slot.compare_exchange_strong(expected, p, std::memory_order_release) ) {
+          posted = true;
+          break;
+        }
+      }
+    }
+    if( !allocator.owns(p) ) ++failures;
+    ++produced;
+  }
+
+  for( auto& consumer : consumers ) {
+    consumer.join();
+  }
+
+  SECTION("Every message is recycled through the remote-free queue")
+  {
+    REQUIRE( failures == 0 );
+    REQUIRE( consumed.load() == messages );
+
+    allocator.drain_remote_frees();
+    for( auto i = 0u; i < pipeline_chunks; ++i ) {
+      REQUIRE( allocator.try_allocate(16,8) != nullptr );
+    }
+  }
+}
@@ -0,0 +1,136 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the sampling_guarded_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/sampling_guarded_allocator.hpp>
+#include <bit/memory/allocators/malloc_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+
+#include <catch.hpp>
+
+#include <cstring> // std::memset
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+using sampling_type = bit::memory::sampling_guarded_allocator<bit::memory::malloc_allocator>;
+
+static_assert( bit::memory::is_allocator<sampling_type>::value,
+               "sampling guarded allocator must be an allocator" );
+
+static_assert( bit::memory::is_allocator<bit::memory::named_sampling_guarded_allocator<bit::memory::malloc_allocator>>::value,
+               "named sampling guarded allocator must be an allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+  int overflows      = 0;
+  int double_deletes = 0;
+
+  void count_overflow( const bit::memory::allocator_info&,
+                       const void*,
+                       std::ptrdiff_t )
+  {
+    ++overflows;
+  }
+
+  void count_double_delete( const bit::memory::allocator_info&,
+                            const void*,
+                            std::ptrdiff_t )
+  {
+    ++double_deletes;
+  }
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("sampling_guarded_allocator::try_allocate( std::size_t, std::size_t )")
+{
+  sampling_type allocator{ 4, 8 };
+
+  SECTION("Samples one in every 'sample_rate' allocations")
+  {
+    void* pointers[8];
+    auto sampled = 0;
+
+    for( auto& p : pointers ) {
+      p = allocator.try_allocate(32,8);
+      if( allocator.is_sampled(p) ) ++sampled;
+    }
+
+    REQUIRE( sampled == 2 );
+    REQUIRE( allocator.is_sampled(pointers[3]) );
+    REQUIRE( allocator.is_sampled(pointers[7]) );
+
+    for( auto p : pointers ) {
+      allocator.deallocate(p,32);
+    }
+  }
+
+  SECTION("Does not sample when the rate is 0")
+  {
+    allocator.set_sample_rate(0);
+
+    for( auto i = 0; i < 16; ++i ) {
+      auto p = allocator.try_allocate(32,8);
+      REQUIRE_FALSE( allocator.is_sampled(p) );
+      allocator.deallocate(p,32);
+    }
+  }
+
+  SECTION("Does not sample allocations larger than a page")
+  {
+    allocator.set_sample_rate(1);
+
+    const auto size = bit::memory::virtual_memory_page_size() + 1;
+    auto p = allocator.try_allocate(size,8);
+
+    REQUIRE_FALSE( allocator.is_sampled(p) );
+
+    allocator.deallocate(p,size);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("sampling_guarded_allocator::deallocate( void*, std::size_t )")
+{
+  sampling_type allocator{ 1, 4 };
+
+  SECTION("Reports overwriting the slack after an allocation")
+  {
+    const auto old_handler = bit::memory::set_buffer_overflow_handler(&count_overflow);
+    overflows = 0;
+
+    auto p = static_cast<unsigned char*>(allocator.try_allocate(30,16));
+    REQUIRE( allocator.is_sampled(p) );
+
+    std::memset(p, 0, 31);
+    allocator.deallocate(p,30);
+
+    bit::memory::set_buffer_overflow_handler(old_handler);
+
+    REQUIRE( overflows == 1 );
+  }
+
+  SECTION("Reports deallocating a sampled allocation twice")
+  {
+    const auto old_handler = bit::memory::set_double_delete_handler(&count_double_delete);
+    double_deletes = 0;
+
+    auto p = allocator.try_allocate(30,16);
+    allocator.deallocate(p,30);
+    allocator.deallocate(p,30);
+
+    bit::memory::set_double_delete_handler(old_handler);
+
+    REQUIRE( double_deletes == 1 );
+  }
+}
@@ -0,0 +1,188 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the slab_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/slab_allocator.hpp>
+#include <bit/memory/block_allocators/new_block_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+
+#include <catch.hpp>
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+namespace {
+  constexpr auto block_size = 8192u;
+
+  using block_allocator_type = bit::memory::new_block_allocator<block_size>;
+  using static_type          = bit::memory::slab_allocator<block_allocator_type>;
+  using named_static_type    = bit::memory::named_slab_allocator<block_allocator_type>;
+}
+
+//=============================================================================
+
+static_assert( bit::memory::is_allocator<static_type>::value,
+               "slab allocator must be an allocator" );
+
+static_assert( bit::memory::is_allocator<named_static_type>::value,
+               "named slab allocator must be an allocator" );
+
+static_assert( static_type::size_class_size(0) == 16,
+               "smallest size-class must be 16 bytes" );
+
+static_assert( static_type::size_class_size(static_type::size_classes::value-1) == 4096,
+               "largest size-class must be 4 KiB" );
+
+static_assert( static_type::header_size::value % static_type::max_alignment::value == 0,
+               "slab header must preserve the chunk alignment" );
+
+static_assert( static_type::min_block_size::value ==
+               static_type::header_size::value + static_type::size_class_size(static_type::size_classes::value-1),
+               "minimum block size must fit the largest size-class" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Size Classes
+//-----------------------------------------------------------------------------
+
+TEST_CASE("slab_allocator::size_class_index( std::size_t )")
+{
+  SECTION("Sizes up to 64 bytes are spaced 16 bytes apart")
+  {
+    REQUIRE( static_type::size_class_index(1) == 0 );
+    REQUIRE( static_type::size_class_index(16) == 0 );
+    REQUIRE( static_type::size_class_index(17) == 1 );
+    REQUIRE( static_type::size_class_index(64) == 3 );
+  }
+
+  SECTION("Larger sizes split each power of two into 4 classes")
+  {
+    REQUIRE( static_type::size_class_size(static_type::size_class_index(65)) == 80 );
+    REQUIRE( static_type::size_class_size(static_type::size_class_index(129)) == 160 );
+    REQUIRE( static_type::size_class_size(static_type::size_class_index(1025)) == 1280 );
+    REQUIRE( static_type::size_class_size(static_type::size_class_index(3073)) == 3584 );
+  }
+
+  SECTION("Every size maps to the smallest class that can hold it")
+  {
+    for( auto size = 1u; size <= 4096u; ++size ) {
+      const auto index = static_type::size_class_index(size);
+
+      REQUIRE( index < static_type::size_classes::value );
+      REQUIRE( static_type::size_class_size(index) >= size );
+      if( index > 0 ) {
+        REQUIRE( static_type::size_class_size(index-1) < size );
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("slab_allocator::try_allocate( std::size_t, std::size_t )")
+{
+  static_type allocator{};
+
+  SECTION("Allocates aligned memory from a slab")
+  {
+    auto p = allocator.try_allocate(24,16);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( bit::memory::align_of(p) >= 16 );
+    REQUIRE( allocator.owns(p) );
+  }
+
+  SECTION("Allocations of the same class are spaced by the class size")
+  {
+    auto p0 = static_cast<char*>(allocator.try_allocate(100,8));
+    auto p1 = static_cast<char*>(allocator.try_allocate(112,8));
+
+    REQUIRE( (p1 - p0) == 112 );
+  }
+
+  SECTION("Allocations of different classes come from different slabs")
+  {
+    auto p0 = static_cast<char*>(allocator.try_allocate(16,8));
+    auto p1 = static_cast<char*>(allocator.try_allocate(4096,8));
+
+    REQUIRE( p0 != nullptr );
+    REQUIRE( p1 != nullptr );
+    REQUIRE( (p1 - p0) != 16 );
+  }
+
+  SECTION("Returns nullptr for sizes larger than max_size")
+  {
+    auto p = allocator.try_allocate(allocator.max_size()+1,8);
+
+    REQUIRE( p == nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("slab_allocator::try_allocate( std::size_t, std::size_t ) with min_block_size blocks")
+{
+  using small_block_allocator = bit::memory::new_block_allocator<static_type::min_block_size::value>;
+
+  bit::memory::slab_allocator<small_block_allocator> allocator{};
+
+  SECTION("Allocates the largest size-class")
+  {
+    auto p = allocator.try_allocate(allocator.max_size(),16);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( bit::memory::align_of(p) >= 16 );
+
+    allocator.deallocate(p,allocator.max_size());
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("slab_allocator::deallocate( void*, std::size_t )")
+{
+  static_type allocator{};
+
+  SECTION("Deallocated memory is reused by the same size-class")
+  {
+    auto p0 = allocator.try_allocate(200,8);
+    allocator.deallocate(p0,200);
+
+    auto p1 = allocator.try_allocate(224,8);
+
+    REQUIRE( p0 == p1 );
+  }
+
+  SECTION("Deallocated memory is not reused by other size-classes")
+  {
+    auto p0 = allocator.try_allocate(200,8);
+    allocator.deallocate(p0,200);
+
+    auto p1 = allocator.try_allocate(32,8);
+
+    REQUIRE( p0 != p1 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("slab_allocator::deallocate_all()")
+{
+  static_type allocator{};
+
+  auto p = allocator.try_allocate(64,8);
+  allocator.deallocate_all();
+
+  SECTION("Releases all slabs")
+  {
+    REQUIRE_FALSE( allocator.owns(p) );
+  }
+}
@@ -0,0 +1,71 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the stack_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/stack_allocator.hpp>
+#include <bit/memory/concepts/ExtendedAllocator.hpp>
+
+#include <catch.hpp>
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+namespace {
+  using static_type       = bit::memory::stack_allocator<256,16>;
+  using named_static_type = bit::memory::named_stack_allocator<256,16>;
+}
+
+static_assert( bit::memory::is_extended_allocator<static_type>::value,
+               "stack allocator must be an extended allocator" );
+
+static_assert( bit::memory::allocator_has_expand<static_type>::value,
+               "stack allocator must be expandable" );
+
+static_assert( bit::memory::allocator_has_expand<named_static_type>::value,
+               "named stack allocator must be expandable" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("stack_allocator::expand( void*, std::size_t )")
+{
+  static_type allocator;
+
+  SECTION("Expands the most recent allocation in place")
+  {
+    auto p0 = static_cast<unsigned char*>(allocator.try_allocate(16,16));
+
+    REQUIRE( allocator.expand(p0, 64) );
+
+    // The next allocation follows its adjustment byte
+    auto p1 = static_cast<unsigned char*>(allocator.try_allocate(16,1));
+    REQUIRE( p1 == (p0 + 64 + 1) );
+  }
+
+  SECTION("Fails to expand an older allocation")
+  {
+    auto p0 = allocator.try_allocate(16,16);
+    auto p1 = allocator.try_allocate(16,16);
+
+    REQUIRE_FALSE( allocator.expand(p0, 32) );
+    REQUIRE( p1 != nullptr );
+  }
+
+  SECTION("Fails to expand past the end of the storage")
+  {
+    // The first allocation follows its adjustment byte, padded to 16 bytes
+    // into the storage
+    auto p0 = allocator.try_allocate(16,16);
+
+    REQUIRE_FALSE( allocator.expand(p0, 256 - 16 + 1) );
+    REQUIRE( allocator.expand(p0, 256 - 16) );
+  }
+}
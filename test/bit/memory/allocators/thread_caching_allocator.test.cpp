@@ -0,0 +1,333 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the thread_caching_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/thread_caching_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+
+#include <catch.hpp>
+
+#include <atomic>  // std::atomic
+#include <cstdlib> // std::malloc, std::free
+#include <memory>  // std::make_unique
+#include <thread>  // std::thread
+
+namespace {
+
+  struct allocation_counts
+  {
+    std::size_t allocations   = 0;
+    std::size_t deallocations = 0;
+
+    std::size_t outstanding() const noexcept
+    {
+      return allocations - deallocations;
+    }
+  };
+
+  /// A central allocator that counts the allocations it has outstanding
+  class counting_allocator
+  {
+  public:
+
+    explicit counting_allocator( allocation_counts& counts )
+      : m_counts(&counts)
+    {
+
+    }
+
+    void* try_allocate( std::size_t size, std::size_t )
+      noexcept
+    {
+      ++m_counts->allocations;
+      return std::malloc(size);
+    }
+
+    void deallocate( void* p, std::size_t )
+    {
+      ++m_counts->deallocations;
+      std::free(p);
+    }
+
+  private:
+
+    allocation_counts* m_counts;
+  };
+
+  using static_type       = bit::memory::thread_caching_allocator<counting_allocator>;
+  using named_static_type = bit::memory::named_thread_caching_allocator<counting_allocator>;
+
+} // anonymous namespace
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_allocator<static_type>::value,
+               "thread caching allocator must be an allocator" );
+
+static_assert( bit::memory::is_allocator<named_static_type>::value,
+               "named thread caching allocator must be an allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("thread_caching_allocator::try_allocate( std::size_t, std::size_t )")
+{
+  auto central = allocation_counts{};
+  static_type allocator{central};
+  allocator.set_magazine_size(8);
+
+  SECTION("Refills the magazine from the central allocator in a batch")
+  {
+    auto p = allocator.try_allocate(24,8);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( central.allocations == 8 );
+
+    allocator.deallocate(p,24);
+  }
+
+  SECTION("Serves subsequent allocations from the magazine")
+  {
+    auto p0 = allocator.try_allocate(24,8);
+    auto p1 = allocator.try_allocate(32,8);
+
+    REQUIRE( central.allocations == 8 );
+
+    allocator.deallocate(p1,32);
+    allocator.deallocate(p0,24);
+  }
+
+  SECTION("Forwards uncached sizes to the central allocator")
+  {
+    const auto size = static_type::max_cached_size::value + 1;
+    auto p = allocator.try_allocate(size,8);
+
+    REQUIRE( central.allocations == 1 );
+
+    allocator.deallocate(p,size);
+
+    REQUIRE( central.deallocations == 1 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("thread_caching_allocator::deallocate( void*, std::size_t )")
+{
+  auto central = allocation_counts{};
+  static_type allocator{central};
+  allocator.set_magazine_size(4);
+  allocator.set_low_water_mark(2);
+  allocator.set_high_water_mark(8);
+
+  SECTION("Deallocated memory is reused by the same size class")
+  {
+    auto p = allocator.try_allocate(64,16);
+    allocator.deallocate(p,64);
+
+    REQUIRE( allocator.try_allocate(50,16) == p );
+
+    allocator.deallocate(p,64);
+  }
+
+  SECTION("Flushes to the low water mark past the high water mark")
+  {
+    void* pointers[9];
+    for( auto& p : pointers ) {
+      p = allocator.try_allocate(64,16);
+    }
+    REQUIRE( central.outstanding() == 12 );
+
+    for( auto p : pointers ) {
+      allocator.deallocate(p,64);
+    }
+
+    // 3 chunks remain cached after 3 refills; the 6th deallocation raises
+    // the magazine to 9 chunks, which is flushed down to 2, and the
+    // remaining 3 deallocations leave 5 chunks cached
+    REQUIRE( central.outstanding() == 5 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("thread_caching_allocator" "[thread exit]")
+{
+  auto central = allocation_counts{};
+  static_type allocator{central};
+  allocator.set_magazine_size(16);
+
+  SECTION("Frees from another thread are cached by that thread")
+  {
+    auto p = allocator.try_allocate(16,16);
+
+    std::thread([&]{ allocator.deallocate(p,16); }).join();
+
+    SECTION("Flushing this thread's cache leaves nothing outstanding")
+    {
+      allocator.flush_thread_cache();
+
+      REQUIRE( central.outstanding() == 0 );
+    }
+  }
+
+  SECTION("Frees from a running thread are cached by that thread")
+  {
+    std::atomic<int> stage{0};
+    void* reused = nullptr;
+
+    auto p = allocator.try_allocate(16,16);
+
+    auto thread = std::thread([&]{
+      while( stage.load() != 1 ) std::this_thread::yield();
+
+      allocator.deallocate(p,16);
+      reused = allocator.try_allocate(16,16);
+      allocator.deallocate(reused,16);
+      stage.store(2);
+
+      while( stage.load() != 3 ) std::this_thread::yield();
+
+      allocator.flush_thread_cache();
+      stage.store(4);
+    });
+
+    // The owning thread keeps allocating while the other thread frees
+    stage.store(1);
+    void* pointers[32];
+    for( auto& q : pointers ) {
+      q = allocator.try_allocate(16,16);
+    }
+    while( stage.load() != 2 ) std::this_thread::yield();
+
+    REQUIRE( reused == p );
+    for( auto q : pointers ) {
+      REQUIRE( q != p );
+      allocator.deallocate(q,16);
+    }
+
+    stage.store(3);
+    thread.join();
+
+    SECTION("Flushing both threads' caches leaves nothing outstanding")
+    {
+      allocator.flush_thread_cache();
+
+      REQUIRE( central.outstanding() == 0 );
+    }
+  }
+
+  SECTION("Allocations on an exiting thread are flushed back")
+  {
+    std::thread([&]{
+      auto p = allocator.try_allocate(128,16);
+      allocator.deallocate(p,128);
+    }).join();
+
+    REQUIRE( central.allocations == 16 );
+    REQUIRE( central.outstanding() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("thread_caching_allocator::~thread_caching_allocator()")
+{
+  auto central = allocation_counts{};
+
+  {
+    static_type allocator{central};
+    allocator.set_magazine_size(8);
+
+    auto p = allocator.try_allocate(16,16);
+    allocator.deallocate(p,16);
+
+    std::thread([&]{
+      auto p = allocator.try_allocate(16,16);
+      allocator.deallocate(p,16);
+    }).join();
+  }
+
+  SECTION("Flushes the caches of every thread")
+  {
+    REQUIRE( central.allocations == 16 );
+    REQUIRE( central.outstanding() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("thread_caching_allocator::~thread_caching_allocator() with a running thread")
+{
+  auto central = allocation_counts{};
+  auto allocator = std::make_unique<static_type>(central);
+  allocator->set_magazine_size(8);
+
+  std::atomic<int> stage{0};
+  auto outstanding = std::size_t{0};
+  auto cache_count = std::size_t{0};
+
+  auto thread = std::thread([&]{
+    auto p = allocator->try_allocate(16,16);
+    allocator->deallocate(p,16);
+    stage.store(1);
+
+    while( stage.load() != 2 ) std::this_thread::yield();
+
+    // The thread outlives the allocator, and moves on to another one
+    static_type other{central};
+    auto q = other.try_allocate(16,16);
+    other.deallocate(q,16);
+
+    cache_count = static_type::local_cache_count();
+  });
+
+  while( stage.load() != 1 ) std::this_thread::yield();
+  allocator.reset();
+  outstanding = central.outstanding();
+
+  stage.store(2);
+  thread.join();
+
+  SECTION("Flushes the cache of the running thread")
+  {
+    REQUIRE( central.allocations > 8 );
+    REQUIRE( outstanding == 0 );
+  }
+
+  SECTION("The running thread reclaims the flushed cache")
+  {
+    REQUIRE( cache_count == 1 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("thread_caching_allocator::local_cache_count()")
+{
+  auto central = allocation_counts{};
+
+  SECTION("Reclaims the caches of destroyed allocators")
+  {
+    for( auto i = 0; i < 100; ++i ) {
+      static_type allocator{central};
+
+      auto p = allocator.try_allocate(16,16);
+      allocator.deallocate(p,16);
+
+      REQUIRE( static_type::local_cache_count() <= 2 );
+    }
+
+    REQUIRE( static_type::local_cache_count() <= 1 );
+    REQUIRE( central.outstanding() == 0 );
+  }
+}
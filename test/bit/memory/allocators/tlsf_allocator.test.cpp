@@ -0,0 +1,214 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the tlsf_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/allocators/tlsf_allocator.hpp>
+#include <bit/memory/concepts/ExtendedAllocator.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( bit::memory::is_extended_allocator<bit::memory::tlsf_allocator>::value,
+               "tlsf allocator must be an extended allocator" );
+
+static_assert( bit::memory::is_extended_allocator<bit::memory::named_tlsf_allocator>::value,
+               "named tlsf allocator must be an extended allocator" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+  constexpr auto block_size = 4096u;
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("tlsf_allocator::try_allocate( std::size_t, std::size_t, std::size_t )")
+{
+  alignas(64) unsigned char storage[block_size];
+  auto block = bit::memory::memory_block{storage,block_size};
+
+  auto allocator = bit::memory::tlsf_allocator{block};
+
+  SECTION("Allocates memory from the block")
+  {
+    auto p = allocator.try_allocate(100,8);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( allocator.owns(p) );
+  }
+
+  SECTION("Allocations do not overlap")
+  {
+    auto p0 = static_cast<unsigned char*>(allocator.try_allocate(100,8));
+    auto p1 = static_cast<unsigned char*>(allocator.try_allocate(100,8));
+
+    REQUIRE( p0 != nullptr );
+    REQUIRE( p1 != nullptr );
+    REQUIRE( (p0 + 100 <= p1 || p1 + 100 <= p0) );
+  }
+
+  SECTION("Allocates memory aligned to 16 bytes by default")
+  {
+    auto p = allocator.try_allocate(24,1);
+
+    REQUIRE( bit::memory::align_of(p) >= 16 );
+  }
+
+  SECTION("Allocates over-aligned memory")
+  {
+    auto p = allocator.try_allocate(24,256);
+
+    REQUIRE( p != nullptr );
+    REQUIRE( bit::memory::align_of(p) >= 256 );
+  }
+
+  SECTION("Allocates memory aligned at an offset")
+  {
+    auto p = static_cast<unsigned char*>(allocator.try_allocate(24,64,4));
+
+    REQUIRE( p != nullptr );
+    REQUIRE( bit::memory::align_of(p + 4) >= 64 );
+  }
+
+  SECTION("Returns nullptr when the block is exhausted")
+  {
+    auto p = allocator.try_allocate(allocator.max_size(),8);
+    REQUIRE( p != nullptr );
+
+    auto q = allocator.try_allocate(16,8);
+    REQUIRE( q == nullptr );
+  }
+
+  SECTION("Returns nullptr for sizes larger than max_size")
+  {
+    auto p = allocator.try_allocate(allocator.max_size()+1,8);
+
+    REQUIRE( p == nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("tlsf_allocator::deallocate( void*, std::size_t )")
+{
+  alignas(64) unsigned char storage[block_size];
+  auto block = bit::memory::memory_block{storage,block_size};
+
+  auto allocator = bit::memory::tlsf_allocator{block};
+
+  SECTION("Coalesces freed neighbours back into a single block")
+  {
+    auto v = std::vector<void*>{};
+    auto sizes = { 16u, 48u, 200u, 32u, 1000u, 64u };
+
+    for( auto size : sizes ) {
+      v.push_back( allocator.try_allocate(size,16) );
+      REQUIRE( v.back() != nullptr );
+    }
+
+    // Free in an interleaved order to coalesce both forwards and backwards
+    allocator.deallocate(v[1],48);
+    allocator.deallocate(v[3],32);
+    allocator.deallocate(v[2],200);
+    allocator.deallocate(v[0],16);
+    allocator.deallocate(v[5],64);
+    allocator.deallocate(v[4],1000);
+
+    auto p = allocator.try_allocate(allocator.max_size(),8);
+
+    REQUIRE( p != nullptr );
+  }
+
+  SECTION("Coalesces blocks split for over-aligned allocations")
+  {
+    auto p0 = allocator.try_allocate(40,512);
+    auto p1 = allocator.try_allocate(40,1024,8);
+
+    allocator.deallocate(p0,40);
+    allocator.deallocate(p1,40);
+
+    auto p = allocator.try_allocate(allocator.max_size(),8);
+
+    REQUIRE( p != nullptr );
+  }
+
+  SECTION("Reuses deallocated memory")
+  {
+    auto p0 = allocator.try_allocate(128,16);
+    allocator.deallocate(p0,128);
+
+    auto p1 = allocator.try_allocate(128,16);
+
+    REQUIRE( p0 == p1 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("tlsf_allocator::deallocate_all()")
+{
+  alignas(64) unsigned char storage[block_size];
+  auto block = bit::memory::memory_block{storage,block_size};
+
+  auto allocator = bit::memory::tlsf_allocator{block};
+  const auto max_size = allocator.max_size();
+
+  allocator.try_allocate(100,8);
+  allocator.try_allocate(1000,8);
+  allocator.deallocate_all();
+
+  SECTION("Restores the block to a single free block")
+  {
+    auto p = allocator.try_allocate(max_size,8);
+
+    REQUIRE( p != nullptr );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+TEST_CASE("tlsf_allocator::add_block( memory_block )")
+{
+  alignas(64) unsigned char storage0[block_size];
+  alignas(64) unsigned char storage1[block_size * 2];
+
+  auto allocator = bit::memory::tlsf_allocator{};
+
+  SECTION("Cannot allocate without a block")
+  {
+    REQUIRE( allocator.try_allocate(16,8) == nullptr );
+  }
+
+  allocator.add_block( bit::memory::memory_block{storage0,block_size} );
+  allocator.add_block( bit::memory::memory_block{storage1,block_size * 2} );
+
+  SECTION("Allocates from every block")
+  {
+    auto p0 = allocator.try_allocate(block_size + 512,8);
+    auto p1 = allocator.try_allocate(block_size - 512,8);
+
+    REQUIRE( p0 != nullptr );
+    REQUIRE( p1 != nullptr );
+    REQUIRE( allocator.owns(p0) );
+    REQUIRE( allocator.owns(p1) );
+  }
+
+  SECTION("Max size is the size of the largest block")
+  {
+    REQUIRE( allocator.max_size() > block_size );
+    REQUIRE( allocator.max_size() < block_size * 2 );
+  }
+}
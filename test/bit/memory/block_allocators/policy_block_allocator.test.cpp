@@ -0,0 +1,108 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the policy_block_allocator
+ *****************************************************************************/
+
+
+#include <bit/memory/block_allocators/policy_block_allocator.hpp>
+#include <bit/memory/block_allocators/new_block_allocator.hpp>
+#include <bit/memory/concepts/BlockAllocator.hpp>
+#include <bit/memory/policies/taggers/null_tagger.hpp>
+
+#include <catch.hpp>
+
+#include <cstddef>     // std::size_t
+#include <type_traits> // std::integral_constant
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+
+  bool lock_held = false;
+
+  /// A lock that records whether it is currently held
+  struct observed_lock
+  {
+    void lock(){ lock_held = true; }
+    void unlock(){ lock_held = false; }
+  };
+
+  /// A tracker that records whether the lock was held when it was notified
+  template<bool ThreadSafe>
+  struct lock_observing_tracker
+  {
+    using is_thread_safe = std::integral_constant<bool,ThreadSafe>;
+
+    static int  notified;
+    static bool notified_in_lock;
+
+    void on_allocate( void*, std::size_t, std::size_t ){ notify(); }
+    void on_deallocate( const bit::memory::allocator_info&, void*, std::size_t ){ notify(); }
+    void on_deallocate_all(){}
+    void finalize( const bit::memory::allocator_info& ){}
+
+    static void notify()
+    {
+      ++notified;
+      notified_in_lock = notified_in_lock || lock_held;
+    }
+
+    static void reset()
+    {
+      notified         = 0;
+      notified_in_lock = false;
+    }
+  };
+
+  template<bool ThreadSafe>
+  int lock_observing_tracker<ThreadSafe>::notified = 0;
+
+  template<bool ThreadSafe>
+  bool lock_observing_tracker<ThreadSafe>::notified_in_lock = false;
+
+  template<bool ThreadSafe>
+  using observed_block_allocator = bit::memory::policy_block_allocator<
+    bit::memory::new_block_allocator<4096>,
+    bit::memory::null_tagger,
+    lock_observing_tracker<ThreadSafe>,
+    observed_lock
+  >;
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Tracking
+//-----------------------------------------------------------------------------
+
+TEST_CASE("policy_block_allocator<..., MemoryTracker, BasicLockable>")
+{
+  SECTION("Notifies thread-safe trackers outside of the lock")
+  {
+    using tracker_type = lock_observing_tracker<true>;
+    tracker_type::reset();
+
+    observed_block_allocator<true> allocator{};
+
+    auto block = allocator.allocate_block();
+    allocator.deallocate_block(block);
+
+    REQUIRE( tracker_type::notified == 2 );
+    REQUIRE_FALSE( tracker_type::notified_in_lock );
+  }
+
+  SECTION("Notifies other trackers inside of the lock")
+  {
+    using tracker_type = lock_observing_tracker<false>;
+    tracker_type::reset();
+
+    observed_block_allocator<false> allocator{};
+
+    auto block = allocator.allocate_block();
+    allocator.deallocate_block(block);
+
+    REQUIRE( tracker_type::notified == 2 );
+    REQUIRE( tracker_type::notified_in_lock );
+  }
+}
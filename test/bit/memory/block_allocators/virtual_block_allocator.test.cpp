@@ -302,3 +302,205 @@ TEST_CASE("virtual_block_allocator<N,power_two_growth>" "[resource management]")
     block_allocator.deallocate_block( block );
   }
 }
+
+//-----------------------------------------------------------------------------
+// virtual_block_allocator( virtual_memory_page_mode )
+//-----------------------------------------------------------------------------
+
+TEST_CASE("virtual_block_allocator( virtual_memory_page_mode )" "[resource management]")
+{
+  using page_mode = bit::memory::virtual_memory_page_mode;
+
+  SECTION("Uses standard pages in standard mode")
+  {
+    auto block_allocator = bit::memory::virtual_block_allocator<2u>{ page_mode::standard };
+
+    REQUIRE( block_allocator.page_mode() == page_mode::standard );
+    REQUIRE( block_allocator.page_size() == bit::memory::virtual_memory_page_size() );
+  }
+
+  SECTION("Commits blocks in huge page granules")
+  {
+    auto block_allocator = bit::memory::virtual_block_allocator<2u>{ page_mode::transparent_huge };
+    const auto page_size = block_allocator.page_size();
+
+    REQUIRE( page_size == bit::memory::virtual_memory_page_size(block_allocator.page_mode()) );
+    REQUIRE( block_allocator.next_block_size() == page_size );
+
+    auto block = block_allocator.allocate_block();
+
+    REQUIRE( block.size() == page_size );
+    REQUIRE( bit::memory::align_of(block.data()) >= page_size );
+
+    // The memory must be writable
+    std::memset( block.data(), 0x01, block.size() );
+
+    block_allocator.deallocate_block( block );
+  }
+
+  SECTION("Falls back when explicit huge pages are unavailable")
+  {
+    auto block_allocator = bit::memory::virtual_block_allocator<1u>{ page_mode::huge };
+
+    auto block = block_allocator.allocate_block();
+
+    REQUIRE( block != bit::memory::nullblock );
+    REQUIRE( block.size() == block_allocator.page_size() );
+
+    std::memset( block.data(), 0x01, block.size() );
+
+    block_allocator.deallocate_block( block );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// virtual_block_allocator::release_unused / release_idle
+//-----------------------------------------------------------------------------
+
+TEST_CASE("virtual_block_allocator::release_unused( std::size_t )" "[resource management]")
+{
+  static constexpr auto blocks     = 4u;
+  static const     auto block_size = bit::memory::virtual_memory_page_size();
+  auto block_allocator = bit::memory::virtual_block_allocator<blocks>{};
+
+  auto allocated_blocks = std::array<bit::memory::memory_block,blocks>{};
+  for( auto& block : allocated_blocks ) {
+    block = block_allocator.allocate_block();
+  }
+  for( auto& block : allocated_blocks ) {
+    block_allocator.deallocate_block( block );
+  }
+
+  SECTION("Retains every cached block")
+  {
+    REQUIRE( block_allocator.retained_size() == block_size * blocks );
+  }
+
+  SECTION("Decommits blocks beyond the retained size")
+  {
+    const auto released = block_allocator.release_unused( block_size );
+
+    REQUIRE( released == block_size * (blocks - 1) );
+    REQUIRE( block_allocator.retained_size() == block_size );
+  }
+
+  SECTION("Retains the most recently deallocated block")
+  {
+    block_allocator.release_unused( block_size );
+
+    auto block = block_allocator.allocate_block();
+
+    REQUIRE( block.data() == allocated_blocks[blocks - 1].data() );
+
+    block_allocator.deallocate_block( block );
+  }
+
+  SECTION("Recommits released blocks before failing")
+  {
+    block_allocator.release_unused();
+
+    REQUIRE( block_allocator.retained_size() == 0 );
+    REQUIRE( block_allocator.next_block_size() == block_size );
+
+    for( auto& block : allocated_blocks ) {
+      block = block_allocator.allocate_block();
+
+      auto success = block != bit::memory::nullblock;
+      REQUIRE( success );
+
+      // The memory must be writable again
+      std::memset( block.data(), 0x01, block.size() );
+    }
+
+    auto success = block_allocator.allocate_block() == bit::memory::nullblock;
+    REQUIRE( success );
+
+    for( auto& block : allocated_blocks ) {
+      block_allocator.deallocate_block( block );
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("virtual_block_allocator::release_idle( duration, time_point )" "[resource management]")
+{
+  using clock_type = bit::memory::virtual_block_allocator<2u>::clock_type;
+
+  static const auto block_size = bit::memory::virtual_memory_page_size();
+  auto block_allocator = bit::memory::virtual_block_allocator<2u>{};
+
+  auto block = block_allocator.allocate_block();
+  block_allocator.deallocate_block( block );
+
+  SECTION("Retains blocks that are not yet idle")
+  {
+    REQUIRE( block_allocator.release_idle( std::chrono::hours{1} ) == 0 );
+    REQUIRE( block_allocator.retained_size() == block_size );
+  }
+
+  SECTION("Decommits blocks that have been idle too long")
+  {
+    const auto later = clock_type::now() + std::chrono::hours{2};
+
+    REQUIRE( block_allocator.release_idle( std::chrono::hours{1}, later ) == block_size );
+    REQUIRE( block_allocator.retained_size() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// virtual_block_allocator::set_commit_mode
+//-----------------------------------------------------------------------------
+
+TEST_CASE("virtual_block_allocator::set_commit_mode( virtual_memory_commit_mode, std::size_t )" "[resource management]")
+{
+  using commit_mode = bit::memory::virtual_memory_commit_mode;
+  using growth_multiplier = bit::memory::uncapped_power_two_growth;
+
+  auto block_allocator = bit::memory::virtual_block_allocator<16u,growth_multiplier>{};
+
+  SECTION("Commits lazily by default")
+  {
+    REQUIRE( block_allocator.commit_mode() == commit_mode::lazy );
+  }
+
+  SECTION("Prefaults blocks across threads")
+  {
+    block_allocator.set_commit_mode( commit_mode::prefault, 4 );
+
+    REQUIRE( block_allocator.commit_mode() == commit_mode::prefault );
+
+    auto block0 = block_allocator.allocate_block();
+    auto block1 = block_allocator.allocate_block();
+    auto block2 = block_allocator.allocate_block();
+
+    auto success = block2 != bit::memory::nullblock;
+    REQUIRE( success );
+
+    // The memory must be writable, and zeroed
+    auto* const p = static_cast<unsigned char*>(block2.data());
+    REQUIRE( p[0] == 0 );
+    REQUIRE( p[block2.size() - 1] == 0 );
+
+    std::memset( block2.data(), 0x01, block2.size() );
+
+    block_allocator.deallocate_block( block2 );
+    block_allocator.deallocate_block( block1 );
+    block_allocator.deallocate_block( block0 );
+  }
+
+  SECTION("Prefaults recommitted blocks")
+  {
+    block_allocator.set_commit_mode( commit_mode::prefault );
+
+    auto block = block_allocator.allocate_block();
+    block_allocator.deallocate_block( block );
+    block_allocator.release_unused();
+
+    block = block_allocator.allocate_block();
+
+    std::memset( block.data(), 0x01, block.size() );
+
+    block_allocator.deallocate_block( block );
+  }
+}
@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the hybrid_spin_then_park_lock
+ *****************************************************************************/
+
+
+#include <bit/memory/policies/lockables/hybrid_spin_then_park_lock.hpp>
+
+#include <catch.hpp>
+
+#include <atomic> // std::atomic
+#include <chrono> // std::chrono::milliseconds
+#include <mutex>  // std::lock_guard
+#include <thread> // std::thread
+#include <vector> // std::vector
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+TEST_CASE("hybrid_spin_then_park_lock::lock()" "[thread safety]")
+{
+  bit::memory::hybrid_spin_then_park_lock lock;
+
+  static constexpr auto threads    = 4u;
+  static constexpr auto iterations = 20000u;
+
+  SECTION("Only one thread enters the critical section at a time")
+  {
+    auto counter = 0u;
+    auto workers = std::vector<std::thread>{};
+
+    for( auto t = 0u; t < threads; ++t ) {
+      workers.emplace_back([&lock,&counter]()
+      {
+        for( auto i = 0u; i < iterations; ++i ) {
+          std::lock_guard<bit::memory::hybrid_spin_then_park_lock> guard{lock};
+          ++counter;
+        }
+      });
+    }
+    for( auto& worker : workers ) {
+      worker.join();
+    }
+
+    REQUIRE( counter == threads * iterations );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("hybrid_spin_then_park_lock::try_lock()")
+{
+  bit::memory::hybrid_spin_then_park_lock lock;
+
+  SECTION("Acquires an unheld lock")
+  {
+    REQUIRE( lock.try_lock() );
+
+    lock.unlock();
+  }
+
+  SECTION("Fails to acquire a lock held by another thread")
+  {
+    lock.lock();
+
+    auto acquired = true;
+    std::thread([&lock,&acquired]{ acquired = lock.try_lock(); }).join();
+
+    lock.unlock();
+
+    REQUIRE_FALSE( acquired );
+  }
+
+  SECTION("Acquires the lock once it is released")
+  {
+    lock.lock();
+    lock.unlock();
+
+    auto acquired = false;
+    std::thread([&lock,&acquired]{
+      acquired = lock.try_lock();
+      if( acquired ) lock.unlock();
+    }).join();
+
+    REQUIRE( acquired );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("hybrid_spin_then_park_lock::hybrid_spin_then_park_lock( std::size_t )" "[thread safety]")
+{
+  // Without spinning, every contended lock parks its thread
+  bit::memory::hybrid_spin_then_park_lock lock{0};
+
+  SECTION("A parked thread is woken when the lock is released")
+  {
+    std::atomic<bool> entered{false};
+
+    lock.lock();
+
+    auto waiter = std::thread([&lock,&entered]{
+      lock.lock();
+      entered.store(true);
+      lock.unlock();
+    });
+
+    // Give the waiter time to park on the held lock
+    std::this_thread::sleep_for( std::chrono::milliseconds(50) );
+    REQUIRE_FALSE( entered.load() );
+
+    lock.unlock();
+    waiter.join();
+
+    REQUIRE( entered.load() );
+  }
+
+  SECTION("Parked threads are woken one at a time")
+  {
+    static constexpr auto threads    = 4u;
+    static constexpr auto iterations = 2000u;
+
+    auto counter = 0u;
+    auto workers = std::vector<std::thread>{};
+
+    for( auto t = 0u; t < threads; ++t ) {
+      workers.emplace_back([&lock,&counter]()
+      {
+        for( auto i = 0u; i < iterations; ++i ) {
+          std::lock_guard<bit::memory::hybrid_spin_then_park_lock> guard{lock};
+          ++counter;
+        }
+      });
+    }
+    for( auto& worker : workers ) {
+      worker.join();
+    }
+
+    REQUIRE( counter == threads * iterations );
+    REQUIRE( lock.try_lock() );
+    lock.unlock();
+  }
+}
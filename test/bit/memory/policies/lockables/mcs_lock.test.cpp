@@ -0,0 +1,167 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the mcs_lock
+ *****************************************************************************/
+
+
+#include <bit/memory/policies/lockables/mcs_lock.hpp>
+
+#include <catch.hpp>
+
+#include <mutex>  // std::lock_guard
+#include <thread> // std::thread
+#include <vector> // std::vector
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+TEST_CASE("mcs_lock::lock()" "[thread safety]")
+{
+  bit::memory::mcs_lock lock;
+
+  static constexpr auto threads    = 4u;
+  static constexpr auto iterations = 20000u;
+
+  SECTION("Only one thread enters the critical section at a time")
+  {
+    auto counter = 0u;
+    auto workers = std::vector<std::thread>{};
+
+    for( auto t = 0u; t < threads; ++t ) {
+      workers.emplace_back([&lock,&counter]()
+      {
+        for( auto i = 0u; i < iterations; ++i ) {
+          std::lock_guard<bit::memory::mcs_lock> guard{lock};
+          ++counter;
+        }
+      });
+    }
+    for( auto& worker : workers ) {
+      worker.join();
+    }
+
+    REQUIRE( counter == threads * iterations );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("mcs_lock::try_lock()")
+{
+  bit::memory::mcs_lock lock;
+
+  SECTION("Acquires an unheld lock")
+  {
+    REQUIRE( lock.try_lock() );
+
+    lock.unlock();
+  }
+
+  SECTION("Fails to acquire a lock held by another thread")
+  {
+    lock.lock();
+
+    auto acquired = true;
+    std::thread([&lock,&acquired]{ acquired = lock.try_lock(); }).join();
+
+    lock.unlock();
+
+    REQUIRE_FALSE( acquired );
+  }
+
+  SECTION("Acquires the lock once it is released")
+  {
+    lock.lock();
+    lock.unlock();
+
+    auto acquired = false;
+    std::thread([&lock,&acquired]{
+      acquired = lock.try_lock();
+      if( acquired ) lock.unlock();
+    }).join();
+
+    REQUIRE( acquired );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("mcs_lock" "[nesting]")
+{
+  bit::memory::mcs_lock locks[bit::memory::mcs_lock::max_held_locks];
+
+  SECTION("A thread may hold several locks at once")
+  {
+    for( auto& lock : locks ) {
+      lock.lock();
+    }
+
+    auto acquired = 0u;
+    std::thread([&locks,&acquired]{
+      for( auto& lock : locks ) {
+        if( lock.try_lock() ) ++acquired;
+      }
+    }).join();
+
+    REQUIRE( acquired == 0u );
+
+    for( auto& lock : locks ) {
+      lock.unlock();
+    }
+  }
+
+  SECTION("Locks may be released in any order")
+  {
+    locks[0].lock();
+    locks[1].lock();
+    locks[2].lock();
+
+    locks[1].unlock();
+    REQUIRE( locks[1].try_lock() );
+
+    locks[0].unlock();
+    locks[2].unlock();
+    locks[1].unlock();
+
+    auto acquired = 0u;
+    std::thread([&locks,&acquired]{
+      for( auto i = 0u; i < 3u; ++i ) {
+        if( locks[i].try_lock() ) ++acquired;
+      }
+      for( auto i = 0u; i < 3u; ++i ) {
+        locks[i].unlock();
+      }
+    }).join();
+
+    REQUIRE( acquired == 3u );
+  }
+
+  SECTION("Nested locks are mutually exclusive across threads")
+  {
+    static constexpr auto threads    = 4u;
+    static constexpr auto iterations = 5000u;
+
+    auto outer   = 0u;
+    auto inner   = 0u;
+    auto workers = std::vector<std::thread>{};
+
+    for( auto t = 0u; t < threads; ++t ) {
+      workers.emplace_back([&locks,&outer,&inner]()
+      {
+        for( auto i = 0u; i < iterations; ++i ) {
+          std::lock_guard<bit::memory::mcs_lock> outer_guard{locks[0]};
+          ++outer;
+          std::lock_guard<bit::memory::mcs_lock> inner_guard{locks[1]};
+          ++inner;
+        }
+      });
+    }
+    for( auto& worker : workers ) {
+      worker.join();
+    }
+
+    REQUIRE( outer == threads * iterations );
+    REQUIRE( inner == threads * iterations );
+  }
+}
@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the spin_lock
+ *****************************************************************************/
+
+
+#include <bit/memory/policies/lockables/spin_lock.hpp>
+
+#include <catch.hpp>
+
+#include <mutex>  // std::lock_guard
+#include <thread> // std::thread
+#include <vector> // std::vector
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+TEST_CASE("spin_lock::lock()" "[thread safety]")
+{
+  bit::memory::spin_lock lock;
+
+  static constexpr auto threads    = 4u;
+  static constexpr auto iterations = 20000u;
+
+  SECTION("Only one thread enters the critical section at a time")
+  {
+    auto counter = 0u;
+    auto workers = std::vector<std::thread>{};
+
+    for( auto t = 0u; t < threads; ++t ) {
+      workers.emplace_back([&lock,&counter]()
+      {
+        for( auto i = 0u; i < iterations; ++i ) {
+          std::lock_guard<bit::memory::spin_lock> guard{lock};
+          ++counter;
+        }
+      });
+    }
+    for( auto& worker : workers ) {
+      worker.join();
+    }
+
+    REQUIRE( counter == threads * iterations );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("spin_lock::try_lock()")
+{
+  bit::memory::spin_lock lock;
+
+  SECTION("Acquires an unheld lock")
+  {
+    REQUIRE( lock.try_lock() );
+
+    lock.unlock();
+  }
+
+  SECTION("Fails to acquire a lock held by another thread")
+  {
+    lock.lock();
+
+    auto acquired = true;
+    std::thread([&lock,&acquired]{ acquired = lock.try_lock(); }).join();
+
+    lock.unlock();
+
+    REQUIRE_FALSE( acquired );
+  }
+
+  SECTION("Acquires the lock once it is released")
+  {
+    lock.lock();
+    lock.unlock();
+
+    auto acquired = false;
+    std::thread([&lock,&acquired]{
+      acquired = lock.try_lock();
+      if( acquired ) lock.unlock();
+    }).join();
+
+    REQUIRE( acquired );
+  }
+}
@@ -0,0 +1,177 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the concurrent_stat_tracker
+ *****************************************************************************/
+
+
+#include <bit/memory/policies/trackers/concurrent_stat_tracker.hpp>
+#include <bit/memory/policies/trackers/null_tracker.hpp>
+#include <bit/memory/concepts/MemoryTracker.hpp>
+
+#include <catch.hpp>
+
+#include <cstddef>     // std::size_t
+#include <thread>      // std::thread
+#include <type_traits> // std::true_type
+#include <vector>      // std::vector
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+namespace {
+
+  struct thread_safe_tracker : bit::memory::null_tracker
+  {
+    using is_thread_safe = std::true_type;
+  };
+
+} // anonymous namespace
+
+static_assert( bit::memory::memory_tracker_is_thread_safe_v<bit::memory::concurrent_stat_tracker>,
+               "concurrent_stat_tracker must be thread-safe" );
+
+static_assert( bit::memory::memory_tracker_is_thread_safe_v<thread_safe_tracker>,
+               "trackers declaring 'is_thread_safe' must be thread-safe" );
+
+static_assert( !bit::memory::memory_tracker_is_thread_safe_v<bit::memory::null_tracker>,
+               "trackers not declaring 'is_thread_safe' must not be thread-safe" );
+
+static_assert( !bit::memory::memory_tracker_is_thread_safe_v<bit::memory::stat_recording_null_tracker>,
+               "trackers not declaring 'is_thread_safe' must not be thread-safe" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+
+  // Requests of this size are published as soon as they are recorded, so
+  // that the totals are exact no matter which shard records them
+  constexpr auto published_size
+    = static_cast<std::size_t>(bit::memory::concurrent_stat_tracker::publish_threshold);
+
+  const auto info = bit::memory::allocator_info{"test",nullptr};
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Tracking
+//-----------------------------------------------------------------------------
+
+TEST_CASE("concurrent_stat_tracker::on_allocate( void*, std::size_t, std::size_t )")
+{
+  bit::memory::concurrent_stat_tracker tracker;
+
+  tracker.on_allocate( nullptr, published_size, 8 );
+  tracker.on_allocate( nullptr, published_size * 2, 16 );
+  tracker.on_deallocate( info, nullptr, published_size * 2 );
+  tracker.on_allocate( nullptr, published_size * 3, 32 );
+
+  SECTION("Counts every allocation")
+  {
+    REQUIRE( tracker.allocations() == 3 );
+    REQUIRE( tracker.deallocations() == 1 );
+    REQUIRE( tracker.total_allocated() == published_size * 6 );
+  }
+
+  SECTION("Records the largest and smallest requests")
+  {
+    REQUIRE( tracker.largest_request() == published_size * 3 );
+    REQUIRE( tracker.smallest_request() == published_size );
+    REQUIRE( tracker.largest_alignment_request() == 32 );
+    REQUIRE( tracker.smallest_alignment_request() == 8 );
+  }
+
+  SECTION("Records the peak size")
+  {
+    REQUIRE( tracker.peak_size() == published_size * 4 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("concurrent_stat_tracker" "[thread safety]")
+{
+  bit::memory::concurrent_stat_tracker tracker;
+
+  static constexpr auto threads    = 4u;
+  static constexpr auto iterations = 200u;
+  static constexpr auto held       = 8u;
+
+  auto workers = std::vector<std::thread>{};
+  for( auto t = 0u; t < threads; ++t ) {
+    workers.emplace_back([&tracker,t]()
+    {
+      // Each thread uses its own alignment, so that the extremes come from
+      // different shards
+      const auto align = std::size_t{8} << t;
+
+      for( auto i = 0u; i < iterations; ++i ) {
+        for( auto j = 0u; j < held; ++j ) {
+          tracker.on_allocate( nullptr, published_size + t, align );
+        }
+        for( auto j = 0u; j < held; ++j ) {
+          tracker.on_deallocate( info, nullptr, published_size + t );
+        }
+      }
+      // Small requests stay in the shard until read
+      tracker.on_allocate( nullptr, t + 1, align );
+    });
+  }
+  for( auto& worker : workers ) {
+    worker.join();
+  }
+
+  SECTION("Aggregates the counts of every shard")
+  {
+    REQUIRE( tracker.allocations() == threads * (iterations * held + 1) );
+    REQUIRE( tracker.deallocations() == threads * iterations * held );
+  }
+
+  SECTION("Aggregates the total allocated by every shard")
+  {
+    auto expected = std::size_t{0};
+    for( auto t = 0u; t < threads; ++t ) {
+      expected += iterations * held * (published_size + t) + (t + 1);
+    }
+
+    REQUIRE( tracker.total_allocated() == expected );
+  }
+
+  SECTION("Aggregates the extremes of every shard")
+  {
+    REQUIRE( tracker.largest_request() == published_size + threads - 1 );
+    REQUIRE( tracker.smallest_request() == 1 );
+    REQUIRE( tracker.largest_alignment_request() == (std::size_t{8} << (threads - 1)) );
+    REQUIRE( tracker.smallest_alignment_request() == 8 );
+  }
+
+  SECTION("Records a peak between one and every thread's held size")
+  {
+    REQUIRE( tracker.peak_size() >= held * published_size );
+    REQUIRE( tracker.peak_size() <= threads * held * (published_size + threads) );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("concurrent_stat_tracker::on_deallocate_all()")
+{
+  bit::memory::concurrent_stat_tracker tracker;
+
+  tracker.on_allocate( nullptr, published_size, 8 );
+  tracker.on_allocate( nullptr, 16, 8 );
+  tracker.on_deallocate_all();
+  tracker.on_allocate( nullptr, published_size, 8 );
+
+  SECTION("Does not count as deallocations")
+  {
+    REQUIRE( tracker.deallocations() == 0 );
+  }
+
+  SECTION("Keeps the peak size")
+  {
+    REQUIRE( tracker.peak_size() == published_size + 16 );
+  }
+}
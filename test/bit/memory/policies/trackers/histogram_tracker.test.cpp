@@ -0,0 +1,261 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the histogram_tracker
+ *****************************************************************************/
+
+
+#include <bit/memory/policies/trackers/histogram_tracker.hpp>
+
+#include <catch.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <cstdio>  // std::tmpfile, std::fgets, std::rewind, std::fclose
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+namespace {
+
+  using histogram_type = bit::memory::histogram_tracker::histogram_type;
+
+  const auto info = bit::memory::allocator_info{"test",nullptr};
+
+  /// Enough distinct addresses to fill the lifetime table, and more
+  constexpr auto max_pointers = bit::memory::histogram_tracker::max_tracked_lifetimes + 64;
+
+  alignas(16) char storage[max_pointers * 16];
+
+  void* pointer_at( std::size_t index )
+  {
+    return storage + index * 16;
+  }
+
+  /// Deallocates \p index from \p tracker, checking that the lifetime it
+  /// records is the one expected from its birth
+  void deallocate_and_check( bit::memory::histogram_tracker& tracker,
+                             std::size_t index,
+                             std::uint64_t clock )
+  {
+    const auto bucket = histogram_type::bucket_of( clock - index );
+    const auto before = tracker.lifetimes().count_at( bucket );
+
+    tracker.on_deallocate( info, pointer_at(index), 16 );
+
+    REQUIRE( tracker.lifetimes().count_at( bucket ) == before + 1 );
+  }
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Tracking
+//-----------------------------------------------------------------------------
+
+TEST_CASE("histogram_tracker::on_allocate( void*, std::size_t, std::size_t )")
+{
+  bit::memory::histogram_tracker tracker;
+
+  tracker.on_allocate( pointer_at(0), 8, 8 );
+  tracker.on_allocate( pointer_at(1), 8, 16 );
+  tracker.on_allocate( pointer_at(2), 100, 8 );
+
+  SECTION("Records the size of every allocation")
+  {
+    REQUIRE( tracker.sizes().count() == 3 );
+    REQUIRE( tracker.sizes().min() == 8 );
+    REQUIRE( tracker.sizes().max() == 100 );
+  }
+
+  SECTION("Records the alignment of every allocation")
+  {
+    REQUIRE( tracker.alignments().count() == 3 );
+    REQUIRE( tracker.alignments().count_at( histogram_type::bucket_of(8) ) == 2 );
+    REQUIRE( tracker.alignments().count_at( histogram_type::bucket_of(16) ) == 1 );
+  }
+
+  SECTION("Records no lifetimes until deallocated")
+  {
+    REQUIRE( tracker.lifetimes().count() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("histogram_tracker::on_deallocate( const allocator_info&, void*, std::size_t )")
+{
+  bit::memory::histogram_tracker tracker;
+
+  SECTION("Measures lifetimes in allocations")
+  {
+    tracker.on_allocate( pointer_at(0), 16, 8 );
+    tracker.on_allocate( pointer_at(1), 16, 8 );
+    tracker.on_allocate( pointer_at(2), 16, 8 );
+    tracker.on_deallocate( info, pointer_at(1), 16 );
+    tracker.on_allocate( pointer_at(3), 16, 8 );
+    tracker.on_deallocate( info, pointer_at(0), 16 );
+
+    REQUIRE( tracker.lifetimes().count() == 2 );
+    REQUIRE( tracker.lifetimes().min() == 2 );
+    REQUIRE( tracker.lifetimes().max() == 4 );
+  }
+
+  SECTION("Finds entries after removals from the middle of probe chains")
+  {
+    // Half a table of entries forces many collisions into probe chains
+    constexpr auto count = std::size_t{2048};
+
+    for( auto i = std::size_t{0}; i < count; ++i ) {
+      tracker.on_allocate( pointer_at(i), 16, 8 );
+    }
+
+    // Every third entry is removed first, in reverse, so that the removals
+    // land in the middle of chains and later entries are shifted back
+    for( auto i = count; i-- > 0; ) {
+      if( i % 3 == 1 ) deallocate_and_check( tracker, i, count );
+    }
+    for( auto i = std::size_t{0}; i < count; ++i ) {
+      if( i % 3 != 1 ) deallocate_and_check( tracker, i, count );
+    }
+
+    REQUIRE( tracker.lifetimes().count() == count );
+    REQUIRE( tracker.lifetimes().min() == 1 );
+    REQUIRE( tracker.lifetimes().max() == count );
+    REQUIRE( tracker.untracked_lifetimes() == 0 );
+  }
+
+  SECTION("Reuses the slots of removed entries")
+  {
+    for( auto round = 0; round < 4; ++round ) {
+      for( auto i = std::size_t{0}; i < 1024; ++i ) {
+        tracker.on_allocate( pointer_at(i), 16, 8 );
+      }
+      for( auto i = std::size_t{0}; i < 1024; ++i ) {
+        tracker.on_deallocate( info, pointer_at(i), 16 );
+      }
+    }
+
+    REQUIRE( tracker.lifetimes().count() == 4 * 1024 );
+    REQUIRE( tracker.lifetimes().max() == 1024 );
+    REQUIRE( tracker.untracked_lifetimes() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("histogram_tracker::untracked_lifetimes()")
+{
+  bit::memory::histogram_tracker tracker;
+
+  constexpr auto limit = bit::memory::histogram_tracker::max_tracked_lifetimes;
+
+  for( auto i = std::size_t{0}; i < max_pointers; ++i ) {
+    tracker.on_allocate( pointer_at(i), 16, 8 );
+  }
+
+  SECTION("Counts the allocations made while the table is full")
+  {
+    REQUIRE( tracker.untracked_lifetimes() == max_pointers - limit );
+  }
+
+  SECTION("Still records the size and alignment of untracked allocations")
+  {
+    REQUIRE( tracker.sizes().count() == max_pointers );
+    REQUIRE( tracker.alignments().count() == max_pointers );
+  }
+
+  SECTION("Records the lifetime of every tracked allocation")
+  {
+    for( auto i = max_pointers; i-- > 0; ) {
+      tracker.on_deallocate( info, pointer_at(i), 16 );
+    }
+
+    REQUIRE( tracker.lifetimes().count() == limit );
+  }
+
+  SECTION("Tracks new allocations once an entry is removed")
+  {
+    tracker.on_deallocate( info, pointer_at(limit / 2), 16 );
+    tracker.on_allocate( pointer_at(limit / 2), 16, 8 );
+    tracker.on_deallocate( info, pointer_at(limit / 2), 16 );
+
+    REQUIRE( tracker.lifetimes().count() == 2 );
+    REQUIRE( tracker.lifetimes().min() == 1 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("histogram_tracker::on_deallocate_all()")
+{
+  bit::memory::histogram_tracker tracker;
+
+  for( auto i = std::size_t{0}; i < 10; ++i ) {
+    tracker.on_allocate( pointer_at(i), 16, 8 );
+  }
+  tracker.on_deallocate_all();
+
+  SECTION("Ends the lifetime of every live allocation")
+  {
+    REQUIRE( tracker.lifetimes().count() == 10 );
+    REQUIRE( tracker.lifetimes().min() == 1 );
+    REQUIRE( tracker.lifetimes().max() == 10 );
+  }
+
+  SECTION("Forgets the ended allocations")
+  {
+    tracker.on_deallocate( info, pointer_at(0), 16 );
+
+    REQUIRE( tracker.lifetimes().count() == 10 );
+  }
+
+  SECTION("Tracks every allocation again afterwards")
+  {
+    for( auto i = std::size_t{0}; i < max_pointers; ++i ) {
+      tracker.on_allocate( pointer_at(i), 16, 8 );
+    }
+
+    REQUIRE( tracker.untracked_lifetimes() == max_pointers - bit::memory::histogram_tracker::max_tracked_lifetimes );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Output
+//-----------------------------------------------------------------------------
+
+TEST_CASE("histogram_tracker::dump( std::FILE* )")
+{
+  bit::memory::histogram_tracker tracker;
+
+  tracker.on_allocate( pointer_at(0), 8, 8 );
+  tracker.on_allocate( pointer_at(1), 8, 16 );
+  tracker.on_deallocate( info, pointer_at(0), 8 );
+
+  auto* file = std::tmpfile();
+  REQUIRE( file != nullptr );
+
+  tracker.dump( file );
+  std::rewind( file );
+
+  auto lines = std::vector<std::string>{};
+  char buffer[128];
+  while( std::fgets( buffer, sizeof(buffer), file ) != nullptr ) {
+    lines.emplace_back( buffer );
+  }
+  std::fclose( file );
+
+  SECTION("Writes a CSV header followed by every non-empty bucket")
+  {
+    const auto expected = std::vector<std::string>{
+      "histogram,lower,upper,count\n",
+      "size,8,8,2\n",
+      "alignment,8,8,1\n",
+      "alignment,16,17,1\n",
+      "lifetime,2,2,1\n"
+    };
+
+    REQUIRE( lines == expected );
+  }
+}
@@ -0,0 +1,109 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the latency_tracker
+ *****************************************************************************/
+
+
+#include <bit/memory/policies/trackers/latency_tracker.hpp>
+#include <bit/memory/utilities/cpu.hpp>
+
+#include <catch.hpp>
+
+#include <thread>  // std::thread
+#include <utility> // std::move
+#include <vector>  // std::vector
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+TEST_CASE("latency_tracker::latency_tracker()")
+{
+  bit::memory::latency_tracker tracker;
+
+  SECTION("Creates a shard for every processor")
+  {
+    REQUIRE( tracker.shards() == bit::memory::cpu_count() );
+  }
+
+  SECTION("Starts with no latencies")
+  {
+    REQUIRE( tracker.allocate_summary().count == 0 );
+    REQUIRE( tracker.deallocate_summary().count == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("latency_tracker::latency_tracker( latency_tracker&& )")
+{
+  bit::memory::latency_tracker tracker;
+  tracker.on_allocate_latency(10);
+
+  bit::memory::latency_tracker moved{std::move(tracker)};
+
+  SECTION("Takes the recorded latencies")
+  {
+    REQUIRE( moved.allocate_latencies().count() == 1 );
+    REQUIRE( moved.allocate_latencies().max() == 10 );
+  }
+
+  SECTION("The moved-from tracker discards latencies")
+  {
+    tracker.on_allocate_latency(20);
+    tracker.on_deallocate_latency(20);
+
+    REQUIRE( tracker.shards() == 0 );
+    REQUIRE( tracker.allocate_summary().count == 0 );
+    REQUIRE( tracker.deallocate_summary().count == 0 );
+    REQUIRE( moved.allocate_latencies().count() == 1 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("latency_tracker::on_allocate_latency( clock_type::rep )")
+{
+  bit::memory::latency_tracker tracker;
+
+  SECTION("Merges the latencies of every thread")
+  {
+    const auto thread_count = 4u;
+    const auto iterations   = 1000u;
+
+    auto threads = std::vector<std::thread>{};
+    for( auto i = 0u; i < thread_count; ++i ) {
+      threads.emplace_back([&tracker,i]{
+        for( auto j = 0u; j < iterations; ++j ) {
+          tracker.on_allocate_latency( i + 1 );
+        }
+      });
+    }
+    for( auto& thread : threads ) {
+      thread.join();
+    }
+
+    const auto latencies = tracker.allocate_latencies();
+
+    REQUIRE( latencies.count() == thread_count * iterations );
+    REQUIRE( latencies.max() == thread_count );
+    REQUIRE( tracker.deallocate_latencies().count() == 0 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("latency_tracker::clear()")
+{
+  bit::memory::latency_tracker tracker;
+  tracker.on_allocate_latency(10);
+  tracker.on_deallocate_latency(10);
+
+  tracker.clear();
+
+  SECTION("Discards the latencies of every shard")
+  {
+    REQUIRE( tracker.allocate_summary().count == 0 );
+    REQUIRE( tracker.deallocate_summary().count == 0 );
+  }
+}
@@ -0,0 +1,123 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the allocator_traits
+ *****************************************************************************/
+
+
+#include <bit/memory/traits/allocator_traits.hpp>
+#include <bit/memory/allocators/malloc_allocator.hpp>
+#include <bit/memory/allocators/pool_allocator.hpp>
+#include <bit/memory/concepts/Allocator.hpp>
+
+#include <catch.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdlib> // std::malloc, std::free
+
+namespace {
+
+  /// An allocator without batch functions that fails after a fixed number
+  /// of allocations
+  class limited_allocator
+  {
+  public:
+
+    explicit limited_allocator( std::size_t limit )
+      : m_limit(limit)
+    {
+
+    }
+
+    void* try_allocate( std::size_t size, std::size_t )
+      noexcept
+    {
+      if( allocations == m_limit ) return nullptr;
+
+      ++allocations;
+      return std::malloc(size);
+    }
+
+    void deallocate( void* p, std::size_t )
+    {
+      ++deallocations;
+      std::free(p);
+    }
+
+    std::size_t allocations   = 0;
+    std::size_t deallocations = 0;
+
+  private:
+
+    std::size_t m_limit;
+  };
+
+  using malloc_traits  = bit::memory::allocator_traits<bit::memory::malloc_allocator>;
+  using limited_traits = bit::memory::allocator_traits<limited_allocator>;
+  using pool_traits    = bit::memory::allocator_traits<bit::memory::pool_allocator>;
+
+} // anonymous namespace
+
+//=============================================================================
+// Static Requirements
+//=============================================================================
+
+static_assert( !bit::memory::allocator_has_try_allocate_n<bit::memory::malloc_allocator>::value,
+               "malloc_allocator must use the fallback batch allocation" );
+
+static_assert( !bit::memory::allocator_has_deallocate_n<bit::memory::malloc_allocator>::value,
+               "malloc_allocator must use the fallback batch deallocation" );
+
+static_assert( bit::memory::allocator_has_try_allocate_n<bit::memory::pool_allocator>::value,
+               "pool_allocator must provide batch allocation" );
+
+//=============================================================================
+// Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Batch Allocation / Deallocation
+//-----------------------------------------------------------------------------
+
+TEST_CASE("allocator_traits<Allocator>::try_allocate_n( Allocator&, std::size_t, std::size_t, std::size_t, void** )")
+{
+  SECTION("Falls back to a try_allocate per allocation")
+  {
+    auto allocator = bit::memory::malloc_allocator{};
+    void* pointers[8] = {};
+
+    REQUIRE( malloc_traits::try_allocate_n(allocator,32,8,8,pointers) == 8 );
+    for( auto p : pointers ) {
+      REQUIRE( p != nullptr );
+    }
+
+    malloc_traits::deallocate_n(allocator,pointers,8,32);
+  }
+
+  SECTION("Stops at the first failed allocation of the fallback")
+  {
+    auto allocator = limited_allocator{5};
+    void* pointers[8] = {};
+
+    REQUIRE( limited_traits::try_allocate_n(allocator,32,8,8,pointers) == 5 );
+    REQUIRE( allocator.allocations == 5 );
+
+    limited_traits::deallocate_n(allocator,pointers,5,32);
+
+    REQUIRE( allocator.deallocations == 5 );
+  }
+
+  SECTION("Dispatches to the allocator's own batch allocation")
+  {
+    alignas(64) static char storage[64 * 8];
+    auto allocator = bit::memory::pool_allocator{
+      64u, bit::memory::memory_block{storage,sizeof(storage)}
+    };
+    void* pointers[10] = {};
+
+    REQUIRE( pool_traits::try_allocate_n(allocator,32,8,10,pointers) == 8 );
+
+    pool_traits::deallocate_n(allocator,pointers,8,32);
+
+    REQUIRE( pool_traits::try_allocate_n(allocator,32,8,8,pointers) == 8 );
+  }
+}
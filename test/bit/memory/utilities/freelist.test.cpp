@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the freelist
+ *****************************************************************************/
+
+
+#include <bit/memory/utilities/freelist.hpp>
+
+#include <catch.hpp>
+
+namespace {
+
+  /// Storage for freelist entries
+  struct entry
+  {
+    alignas(void*) char storage[sizeof(void*)];
+  };
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+// Caching
+//----------------------------------------------------------------------------
+
+TEST_CASE("freelist::request_n( void**, std::size_t )")
+{
+  entry entries[4];
+  auto list = bit::memory::freelist{};
+
+  for( auto& e : entries ) {
+    list.store( &e );
+  }
+
+  SECTION("Requests entries in the order they would be requested singly")
+  {
+    void* out[3];
+
+    REQUIRE( list.request_n(out,3) == 3 );
+    REQUIRE( out[0] == &entries[3] );
+    REQUIRE( out[1] == &entries[2] );
+    REQUIRE( out[2] == &entries[1] );
+    REQUIRE( list.request() == &entries[0] );
+  }
+
+  SECTION("Requests at most the entries available")
+  {
+    void* out[8];
+
+    REQUIRE( list.request_n(out,8) == 4 );
+    REQUIRE( list.empty() );
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_CASE("freelist::splice( void*, void* )")
+{
+  entry entries[4];
+  auto list  = bit::memory::freelist{};
+  auto chain = bit::memory::freelist{};
+
+  list.store( &entries[0] );
+  chain.store( &entries[3] );
+  chain.store( &entries[2] );
+  chain.store( &entries[1] );
+
+  // Detach the chain from its list; its entries remain linked
+  void* out[3];
+  chain.request_n(out,3);
+
+  list.splice( out[0], out[2] );
+
+  SECTION("Stores the whole chain in front of the existing entries")
+  {
+    REQUIRE( list.size() == 4 );
+    REQUIRE( list.request() == &entries[1] );
+    REQUIRE( list.request() == &entries[2] );
+    REQUIRE( list.request() == &entries[3] );
+    REQUIRE( list.request() == &entries[0] );
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_CASE("freelist::steal( freelist& )")
+{
+  entry entries[4];
+  auto list  = bit::memory::freelist{};
+  auto other = bit::memory::freelist{};
+
+  other.store( &entries[1] );
+  other.store( &entries[0] );
+
+  SECTION("Takes every entry when empty")
+  {
+    list.steal( other );
+
+    REQUIRE( other.empty() );
+    REQUIRE( list.size() == 2 );
+    REQUIRE( list.request() == &entries[0] );
+    REQUIRE( list.request() == &entries[1] );
+  }
+
+  SECTION("Splices every entry in front of existing entries")
+  {
+    list.store( &entries[3] );
+    list.store( &entries[2] );
+
+    list.steal( other );
+
+    REQUIRE( other.empty() );
+    REQUIRE( list.size() == 4 );
+    REQUIRE( list.request() == &entries[0] );
+    REQUIRE( list.request() == &entries[1] );
+    REQUIRE( list.request() == &entries[2] );
+    REQUIRE( list.request() == &entries[3] );
+  }
+
+  SECTION("Leaves the list unchanged when stealing from an empty list")
+  {
+    list.store( &entries[2] );
+
+    auto empty = bit::memory::freelist{};
+    list.steal( empty );
+
+    REQUIRE( list.size() == 1 );
+  }
+}
@@ -0,0 +1,197 @@
+/*****************************************************************************
+ * \file
+ * \brief Unit tests for the log_linear_histogram
+ *****************************************************************************/
+
+
+#include <bit/memory/utilities/log_linear_histogram.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <limits>
+
+namespace {
+  using histogram = bit::memory::log_linear_histogram<3>;
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------
+
+TEST_CASE("log_linear_histogram::log_linear_histogram()")
+{
+  auto h = histogram();
+
+  SECTION("Contains no values")
+  {
+    REQUIRE( h.count() == 0 );
+  }
+
+  SECTION("Reports 0 for every statistic")
+  {
+    REQUIRE( h.min() == 0 );
+    REQUIRE( h.max() == 0 );
+    REQUIRE( h.value_at_percentile(50.0) == 0 );
+  }
+}
+
+//----------------------------------------------------------------------------
+// Buckets
+//----------------------------------------------------------------------------
+
+TEST_CASE("log_linear_histogram::bucket_of( std::uint64_t )")
+{
+  SECTION("Gives small values their own bucket")
+  {
+    for( auto v = std::uint64_t{0}; v < 2 * histogram::sub_buckets; ++v ) {
+      const auto bucket = histogram::bucket_of(v);
+
+      REQUIRE( histogram::bucket_lower_bound(bucket) == v );
+      REQUIRE( histogram::bucket_upper_bound(bucket) == v );
+    }
+  }
+
+  SECTION("Places every value within the bounds of its bucket")
+  {
+    for( auto v = std::uint64_t{1}; v < (std::uint64_t{1} << 62); v = v * 3 + 1 ) {
+      const auto bucket = histogram::bucket_of(v);
+
+      REQUIRE( histogram::bucket_lower_bound(bucket) <= v );
+      REQUIRE( histogram::bucket_upper_bound(bucket) >= v );
+    }
+  }
+
+  SECTION("Bounds the relative error by the precision")
+  {
+    const auto bucket = histogram::bucket_of(1000);
+    const auto width  = histogram::bucket_upper_bound(bucket) -
+                        histogram::bucket_lower_bound(bucket) + 1;
+
+    REQUIRE( width * histogram::sub_buckets <= 1000 );
+  }
+
+  SECTION("Places the largest value in the last bucket")
+  {
+    const auto max = std::numeric_limits<std::uint64_t>::max();
+
+    REQUIRE( histogram::bucket_of(max) == histogram::buckets - 1 );
+    REQUIRE( histogram::bucket_upper_bound(histogram::buckets - 1) == max );
+  }
+
+  SECTION("Leaves no gaps between buckets")
+  {
+    for( auto b = std::size_t{0}; b + 1 < histogram::buckets; ++b ) {
+      REQUIRE( histogram::bucket_upper_bound(b) + 1 ==
+               histogram::bucket_lower_bound(b + 1) );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Recording
+//----------------------------------------------------------------------------
+
+TEST_CASE("log_linear_histogram::record( std::uint64_t )")
+{
+  auto h = histogram();
+
+  for( auto v = std::uint64_t{1}; v <= 1000; ++v ) {
+    h.record(v);
+  }
+
+  SECTION("Counts every value")
+  {
+    REQUIRE( h.count() == 1000 );
+  }
+
+  SECTION("Records the exact extremes")
+  {
+    REQUIRE( h.min() == 1 );
+    REQUIRE( h.max() == 1000 );
+  }
+
+  SECTION("Reports percentiles within the precision")
+  {
+    const auto p50 = h.value_at_percentile(50.0);
+    const auto p99 = h.value_at_percentile(99.0);
+
+    REQUIRE( p50 >= 500 );
+    REQUIRE( p50 <= 500 + 500 / histogram::sub_buckets );
+    REQUIRE( p99 >= 990 );
+    REQUIRE( p99 <= 1000 );
+    REQUIRE( h.value_at_percentile(100.0) == 1000 );
+  }
+
+  SECTION("Visits only the buckets that hold values")
+  {
+    auto total = std::uint64_t{0};
+    auto last  = std::uint64_t{0};
+    h.for_each_bucket([&]( std::uint64_t lower,
+                           std::uint64_t upper,
+                           std::uint64_t count ){
+      REQUIRE( count > 0 );
+      REQUIRE( lower <= upper );
+      REQUIRE( lower >= last );
+      last   = upper;
+      total += count;
+    });
+
+    REQUIRE( total == h.count() );
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_CASE("log_linear_histogram::clear()")
+{
+  auto h = histogram();
+  h.record(5);
+  h.record(500);
+  h.clear();
+
+  SECTION("Removes every value")
+  {
+    REQUIRE( h.count() == 0 );
+    REQUIRE( h.count_at( histogram::bucket_of(5) ) == 0 );
+    REQUIRE( h.max() == 0 );
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_CASE("log_linear_histogram::merge( const log_linear_histogram& )")
+{
+  auto h = histogram();
+  h.record(5);
+  h.record(500);
+
+  auto other = histogram();
+  other.record(3);
+  other.record(5);
+  other.record(9000);
+
+  h.merge(other);
+
+  SECTION("Adds the counts of every bucket")
+  {
+    REQUIRE( h.count() == 5 );
+    REQUIRE( h.count_at( histogram::bucket_of(5) ) == 2 );
+    REQUIRE( h.count_at( histogram::bucket_of(3) ) == 1 );
+  }
+
+  SECTION("Combines the extremes")
+  {
+    REQUIRE( h.min() == 3 );
+    REQUIRE( h.max() == 9000 );
+  }
+
+  SECTION("Leaves the histogram unchanged when merging an empty one")
+  {
+    h.merge( histogram() );
+
+    REQUIRE( h.count() == 5 );
+    REQUIRE( h.min() == 3 );
+    REQUIRE( h.max() == 9000 );
+  }
+}